@@ -1209,6 +1209,17 @@ macro(process_options)
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
+  # Compile out the trace sources invoked with NS_TRACE if requested
+  if(NOT ${NS3_TRACE})
+    # The tests connect sinks to these trace sources, e.g. the TCP tests
+    if(${ENABLE_TESTS})
+      message(
+        FATAL_ERROR
+          "The tests require the trace sources.\nTry reconfiguring CMake with -DNS3_TESTS=OFF or -DNS3_TRACE=ON"
+      )
+    endif()
+    add_definitions(-DNS3_TRACE_DISABLE)
+  endif()
 
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
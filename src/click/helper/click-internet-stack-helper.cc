@@ -25,6 +25,7 @@
 
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/assert.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/callback.h"
 #include "ns3/config.h"
 #include "ns3/core-config.h"
@@ -360,6 +361,15 @@ Ipv4L3ProtocolDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d',
+                      Simulator::Now(),
+                      ipv4->GetObject<Node>()->GetId(),
+                      BinaryTraceWriter::NO_ID,
+                      p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -387,6 +397,11 @@ Ipv4L3ProtocolDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), context, p);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *p << std::endl;
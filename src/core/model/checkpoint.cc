@@ -0,0 +1,528 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "checkpoint.h"
+
+#include "abort.h"
+#include "config.h"
+#include "log.h"
+#include "object-ptr-container.h"
+#include "pointer.h"
+#include "simulator-impl.h"
+#include "simulator.h"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHECKPOINT_MMAP
+#endif
+
+/**
+ * \file
+ * \ingroup checkpoint
+ * ns3::Checkpoint implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Checkpoint");
+
+namespace
+{
+
+const char CHECKPOINT_MAGIC[8] = {'n', 's', '3', 'c', 'k', 'p', 't', '1'}; //!< File magic
+const uint32_t CHECKPOINT_BOM = 0x01020304; //!< Byte order mark
+
+/// The types of the records of a checkpoint
+enum RecordType : char
+{
+    ATTRIBUTE_RECORD = 'a', //!< The value of an attribute
+    STATE_RECORD = 's'      //!< The state saved by a hook
+};
+
+/// The hooks which save and restore the state of the objects of a type
+struct StateHook
+{
+    TypeId tid;                          //!< The type of the objects
+    Checkpoint::SaveCallback save;       //!< Save the state of an object
+    Checkpoint::RestoreCallback restore; //!< Restore the state of an object
+};
+
+/**
+ * \brief Get the hooks registered
+ * \return the hooks
+ */
+std::vector<StateHook>&
+GetStateHooks()
+{
+    static std::vector<StateHook> hooks;
+    return hooks;
+}
+
+/**
+ * \brief Append the bytes of a value to a buffer
+ * \param buffer the buffer
+ * \param value the value
+ */
+template <typename T>
+void
+Append(std::vector<char>& buffer, const T& value)
+{
+    const char* p = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+/**
+ * \brief Append a record to a buffer
+ * \param buffer the buffer
+ * \param type the type of the record
+ * \param path the path of the object
+ * \param name the name of the attribute, or of the type of the hook
+ * \param value the value of the attribute, or the state of the object
+ */
+void
+AppendRecord(std::vector<char>& buffer,
+             RecordType type,
+             const std::string& path,
+             const std::string& name,
+             const std::string& value)
+{
+    buffer.push_back(type);
+    for (const std::string* s : {&path, &name, &value})
+    {
+        Append(buffer, static_cast<uint32_t>(s->size()));
+        buffer.insert(buffer.end(), s->begin(), s->end());
+    }
+}
+
+/**
+ * \brief Read a value from a buffer
+ * \param data the buffer
+ * \param size the size of the buffer
+ * \param offset [in,out] the offset of the value, moved past the value
+ * \param value [out] the value
+ */
+template <typename T>
+void
+Extract(const char* data, std::size_t size, std::size_t& offset, T& value)
+{
+    NS_ABORT_MSG_IF(size - offset < sizeof(T), "Truncated checkpoint");
+    std::memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+}
+
+/**
+ * \brief Read a string from a buffer, without copying it
+ * \param data the buffer
+ * \param size the size of the buffer
+ * \param offset [in,out] the offset of the string, moved past the string
+ * \return the string
+ */
+std::string_view
+ExtractString(const char* data, std::size_t size, std::size_t& offset)
+{
+    uint32_t length;
+    Extract(data, size, offset, length);
+    NS_ABORT_MSG_IF(size - offset < length, "Truncated checkpoint");
+    std::string_view s(data + offset, length);
+    offset += length;
+    return s;
+}
+
+/**
+ * \brief Check if an attribute points to objects
+ * \param info the attribute
+ * \return true if the attribute is a Pointer or an ObjectPtrContainer
+ */
+bool
+IsObjectAttribute(const TypeId::AttributeInformation& info)
+{
+    return dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr ||
+           dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) != nullptr;
+}
+
+/**
+ * \brief Check if the value of an attribute is saved in the checkpoints
+ * \param info the attribute
+ * \return true if the attribute has a value which can be got, serialized and set
+ */
+bool
+IsSavedAttribute(const TypeId::AttributeInformation& info)
+{
+    return (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter() &&
+           (info.flags & TypeId::ATTR_SET) && info.accessor->HasSetter() &&
+           info.supportLevel == TypeId::SUPPORTED && !IsObjectAttribute(info) &&
+           dynamic_cast<const CallbackChecker*>(PeekPointer(info.checker)) == nullptr;
+}
+
+/**
+ * Function called for each object visited: the path and the object.
+ */
+typedef std::function<void(const std::string&, Ptr<Object>)> ObjectVisitor;
+
+/**
+ * \brief Visit an object, then the objects its attributes point to and
+ * its aggregates, once each.
+ *
+ * The paths of the objects are built as by the ConfigStore.
+ *
+ * \param path the path of the object
+ * \param object the object
+ * \param visited [in,out] the objects already visited
+ * \param visit the function called for each object
+ */
+void
+VisitObjects(const std::string& path,
+             Ptr<Object> object,
+             std::unordered_set<const Object*>& visited,
+             const ObjectVisitor& visit)
+{
+    if (!visited.insert(PeekPointer(object)).second)
+    {
+        return;
+    }
+    visit(path, object);
+    for (TypeId tid = object->GetInstanceTypeId(); tid.HasParent(); tid = tid.GetParent())
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            const TypeId::AttributeInformation& info = tid.GetAttribute(i);
+            if (!IsObjectAttribute(info) || !(info.flags & TypeId::ATTR_GET) ||
+                !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                PointerValue pointer;
+                info.accessor->Get(PeekPointer(object), pointer);
+                Ptr<Object> item = pointer.Get<Object>();
+                if (item)
+                {
+                    VisitObjects(path + "/" + info.name + "/$" +
+                                     item->GetInstanceTypeId().GetName(),
+                                 item,
+                                 visited,
+                                 visit);
+                }
+                continue;
+            }
+            ObjectPtrContainerValue items;
+            info.accessor->Get(PeekPointer(object), items);
+            for (auto it = items.Begin(); it != items.End(); ++it)
+            {
+                if (it->second)
+                {
+                    VisitObjects(path + "/" + info.name + "/" + std::to_string(it->first) +
+                                     "/$" + it->second->GetInstanceTypeId().GetName(),
+                                 it->second,
+                                 visited,
+                                 visit);
+                }
+            }
+        }
+    }
+    Object::AggregateIterator aggregates = object->GetAggregateIterator();
+    while (aggregates.HasNext())
+    {
+        Ptr<Object> item = const_cast<Object*>(PeekPointer(aggregates.Next()));
+        VisitObjects(path + "/$" + item->GetInstanceTypeId().GetName(), item, visited, visit);
+    }
+}
+
+/**
+ * \brief Visit the objects reachable from the root namespaces of the Config paths
+ * \param visit the function called for each object
+ */
+void
+VisitAllObjects(const ObjectVisitor& visit)
+{
+    std::unordered_set<const Object*> visited;
+    for (std::size_t i = 0; i < Config::GetRootNamespaceObjectN(); i++)
+    {
+        Ptr<Object> root = Config::GetRootNamespaceObject(i);
+        VisitObjects("/$" + root->GetInstanceTypeId().GetName(), root, visited, visit);
+    }
+}
+
+/**
+ * \brief Check if a hook applies to an object
+ * \param hook the hook
+ * \param object the object
+ * \return true if the object is of the type of the hook, or of a subclass
+ */
+bool
+IsHookOf(const StateHook& hook, Ptr<Object> object)
+{
+    TypeId tid = object->GetInstanceTypeId();
+    return tid == hook.tid || tid.IsChildOf(hook.tid);
+}
+
+/**
+ * \brief The content of a checkpoint file, mapped in memory when the
+ * system supports it.
+ */
+class CheckpointData
+{
+  public:
+    /**
+     * \brief Map or read a file
+     * \param filename the name of the file
+     */
+    CheckpointData(const std::string& filename);
+    ~CheckpointData();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CheckpointData(const CheckpointData&) = delete;
+    CheckpointData& operator=(const CheckpointData&) = delete;
+
+    /** \return the content of the file */
+    const char* GetData() const
+    {
+        return m_data;
+    }
+
+    /** \return the size of the file */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+  private:
+    const char* m_data;    //!< The content of the file
+    std::size_t m_size;    //!< The size of the file
+    bool m_mapped;         //!< True if the file is mapped in memory
+    std::string m_content; //!< The content of the file, when it is not mapped
+};
+
+CheckpointData::CheckpointData(const std::string& filename)
+    : m_data(nullptr),
+      m_size(0),
+      m_mapped(false)
+{
+#ifdef CHECKPOINT_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Unable to open checkpoint " << filename);
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            m_data = static_cast<const char*>(data);
+            m_size = st.st_size;
+            m_mapped = true;
+        }
+    }
+    close(fd);
+    if (m_mapped)
+    {
+        return;
+    }
+#endif
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Unable to open checkpoint " << filename);
+    std::ostringstream content;
+    content << file.rdbuf();
+    m_content = content.str();
+    m_data = m_content.data();
+    m_size = m_content.size();
+}
+
+CheckpointData::~CheckpointData()
+{
+#ifdef CHECKPOINT_MMAP
+    if (m_mapped)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+}
+
+} // namespace
+
+void
+Checkpoint::Save(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::vector<char> buffer(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+    Append(buffer, CHECKPOINT_BOM);
+    Append(buffer, Simulator::Now().GetTimeStep());
+    uint32_t attributes = 0;
+    uint32_t states = 0;
+    VisitAllObjects([&buffer, &attributes, &states](const std::string& path, Ptr<Object> object) {
+        for (TypeId tid = object->GetInstanceTypeId(); tid.HasParent(); tid = tid.GetParent())
+        {
+            for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+            {
+                const TypeId::AttributeInformation& info = tid.GetAttribute(i);
+                if (!IsSavedAttribute(info))
+                {
+                    continue;
+                }
+                Ptr<AttributeValue> value = info.checker->Create();
+                if (info.accessor->Get(PeekPointer(object), *value))
+                {
+                    AppendRecord(buffer,
+                                 ATTRIBUTE_RECORD,
+                                 path,
+                                 info.name,
+                                 value->SerializeToString(info.checker));
+                    attributes++;
+                }
+            }
+        }
+        for (const auto& hook : GetStateHooks())
+        {
+            if (IsHookOf(hook, object))
+            {
+                std::ostringstream os;
+                hook.save(object, os);
+                AppendRecord(buffer, STATE_RECORD, path, hook.tid.GetName(), os.str());
+                states++;
+            }
+        }
+    });
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Unable to open checkpoint " << filename);
+    file.write(buffer.data(), buffer.size());
+    NS_ABORT_MSG_IF(file.fail(), "Unable to write checkpoint " << filename);
+    NS_LOG_INFO("Saved " << attributes << " attributes and " << states << " states at "
+                         << Simulator::Now().As(Time::S));
+}
+
+void
+Checkpoint::Restore(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    CheckpointData file(filename);
+    const char* data = file.GetData();
+    std::size_t size = file.GetSize();
+    NS_ABORT_MSG_IF(size < sizeof(CHECKPOINT_MAGIC) ||
+                        std::memcmp(data, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0,
+                    filename << " is not a checkpoint");
+    std::size_t offset = sizeof(CHECKPOINT_MAGIC);
+    uint32_t bom;
+    Extract(data, size, offset, bom);
+    NS_ABORT_MSG_IF(bom != CHECKPOINT_BOM, "Checkpoint " << filename << " of another byte order");
+    int64_t ts;
+    Extract(data, size, offset, ts);
+
+    // The records, by type, path and name
+    std::unordered_map<std::string, std::string_view> records;
+    while (offset < size)
+    {
+        char type = data[offset++];
+        std::string_view path = ExtractString(data, size, offset);
+        std::string_view name = ExtractString(data, size, offset);
+        std::string_view value = ExtractString(data, size, offset);
+        std::string key;
+        key.reserve(path.size() + name.size() + 2);
+        key.append(1, type).append(path).append(1, '/').append(name);
+        records.emplace(std::move(key), value);
+    }
+
+    Time time = TimeStep(ts);
+    NS_ABORT_MSG_IF(time < Simulator::Now(),
+                    "Checkpoint " << filename << " earlier than the current time");
+    Simulator::GetImplementation()->SetCurrentTime(time);
+
+    std::size_t restored = 0;
+    uint32_t changed = 0;
+    auto find = [&records, &restored](RecordType type,
+                                      const std::string& path,
+                                      const std::string& name) {
+        std::string key;
+        key.reserve(path.size() + name.size() + 2);
+        key.append(1, type).append(path).append(1, '/').append(name);
+        auto it = records.find(key);
+        if (it == records.end())
+        {
+            return std::make_pair(false, std::string_view());
+        }
+        restored++;
+        return std::make_pair(true, it->second);
+    };
+    VisitAllObjects([&find, &changed](const std::string& path, Ptr<Object> object) {
+        for (TypeId tid = object->GetInstanceTypeId(); tid.HasParent(); tid = tid.GetParent())
+        {
+            for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+            {
+                const TypeId::AttributeInformation& info = tid.GetAttribute(i);
+                if (!IsSavedAttribute(info))
+                {
+                    continue;
+                }
+                auto [found, saved] = find(ATTRIBUTE_RECORD, path, info.name);
+                Ptr<AttributeValue> value = info.checker->Create();
+                if (!found || !info.accessor->Get(PeekPointer(object), *value) ||
+                    value->SerializeToString(info.checker) == saved)
+                {
+                    continue;
+                }
+                // Only set the attributes changed, since setting an attribute
+                // may have side effects.
+                if (!value->DeserializeFromString(std::string(saved), info.checker) ||
+                    !info.accessor->Set(PeekPointer(object), *value))
+                {
+                    NS_LOG_WARN("Unable to restore " << path << "/" << info.name << " to "
+                                                     << saved);
+                    continue;
+                }
+                changed++;
+            }
+        }
+        for (const auto& hook : GetStateHooks())
+        {
+            if (IsHookOf(hook, object))
+            {
+                auto [found, saved] = find(STATE_RECORD, path, hook.tid.GetName());
+                if (found)
+                {
+                    std::istringstream is{std::string(saved)};
+                    hook.restore(object, is);
+                }
+            }
+        }
+    });
+    NS_LOG_INFO("Restored " << changed << " attributes changed at " << time.As(Time::S));
+    if (restored != records.size())
+    {
+        NS_LOG_WARN(records.size() - restored << " values of the checkpoint were not restored,"
+                                              << " their objects don't exist");
+    }
+}
+
+void
+Checkpoint::AddStateHook(TypeId tid, SaveCallback save, RestoreCallback restore)
+{
+    NS_LOG_FUNCTION(tid.GetName());
+    GetStateHooks().push_back({tid, save, restore});
+}
+
+} // namespace ns3
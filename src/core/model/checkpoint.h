@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "callback.h"
+#include "object.h"
+#include "ptr.h"
+#include "type-id.h"
+
+#include <iostream>
+#include <string>
+
+/**
+ * \file
+ * \ingroup checkpoint
+ * ns3::Checkpoint declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \defgroup checkpoint Checkpoint
+ *
+ * Save the state of a simulation, to start other runs from it.
+ */
+
+/**
+ * \ingroup checkpoint
+ *
+ * \brief Save the state of a simulation in a file, and restore it in
+ * another run.
+ *
+ * A checkpoint holds the current time, and the state of all the objects
+ * reachable from the root namespaces of the Config paths, e.g., from the
+ * NodeList: the value of their attributes, found by introspection, and
+ * the state saved by the hooks that the modules register for their types,
+ * e.g., the entries of the ARP caches.
+ *
+ * The events pending can't be saved.  To restore a checkpoint, a run builds
+ * the same scenario as the run which saved it, then calls Restore() before
+ * Simulator::Run():
+ *
+ * \code
+ *   // warm-up run
+ *   BuildScenario();
+ *   Simulator::Schedule(Seconds(60), &Checkpoint::Save, "warm.ckpt");
+ *   Simulator::Stop(Seconds(60));
+ *   Simulator::Run();
+ *
+ *   // measurement run
+ *   BuildScenario();
+ *   Checkpoint::Restore("warm.ckpt");
+ *   Simulator::Stop(Seconds(10));
+ *   Simulator::Run();
+ * \endcode
+ *
+ * Restore() moves the current time to the time of the checkpoint: the
+ * events scheduled at an earlier time, e.g., the start of the applications,
+ * are run at the time of the checkpoint.  Then it sets the attributes which
+ * differ from the checkpoint, and calls the restore hooks.  The objects
+ * which don't exist in the run restored, e.g., the sockets opened by the
+ * applications, are ignored.
+ *
+ * The file is read through a memory mapping when the system supports it.
+ */
+class Checkpoint
+{
+  public:
+    /**
+     * Callback to save the state of an object which is not held by its
+     * attributes.
+     *
+     * \param [in] object The object.
+     * \param [in,out] os The stream to write the state to.
+     */
+    typedef Callback<void, Ptr<Object>, std::ostream&> SaveCallback;
+    /**
+     * Callback to restore the state of an object saved by a SaveCallback.
+     *
+     * \param [in] object The object.
+     * \param [in,out] is The stream to read the state from.
+     */
+    typedef Callback<void, Ptr<Object>, std::istream&> RestoreCallback;
+
+    /**
+     * Save the state of the simulation.
+     *
+     * \param [in] filename The name of the checkpoint file.
+     */
+    static void Save(const std::string& filename);
+    /**
+     * Restore the state of the simulation saved by Save().
+     *
+     * The checkpoint must not be earlier than the current time.
+     *
+     * \param [in] filename The name of the checkpoint file.
+     */
+    static void Restore(const std::string& filename);
+    /**
+     * Register the hooks which save and restore the state of the objects
+     * of a type, and of its subclasses.
+     *
+     * The modules which support checkpoints register their hooks when
+     * they are loaded.
+     *
+     * \param [in] tid The type of the objects.
+     * \param [in] save The callback which saves the state of an object.
+     * \param [in] restore The callback which restores the state of an object.
+     */
+    static void AddStateHook(TypeId tid, SaveCallback save, RestoreCallback restore);
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
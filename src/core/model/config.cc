@@ -26,7 +26,11 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 
 /**
  * \file
@@ -197,6 +201,8 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, when the matcher is constructed.
  */
 class ArrayMatcher
 {
@@ -214,8 +220,24 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the indices which match the Config Path, if they are all less
+     * than a bound and fewer than it.
+     *
+     * \param [in] n The bound of the indices.
+     * \param [out] indices The matching indices, in increasing order.
+     * \returns \c false if the Config Path can match an index greater than
+     *          or equal to \pname{n}, or at least \pname{n} indices.
+     */
+    bool GetIndices(std::size_t n, std::vector<std::size_t>* indices) const;
 
   private:
+    /**
+     * Parse a Config path specification, or one of its alternatives.
+     *
+     * \param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,75 +248,112 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether the Config path element matches every index. */
+    bool m_all;
+    /** The ranges of matching indices, bounds included. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_all = true;
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        std::string left = element.substr(0, tmp - 0);
+        std::string right = element.substr(tmp + 1, element.size() - (tmp + 1));
+        Parse(left);
+        Parse(right);
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
+        {
+            m_ranges.emplace_back(min, max);
+        }
+        return;
+    }
+    uint32_t value;
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
+        return true;
+    }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
         {
             NS_LOG_DEBUG("Array " << i << " matches " << m_element);
             return true;
         }
-        else
+    }
+    NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
+    return false;
+}
+
+bool
+ArrayMatcher::GetIndices(std::size_t n, std::vector<std::size_t>* indices) const
+{
+    NS_LOG_FUNCTION(this << n << indices);
+    if (m_all)
+    {
+        return false;
+    }
+    std::size_t count = 0;
+    for (const auto& range : m_ranges)
+    {
+        count += range.second - range.first + 1;
+        if (range.second >= n || count >= n)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
             return false;
         }
     }
-    uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    indices->clear();
+    for (const auto& range : m_ranges)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
+        for (std::size_t i = range.first; i <= range.second; i++)
+        {
+            indices->push_back(i);
+        }
     }
-    NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-    return false;
+    std::sort(indices->begin(), indices->end());
+    indices->erase(std::unique(indices->begin(), indices->end()), indices->end());
+    return true;
 }
 
 bool
@@ -307,9 +366,68 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * The objects found by the resolvers of a Config::Batch, to be reused by
+ * the next resolvers.
+ */
+class ResolverCache
+{
+  public:
+    /** An object found from another object on a Config path. */
+    struct Match
+    {
+        Ptr<Object> object;            //!< The object found.
+        std::vector<std::string> path; //!< The elements of the path to the object.
+    };
+
+    /** The objects found from an object. */
+    typedef std::vector<Match> Matches;
+
+    /** The objects found from an object by the next elements of a Config path. */
+    struct Entry
+    {
+        /**
+         * Whether the objects are in a container, and depend on the element
+         * after the next one, their index.
+         */
+        bool indexed;
+        Matches matches; //!< The objects found.
+    };
+
+    /**
+     * An object, the next element of a Config path and the element after it,
+     * if the objects found are indexed, or "/".
+     */
+    typedef std::tuple<const Object*, std::string, std::string> Key;
+
+    /** Hash function of a Key. */
+    struct KeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<const Object*>()(std::get<0>(key));
+            hash = hash * 31 + std::hash<std::string>()(std::get<1>(key));
+            return hash * 31 + std::hash<std::string>()(std::get<2>(key));
+        }
+    };
+
+    /** The objects found from an object by the next elements of a Config path. */
+    std::unordered_map<Key, Entry, KeyHash> m_matches;
+
+}; // class ResolverCache
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is split into its elements once, when the resolver is
+ * constructed, and the pointer and container attributes which can match
+ * an element are looked up once for each TypeId.
  */
 class Resolver
 {
@@ -332,24 +450,85 @@ class Resolver
      */
     void Resolve(Ptr<Object> root);
 
+    /**
+     * Reuse the objects found by the previous resolvers sharing the cache,
+     * and store the objects found by this one.
+     *
+     * \param [in] cache The cache.
+     */
+    void SetCache(ResolverCache* cache);
+
   private:
+    /** An element of the Config path. */
+    struct Element
+    {
+        /**
+         * Parse an element of the Config path.
+         *
+         * \param [in] element The element.
+         */
+        Element(std::string element);
+
+        std::string item;     //!< The element.
+        ArrayMatcher matcher; //!< The element as an array index.
+        bool isObject;        //!< Whether the element is a "$" GetObject element.
+        bool hasTid;          //!< Whether the TypeId of a GetObject element exists.
+        TypeId tid;           //!< The TypeId of a GetObject element.
+    };
+
+    /** A pointer or container attribute which can be followed on a Config path. */
+    struct PathAttribute
+    {
+        std::string name;                      //!< The name of the attribute.
+        Ptr<const AttributeAccessor> accessor; //!< The accessor of the attribute.
+        /** The accessor of a container attribute. */
+        const ObjectPtrContainerAccessor* containerAccessor;
+        bool container; //!< Whether the attribute is a container.
+        bool gettable;  //!< Whether the attribute has a getter.
+    };
+
     /** Ensure the Config path starts and ends with a '/'. */
     void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] i The index of the next element.
+     * \param [in] root The object corresponding to the current position
+     *                  in the Config path.
+     */
+    void DoResolve(std::size_t i, Ptr<Object> root);
+    /**
+     * Find the objects matching the next element in the Config path.
+     *
+     * \param [in] i The index of the next element.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
+     * \param [out] matches The objects found.
+     * \param [out] indexed Whether objects were looked up in a container.
+     */
+    void DoFind(std::size_t i, Ptr<Object> root, ResolverCache::Matches* matches, bool* indexed);
+    /**
+     * Find the objects of a container matching an index on the Config path.
+     *
+     * \param [in] i The index of the element of the index.
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
+     * \param [out] matches The objects found.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoArrayFind(std::size_t i,
+                     Ptr<Object> root,
+                     const PathAttribute& attribute,
+                     ResolverCache::Matches* matches);
     /**
-     * Parse an index on the Config path.
+     * Get the value of a pointer or container attribute.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] object The object.
+     * \param [in] attribute The attribute.
+     * \param [out] value The value.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void GetAttribute(Ptr<Object> object,
+                      const PathAttribute& attribute,
+                      AttributeValue& value) const;
     /**
      * Handle one object found on the path.
      *
@@ -370,18 +549,53 @@ class Resolver
      */
     virtual void DoOne(Ptr<Object> object, std::string path) = 0;
 
+    /**
+     * Get the pointer and container attributes of a TypeId and its parents
+     * matching an element of a Config path.
+     *
+     * \param [in] tid The TypeId.
+     * \param [in] item The element of the Config path.
+     * \returns The attributes.
+     */
+    static const std::vector<PathAttribute>& GetAttributes(TypeId tid, const std::string& item);
+
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
     /** The Config path. */
     std::string m_path;
+    /** The elements of the Config path. */
+    std::vector<Element> m_elements;
+    /** The objects found by the previous resolvers, or null. */
+    ResolverCache* m_cache;
 
 }; // class Resolver
 
+Resolver::Element::Element(std::string element)
+    : item(element),
+      matcher(element),
+      isObject(element.find('$') == 0),
+      hasTid(false)
+{
+    if (isObject)
+    {
+        hasTid = TypeId::LookupByNameFailSafe(element.substr(1, element.size() - 1), &tid);
+    }
+}
+
 Resolver::Resolver(std::string path)
-    : m_path(path)
+    : m_path(path),
+      m_cache(nullptr)
 {
     NS_LOG_FUNCTION(this << path);
     Canonicalize();
+
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = m_path.find('/', start)) != std::string::npos)
+    {
+        m_elements.emplace_back(m_path.substr(start, next - start));
+        start = next + 1;
+    }
 }
 
 Resolver::~Resolver()
@@ -414,7 +628,14 @@ Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
+}
+
+void
+Resolver::SetCache(ResolverCache* cache)
+{
+    NS_LOG_FUNCTION(this << cache);
+    m_cache = cache;
 }
 
 std::string
@@ -441,13 +662,11 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t i, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << i << root);
 
-    if (next == std::string::npos)
+    if (i == m_elements.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -463,8 +682,58 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+
+    ResolverCache::Matches found;
+    const ResolverCache::Matches* matches = &found;
+    bool indexed = false;
+    if (m_cache != nullptr)
+    {
+        // The objects found also depend on the element after this one when
+        // it is the index of a container: they are then stored with it, and
+        // marked as indexed without it.
+        const std::string& item = m_elements[i].item;
+        std::string next = i + 1 < m_elements.size() ? m_elements[i + 1].item : "//";
+        auto it = m_cache->m_matches.find(std::make_tuple(PeekPointer(root), item, "/"));
+        if (it != m_cache->m_matches.end() && it->second.indexed)
+        {
+            it = m_cache->m_matches.find(std::make_tuple(PeekPointer(root), item, next));
+        }
+        if (it == m_cache->m_matches.end())
+        {
+            DoFind(i, root, &found, &indexed);
+            ResolverCache::Entry entry = {indexed, std::move(found)};
+            if (indexed)
+            {
+                m_cache->m_matches[std::make_tuple(PeekPointer(root), item, "/")] = {true, {}};
+            }
+            else
+            {
+                next = "/";
+            }
+            auto key = std::make_tuple(PeekPointer(root), item, next);
+            it = m_cache->m_matches.emplace(key, std::move(entry)).first;
+        }
+        matches = &it->second.matches;
+    }
+    else
+    {
+        DoFind(i, root, &found, &indexed);
+    }
+
+    for (const auto& match : *matches)
+    {
+        m_workStack.insert(m_workStack.end(), match.path.begin(), match.path.end());
+        DoResolve(i + match.path.size(), match.object);
+        m_workStack.resize(m_workStack.size() - match.path.size());
+    }
+}
+
+void
+Resolver::DoFind(std::size_t i, Ptr<Object> root, ResolverCache::Matches* matches, bool* indexed)
+{
+    NS_LOG_FUNCTION(this << i << root << matches << indexed);
+    const Element& element = m_elements[i];
+    const std::string& item = element.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -475,12 +744,9 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
+            matches->push_back({nullptr, {item}});
             return;
         }
     }
@@ -495,9 +761,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     if (namedObject)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
-        m_workStack.pop_back();
+        matches->push_back({namedObject, {item}});
         return;
     }
 
@@ -512,124 +776,187 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (element.isObject)
     {
         // This is a call to GetObject
         std::string tidString = item.substr(1, item.size() - 1);
         NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        // an unknown TypeId is a fatal error, as soon as the path reaches it
+        TypeId tid = element.hasTid ? element.tid : TypeId::LookupByName(tidString);
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
             NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
             return;
         }
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
-        m_workStack.pop_back();
+        matches->push_back({object, {item}});
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
-        bool foundMatch = false;
-
-        do
+        const std::vector<PathAttribute>& attributes =
+            GetAttributes(root->GetInstanceTypeId(), item);
+        for (const auto& attribute : attributes)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (!attribute.container)
             {
-                struct TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const PointerChecker* pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const ObjectPtrContainerChecker* vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                matches->push_back({object, {attribute.name}});
             }
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                *indexed = true;
+                DoArrayFind(i + 1, root, attribute, matches);
+            }
+        }
 
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
-
-        if (!foundMatch)
+        if (attributes.empty())
         {
             NS_LOG_DEBUG("Requested item=" << item
                                            << " does not exist on path=" << GetResolvedPath());
-            return;
         }
     }
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayFind(std::size_t i,
+                      Ptr<Object> root,
+                      const PathAttribute& attribute,
+                      ResolverCache::Matches* matches)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(path != "");
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << i << root << attribute.name << matches);
+    if (i == m_elements.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_elements[i].matcher;
+
+    // When the path selects a few indices, e.g., "/NodeList/3", get these
+    // objects only instead of the whole container.  This is possible if the
+    // object at each position has this position as index, as in vectors.
+    std::size_t n;
+    std::vector<std::size_t> indices;
+    if (attribute.containerAccessor != nullptr && attribute.gettable &&
+        attribute.containerAccessor->GetN(PeekPointer(root), &n) && matcher.GetIndices(n, &indices))
+    {
+        ResolverCache::Matches found;
+        for (auto k : indices)
+        {
+            std::size_t index;
+            Ptr<Object> object = attribute.containerAccessor->Get(PeekPointer(root), k, &index);
+            if (index != k)
+            {
+                break;
+            }
+            found.push_back({object, {attribute.name, std::to_string(k)}});
+        }
+        if (found.size() == indices.size())
+        {
+            matches->insert(matches->end(), found.begin(), found.end());
+            return;
+        }
+    }
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    ObjectPtrContainerValue container;
+    GetAttribute(root, attribute, container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            matches->push_back({(*it).second, {attribute.name, std::to_string((*it).first)}});
         }
     }
 }
 
+void
+Resolver::GetAttribute(Ptr<Object> object,
+                       const PathAttribute& attribute,
+                       AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << object << attribute.name << &value);
+    if (!attribute.gettable || !attribute.accessor->Get(PeekPointer(object), value))
+    {
+        // report the error
+        object->GetAttribute(attribute.name, value);
+    }
+}
+
+const std::vector<Resolver::PathAttribute>&
+Resolver::GetAttributes(TypeId tid, const std::string& item)
+{
+    NS_LOG_FUNCTION(tid << item);
+    static std::map<std::pair<uint16_t, std::string>, std::vector<PathAttribute>> attributes;
+
+    auto key = std::make_pair(tid.GetUid(), item);
+    auto it = attributes.find(key);
+    if (it != attributes.end())
+    {
+        return it->second;
+    }
+
+    std::vector<PathAttribute>& found = attributes[key];
+    TypeId current;
+    TypeId nextTid = tid;
+    do
+    {
+        current = nextTid;
+
+        for (uint32_t i = 0; i < current.GetAttributeN(); i++)
+        {
+            struct TypeId::AttributeInformation info;
+            info = current.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            PathAttribute attribute;
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                attribute.container = false;
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                attribute.container = true;
+            }
+            else
+            {
+                // this could be anything else and we don't know what to do with it.
+                // So, we just ignore it.
+                continue;
+            }
+            // the value of the attribute is the one of the attribute with
+            // this name closest to the TypeId
+            tid.LookupAttributeByName(info.name, &info);
+            attribute.name = info.name;
+            attribute.accessor = info.accessor;
+            attribute.containerAccessor =
+                dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+            attribute.gettable = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter();
+            found.push_back(attribute);
+        }
+
+        nextTid = current.GetParent();
+    } while (nextTid != current);
+
+    return found;
+}
+
 /**
  * \ingroup config-impl
  * Config system implementation class.
@@ -643,16 +970,30 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void Set(std::string path, const AttributeValue& value);
     /** \copydoc ns3::Config::SetFailSafe() */
     bool SetFailSafe(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe() */
-    bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::ConnectFailSafe() */
-    bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+    /**
+     * \copydoc ns3::Config::ConnectWithoutContextFailSafe()
+     * \param [in] cache The objects found by the previous paths of a
+     *                   Config::Batch, or null.
+     */
+    bool ConnectWithoutContextFailSafe(std::string path,
+                                       const CallbackBase& cb,
+                                       ResolverCache* cache = nullptr);
+    /**
+     * \copydoc ns3::Config::ConnectFailSafe()
+     * \param [in] cache The objects found by the previous paths of a
+     *                   Config::Batch, or null.
+     */
+    bool ConnectFailSafe(std::string path, const CallbackBase& cb, ResolverCache* cache = nullptr);
     /** \copydoc ns3::Config::DisconnectWithoutContext() */
     void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
     /** \copydoc ns3::Config::Disconnect() */
     void Disconnect(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::LookupMatches() */
-    MatchContainer LookupMatches(std::string path);
+    /**
+     * \copydoc ns3::Config::LookupMatches()
+     * \param [in] cache The objects found by the previous paths of a
+     *                   Config::Batch, or null.
+     */
+    MatchContainer LookupMatches(std::string path, ResolverCache* cache = nullptr);
 
     /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -719,13 +1060,15 @@ ConfigImpl::SetFailSafe(std::string path, const AttributeValue& value)
 }
 
 bool
-ConfigImpl::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
+ConfigImpl::ConnectWithoutContextFailSafe(std::string path,
+                                          const CallbackBase& cb,
+                                          ResolverCache* cache)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
+    NS_LOG_FUNCTION(this << path << &cb << cache);
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
+    MatchContainer container = LookupMatches(root, cache);
     return container.ConnectWithoutContextFailSafe(leaf, cb);
 }
 
@@ -748,14 +1091,14 @@ ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
 }
 
 bool
-ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
+ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb, ResolverCache* cache)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
+    NS_LOG_FUNCTION(this << path << &cb << cache);
 
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
+    MatchContainer container = LookupMatches(root, cache);
     return container.ConnectFailSafe(leaf, cb);
 }
 
@@ -779,9 +1122,9 @@ ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
 }
 
 MatchContainer
-ConfigImpl::LookupMatches(std::string path)
+ConfigImpl::LookupMatches(std::string path, ResolverCache* cache)
 {
-    NS_LOG_FUNCTION(this << path);
+    NS_LOG_FUNCTION(this << path << cache);
 
     class LookupMatchesResolver : public Resolver
     {
@@ -800,6 +1143,7 @@ ConfigImpl::LookupMatches(std::string path)
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
     } resolver = LookupMatchesResolver(path);
+    resolver.SetCache(cache);
 
     for (Roots::const_iterator i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -1002,6 +1346,59 @@ LookupMatches(std::string path)
     return ConfigImpl::Get()->LookupMatches(path);
 }
 
+Batch::Batch()
+    : m_cache(new ResolverCache())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Batch::~Batch()
+{
+    NS_LOG_FUNCTION(this);
+    delete m_cache;
+}
+
+void
+Batch::ConnectWithoutContext(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    if (!ConnectWithoutContextFailSafe(path, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << path);
+    }
+}
+
+bool
+Batch::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(path, cb, m_cache);
+}
+
+void
+Batch::Connect(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    if (!ConnectFailSafe(path, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << path);
+    }
+}
+
+bool
+Batch::ConnectFailSafe(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(this << path << &cb);
+    return ConfigImpl::Get()->ConnectFailSafe(path, cb, m_cache);
+}
+
+MatchContainer
+Batch::LookupMatches(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+    return ConfigImpl::Get()->LookupMatches(path, m_cache);
+}
+
 void
 RegisterRootNamespaceObject(Ptr<Object> obj)
 {
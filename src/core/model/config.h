@@ -361,6 +361,61 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+class ResolverCache;
+
+/**
+ * \ingroup config
+ * \brief Connect many trace sinks, resolving the objects shared by their
+ * paths once.
+ *
+ * Setting up the traces of a large topology usually connects a sink for
+ * each node or device, with paths such as
+ * "/NodeList/3/DeviceList/1/$ns3::PointToPointNetDevice/MacTx", and each
+ * call to Config::Connect walks the objects from the root namespace again.
+ * A Batch remembers the objects found on the paths it has resolved, so
+ * that the elements a path shares with the previous ones are not resolved
+ * again:
+ * \code
+ *   Config::Batch batch;
+ *   for (uint32_t i = 0; i < nodes.GetN (); i++)
+ *     {
+ *       std::ostringstream oss;
+ *       oss << "/NodeList/" << i << "/DeviceList/0/$ns3::PointToPointNetDevice/";
+ *       batch.Connect (oss.str () + "MacTx", MakeCallback (&MacTx));
+ *       batch.Connect (oss.str () + "MacRx", MakeCallback (&MacRx));
+ *     }
+ * \endcode
+ *
+ * The objects found are kept until the Batch is destroyed, so it should
+ * only live as long as the setup of the traces, while no object is added
+ * to or removed from the configuration namespace.
+ */
+class Batch
+{
+  public:
+    Batch();
+    ~Batch();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    /** \copydoc ns3::Config::ConnectWithoutContext() */
+    void ConnectWithoutContext(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe() */
+    bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::Connect() */
+    void Connect(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::ConnectFailSafe() */
+    bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::LookupMatches() */
+    MatchContainer LookupMatches(std::string path);
+
+  private:
+    /** The objects found on the paths resolved by this Batch. */
+    ResolverCache* m_cache;
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -82,6 +82,7 @@ DefaultSimulatorImpl::DoDispose()
         Scheduler::Event next = m_events->RemoveNext();
         next.impl->Unref();
     }
+    m_movedEvents.clear();
     m_events = nullptr;
     SimulatorImpl::DoDispose();
 }
@@ -130,6 +131,10 @@ void
 DefaultSimulatorImpl::ProcessOneEvent()
 {
     Scheduler::Event next = m_events->RemoveNext();
+    if (!m_movedEvents.empty())
+    {
+        m_movedEvents.erase(next.key.m_uid);
+    }
 
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
@@ -300,6 +305,20 @@ DefaultSimulatorImpl::Now() const
     return TimeStep(m_currentTs);
 }
 
+uint64_t
+DefaultSimulatorImpl::GetEventTs(const EventId& id) const
+{
+    if (!m_movedEvents.empty())
+    {
+        auto moved = m_movedEvents.find(id.GetUid());
+        if (moved != m_movedEvents.end())
+        {
+            return moved->second;
+        }
+    }
+    return id.GetTs();
+}
+
 Time
 DefaultSimulatorImpl::GetDelayLeft(const EventId& id) const
 {
@@ -309,7 +328,7 @@ DefaultSimulatorImpl::GetDelayLeft(const EventId& id) const
     }
     else
     {
-        return TimeStep(id.GetTs() - m_currentTs);
+        return TimeStep(GetEventTs(id) - m_currentTs);
     }
 }
 
@@ -335,10 +354,11 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     }
     Scheduler::Event event;
     event.impl = id.PeekEventImpl();
-    event.key.m_ts = id.GetTs();
+    event.key.m_ts = GetEventTs(id);
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
     m_events->Remove(event);
+    m_movedEvents.erase(event.key.m_uid);
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
@@ -375,8 +395,12 @@ DefaultSimulatorImpl::IsExpired(const EventId& id) const
         }
         return true;
     }
-    if (id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
-        (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+    if (id.PeekEventImpl() == nullptr)
+    {
+        return true;
+    }
+    uint64_t ts = GetEventTs(id);
+    if (ts < m_currentTs || (ts == m_currentTs && id.GetUid() <= m_currentUid) ||
         id.PeekEventImpl()->IsCancelled())
     {
         return true;
@@ -405,4 +429,37 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+void
+DefaultSimulatorImpl::SetCurrentTime(const Time& time)
+{
+    NS_LOG_FUNCTION(this << time);
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::SetCurrentTime Thread-unsafe invocation!");
+    uint64_t ts = time.GetTimeStep();
+    NS_ABORT_MSG_IF(ts < m_currentTs, "Can't move the current time backward to " << time);
+    if (ts == m_currentTs)
+    {
+        return;
+    }
+    ProcessEventsWithContext();
+    // The events removed in order keep their order when inserted back,
+    // since the uid breaks the ties between the events at the same time.
+    std::list<Scheduler::Event> late;
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts < ts)
+    {
+        late.push_back(m_events->RemoveNext());
+    }
+    // Their EventIds keep the previous timestamp, so the new one is kept
+    // to find them.
+    for (auto& event : late)
+    {
+        event.key.m_ts = ts;
+        m_events->Insert(event);
+        m_movedEvents[event.key.m_uid] = ts;
+    }
+    m_currentTs = ts;
+    // None of the events pending at this time has run yet
+    m_currentUid = EventId::UID::INVALID;
+}
+
 } // namespace ns3
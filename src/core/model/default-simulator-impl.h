@@ -25,6 +25,7 @@
 #include <list>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 
 /**
  * \file
@@ -77,6 +78,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    void SetCurrentTime(const Time& time) override;
 
   private:
     void DoDispose() override;
@@ -85,6 +87,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /**
+     * Get the timestamp of an event in the event queue, which differs
+     * from the one of its EventId if SetCurrentTime() moved the event.
+     * \param [in] id The event.
+     * \returns The timestamp of the event in the event queue.
+     */
+    uint64_t GetEventTs(const EventId& id) const;
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -112,6 +121,10 @@ class DefaultSimulatorImpl : public SimulatorImpl
     typedef std::list<EventId> DestroyEvents;
     /** The container of events to run at Destroy. */
     DestroyEvents m_destroyEvents;
+    /** Container type for the timestamps of the events moved, by uid. */
+    typedef std::unordered_map<uint32_t, uint64_t> MovedEvents;
+    /** The timestamps of the pending events moved by SetCurrentTime(). */
+    MovedEvents m_movedEvents;
     /** Flag calling for the end of the simulation. */
     bool m_stop;
     /** The event priority queue. */
@@ -187,6 +187,7 @@ void
 FlushStreams()
 {
     NS_LOG_FUNCTION_NOARGS();
+    LogFlushBinary();
     std::list<std::ostream*>** pl = PeekStreamList();
     if (*pl == nullptr)
     {
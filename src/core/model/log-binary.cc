@@ -0,0 +1,1000 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-binary.h"
+
+#include "fatal-error.h"
+#include "log.h"
+#include "node-printer.h"
+#include "nstime.h"
+#include "simulator.h"
+#include "time-printer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup logging
+ * ns3::BinaryLogRecord and ns3::BinaryLogReader implementations.
+ *
+ * A binary log file starts with the magic "ns3blog1" and the byte order
+ * mark 0x01020304, followed by chunks:
+ *   - a call site chunk: the type 'S', the id, the kind and the line of
+ *     the call site, and the names of its component, function and file,
+ *     each as a 32 bit length and the characters;
+ *   - a data chunk: the type 'D', the index of the thread, the Time::Unit
+ *     of the simulation times, the size of the messages and the messages.
+ *
+ * Each message is made of its size, the id of its call site, its level
+ * with the prefixes enabled for its component, the flags of the fields
+ * below, its simulation time (time step, or text of a custom TimePrinter),
+ * its node (context, or text of a custom NodePrinter), the text of
+ * NS_LOG_APPEND_CONTEXT and the text of the message.
+ *
+ * The call sites used by the messages of a data chunk are always written
+ * before it.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup logging
+ * Implementation details of the binary log.
+ */
+namespace
+{
+
+/** The magic of a binary log file. */
+const char BINARY_LOG_MAGIC[8] = {'n', 's', '3', 'b', 'l', 'o', 'g', '1'};
+/** The byte order mark of a binary log file. */
+const uint32_t BINARY_LOG_BYTE_ORDER = 0x01020304;
+/** The type of a call site chunk. */
+const char CHUNK_SITE = 'S';
+/** The type of a data chunk. */
+const char CHUNK_DATA = 'D';
+/** The size of the ring buffer of each thread. */
+const std::size_t RING_SIZE = 1 << 20;
+/** The period of the flush thread. */
+const std::chrono::milliseconds FLUSH_PERIOD(100);
+
+/** The flags of the fields of a message. */
+enum Fields : uint8_t
+{
+    TIME_STEP = 0x01, //!< time step of the default TimePrinter
+    TIME_TEXT = 0x02, //!< text of a custom TimePrinter
+    NODE_ID = 0x04,   //!< context of the default NodePrinter
+    NODE_TEXT = 0x08  //!< text of a custom NodePrinter
+};
+
+/**
+ * The ring buffer of a thread.
+ *
+ * The thread is the only producer, it moves the head; the consumer
+ * draining the buffer to the file, with the mutex of the backend locked,
+ * moves the tail.
+ */
+struct Ring
+{
+    /**
+     * Constructor.
+     * \param [in] i The index of the thread.
+     */
+    explicit Ring(uint32_t i)
+        : index(i),
+          data(RING_SIZE),
+          head(0),
+          tail(0)
+    {
+    }
+
+    uint32_t index;             //!< The index of the thread.
+    std::vector<char> data;     //!< The bytes of the messages.
+    std::atomic<uint64_t> head; //!< The total of the bytes written.
+    std::atomic<uint64_t> tail; //!< The total of the bytes drained.
+};
+
+/** A call site of the NS_LOG macros. */
+struct CallSite
+{
+    uint8_t kind;          //!< The BinaryLogRecord::Kind.
+    uint32_t line;         //!< The line.
+    std::string component; //!< The name of the LogComponent.
+    std::string function;  //!< The name of the function.
+    std::string file;      //!< The file.
+};
+
+/**
+ * The binary log file, the ring buffers of the threads and the flush
+ * thread.
+ */
+class BinaryLogBackend
+{
+  public:
+    /** \returns The backend. */
+    static BinaryLogBackend& Get();
+
+    BinaryLogBackend();
+    ~BinaryLogBackend();
+
+    /**
+     * Open the binary log file.  The flush thread is started by the first
+     * message committed.
+     * \param [in] filename The binary log file.
+     */
+    void Open(const std::string& filename);
+    /** Stop the flush thread, drain the ring buffers and close the file. */
+    void Close();
+    /** \returns \c true if the binary log file is open. */
+    bool IsOpen() const;
+    /** Drain the ring buffers to the file. */
+    void Flush();
+
+    /**
+     * Register a call site.
+     * \param [in] site The call site.
+     * \returns The id of the call site.
+     */
+    uint32_t AddCallSite(const CallSite& site);
+
+    /** \returns The ring buffer of a new thread. */
+    Ring* AddRing();
+    /**
+     * Drain and release the ring buffer of a thread which exits.
+     * \param [in] ring The ring buffer.
+     */
+    void RemoveRing(Ring* ring);
+
+    /**
+     * Commit a message to the ring buffer of the calling thread.
+     * \param [in] ring The ring buffer.
+     * \param [in] data The message.
+     * \param [in] size The size of the message.
+     */
+    void Commit(Ring& ring, const char* data, std::size_t size);
+
+  private:
+    /** Start the flush thread, if the binary log file is open. */
+    void StartThread();
+    /** Drain the ring buffers periodically, until Close(). */
+    void Run();
+    /** Write the new call sites to the file, with the mutex locked. */
+    void WriteCallSitesLocked();
+    /**
+     * Drain a ring buffer to the file, with the mutex locked.
+     * \param [in] ring The ring buffer.
+     */
+    void DrainLocked(Ring& ring);
+    /**
+     * Write a data chunk to the file, with the mutex locked.
+     * \param [in] index The index of the thread.
+     * \param [in] first The first part of the messages.
+     * \param [in] firstSize The size of the first part.
+     * \param [in] second The second part of the messages.
+     * \param [in] secondSize The size of the second part.
+     */
+    void WriteDataLocked(uint32_t index,
+                         const char* first,
+                         std::size_t firstSize,
+                         const char* second,
+                         std::size_t secondSize);
+
+    std::mutex m_mutex;             //!< Protects the members below.
+    std::condition_variable m_wake; //!< Wakes up the flush thread.
+    std::thread m_thread;           //!< The flush thread.
+    std::atomic<bool> m_running;    //!< The flush thread is started.
+    bool m_stop;                    //!< Stop the flush thread.
+    std::atomic<bool> m_open;       //!< The binary log file is open.
+    std::ofstream m_file;           //!< The binary log file.
+    std::vector<Ring*> m_rings;     //!< The ring buffers of the threads.
+    uint32_t m_nextRing;            //!< The index of the next thread.
+    std::vector<CallSite> m_sites;  //!< The call sites, by id.
+    std::size_t m_sitesWritten;     //!< The number of call sites written.
+};
+
+/**
+ * Write a value to a stream in binary form.
+ * \param [in] os The stream.
+ * \param [in] value The value.
+ */
+template <typename T>
+void
+WriteValue(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Write a string to a stream, after its length.
+ * \param [in] os The stream.
+ * \param [in] value The string.
+ */
+void
+WriteString(std::ostream& os, const std::string& value)
+{
+    WriteValue<uint32_t>(os, value.size());
+    os.write(value.data(), value.size());
+}
+
+BinaryLogBackend&
+BinaryLogBackend::Get()
+{
+    static BinaryLogBackend backend;
+    return backend;
+}
+
+BinaryLogBackend::BinaryLogBackend()
+    : m_running(false),
+      m_stop(false),
+      m_open(false),
+      m_nextRing(0),
+      m_sitesWritten(0)
+{
+}
+
+BinaryLogBackend::~BinaryLogBackend()
+{
+    Close();
+    for (auto ring : m_rings)
+    {
+        delete ring;
+    }
+}
+
+void
+BinaryLogBackend::Open(const std::string& filename)
+{
+    Close();
+    // opened before taking the lock: NS_FATAL_ERROR flushes the binary log
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        NS_FATAL_ERROR("Unable to open the binary log file " << filename);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file = std::move(file);
+    m_file.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    WriteValue(m_file, BINARY_LOG_BYTE_ORDER);
+    // the messages buffered while the log was closed are discarded
+    for (auto ring : m_rings)
+    {
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    m_sitesWritten = 0;
+    m_stop = false;
+    m_open.store(true, std::memory_order_release);
+}
+
+void
+BinaryLogBackend::Close()
+{
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_open.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        m_open.store(false, std::memory_order_release);
+        m_stop = true;
+        m_running.store(false, std::memory_order_relaxed);
+        thread = std::move(m_thread);
+    }
+    m_wake.notify_all();
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto ring : m_rings)
+    {
+        DrainLocked(*ring);
+    }
+    m_file.close();
+}
+
+bool
+BinaryLogBackend::IsOpen() const
+{
+    return m_open.load(std::memory_order_relaxed);
+}
+
+void
+BinaryLogBackend::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file.is_open())
+    {
+        for (auto ring : m_rings)
+        {
+            DrainLocked(*ring);
+        }
+        m_file.flush();
+    }
+}
+
+void
+BinaryLogBackend::StartThread()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open.load(std::memory_order_relaxed) && !m_thread.joinable())
+    {
+        m_thread = std::thread(&BinaryLogBackend::Run, this);
+        m_running.store(true, std::memory_order_release);
+    }
+}
+
+void
+BinaryLogBackend::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        m_wake.wait_for(lock, FLUSH_PERIOD);
+        for (auto ring : m_rings)
+        {
+            DrainLocked(*ring);
+        }
+        m_file.flush();
+    }
+}
+
+uint32_t
+BinaryLogBackend::AddCallSite(const CallSite& site)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sites.push_back(site);
+    return m_sites.size() - 1;
+}
+
+Ring*
+BinaryLogBackend::AddRing()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Ring* ring = new Ring(m_nextRing++);
+    m_rings.push_back(ring);
+    return ring;
+}
+
+void
+BinaryLogBackend::RemoveRing(Ring* ring)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file.is_open())
+    {
+        DrainLocked(*ring);
+    }
+    m_rings.erase(std::find(m_rings.begin(), m_rings.end(), ring));
+    delete ring;
+}
+
+void
+BinaryLogBackend::Commit(Ring& ring, const char* data, std::size_t size)
+{
+    if (!m_running.load(std::memory_order_acquire))
+    {
+        // started by the first message rather than when the log is opened
+        StartThread();
+    }
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (size > RING_SIZE - (head - ring.tail.load(std::memory_order_acquire)))
+    {
+        // the ring buffer is full: drain it from this thread
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DrainLocked(ring);
+        if (size > RING_SIZE)
+        {
+            if (m_file.is_open())
+            {
+                WriteDataLocked(ring.index, data, size, nullptr, 0);
+            }
+            return;
+        }
+    }
+    std::size_t start = head % RING_SIZE;
+    std::size_t first = std::min(size, RING_SIZE - start);
+    std::memcpy(ring.data.data() + start, data, first);
+    std::memcpy(ring.data.data(), data + first, size - first);
+    ring.head.store(head + size, std::memory_order_release);
+}
+
+void
+BinaryLogBackend::WriteCallSitesLocked()
+{
+    for (; m_sitesWritten < m_sites.size(); m_sitesWritten++)
+    {
+        const CallSite& site = m_sites[m_sitesWritten];
+        m_file.put(CHUNK_SITE);
+        WriteValue<uint32_t>(m_file, m_sitesWritten);
+        WriteValue(m_file, site.kind);
+        WriteValue(m_file, site.line);
+        WriteString(m_file, site.component);
+        WriteString(m_file, site.function);
+        WriteString(m_file, site.file);
+    }
+}
+
+void
+BinaryLogBackend::DrainLocked(Ring& ring)
+{
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (head == tail)
+    {
+        return;
+    }
+    if (m_file.is_open())
+    {
+        std::size_t start = tail % RING_SIZE;
+        std::size_t size = head - tail;
+        std::size_t first = std::min(size, RING_SIZE - start);
+        WriteDataLocked(ring.index,
+                        ring.data.data() + start,
+                        first,
+                        ring.data.data(),
+                        size - first);
+    }
+    ring.tail.store(head, std::memory_order_release);
+}
+
+void
+BinaryLogBackend::WriteDataLocked(uint32_t index,
+                                  const char* first,
+                                  std::size_t firstSize,
+                                  const char* second,
+                                  std::size_t secondSize)
+{
+    // the call sites are registered before the messages using them are committed
+    WriteCallSitesLocked();
+    m_file.put(CHUNK_DATA);
+    WriteValue(m_file, index);
+    WriteValue<uint8_t>(m_file, Time::GetResolution());
+    WriteValue<uint32_t>(m_file, firstSize + secondSize);
+    m_file.write(first, firstSize);
+    m_file.write(second, secondSize);
+}
+
+/**
+ * Drains the ring buffer of a thread when it exits.
+ */
+class ThreadRing
+{
+  public:
+    ThreadRing()
+        : m_ring(BinaryLogBackend::Get().AddRing())
+    {
+    }
+
+    ~ThreadRing()
+    {
+        BinaryLogBackend::Get().RemoveRing(m_ring);
+    }
+
+    Ring* m_ring; //!< The ring buffer of the thread.
+};
+
+/**
+ * \returns The ring buffer of the calling thread.
+ */
+Ring&
+GetThreadRing()
+{
+    thread_local ThreadRing ring;
+    return *ring.m_ring;
+}
+
+/**
+ * The stream of the context of the binary log record being built by the
+ * calling thread, if any.
+ */
+thread_local std::ostream* g_contextStream = nullptr;
+
+} // unnamed namespace
+
+/**
+ * \ingroup logging
+ * The buffer of a BinaryLogRecord, growing as needed.
+ */
+class BinaryLogBuffer : public std::streambuf
+{
+  public:
+    /** Empty the buffer. */
+    void Reset()
+    {
+        if (m_data.empty())
+        {
+            m_data.resize(256);
+        }
+        setp(m_data.data(), m_data.data() + m_data.size());
+    }
+
+    /** \returns The content of the buffer. */
+    char* GetData()
+    {
+        return m_data.data();
+    }
+
+    /** \returns The size of the content of the buffer. */
+    std::size_t GetSize() const
+    {
+        return pptr() - pbase();
+    }
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+        std::size_t size = GetSize();
+        m_data.resize(2 * m_data.size());
+        setp(m_data.data(), m_data.data() + m_data.size());
+        pbump(size);
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+  private:
+    std::vector<char> m_data; //!< The bytes of the buffer.
+};
+
+/**
+ * \ingroup logging
+ * The stream of a BinaryLogRecord.
+ */
+class BinaryLogStream : public std::ostream
+{
+  public:
+    BinaryLogStream()
+        : std::ostream(&m_buffer)
+    {
+    }
+
+    /** Empty the buffer, and reset the format of the stream. */
+    void Reset()
+    {
+        m_buffer.Reset();
+        clear();
+        flags(std::ios_base::dec | std::ios_base::skipws);
+        precision(6);
+        width(0);
+        fill(' ');
+    }
+
+    /**
+     * Write a value in binary form.
+     * \param [in] value The value.
+     */
+    template <typename T>
+    void WriteValue(T value)
+    {
+        m_buffer.sputn(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    /**
+     * Start a field of variable length.
+     * \returns The offset of the length of the field.
+     */
+    std::size_t BeginField()
+    {
+        std::size_t offset = m_buffer.GetSize();
+        WriteValue<uint32_t>(0);
+        return offset;
+    }
+
+    /**
+     * End a field of variable length.
+     * \param [in] offset The offset of the length of the field.
+     */
+    void EndField(std::size_t offset)
+    {
+        uint32_t length = m_buffer.GetSize() - offset - sizeof(uint32_t);
+        std::memcpy(m_buffer.GetData() + offset, &length, sizeof(length));
+    }
+
+    /**
+     * Set the size of the record, at its start.
+     * \returns The record.
+     */
+    const char* Finish()
+    {
+        uint32_t size = m_buffer.GetSize();
+        std::memcpy(m_buffer.GetData(), &size, sizeof(size));
+        return m_buffer.GetData();
+    }
+
+    /** \returns The buffer. */
+    BinaryLogBuffer* GetBuffer()
+    {
+        return &m_buffer;
+    }
+
+  private:
+    BinaryLogBuffer m_buffer; //!< The buffer.
+};
+
+/**
+ * \ingroup logging
+ * The streams of the records of a thread, by nesting depth: a record is
+ * nested when an operator<< streaming its message logs a message too.
+ */
+class BinaryLogStreamPool
+{
+  public:
+    /** \returns A stream for a new record. */
+    BinaryLogStream* Acquire()
+    {
+        if (m_depth == m_streams.size())
+        {
+            m_streams.push_back(std::make_unique<BinaryLogStream>());
+        }
+        BinaryLogStream* stream = m_streams[m_depth++].get();
+        stream->Reset();
+        return stream;
+    }
+
+    /** Release the stream of the last record. */
+    void Release()
+    {
+        m_depth--;
+    }
+
+  private:
+    std::vector<std::unique_ptr<BinaryLogStream>> m_streams; //!< The streams.
+    std::size_t m_depth{0};                                  //!< The number of streams in use.
+};
+
+/**
+ * \returns The streams of the records of the calling thread.
+ */
+static BinaryLogStreamPool&
+GetStreamPool()
+{
+    thread_local BinaryLogStreamPool pool;
+    return pool;
+}
+
+void
+LogSetBinaryFile(const std::string& filename)
+{
+    if (filename.empty())
+    {
+        BinaryLogBackend::Get().Close();
+    }
+    else
+    {
+        BinaryLogBackend::Get().Open(filename);
+    }
+}
+
+bool
+LogIsBinary()
+{
+    return BinaryLogBackend::Get().IsOpen();
+}
+
+void
+LogFlushBinary()
+{
+    BinaryLogBackend::Get().Flush();
+}
+
+std::ostream&
+LogGetContextStream()
+{
+    return g_contextStream != nullptr ? *g_contextStream : std::clog;
+}
+
+uint32_t
+BinaryLogRecord::RegisterCallSite(Kind kind,
+                                  const std::string& component,
+                                  const char* function,
+                                  const char* file,
+                                  int line)
+{
+    return BinaryLogBackend::Get().AddCallSite(
+        {static_cast<uint8_t>(kind), static_cast<uint32_t>(line), component, function, file});
+}
+
+BinaryLogRecord::BinaryLogRecord(uint32_t site, const LogComponent& component, uint32_t level)
+    : m_stream(GetStreamPool().Acquire()),
+      m_context(0),
+      m_previousContext(nullptr)
+{
+    TimePrinter timePrinter = component.IsEnabled(LOG_PREFIX_TIME) ? LogGetTimePrinter() : nullptr;
+    NodePrinter nodePrinter = component.IsEnabled(LOG_PREFIX_NODE) ? LogGetNodePrinter() : nullptr;
+    uint8_t fields = 0;
+    if (timePrinter != nullptr)
+    {
+        fields |= (timePrinter == &DefaultTimePrinter ? TIME_STEP : TIME_TEXT);
+    }
+    if (nodePrinter != nullptr)
+    {
+        fields |= (nodePrinter == &DefaultNodePrinter ? NODE_ID : NODE_TEXT);
+    }
+    uint32_t prefixes = 0;
+    for (auto prefix : {LOG_PREFIX_FUNC, LOG_PREFIX_TIME, LOG_PREFIX_NODE, LOG_PREFIX_LEVEL})
+    {
+        if (component.IsEnabled(prefix))
+        {
+            prefixes |= prefix;
+        }
+    }
+
+    m_stream->WriteValue<uint32_t>(0); // size
+    m_stream->WriteValue(site);
+    m_stream->WriteValue(level | prefixes);
+    m_stream->WriteValue(fields);
+    if (fields & TIME_STEP)
+    {
+        m_stream->WriteValue(Simulator::Now().GetTimeStep());
+    }
+    else if (fields & TIME_TEXT)
+    {
+        std::size_t offset = m_stream->BeginField();
+        (*timePrinter)(*m_stream);
+        m_stream->EndField(offset);
+    }
+    if (fields & NODE_ID)
+    {
+        m_stream->WriteValue(Simulator::GetContext());
+    }
+    else if (fields & NODE_TEXT)
+    {
+        std::size_t offset = m_stream->BeginField();
+        (*nodePrinter)(*m_stream);
+        m_stream->EndField(offset);
+    }
+}
+
+BinaryLogRecord::~BinaryLogRecord()
+{
+    const char* data = m_stream->Finish();
+    BinaryLogBackend::Get().Commit(GetThreadRing(), data, m_stream->GetBuffer()->GetSize());
+    GetStreamPool().Release();
+}
+
+void
+BinaryLogRecord::BeginContext()
+{
+    m_context = m_stream->BeginField();
+    m_previousContext = g_contextStream;
+    g_contextStream = m_stream;
+}
+
+void
+BinaryLogRecord::EndContext()
+{
+    g_contextStream = m_previousContext;
+    m_stream->EndField(m_context);
+}
+
+std::ostream&
+BinaryLogRecord::GetStream()
+{
+    return *m_stream;
+}
+
+BinaryLogReader::BinaryLogReader()
+    : m_offset(0),
+      m_resolution(Time::GetResolution())
+{
+}
+
+bool
+BinaryLogReader::Open(const std::string& filename)
+{
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(BINARY_LOG_MAGIC)];
+    uint32_t byteOrder = 0;
+    m_file.read(magic, sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&byteOrder), sizeof(byteOrder));
+    m_sites.clear();
+    m_chunk.clear();
+    m_offset = 0;
+    return m_file && std::memcmp(magic, BINARY_LOG_MAGIC, sizeof(magic)) == 0 &&
+           byteOrder == BINARY_LOG_BYTE_ORDER;
+}
+
+/**
+ * Read a value in binary form.
+ * \param [in] is The stream.
+ * \returns The value.
+ */
+template <typename T>
+static T
+ReadValue(std::istream& is)
+{
+    T value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/**
+ * Read a string, after its length.
+ * \param [in] is The stream.
+ * \returns The string.
+ */
+static std::string
+ReadString(std::istream& is)
+{
+    std::string value(ReadValue<uint32_t>(is), '\0');
+    is.read(&value[0], value.size());
+    return value;
+}
+
+/**
+ * Read a value in binary form from a message.
+ * \param [in,out] data The message, moved past the value.
+ * \returns The value.
+ */
+template <typename T>
+static T
+ReadValue(const char*& data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    return value;
+}
+
+/**
+ * Read a string, after its length, from a message.
+ * \param [in,out] data The message, moved past the string.
+ * \returns The string.
+ */
+static std::string
+ReadString(const char*& data)
+{
+    uint32_t length = ReadValue<uint32_t>(data);
+    data += length;
+    return std::string(data - length, length);
+}
+
+bool
+BinaryLogReader::ReadChunk()
+{
+    char type;
+    while (m_file.get(type))
+    {
+        if (type == CHUNK_SITE)
+        {
+            uint32_t id = ReadValue<uint32_t>(m_file);
+            CallSite& site = m_sites[id];
+            site.kind = ReadValue<uint8_t>(m_file);
+            ReadValue<uint32_t>(m_file); // line
+            site.component = ReadString(m_file);
+            site.function = ReadString(m_file);
+            ReadString(m_file); // file
+        }
+        else if (type == CHUNK_DATA)
+        {
+            ReadValue<uint32_t>(m_file); // thread
+            m_resolution = ReadValue<uint8_t>(m_file);
+            m_chunk.resize(ReadValue<uint32_t>(m_file));
+            m_file.read(m_chunk.data(), m_chunk.size());
+            m_offset = 0;
+            return bool(m_file);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool
+BinaryLogReader::Read(std::string& line)
+{
+    while (m_offset >= m_chunk.size())
+    {
+        if (!ReadChunk())
+        {
+            return false;
+        }
+    }
+    const char* data = m_chunk.data() + m_offset;
+    const char* end = data + ReadValue<uint32_t>(data);
+    m_offset = end - m_chunk.data();
+    uint32_t site = ReadValue<uint32_t>(data);
+    uint32_t level = ReadValue<uint32_t>(data);
+    uint8_t fields = ReadValue<uint8_t>(data);
+
+    std::ostringstream os;
+    if (fields & TIME_STEP)
+    {
+        // as DefaultTimePrinter
+        Time time = Time::From(ReadValue<int64_t>(data), static_cast<Time::Unit>(m_resolution));
+        os << std::fixed;
+        switch (static_cast<Time::Unit>(m_resolution))
+        {
+        case Time::US:
+            os << std::setprecision(6);
+            break;
+        case Time::NS:
+            os << std::setprecision(9);
+            break;
+        case Time::PS:
+            os << std::setprecision(12);
+            break;
+        case Time::FS:
+            os << std::setprecision(15);
+            break;
+        default:
+            os << std::setprecision(5);
+        }
+        os << time.As(Time::S) << " ";
+        os << std::defaultfloat << std::setprecision(6);
+    }
+    else if (fields & TIME_TEXT)
+    {
+        os << ReadString(data) << " ";
+    }
+    if (fields & NODE_ID)
+    {
+        // as DefaultNodePrinter
+        uint32_t context = ReadValue<uint32_t>(data);
+        if (context == Simulator::NO_CONTEXT)
+        {
+            os << "-1 ";
+        }
+        else
+        {
+            os << context << " ";
+        }
+    }
+    else if (fields & NODE_TEXT)
+    {
+        os << ReadString(data) << " ";
+    }
+    os << ReadString(data); // NS_LOG_APPEND_CONTEXT
+
+    auto it = m_sites.find(site);
+    const CallSite unknown = {BinaryLogRecord::MESSAGE, "unknown", "unknown"};
+    const CallSite& callSite = (it == m_sites.end() ? unknown : it->second);
+    std::string message(data, end - data);
+    if (callSite.kind == BinaryLogRecord::FUNCTION)
+    {
+        os << callSite.component << ":" << callSite.function << "(" << message << ")";
+    }
+    else
+    {
+        if (level & LOG_PREFIX_FUNC)
+        {
+            os << callSite.component << ":" << callSite.function << "(): ";
+        }
+        if (level & LOG_PREFIX_LEVEL)
+        {
+            auto messageLevel = static_cast<LogLevel>(level & LOG_LEVEL_ALL);
+            os << "[" << LogComponent::GetLevelLabel(messageLevel) << "] ";
+        }
+        os << message;
+    }
+    line = os.str();
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,199 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary backend of the NS_LOG macros.
+ */
+
+namespace ns3
+{
+
+class LogComponent;
+class BinaryLogStream;
+
+/**
+ * \ingroup logging
+ *
+ * Write the log messages to a binary log file instead of \c std::clog.
+ *
+ * Each thread appends its messages to its own lock-free ring buffer,
+ * with the simulation time, the node, the component, the function and
+ * the level of each message in binary form, and a flush thread writes
+ * the buffers to the file.  The text of the messages is rendered
+ * afterwards by BinaryLogReader, e.g., with the \c read-binary-log
+ * utility.
+ *
+ * The binary log can also be selected with the \c binary token of the
+ * \c NS_LOG environment variable, e.g.,
+ * \c NS_LOG="TcpSocketBase=level_all|prefix_all:binary=tcp.log".
+ *
+ * \param [in] filename The binary log file, or an empty string to
+ *             flush and close the binary log and write the messages
+ *             to \c std::clog again.
+ */
+void LogSetBinaryFile(const std::string& filename);
+
+/**
+ * Check if the log messages are written to a binary log file.
+ * \returns \c true if the log messages are written to a binary log file.
+ */
+bool LogIsBinary();
+
+/**
+ * Write the log messages buffered by all the threads to the binary log
+ * file.
+ */
+void LogFlushBinary();
+
+/**
+ * \ingroup logging
+ *
+ * Get the stream of the context of a log message, for NS_LOG_APPEND_CONTEXT.
+ *
+ * \returns The stream of the context of the binary log record being built
+ *          by the calling thread, or \c std::clog.
+ */
+std::ostream& LogGetContextStream();
+
+/**
+ * \ingroup logging
+ *
+ * A log message written to the binary log.
+ *
+ * The record is built in a buffer of the calling thread and committed to
+ * the ring buffer of the thread when destroyed.  The NS_LOG macros stream
+ * the message to GetStream(), and NS_LOG_APPEND_CONTEXT to
+ * LogGetContextStream() between BeginContext() and EndContext().
+ */
+class BinaryLogRecord
+{
+  public:
+    /** The kind of NS_LOG statement of a call site. */
+    enum Kind
+    {
+        MESSAGE = 0, //!< NS_LOG and its NS_LOG_ERROR, ... variants
+        FUNCTION = 1 //!< NS_LOG_FUNCTION and NS_LOG_FUNCTION_NOARGS
+    };
+
+    /**
+     * Register a call site of the NS_LOG macros.
+     *
+     * \param [in] kind The kind of NS_LOG statement.
+     * \param [in] component The name of the LogComponent.
+     * \param [in] function The name of the function.
+     * \param [in] file The file of the call site.
+     * \param [in] line The line of the call site.
+     * \returns The id of the call site.
+     */
+    static uint32_t RegisterCallSite(Kind kind,
+                                     const std::string& component,
+                                     const char* function,
+                                     const char* file,
+                                     int line);
+
+    /**
+     * Start a log message.
+     *
+     * \param [in] site The id of the call site.
+     * \param [in] component The LogComponent.
+     * \param [in] level The LogLevel of the message.
+     */
+    BinaryLogRecord(uint32_t site, const LogComponent& component, uint32_t level);
+    /** Commit the log message to the ring buffer of the thread. */
+    ~BinaryLogRecord();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    BinaryLogRecord(const BinaryLogRecord&) = delete;
+    BinaryLogRecord& operator=(const BinaryLogRecord&) = delete;
+
+    /** Make LogGetContextStream() the stream of the context of the message. */
+    void BeginContext();
+    /** Restore the previous stream of LogGetContextStream(). */
+    void EndContext();
+
+    /**
+     * Get the stream of the text of the message.
+     * \returns The stream.
+     */
+    std::ostream& GetStream();
+
+  private:
+    BinaryLogStream* m_stream;       //!< The stream of the message.
+    std::size_t m_context;           //!< The offset of the length of the context.
+    std::ostream* m_previousContext; //!< The previous stream of the context.
+};
+
+/**
+ * \ingroup logging
+ *
+ * Render the messages of a binary log file in the text format of the
+ * NS_LOG macros.
+ */
+class BinaryLogReader
+{
+  public:
+    BinaryLogReader();
+
+    /**
+     * Open a binary log file.
+     * \param [in] filename The binary log file.
+     * \returns \c true if the file is a binary log file.
+     */
+    bool Open(const std::string& filename);
+
+    /**
+     * Read the next message.
+     * \param [out] line The text of the message, without end of line.
+     * \returns \c false at the end of the file.
+     */
+    bool Read(std::string& line);
+
+  private:
+    /** A call site of the NS_LOG macros. */
+    struct CallSite
+    {
+        uint8_t kind;          //!< The BinaryLogRecord::Kind.
+        std::string component; //!< The name of the LogComponent.
+        std::string function;  //!< The name of the function.
+    };
+
+    /**
+     * Read the next chunk of messages, and the call sites before it.
+     * \returns \c false at the end of the file.
+     */
+    bool ReadChunk();
+
+    std::ifstream m_file;                 //!< The binary log file.
+    std::map<uint32_t, CallSite> m_sites; //!< The call sites.
+    std::vector<char> m_chunk;            //!< The messages of the current chunk.
+    std::size_t m_offset;                 //!< The offset of the next message.
+    int m_resolution;                     //!< The Time::Unit of the current chunk.
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -129,18 +129,42 @@
  * This is implemented locally in `.cc` files because
  * the relevant variable is only known there.
  *
+ * The context is written to LogGetContextStream(), which is \c std::clog,
+ * or the record of the message when the binary log is used.
+ *
  * Preferred format is something like (assuming the node id is
  * accessible from `var`:
  * \code
  *   if (var)
  *     {
- *       std::clog << "[node " << var->GetObject<Node> ()->GetId () << "] ";
+ *       LogGetContextStream() << "[node " << var->GetObject<Node> ()->GetId () << "] ";
  *     }
  * \endcode
  */
 #define NS_LOG_APPEND_CONTEXT
 #endif /* NS_LOG_APPEND_CONTEXT */
 
+/**
+ * \ingroup logging
+ * \internal
+ * Start the record \c ns3LogRecord of a log message in the binary log,
+ * with its call site and context; should not be called directly.
+ *
+ * \param [in] kind The BinaryLogRecord::Kind of the call site.
+ * \param [in] level The level of the message.
+ */
+#define NS_LOG_BINARY_RECORD(kind, level)                                                          \
+    static const uint32_t ns3LogSite =                                                             \
+        ns3::BinaryLogRecord::RegisterCallSite(kind,                                               \
+                                               g_log.Name(),                                       \
+                                               __FUNCTION__,                                       \
+                                               __FILE__,                                           \
+                                               __LINE__);                                          \
+    ns3::BinaryLogRecord ns3LogRecord(ns3LogSite, g_log, level);                                   \
+    ns3LogRecord.BeginContext();                                                                   \
+    NS_LOG_APPEND_CONTEXT;                                                                         \
+    ns3LogRecord.EndContext()
+
 #ifndef NS_LOG_CONDITION
 /**
  * \ingroup logging
@@ -184,12 +208,20 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            NS_LOG_APPEND_FUNC_PREFIX;                                                             \
-            NS_LOG_APPEND_LEVEL_PREFIX(level);                                                     \
-            std::clog << msg << std::endl;                                                         \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                NS_LOG_BINARY_RECORD(ns3::BinaryLogRecord::MESSAGE, level);                        \
+                ns3LogRecord.GetStream() << msg;                                                   \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                NS_LOG_APPEND_FUNC_PREFIX;                                                         \
+                NS_LOG_APPEND_LEVEL_PREFIX(level);                                                 \
+                std::clog << msg << std::endl;                                                     \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -207,10 +239,17 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;                 \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                NS_LOG_BINARY_RECORD(ns3::BinaryLogRecord::FUNCTION, ns3::LOG_FUNCTION);           \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "()" << std::endl;             \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
@@ -241,12 +280,20 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
-            NS_LOG_APPEND_TIME_PREFIX;                                                             \
-            NS_LOG_APPEND_NODE_PREFIX;                                                             \
-            NS_LOG_APPEND_CONTEXT;                                                                 \
-            std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                               \
-            ns3::ParameterLogger(std::clog) << parameters;                                         \
-            std::clog << ")" << std::endl;                                                         \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                NS_LOG_BINARY_RECORD(ns3::BinaryLogRecord::FUNCTION, ns3::LOG_FUNCTION);           \
+                ns3::ParameterLogger(ns3LogRecord.GetStream()) << parameters;                      \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                NS_LOG_APPEND_TIME_PREFIX;                                                         \
+                NS_LOG_APPEND_NODE_PREFIX;                                                         \
+                NS_LOG_APPEND_CONTEXT;                                                             \
+                std::clog << g_log.Name() << ":" << __FUNCTION__ << "(";                           \
+                ns3::ParameterLogger(std::clog) << parameters;                                     \
+                std::clog << ")" << std::endl;                                                     \
+            }                                                                                      \
         }                                                                                          \
     } while (false)
 
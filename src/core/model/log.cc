@@ -69,6 +69,24 @@ class PrintList
  */
 static PrintList g_printList;
 
+/**
+ * \ingroup logging
+ * Handler for \c binary token in NS_LOG
+ * to write the log messages to a binary log file.
+ * This is private to the logging implementation.
+ */
+class BinaryLogFile
+{
+  public:
+    BinaryLogFile(); //<! Constructor, opens the binary log file.
+};
+
+/**
+ * Invoke handler for \c binary in NS_LOG environment variable.
+ * This is private to the logging implementation.
+ */
+static BinaryLogFile g_binaryLogFile;
+
 /* static */
 LogComponent::ComponentList*
 LogComponent::GetComponentList()
@@ -101,6 +119,32 @@ PrintList::PrintList()
     }
 }
 
+BinaryLogFile::BinaryLogFile()
+{
+    const char* envVar = std::getenv("NS_LOG");
+    if (envVar == nullptr || std::strlen(envVar) == 0)
+    {
+        return;
+    }
+    std::string env = envVar;
+    std::string::size_type cur = 0;
+    std::string::size_type next = 0;
+    while (next != std::string::npos)
+    {
+        next = env.find_first_of(':', cur);
+        std::string tmp = std::string(env, cur, next - cur);
+        if (tmp == "binary")
+        {
+            LogSetBinaryFile("ns3-log.bin");
+        }
+        else if (tmp.substr(0, 7) == "binary=")
+        {
+            LogSetBinaryFile(tmp.substr(7));
+        }
+        cur = next + 1;
+    }
+}
+
 LogComponent::LogComponent(const std::string& name,
                            const std::string& file,
                            const enum LogLevel mask /* = 0 */)
@@ -275,13 +319,6 @@ LogComponent::EnvVarCheck()
     }
 }
 
-bool
-LogComponent::IsEnabled(const enum LogLevel level) const
-{
-    //  LogComponentEnableEnvVar ();
-    return (level & m_levels) ? 1 : 0;
-}
-
 bool
 LogComponent::IsNoneEnabled() const
 {
@@ -542,7 +579,11 @@ CheckEnvironmentVariables()
         {
             // ie no '=' characters found
             component = tmp;
-            if (ComponentExists(component) || component == "*" || component == "***")
+            if (component == "binary")
+            {
+                // handled by BinaryLogFile
+            }
+            else if (ComponentExists(component) || component == "*" || component == "***")
             {
                 return;
             }
@@ -558,7 +599,11 @@ CheckEnvironmentVariables()
         else
         {
             component = tmp.substr(0, equal);
-            if (ComponentExists(component) || component == "*")
+            if (component == "binary")
+            {
+                // handled by BinaryLogFile
+            }
+            else if (ComponentExists(component) || component == "*")
             {
                 std::string::size_type cur_lev;
                 std::string::size_type next_lev = equal;
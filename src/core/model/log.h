@@ -20,6 +20,7 @@
 #ifndef NS3_LOG_H
 #define NS3_LOG_H
 
+#include "log-binary.h"
 #include "log-macros-disabled.h"
 #include "log-macros-enabled.h"
 #include "node-printer.h"
@@ -425,6 +426,13 @@ class LogComponent
 
 }; // class LogComponent
 
+// Inline, as it is checked by every NS_LOG statement
+inline bool
+LogComponent::IsEnabled(const enum LogLevel level) const
+{
+    return (level & m_levels) ? 1 : 0;
+}
+
 /**
  * Get the LogComponent registered with the given name.
  *
@@ -49,11 +49,16 @@ namespace
 /**
  * Get key, value pairs from the "NS_ATTRIBUTE_DEFAULT" environment variable.
  *
- * \param [in] key The key to search for.
- * \return \c true if the key was found, and the associated value.
+ * The full name of the attribute is only built if the environment
+ * variable is set, to keep it off the path of object construction.
+ *
+ * \param [in] tid The TypeId declaring the attribute.
+ * \param [in] i The index of the attribute in \pname{tid}.
+ * \return \c true if the full name of the attribute was found, and the
+ *         associated value.
  */
 std::pair<bool, std::string>
-EnvDictionary(std::string key)
+EnvDictionary(TypeId tid, std::size_t i)
 {
     static std::unordered_map<std::string, std::string> dict;
 
@@ -88,8 +93,12 @@ EnvDictionary(std::string key)
 
     std::string value;
     bool found{false};
+    if (dict.size() == 1 && dict.begin()->first.empty())
+    {
+        return {found, value};
+    }
 
-    auto loc = dict.find(key);
+    auto loc = dict.find(tid.GetAttributeFullName(i));
     if (loc != dict.end())
     {
         value = loc->second;
@@ -170,7 +179,7 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
         NS_LOG_DEBUG("construct tid=" << tid.GetName() << ", params=" << tid.GetAttributeN());
         for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
         {
-            struct TypeId::AttributeInformation info = tid.GetAttribute(i);
+            const struct TypeId::AttributeInformation& info = tid.GetAttribute(i);
             NS_LOG_DEBUG("try to construct \"" << tid.GetName() << "::" << info.name << "\"");
 
             Ptr<const AttributeValue> value = attributes.Find(info.checker);
@@ -203,7 +212,7 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
 
             if (!value)
             {
-                auto [found, val] = EnvDictionary(tid.GetAttributeFullName(i));
+                auto [found, val] = EnvDictionary(tid, i);
                 if (found)
                 {
                     value = Create<StringValue>(val);
@@ -19,8 +19,10 @@
 #include "object-factory.h"
 
 #include "log.h"
+#include "pointer.h"
 
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -83,7 +85,20 @@ ObjectFactory::DoSet(const std::string& name, const AttributeValue& value)
         NS_FATAL_ERROR("Invalid value for attribute set (" << name << ") on " << m_tid.GetName());
         return;
     }
-    m_parameters.Add(name, info.checker, value.Copy());
+    // Keep the checked value, so that each object created doesn't convert
+    // it again, e.g., from a string.  A PointerValue converted from another
+    // value, e.g., from the description of an ObjectFactory, points to an
+    // object which must not be shared: keep the value given, so that each
+    // object created gets its own object.
+    if (dynamic_cast<const PointerValue*>(PeekPointer(v)) != nullptr &&
+        dynamic_cast<const PointerValue*>(&value) == nullptr)
+    {
+        m_parameters.Add(name, info.checker, value.Copy());
+    }
+    else
+    {
+        m_parameters.Add(name, info.checker, v);
+    }
 }
 
 TypeId
@@ -129,8 +144,27 @@ operator<<(std::ostream& os, const ObjectFactory& factory)
 std::istream&
 operator>>(std::istream& is, ObjectFactory& factory)
 {
+    // The factories parsed, by description.  The same descriptions are
+    // parsed for each object created, e.g., for the random variables of
+    // the attributes of the models, so parse each description once.
+    static std::unordered_map<std::string, ObjectFactory> parsed;
+    // Bound the memory used by the descriptions built by the scenarios
+    const std::size_t maxParsed = 1000;
+
     std::string v;
     is >> v;
+    auto it = parsed.find(v);
+    if (it != parsed.end())
+    {
+        factory.SetTypeId(it->second.m_tid);
+        for (AttributeConstructionList::CIterator i = it->second.m_parameters.Begin();
+             i != it->second.m_parameters.End();
+             ++i)
+        {
+            factory.m_parameters.Add(i->name, i->checker, i->value);
+        }
+        return is;
+    }
     std::string::size_type lbracket;
     std::string::size_type rbracket;
     lbracket = v.find('[');
@@ -149,6 +183,11 @@ operator>>(std::istream& is, ObjectFactory& factory)
     std::string tid = v.substr(0, lbracket);
     std::string parameters = v.substr(lbracket + 1, rbracket - (lbracket + 1));
     factory.SetTypeId(tid);
+    ObjectFactory description;
+    description.SetTypeId(factory.m_tid);
+    // A value pointing to an object, e.g., to a random variable described by
+    // an ObjectFactory, must not be shared by the factories parsed later.
+    bool cacheable = true;
     std::string::size_type cur;
     cur = 0;
     while (cur != parameters.size())
@@ -192,11 +231,17 @@ operator>>(std::istream& is, ObjectFactory& factory)
                 else
                 {
                     factory.m_parameters.Add(name, info.checker, val);
+                    description.m_parameters.Add(name, info.checker, val);
+                    cacheable = cacheable && (DynamicCast<PointerValue>(val) == nullptr);
                 }
             }
         }
     }
     NS_ABORT_MSG_IF(is.bad(), "Failure to parse " << parameters);
+    if (!is.fail() && cacheable && parsed.size() < maxParsed)
+    {
+        parsed.emplace(v, description);
+    }
     return is;
 }
 
@@ -48,6 +48,63 @@ NS_LOG_COMPONENT_DEFINE("Object");
 
 NS_OBJECT_ENSURE_REGISTERED(Object);
 
+/** Unnamed namespace */
+namespace
+{
+
+/**
+ * Check if an aggregated object of TypeId \pname{instance} is found by
+ * a lookup of TypeId \pname{tid}, i.e. if \pname{tid} is \pname{instance}
+ * or one of its parents up to Object.
+ *
+ * The result is remembered for each pair of TypeIds, as the TypeIds
+ * looked up by GetObject() and the TypeIds of the aggregated objects
+ * are few, and the inheritance tree doesn't change once the TypeIds are
+ * registered.
+ *
+ * \param [in] instance The TypeId of the aggregated object.
+ * \param [in] tid The TypeId looked up.
+ * \returns \c true if the object is found by the lookup.
+ */
+bool
+IsAggregateOf(TypeId instance, TypeId tid)
+{
+    enum Match : uint8_t
+    {
+        UNKNOWN = 0,
+        MATCH,
+        NO_MATCH
+    };
+
+    // matches[tid][instance]
+    static std::vector<std::vector<uint8_t>> matches;
+
+    uint16_t t = tid.GetUid();
+    uint16_t u = instance.GetUid();
+    if (t >= matches.size())
+    {
+        matches.resize(t + 1);
+    }
+    std::vector<uint8_t>& row = matches[t];
+    if (u >= row.size())
+    {
+        row.resize(u + 1, UNKNOWN);
+    }
+    if (row[u] == UNKNOWN)
+    {
+        TypeId objectTid = Object::GetTypeId();
+        TypeId cur = instance;
+        while (cur != tid && cur != objectTid)
+        {
+            cur = cur.GetParent();
+        }
+        row[u] = (cur == tid) ? MATCH : NO_MATCH;
+    }
+    return row[u] == MATCH;
+}
+
+} // unnamed namespace
+
 Object::AggregateIterator::AggregateIterator()
     : m_object(nullptr),
       m_current(0)
@@ -154,16 +211,10 @@ Object::DoGetObject(TypeId tid) const
     NS_ASSERT(CheckLoose());
 
     uint32_t n = m_aggregates->n;
-    TypeId objectTid = Object::GetTypeId();
     for (uint32_t i = 0; i < n; i++)
     {
         Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
-        {
-            cur = cur.GetParent();
-        }
-        if (cur == tid)
+        if (IsAggregateOf(current->GetInstanceTypeId(), tid))
         {
             // This is an attempt to 'cache' the result of this lookup.
             // the idea is that if we perform a lookup for a TypeId on this object,
@@ -40,4 +40,10 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+void
+SimulatorImpl::SetCurrentTime(const Time& time)
+{
+    NS_FATAL_ERROR(GetInstanceTypeId().GetName() << " can't set the current time");
+}
+
 } // namespace ns3
@@ -100,6 +100,18 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** \copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /**
+     * Move the current time forward, e.g., to restore a Checkpoint.
+     *
+     * The events pending at an earlier time run at the new time, in the
+     * order they were scheduled.  Their EventId stay valid: they can still
+     * be cancelled or removed, and their delay left is zero.
+     *
+     * Not supported by default.
+     *
+     * \param [in] time The new current time, not earlier than Now().
+     */
+    virtual void SetCurrentTime(const Time& time);
 
     /**
      * Hook called before processing each event.
@@ -22,7 +22,9 @@
 
 #include "callback.h"
 
+#include <algorithm>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -47,6 +49,12 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The arguments of the functor are built by the caller even when
+ * no Callback is connected.  Hot code paths should instead invoke
+ * the chain with NS_TRACE, which only builds them when the chain is
+ * not empty, and which compiles to nothing when the trace sources
+ * are disabled at build time (NS3_TRACE=OFF).
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -111,11 +119,23 @@ class TracedCallback
     /**
      * Container type for holding the chain of Callbacks.
      *
+     * Most chains hold zero or one Callback: a vector does not allocate
+     * while empty and is iterated without chasing pointers.
+     *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * The chain of Callbacks.
+     *
+     * The Callbacks disconnected while the chain is invoked are only
+     * nulled, and removed once the outermost invocation returns.
+     */
+    mutable CallbackList m_callbackList;
+    /** Number of invocations of the chain in progress. */
+    mutable std::size_t m_invocations;
+    /** Whether Callbacks were nulled while the chain was invoked. */
+    mutable bool m_disconnected;
 };
 
 } // namespace ns3
@@ -129,7 +149,9 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_invocations(0),
+      m_disconnected(false)
 {
 }
 
@@ -162,6 +184,19 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
+    if (m_invocations > 0)
+    {
+        // Erasing would shift the Callbacks not yet invoked
+        for (auto& cb : m_callbackList)
+        {
+            if (!cb.IsNull() && cb.IsEqual(callback))
+            {
+                cb = Callback<void, Ts...>();
+                m_disconnected = true;
+            }
+        }
+        return;
+    }
     for (typename CallbackList::iterator i = m_callbackList.begin(); i != m_callbackList.end();
          /* empty */)
     {
@@ -193,11 +228,25 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (typename CallbackList::const_iterator i = m_callbackList.begin();
-         i != m_callbackList.end();
-         i++)
+    // Iterate by index, as a Callback may connect another one to the chain
+    m_invocations++;
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
     {
-        (*i)(args...);
+        if (!m_callbackList[i].IsNull())
+        {
+            m_callbackList[i](args...);
+        }
+    }
+    m_invocations--;
+    if (m_invocations == 0 && m_disconnected)
+    {
+        m_callbackList.erase(std::remove_if(m_callbackList.begin(),
+                                            m_callbackList.end(),
+                                            [](const Callback<void, Ts...>& cb) {
+                                                return cb.IsNull();
+                                            }),
+                             m_callbackList.end());
+        m_disconnected = false;
     }
 }
 
@@ -210,4 +259,39 @@ TracedCallback<Ts...>::IsEmpty() const
 
 } // namespace ns3
 
+/**
+ * \ingroup tracing
+ * \brief Invoke the chain of Callbacks of a TracedCallback, if any.
+ *
+ * The arguments are only evaluated if a Callback is connected to the
+ * trace source, and the whole statement compiles to nothing when the
+ * trace sources are disabled at build time (NS3_TRACE_DISABLE).
+ * For example:
+ * \code
+ *   NS_TRACE(m_txTrace, packet, header, this);
+ * \endcode
+ *
+ * \param [in] traceSource The TracedCallback to invoke.
+ * \param [in] ... The arguments of the Callbacks.
+ */
+#ifdef NS3_TRACE_DISABLE
+#define NS_TRACE(traceSource, ...)                                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        if (false)                                                                                 \
+        {                                                                                          \
+            (traceSource)(__VA_ARGS__);                                                            \
+        }                                                                                          \
+    } while (false)
+#else
+#define NS_TRACE(traceSource, ...)                                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(traceSource).IsEmpty())                                                              \
+        {                                                                                          \
+            (traceSource)(__VA_ARGS__);                                                            \
+        }                                                                                          \
+    } while (false)
+#endif /* NS3_TRACE_DISABLE */
+
 #endif /* TRACED_CALLBACK_H */
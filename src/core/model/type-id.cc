@@ -23,9 +23,10 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <deque>
 #include <iomanip>
-#include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -228,7 +229,16 @@ class IidManager : public Singleton<IidManager>
      * \param [in] i Index into attribute array
      * \returns The information associated to attribute whose index is \pname{i}.
      */
-    struct TypeId::AttributeInformation GetAttribute(uint16_t uid, std::size_t i) const;
+    const struct TypeId::AttributeInformation& GetAttribute(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute by name in a type id and in its parents.
+     * \param [in] uid The id.
+     * \param [in] name The Attribute name.
+     * \returns The Attribute of \pname{uid} or of the closest parent of
+     *          \pname{uid} with this name, or \c nullptr if not found.
+     */
+    const struct TypeId::AttributeInformation* FindAttribute(uint16_t uid,
+                                                             const std::string& name) const;
     /**
      * Record a new TraceSource.
      * \param [in] uid The id.
@@ -262,7 +272,17 @@ class IidManager : public Singleton<IidManager>
      * \param [in] i Index into trace source array.
      * \returns Detailed information about the requested trace source.
      */
-    struct TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, std::size_t i) const;
+    const struct TypeId::TraceSourceInformation& GetTraceSource(uint16_t uid,
+                                                                std::size_t i) const;
+    /**
+     * Find a TraceSource by name in a type id and in its parents.
+     * \param [in] uid The id.
+     * \param [in] name The TraceSource name.
+     * \returns The TraceSource of \pname{uid} or of the closest parent of
+     *          \pname{uid} with this name, or \c nullptr if not found.
+     */
+    const struct TypeId::TraceSourceInformation* FindTraceSource(uint16_t uid,
+                                                                 const std::string& name) const;
     /**
      * Check if this TypeId should not be listed in documentation.
      * \param [in] uid The id.
@@ -292,6 +312,14 @@ class IidManager : public Singleton<IidManager>
      */
     static TypeId::hash_t Hasher(const std::string name);
 
+    /**
+     * The location of an Attribute or of a TraceSource: the id which
+     * declares it, and its index in this id.
+     */
+    typedef std::pair<uint16_t, std::size_t> location_t;
+    /** Type of the by-name index of the Attributes or TraceSources of a type id. */
+    typedef std::unordered_map<std::string, location_t> memberindex_t;
+
     /** The information record about a single type id. */
     struct IidInformation
     {
@@ -319,9 +347,22 @@ class IidManager : public Singleton<IidManager>
         TypeId::SupportLevel supportLevel;
         /** Support message. */
         std::string supportMsg;
+        /**
+         * The Attributes of this type id and of its parents by name,
+         * built on demand.
+         */
+        memberindex_t attributeIndex;
+        /**
+         * The TraceSources of this type id and of its parents by name,
+         * built on demand.
+         */
+        memberindex_t traceSourceIndex;
+        /**
+         * The value of m_generation when attributeIndex and
+         * traceSourceIndex were built.
+         */
+        uint32_t indexGeneration;
     };
-    /** Iterator type. */
-    typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
     /**
      * Retrieve the information record for a type.
@@ -329,20 +370,38 @@ class IidManager : public Singleton<IidManager>
      * \returns The information record.
      */
     struct IidManager::IidInformation* LookupInformation(uint16_t uid) const;
+    /**
+     * Build the by-name indexes of the Attributes and TraceSources of a
+     * type id, if they are out of date.
+     * \param [in] uid The id.
+     * \returns The information record of the type id.
+     */
+    struct IidManager::IidInformation* UpdateIndexes(uint16_t uid) const;
 
-    /** The container of all type id records. */
-    std::vector<struct IidInformation> m_information;
+    /**
+     * The container of all type id records.
+     *
+     * The records don't move when a type id is added, so the references
+     * returned by GetAttribute() and GetTraceSource() stay valid.
+     */
+    std::deque<struct IidInformation> m_information;
 
     /** Type of the by-name index. */
-    typedef std::map<std::string, uint16_t> namemap_t;
+    typedef std::unordered_map<std::string, uint16_t> namemap_t;
     /** The by-name index. */
     namemap_t m_namemap;
 
     /** Type of the by-hash index. */
-    typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
+    typedef std::unordered_map<TypeId::hash_t, uint16_t> hashmap_t;
     /** The by-hash index. */
     hashmap_t m_hashmap;
 
+    /**
+     * Incremented when a parent, an Attribute or a TraceSource is set,
+     * to invalidate the by-name indexes of all the type ids.
+     */
+    uint32_t m_generation{1};
+
     /** IidManager constants. */
     enum
     {
@@ -439,6 +498,7 @@ IidManager::AllocateUid(std::string name)
     information.hasConstructor = false;
     information.mustHideFromDocumentation = false;
     information.supportLevel = TypeId::SUPPORTED;
+    information.indexGeneration = 0;
     m_information.push_back(information);
     std::size_t tuid = m_information.size();
     NS_ASSERT(tuid <= 0xffff);
@@ -467,6 +527,7 @@ IidManager::SetParent(uint16_t uid, uint16_t parent)
     NS_ASSERT(parent <= m_information.size());
     struct IidInformation* information = LookupInformation(uid);
     information->parent = parent;
+    m_generation++;
 }
 
 void
@@ -687,6 +748,7 @@ IidManager::AddAttribute(uint16_t uid,
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
     information->attributes.push_back(info);
+    m_generation++;
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -711,7 +773,7 @@ IidManager::GetAttributeN(uint16_t uid) const
     return size;
 }
 
-struct TypeId::AttributeInformation
+const struct TypeId::AttributeInformation&
 IidManager::GetAttribute(uint16_t uid, std::size_t i) const
 {
     NS_LOG_FUNCTION(IID << uid << i);
@@ -721,6 +783,21 @@ IidManager::GetAttribute(uint16_t uid, std::size_t i) const
     return information->attributes[i];
 }
 
+const struct TypeId::AttributeInformation*
+IidManager::FindAttribute(uint16_t uid, const std::string& name) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    struct IidInformation* information = UpdateIndexes(uid);
+    memberindex_t::const_iterator it = information->attributeIndex.find(name);
+    if (it == information->attributeIndex.end())
+    {
+        NS_LOG_LOGIC(IIDL << false);
+        return nullptr;
+    }
+    NS_LOG_LOGIC(IIDL << it->second.first << " " << it->second.second);
+    return &LookupInformation(it->second.first)->attributes[it->second.second];
+}
+
 bool
 IidManager::HasTraceSource(uint16_t uid, std::string name)
 {
@@ -778,6 +855,7 @@ IidManager::AddTraceSource(uint16_t uid,
     source.supportLevel = supportLevel;
     source.supportMsg = supportMsg;
     information->traceSources.push_back(source);
+    m_generation++;
     NS_LOG_LOGIC(IIDL << information->traceSources.size() - 1);
 }
 
@@ -791,7 +869,7 @@ IidManager::GetTraceSourceN(uint16_t uid) const
     return size;
 }
 
-struct TypeId::TraceSourceInformation
+const struct TypeId::TraceSourceInformation&
 IidManager::GetTraceSource(uint16_t uid, std::size_t i) const
 {
     NS_LOG_FUNCTION(IID << uid << i);
@@ -801,6 +879,59 @@ IidManager::GetTraceSource(uint16_t uid, std::size_t i) const
     return information->traceSources[i];
 }
 
+const struct TypeId::TraceSourceInformation*
+IidManager::FindTraceSource(uint16_t uid, const std::string& name) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    struct IidInformation* information = UpdateIndexes(uid);
+    memberindex_t::const_iterator it = information->traceSourceIndex.find(name);
+    if (it == information->traceSourceIndex.end())
+    {
+        NS_LOG_LOGIC(IIDL << false);
+        return nullptr;
+    }
+    NS_LOG_LOGIC(IIDL << it->second.first << " " << it->second.second);
+    return &LookupInformation(it->second.first)->traceSources[it->second.second];
+}
+
+struct IidManager::IidInformation*
+IidManager::UpdateIndexes(uint16_t uid) const
+{
+    NS_LOG_FUNCTION(IID << uid);
+    struct IidInformation* information = LookupInformation(uid);
+    if (information->indexGeneration == m_generation)
+    {
+        return information;
+    }
+    information->attributeIndex.clear();
+    information->traceSourceIndex.clear();
+    // Walk from this type id up to the top of the inheritance tree,
+    // keeping the first member found with each name, as a scan of
+    // the parents would.
+    while (true)
+    {
+        struct IidInformation* current = LookupInformation(uid);
+        for (std::size_t i = 0; i < current->attributes.size(); i++)
+        {
+            information->attributeIndex.emplace(current->attributes[i].name,
+                                                location_t(uid, i));
+        }
+        for (std::size_t i = 0; i < current->traceSources.size(); i++)
+        {
+            information->traceSourceIndex.emplace(current->traceSources[i].name,
+                                                  location_t(uid, i));
+        }
+        if (current->parent == uid || current->parent == 0)
+        {
+            // top of inheritance tree, or no parent set yet
+            break;
+        }
+        uid = current->parent;
+    }
+    information->indexGeneration = m_generation;
+    return information;
+}
+
 bool
 IidManager::MustHideFromDocumentation(uint16_t uid) const
 {
@@ -897,38 +1028,22 @@ bool
 TypeId::LookupAttributeByName(std::string name, struct TypeId::AttributeInformation* info) const
 {
     NS_LOG_FUNCTION(this << name << info);
-    TypeId tid;
-    TypeId nextTid = *this;
-    do
+    const struct TypeId::AttributeInformation* tmp = IidManager::Get()->FindAttribute(m_tid, name);
+    if (tmp == nullptr)
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
-        {
-            struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
-                                                 << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return false;
+        return false;
+    }
+    if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "Attribute '" << name << "' is deprecated: " << tmp->supportMsg << std::endl;
+    }
+    else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
+                                     << tmp->supportMsg);
+    }
+    *info = *tmp;
+    return true;
 }
 
 TypeId
@@ -1108,7 +1223,7 @@ TypeId::GetAttributeN() const
     return n;
 }
 
-struct TypeId::AttributeInformation
+const struct TypeId::AttributeInformation&
 TypeId::GetAttribute(std::size_t i) const
 {
     NS_LOG_FUNCTION(this << i);
@@ -1119,7 +1234,7 @@ std::string
 TypeId::GetAttributeFullName(std::size_t i) const
 {
     NS_LOG_FUNCTION(this << i);
-    struct TypeId::AttributeInformation info = GetAttribute(i);
+    const struct TypeId::AttributeInformation& info = GetAttribute(i);
     return GetName() + "::" + info.name;
 }
 
@@ -1130,7 +1245,7 @@ TypeId::GetTraceSourceN() const
     return IidManager::Get()->GetTraceSourceN(m_tid);
 }
 
-struct TypeId::TraceSourceInformation
+const struct TypeId::TraceSourceInformation&
 TypeId::GetTraceSource(std::size_t i) const
 {
     NS_LOG_FUNCTION(this << i);
@@ -1163,39 +1278,24 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName(std::string name, struct TraceSourceInformation* info) const
 {
     NS_LOG_FUNCTION(this << name);
-    TypeId tid;
-    TypeId nextTid = *this;
-    struct TypeId::TraceSourceInformation tmp;
-    do
+    const struct TypeId::TraceSourceInformation* tmp =
+        IidManager::Get()->FindTraceSource(m_tid, name);
+    if (tmp == nullptr)
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-            tmp = tid.GetTraceSource(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
-                                                   << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return nullptr;
+        return nullptr;
+    }
+    if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp->supportMsg
+                  << std::endl;
+    }
+    else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
+                                       << tmp->supportMsg);
+    }
+    *info = *tmp;
+    return tmp->accessor;
 }
 
 Ptr<const TraceSourceAccessor>
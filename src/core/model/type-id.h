@@ -259,10 +259,12 @@ class TypeId
     /**
      * Get Attribute information by index.
      *
+     * The reference stays valid until an Attribute is added to this TypeId.
+     *
      * \param [in] i Index into attribute array
      * \returns The information associated to attribute whose index is \pname{i}.
      */
-    struct TypeId::AttributeInformation GetAttribute(std::size_t i) const;
+    const struct TypeId::AttributeInformation& GetAttribute(std::size_t i) const;
     /**
      * Get the Attribute name by index.
      *
@@ -295,10 +297,12 @@ class TypeId
     /**
      * Get the trace source by index.
      *
+     * The reference stays valid until a TraceSource is added to this TypeId.
+     *
      * \param [in] i Index into trace source array.
      * \returns Detailed information about the requested trace source.
      */
-    struct TypeId::TraceSourceInformation GetTraceSource(std::size_t i) const;
+    const struct TypeId::TraceSourceInformation& GetTraceSource(std::size_t i) const;
 
     /**
      * Set the parent TypeId.
@@ -1162,6 +1162,29 @@ RandomVariableStreamAttributeTestCase::DoRun()
     ok = p->SetAttributeFailSafe("TestRandom",
                                  StringValue("ns3::ConstantRandomVariable[Constant=1.0]"));
     NS_TEST_ASSERT_MSG_EQ(ok, true, "Could not SetAttributeFailSafe() a ConstantRandomVariable");
+
+    //
+    // Each object gets its own random variable, from the initial value
+    // or from a factory, although the description is parsed once.
+    //
+    ObjectFactory factory("ns3::AttributeObjectTest");
+    factory.Set("TestRandom", StringValue("ns3::UniformRandomVariable[Min=0.|Max=1.]"));
+    std::vector<Ptr<AttributeObjectTest>> objects = {CreateObject<AttributeObjectTest>(),
+                                                     CreateObject<AttributeObjectTest>(),
+                                                     factory.Create<AttributeObjectTest>(),
+                                                     factory.Create<AttributeObjectTest>()};
+    std::vector<Ptr<RandomVariableStream>> variables;
+    for (const auto& object : objects)
+    {
+        PointerValue random;
+        object->GetAttribute("TestRandom", random);
+        variables.push_back(random.Get<RandomVariableStream>());
+    }
+    NS_TEST_EXPECT_MSG_NE(variables[0], variables[1], "Initial random variable shared");
+    NS_TEST_EXPECT_MSG_NE(variables[2], variables[3], "Random variable shared by the factory");
+    NS_TEST_EXPECT_MSG_NE(DynamicCast<UniformRandomVariable>(variables[2]),
+                          nullptr,
+                          "Wrong random variable created by the factory");
 }
 
 /**
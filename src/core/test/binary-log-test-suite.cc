@@ -0,0 +1,285 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#define NS_LOG_APPEND_CONTEXT LogGetContextStream() << "[context] "
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BINARY_LOG_TEST_FORK
+#endif
+
+/**
+ * \file
+ * \ingroup logging-tests
+ * Binary log test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup logging-tests Logging tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryLogTestSuite");
+
+/**
+ * \ingroup logging-tests
+ * Log messages of every kind.
+ * \param [in] value A parameter.
+ */
+static void
+LogMessages(uint32_t value)
+{
+    NS_LOG_FUNCTION(value << std::string("text") << 'c');
+    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_DEBUG("value " << value << " " << 1.5);
+    NS_LOG_INFO("hex " << std::hex << std::setw(4) << value << std::dec);
+    NS_LOG_WARN(Seconds(value));
+}
+
+/**
+ * \ingroup logging-tests
+ *
+ * Check that the binary log renders the messages, with their context,
+ * as std::clog, and leaves std::clog untouched.
+ */
+class BinaryLogTextTestCase : public TestCase
+{
+  public:
+    BinaryLogTextTestCase();
+
+  private:
+    void DoRun() override;
+    /** Log messages from simulation events. */
+    void Simulate();
+};
+
+BinaryLogTextTestCase::BinaryLogTextTestCase()
+    : TestCase("Check the text of the messages of the binary log")
+{
+}
+
+void
+BinaryLogTextTestCase::Simulate()
+{
+    Simulator::Schedule(Seconds(0.5), &LogMessages, 1);
+    Simulator::ScheduleWithContext(3, Seconds(1), &LogMessages, 255);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+BinaryLogTextTestCase::DoRun()
+{
+#ifdef NS3_LOG_ENABLE
+    LogComponentEnable("BinaryLogTestSuite", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+
+    std::ostringstream text;
+    std::streambuf* clog = std::clog.rdbuf(text.rdbuf());
+    Simulate();
+    std::clog.rdbuf(clog);
+
+    std::string filename = CreateTempDirFilename("binary-log.bin");
+    LogSetBinaryFile(filename);
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinary(), true, "The binary log is not open");
+    std::ostringstream untouched;
+    clog = std::clog.rdbuf(untouched.rdbuf());
+    Simulate();
+    std::clog.rdbuf(clog);
+    LogSetBinaryFile("");
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinary(), false, "The binary log is not closed");
+    NS_TEST_EXPECT_MSG_EQ(untouched.str(), "", "The binary log wrote to std::clog");
+
+    BinaryLogReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    std::ostringstream binary;
+    std::string line;
+    while (reader.Read(line))
+    {
+        binary << line << std::endl;
+    }
+    NS_TEST_EXPECT_MSG_EQ(binary.str(), text.str(), "The binary log differs from std::clog");
+    NS_TEST_EXPECT_MSG_NE(text.str(), "", "No message logged");
+    NS_TEST_EXPECT_MSG_NE(text.str().find("[context] "), std::string::npos, "No context logged");
+
+    LogComponentDisable("BinaryLogTestSuite", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+    remove(filename.c_str());
+#endif
+}
+
+/**
+ * \ingroup logging-tests
+ *
+ * Check that the messages of several threads are written to the binary
+ * log, in order for each thread.
+ */
+class BinaryLogThreadsTestCase : public TestCase
+{
+  public:
+    BinaryLogThreadsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryLogThreadsTestCase::BinaryLogThreadsTestCase()
+    : TestCase("Check the messages of several threads in the binary log")
+{
+}
+
+void
+BinaryLogThreadsTestCase::DoRun()
+{
+#ifdef NS3_LOG_ENABLE
+    const uint32_t threads = 4;
+    // enough messages to fill the ring buffers
+    const uint32_t messages = 20000;
+    LogComponentEnable("BinaryLogTestSuite", LOG_LEVEL_DEBUG);
+    std::string filename = CreateTempDirFilename("binary-log-threads.bin");
+    LogSetBinaryFile(filename);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([t]() {
+            for (uint32_t i = 0; i < messages; i++)
+            {
+                NS_LOG_DEBUG(t << " " << i << " " << std::string(40, 'x'));
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    LogSetBinaryFile("");
+    LogComponentDisable("BinaryLogTestSuite", LOG_LEVEL_DEBUG);
+
+    BinaryLogReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    std::vector<uint32_t> next(threads, 0);
+    std::string line;
+    uint32_t total = 0;
+    while (reader.Read(line))
+    {
+        std::istringstream is(line);
+        std::string context;
+        uint32_t t;
+        uint32_t i;
+        is >> context >> t >> i;
+        NS_TEST_ASSERT_MSG_LT(t, threads, "Wrong thread in " << line);
+        NS_TEST_EXPECT_MSG_EQ(i, next[t], "Messages of thread " << t << " out of order");
+        next[t] = i + 1;
+        total++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(total, threads * messages, "Messages are missing");
+    remove(filename.c_str());
+#endif
+}
+
+/**
+ * \ingroup logging-tests
+ *
+ * Check that a binary log file which cannot be opened is a fatal error,
+ * reported without hanging: the error flushes the binary log.
+ */
+class BinaryLogBadFileTestCase : public TestCase
+{
+  public:
+    BinaryLogBadFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryLogBadFileTestCase::BinaryLogBadFileTestCase()
+    : TestCase("Check the fatal error of a binary log file which cannot be opened")
+{
+}
+
+void
+BinaryLogBadFileTestCase::DoRun()
+{
+#ifdef BINARY_LOG_TEST_FORK
+    std::string filename = CreateTempDirFilename("missing-dir/binary-log.bin");
+    pid_t pid = fork();
+    NS_TEST_ASSERT_MSG_NE(pid, -1, "Unable to fork");
+    if (pid == 0)
+    {
+        // the child aborts with the fatal error, which is not shown
+        std::freopen("/dev/null", "w", stderr);
+        LogSetBinaryFile(filename);
+        _exit(0);
+    }
+    int status = 0;
+    pid_t done = 0;
+    // 10 s are more than enough to report the error
+    for (uint32_t i = 0; i < 1000 && done == 0; i++)
+    {
+        done = waitpid(pid, &status, WNOHANG);
+        if (done == 0)
+        {
+            usleep(10000);
+        }
+    }
+    if (done == 0)
+    {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        NS_TEST_ASSERT_MSG_EQ(true, false, "The fatal error hangs");
+    }
+    NS_TEST_EXPECT_MSG_EQ(WIFSIGNALED(status), true, "No fatal error");
+#endif
+}
+
+/**
+ * \ingroup logging-tests
+ *
+ * Binary log TestSuite
+ */
+class BinaryLogTestSuite : public TestSuite
+{
+  public:
+    BinaryLogTestSuite();
+};
+
+BinaryLogTestSuite::BinaryLogTestSuite()
+    : TestSuite("binary-log", UNIT)
+{
+    AddTestCase(new BinaryLogTextTestCase(), TestCase::QUICK);
+    AddTestCase(new BinaryLogThreadsTestCase(), TestCase::QUICK);
+    AddTestCase(new BinaryLogBadFileTestCase(), TestCase::QUICK);
+}
+
+static BinaryLogTestSuite g_binaryLogTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
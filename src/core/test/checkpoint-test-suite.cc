@@ -0,0 +1,246 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/checkpoint.h"
+#include "ns3/config.h"
+#include "ns3/integer.h"
+#include "ns3/object-vector.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup checkpoint-tests
+ * Checkpoint test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup checkpoint-tests Checkpoint tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup checkpoint-tests
+ * An object with attributes, objects and a state to checkpoint.
+ */
+class CheckpointTestObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    int16_t m_value;                                //!< Value attribute target.
+    Ptr<CheckpointTestObject> m_child;              //!< Child attribute target.
+    std::vector<Ptr<CheckpointTestObject>> m_items; //!< Items attribute target.
+    std::string m_state;                            //!< State saved by the hook.
+};
+
+TypeId
+CheckpointTestObject::GetTypeId()
+{
+    static TypeId tid = TypeId("CheckpointTestObject")
+                            .SetParent<Object>()
+                            .AddConstructor<CheckpointTestObject>()
+                            .AddAttribute("Value",
+                                          "",
+                                          IntegerValue(0),
+                                          MakeIntegerAccessor(&CheckpointTestObject::m_value),
+                                          MakeIntegerChecker<int16_t>())
+                            .AddAttribute("Child",
+                                          "",
+                                          PointerValue(),
+                                          MakePointerAccessor(&CheckpointTestObject::m_child),
+                                          MakePointerChecker<CheckpointTestObject>())
+                            .AddAttribute("Items",
+                                          "",
+                                          ObjectVectorValue(),
+                                          MakeObjectVectorAccessor(&CheckpointTestObject::m_items),
+                                          MakeObjectVectorChecker<CheckpointTestObject>());
+    return tid;
+}
+
+/**
+ * \ingroup checkpoint-tests
+ * Save the state of a CheckpointTestObject.
+ * \param [in] object The object.
+ * \param [in,out] os The stream to write the state to.
+ */
+static void
+SaveTestState(Ptr<Object> object, std::ostream& os)
+{
+    os << DynamicCast<CheckpointTestObject>(object)->m_state;
+}
+
+/**
+ * \ingroup checkpoint-tests
+ * Restore the state of a CheckpointTestObject.
+ * \param [in] object The object.
+ * \param [in,out] is The stream to read the state from.
+ */
+static void
+RestoreTestState(Ptr<Object> object, std::istream& is)
+{
+    is >> DynamicCast<CheckpointTestObject>(object)->m_state;
+}
+
+/**
+ * \ingroup checkpoint-tests
+ *
+ * Check that a checkpoint restores the time, the attributes and the
+ * states of the objects, and that the events moved to the checkpoint time
+ * can still be cancelled.
+ */
+class CheckpointRestoreTestCase : public TestCase
+{
+  public:
+    CheckpointRestoreTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Build the objects of the scenario.
+     * \param [in] items The number of items of the root object.
+     * \return The root object.
+     */
+    Ptr<CheckpointTestObject> Build(uint32_t items);
+    /** Change the objects during the warm-up run. */
+    void Change();
+    /** Record the time of an event. */
+    void Record();
+
+    Ptr<CheckpointTestObject> m_root; //!< The root object.
+    std::vector<Time> m_times;        //!< The times of the events recorded.
+};
+
+CheckpointRestoreTestCase::CheckpointRestoreTestCase()
+    : TestCase("Check the time, attributes and states restored from a checkpoint")
+{
+}
+
+Ptr<CheckpointTestObject>
+CheckpointRestoreTestCase::Build(uint32_t items)
+{
+    Ptr<CheckpointTestObject> root = CreateObject<CheckpointTestObject>();
+    root->m_child = CreateObject<CheckpointTestObject>();
+    for (uint32_t i = 0; i < items; i++)
+    {
+        root->m_items.push_back(CreateObject<CheckpointTestObject>());
+    }
+    Config::RegisterRootNamespaceObject(root);
+    return root;
+}
+
+void
+CheckpointRestoreTestCase::Change()
+{
+    m_root->SetAttribute("Value", IntegerValue(1));
+    m_root->m_child->SetAttribute("Value", IntegerValue(2));
+    m_root->m_items[1]->SetAttribute("Value", IntegerValue(3));
+    m_root->m_items[2]->SetAttribute("Value", IntegerValue(4));
+    m_root->m_child->m_state = "learnt";
+}
+
+void
+CheckpointRestoreTestCase::Record()
+{
+    m_times.push_back(Simulator::Now());
+}
+
+void
+CheckpointRestoreTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("checkpoint.ckpt");
+
+    // warm-up run
+    m_root = Build(3);
+    Simulator::Schedule(Seconds(1), &CheckpointRestoreTestCase::Change, this);
+    Simulator::Schedule(Seconds(5), &Checkpoint::Save, filename);
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::UnregisterRootNamespaceObject(m_root);
+
+    // measurement run, with an item less
+    m_root = Build(2);
+    Simulator::Schedule(Seconds(1), &CheckpointRestoreTestCase::Record, this);
+    Simulator::Schedule(Seconds(7), &CheckpointRestoreTestCase::Record, this);
+    EventId cancelled = Simulator::Schedule(Seconds(2), &CheckpointRestoreTestCase::Record, this);
+    EventId removed = Simulator::Schedule(Seconds(3), &CheckpointRestoreTestCase::Record, this);
+    Checkpoint::Restore(filename);
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(5), "Wrong time restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_value, 1, "Wrong root attribute restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_child->m_value, 2, "Wrong child attribute restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_items[0]->m_value, 0, "Unchanged attribute restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_items[1]->m_value, 3, "Wrong item attribute restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_child->m_state, "learnt", "Wrong state restored");
+    NS_TEST_EXPECT_MSG_EQ(m_root->m_state, "", "State restored for the wrong object");
+    NS_TEST_EXPECT_MSG_EQ(cancelled.IsRunning(), true, "Moved event expired");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetDelayLeft(cancelled),
+                          Seconds(0),
+                          "Moved event not at the checkpoint time");
+    cancelled.Cancel();
+    NS_TEST_EXPECT_MSG_EQ(cancelled.IsExpired(), true, "Moved event not cancelled");
+    NS_TEST_EXPECT_MSG_EQ(removed.IsRunning(), true, "Moved event expired");
+    removed.Remove();
+    NS_TEST_EXPECT_MSG_EQ(removed.IsExpired(), true, "Moved event not removed");
+
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_times.size(), 2, "Events lost by the restore");
+    NS_TEST_EXPECT_MSG_EQ(m_times[0], Seconds(5), "Earlier event not run at the checkpoint");
+    NS_TEST_EXPECT_MSG_EQ(m_times[1], Seconds(7), "Later event not run at its time");
+    Simulator::Destroy();
+    Config::UnregisterRootNamespaceObject(m_root);
+    m_root = nullptr;
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup checkpoint-tests
+ *
+ * Checkpoint TestSuite
+ */
+class CheckpointTestSuite : public TestSuite
+{
+  public:
+    CheckpointTestSuite();
+};
+
+CheckpointTestSuite::CheckpointTestSuite()
+    : TestSuite("checkpoint", UNIT)
+{
+    Checkpoint::AddStateHook(CheckpointTestObject::GetTypeId(),
+                             MakeCallback(&SaveTestState),
+                             MakeCallback(&RestoreTestState));
+    AddTestCase(new CheckpointRestoreTestCase(), TestCase::QUICK);
+}
+
+static CheckpointTestSuite g_checkpointTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
@@ -864,6 +864,133 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test that a Config::Batch finds the same objects as Config.
+ */
+class BatchConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    BatchConfigTestCase();
+
+    /** Destructor. */
+    ~BatchConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_count++;
+    }
+
+    /**
+     * Trace callback with context path.
+     * \param path The context path.
+     * \param old The old value.
+     * \param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+  private:
+    void DoRun() override;
+
+    int16_t m_newValue; //!< Flag to detect tracing result.
+    uint32_t m_count;   //!< Number of trace calls.
+    std::string m_path; //!< The context path.
+};
+
+BatchConfigTestCase::BatchConfigTestCase()
+    : TestCase("Check that a Config::Batch finds the same objects as Config")
+{
+}
+
+void
+BatchConfigTestCase::DoRun()
+{
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a->SetNodeB(b);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        b->AddNodeB(objects.back());
+    }
+    Names::Add("BatchB", b);
+
+    Config::Batch batch;
+    const std::vector<std::string> paths = {"/NodeA/NodeB/NodesB/2",
+                                            "/NodeA/NodeB/NodesB/[1-2]",
+                                            "/NodeA/NodeB/NodesB/3|0",
+                                            "/NodeA/NodeB/NodesB/*",
+                                            "/NodeA/NodeB/NodesB/9",
+                                            "/NodeA/NodeB/NodesB/[2-9]",
+                                            "/NodeA/NodeB/NodesB",
+                                            "/NodeA/*",
+                                            "/*/NodeB/*/1",
+                                            "/NodeA/$ns3::Object/NodeB",
+                                            "/Names/BatchB/NodesB/1"};
+    // resolve the paths twice, the second time with the objects found the
+    // first time
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        for (const auto& path : paths)
+        {
+            Config::MatchContainer expected = Config::LookupMatches(path);
+            Config::MatchContainer found = batch.LookupMatches(path);
+            NS_TEST_ASSERT_MSG_EQ(found.GetN(), expected.GetN(), "Wrong matches of " << path);
+            for (std::size_t i = 0; i < found.GetN(); i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(found.Get(i), expected.Get(i), "Wrong match of " << path);
+                NS_TEST_EXPECT_MSG_EQ(found.GetMatchedPath(i),
+                                      expected.GetMatchedPath(i),
+                                      "Wrong match of " << path);
+            }
+        }
+    }
+
+    batch.ConnectWithoutContext("/NodeA/NodeB/NodesB/3|1/Source",
+                                MakeCallback(&BatchConfigTestCase::Trace, this));
+    for (uint32_t i = 0; i < objects.size(); i++)
+    {
+        m_count = 0;
+        objects[i]->SetAttribute("Source", IntegerValue(-1 - static_cast<int>(i)));
+        bool connected = (i == 1 || i == 3);
+        NS_TEST_EXPECT_MSG_EQ(m_count, (connected ? 1 : 0), "Trace " << i << " is wrong");
+    }
+
+    batch.Connect("/NodeA/NodeB/NodesB/2/Source",
+                  MakeCallback(&BatchConfigTestCase::TraceWithPath, this));
+    m_newValue = 0;
+    m_path = "";
+    objects[2]->SetAttribute("Source", IntegerValue(-5));
+    NS_TEST_EXPECT_MSG_EQ(m_newValue, -5, "Trace 2 did not fire as expected");
+    NS_TEST_EXPECT_MSG_EQ(m_path,
+                          "/NodeA/NodeB/NodesB/2/Source",
+                          "Trace 2 did not provide expected context");
+
+    bool ok = batch.ConnectFailSafe("/NodeA/NodeB/NodesB/9/Source",
+                                    MakeCallback(&BatchConfigTestCase::TraceWithPath, this));
+    NS_TEST_EXPECT_MSG_EQ(ok, false, "Connected a trace source which does not exist");
+
+    Names::Clear();
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +1009,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new BatchConfigTestCase);
 }
 
 /**
@@ -133,6 +133,174 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check NS_TRACE and the Callbacks connected
+ * while the chain is invoked.
+ */
+class NsTraceTestCase : public TestCase
+{
+  public:
+    NsTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Argument of the trace source, counting its evaluations.
+     * \return The argument.
+     */
+    int Argument();
+
+    /**
+     * Callback connecting another Callback to the trace source.
+     * \param a The parameter.
+     */
+    void CbConnect(int a);
+
+    /**
+     * Callback counting its calls.
+     * \param a The parameter.
+     */
+    void CbCount(int a);
+
+    TracedCallback<int> m_trace; //!< The trace source.
+    int m_arguments;             //!< Number of evaluations of the argument.
+    int m_calls;                 //!< Number of calls of CbCount.
+};
+
+NsTraceTestCase::NsTraceTestCase()
+    : TestCase("Check NS_TRACE and the growth of the Callback chain")
+{
+}
+
+int
+NsTraceTestCase::Argument()
+{
+    m_arguments++;
+    return 1;
+}
+
+void
+NsTraceTestCase::CbConnect(int a)
+{
+    m_trace.ConnectWithoutContext(MakeCallback(&NsTraceTestCase::CbCount, this));
+}
+
+void
+NsTraceTestCase::CbCount(int a)
+{
+    m_calls++;
+}
+
+void
+NsTraceTestCase::DoRun()
+{
+    m_arguments = 0;
+    m_calls = 0;
+    NS_TRACE(m_trace, Argument());
+    NS_TEST_ASSERT_MSG_EQ(m_arguments, 0, "Argument evaluated without connected Callback");
+
+    // A Callback connected while the chain is invoked is called too
+    m_trace.ConnectWithoutContext(MakeCallback(&NsTraceTestCase::CbConnect, this));
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, 1, "Callback connected during the invocation not called");
+
+    NS_TRACE(m_trace, Argument());
+    NS_TEST_ASSERT_MSG_EQ(m_arguments, 1, "Argument not evaluated once");
+    NS_TEST_ASSERT_MSG_EQ(m_calls, 3, "Callbacks not called by NS_TRACE");
+}
+
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the Callbacks disconnected while the
+ * chain is invoked.
+ */
+class DisconnectDuringInvocationTestCase : public TestCase
+{
+  public:
+    DisconnectDuringInvocationTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback counting its calls.
+     * \param a The parameter.
+     */
+    void CbFirst(int a);
+
+    /**
+     * Callback disconnecting CbFirst, which precedes it in the chain.
+     * \param a The parameter.
+     */
+    void CbDisconnect(int a);
+
+    /**
+     * Callback counting its calls.
+     * \param a The parameter.
+     */
+    void CbLast(int a);
+
+    TracedCallback<int> m_trace; //!< The trace source.
+    int m_first;                 //!< Number of calls of CbFirst.
+    int m_last;                  //!< Number of calls of CbLast.
+};
+
+DisconnectDuringInvocationTestCase::DisconnectDuringInvocationTestCase()
+    : TestCase("Check the Callbacks disconnected while the chain is invoked")
+{
+}
+
+void
+DisconnectDuringInvocationTestCase::CbFirst(int a)
+{
+    m_first++;
+}
+
+void
+DisconnectDuringInvocationTestCase::CbDisconnect(int a)
+{
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&DisconnectDuringInvocationTestCase::CbFirst, this));
+}
+
+void
+DisconnectDuringInvocationTestCase::CbLast(int a)
+{
+    m_last++;
+}
+
+void
+DisconnectDuringInvocationTestCase::DoRun()
+{
+    m_first = 0;
+    m_last = 0;
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&DisconnectDuringInvocationTestCase::CbFirst, this));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&DisconnectDuringInvocationTestCase::CbDisconnect, this));
+    m_trace.ConnectWithoutContext(MakeCallback(&DisconnectDuringInvocationTestCase::CbLast, this));
+
+    // Disconnecting a Callback already invoked does not skip the next one
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_first, 1, "Callback CbFirst not called once");
+    NS_TEST_ASSERT_MSG_EQ(m_last, 1, "Callback CbLast skipped");
+
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_first, 1, "Disconnected Callback CbFirst called");
+    NS_TEST_ASSERT_MSG_EQ(m_last, 2, "Callback CbLast skipped");
+
+    // The disconnected Callbacks are removed once the invocation returns
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&DisconnectDuringInvocationTestCase::CbDisconnect, this));
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&DisconnectDuringInvocationTestCase::CbLast, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Disconnected Callbacks left in the chain");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -148,6 +316,8 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new NsTraceTestCase, TestCase::QUICK);
+    AddTestCase(new DisconnectDuringInvocationTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite
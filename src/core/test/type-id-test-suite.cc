@@ -347,6 +347,143 @@ DeprecatedAttributeTestCase::DoRun()
               << (tinfo.supportLevel == TypeId::DEPRECATED ? "deprecated" : "error") << std::endl;
 }
 
+/**
+ * \ingroup typeid-tests
+ *
+ * Class used to test the lookup of inherited Attributes and TraceSources.
+ */
+class LookupParent : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("LookupParent")
+                .SetParent<Object>()
+                .AddAttribute("ParentAttribute",
+                              "an Attribute of the parent",
+                              IntegerValue(1),
+                              MakeIntegerAccessor(&LookupParent::m_parentAttr),
+                              MakeIntegerChecker<int>())
+                .AddTraceSource("ParentTrace",
+                                "a TraceSource of the parent",
+                                MakeTraceSourceAccessor(&LookupParent::m_parentTrace),
+                                "ns3::TracedValueCallback::Double");
+        return tid;
+    }
+
+  private:
+    int m_parentAttr{0};               //!< An attribute of the parent.
+    TracedValue<double> m_parentTrace; //!< A trace source of the parent.
+};
+
+/**
+ * \ingroup typeid-tests
+ *
+ * Class used to test the lookup of inherited Attributes and TraceSources.
+ */
+class LookupChild : public LookupParent
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("LookupChild")
+                .SetParent<LookupParent>()
+                .AddAttribute("ChildAttribute",
+                              "an Attribute of the child",
+                              IntegerValue(2),
+                              MakeIntegerAccessor(&LookupChild::m_childAttr),
+                              MakeIntegerChecker<int>())
+                .AddTraceSource("ChildTrace",
+                                "a TraceSource of the child",
+                                MakeTraceSourceAccessor(&LookupChild::m_childTrace),
+                                "ns3::TracedValueCallback::Double");
+        return tid;
+    }
+
+  private:
+    int m_childAttr{0};               //!< An attribute of the child.
+    TracedValue<double> m_childTrace; //!< A trace source of the child.
+};
+
+/**
+ * \ingroup typeid-tests
+ *
+ * Check the lookup by name of inherited Attributes and TraceSources,
+ * also after a parent gains a new Attribute.
+ */
+class InheritedLookupTestCase : public TestCase
+{
+  public:
+    InheritedLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+InheritedLookupTestCase::InheritedLookupTestCase()
+    : TestCase("Check the lookup of inherited Attributes and TraceSources")
+{
+}
+
+void
+InheritedLookupTestCase::DoRun()
+{
+    TypeId parent = LookupParent::GetTypeId();
+    TypeId child = LookupChild::GetTypeId();
+
+    struct TypeId::AttributeInformation ainfo;
+    NS_TEST_ASSERT_MSG_EQ(child.LookupAttributeByName("ChildAttribute", &ainfo),
+                          true,
+                          "lookup child attribute");
+    NS_TEST_EXPECT_MSG_EQ(ainfo.help, "an Attribute of the child", "wrong child attribute");
+    NS_TEST_ASSERT_MSG_EQ(child.LookupAttributeByName("ParentAttribute", &ainfo),
+                          true,
+                          "lookup inherited attribute");
+    NS_TEST_EXPECT_MSG_EQ(ainfo.help, "an Attribute of the parent", "wrong parent attribute");
+    NS_TEST_EXPECT_MSG_EQ(parent.LookupAttributeByName("ChildAttribute", &ainfo),
+                          false,
+                          "parent has the attribute of its child");
+    NS_TEST_EXPECT_MSG_EQ(child.LookupAttributeByName("NoAttribute", &ainfo),
+                          false,
+                          "lookup missing attribute");
+
+    struct TypeId::TraceSourceInformation tinfo;
+    Ptr<const TraceSourceAccessor> acc = child.LookupTraceSourceByName("ParentTrace", &tinfo);
+    NS_TEST_ASSERT_MSG_NE(acc, nullptr, "lookup inherited trace source");
+    NS_TEST_EXPECT_MSG_EQ(tinfo.help, "a TraceSource of the parent", "wrong parent trace");
+    NS_TEST_EXPECT_MSG_EQ(acc, parent.GetTraceSource(0).accessor, "wrong accessor");
+    NS_TEST_EXPECT_MSG_NE(child.LookupTraceSourceByName("ChildTrace"),
+                          nullptr,
+                          "lookup child trace source");
+    NS_TEST_EXPECT_MSG_EQ(parent.LookupTraceSourceByName("ChildTrace"),
+                          nullptr,
+                          "parent has the trace source of its child");
+
+    // A new Attribute of the parent is found through the child
+    NS_TEST_EXPECT_MSG_EQ(child.LookupAttributeByName("LateAttribute", &ainfo),
+                          false,
+                          "lookup attribute before it is added");
+    parent.AddAttribute("LateAttribute",
+                        "an Attribute added to the parent later",
+                        EmptyAttributeValue(),
+                        MakeEmptyAttributeAccessor(),
+                        MakeEmptyAttributeChecker());
+    NS_TEST_ASSERT_MSG_EQ(child.LookupAttributeByName("LateAttribute", &ainfo),
+                          true,
+                          "lookup attribute after it is added");
+    NS_TEST_EXPECT_MSG_EQ(ainfo.help, "an Attribute added to the parent later", "wrong attribute");
+}
+
 /**
  * \ingroup typeid-tests
  *
@@ -461,6 +598,7 @@ TypeIdTestSuite::TypeIdTestSuite()
     AddTestCase(new UniqueTypeIdTestCase, QUICK);
     AddTestCase(new CollisionTestCase, QUICK);
     AddTestCase(new DeprecatedAttributeTestCase, QUICK);
+    AddTestCase(new InheritedLookupTestCase, QUICK);
 }
 
 /// Static variable for test initialization.
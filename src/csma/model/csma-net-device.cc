@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -529,6 +530,20 @@ CsmaNetDevice::TransmitStart()
             m_txMachineState = BUSY;
 
             Time tEvent = m_bps.CalculateBytesTxTime(m_currentPkt->GetSize());
+            SegmentationOffloadTag tsoTag;
+            if (m_currentPkt->PeekPacketTag(tsoTag))
+            {
+                //
+                // A TSO super-segment holds the channel for as long as the
+                // frames it would have been split into, each with its own
+                // headers and separated by an interframe gap.
+                //
+                uint32_t framingSize = EthernetHeader(false).GetSerializedSize() +
+                                       EthernetTrailer().GetSerializedSize();
+                uint32_t frameSize = m_currentPkt->GetSize();
+                tEvent = m_bps.CalculateBytesTxTime(tsoTag.GetWireSize(frameSize, framingSize)) +
+                         m_tInterframeGap * (tsoTag.GetNSegments() - 1);
+            }
             NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << tEvent.As(Time::S));
             Simulator::Schedule(tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
@@ -980,8 +995,35 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
         return false;
     }
 
-    Mac48Address destination = Mac48Address::ConvertFrom(dest);
-    Mac48Address source = Mac48Address::ConvertFrom(src);
+    return DoSend(packet,
+                  Mac48Address::ConvertFrom(src),
+                  Mac48Address::ConvertFrom(dest),
+                  protocolNumber);
+}
+
+bool
+CsmaNetDevice::CheckSendBatch()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(IsLinkUp());
+    return IsSendEnabled();
+}
+
+void
+CsmaNetDevice::DoSendBatchItem(const BatchItem& item)
+{
+    NS_LOG_FUNCTION(this << item.packet << item.dest << item.protocolNumber);
+    DoSend(item.packet, m_address, Mac48Address::ConvertFrom(item.dest), item.protocolNumber);
+}
+
+bool
+CsmaNetDevice::DoSend(Ptr<Packet> packet,
+                      Mac48Address source,
+                      Mac48Address destination,
+                      uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(packet << source << destination << protocolNumber);
+
     AddHeader(packet, source, destination, protocolNumber);
 
     m_macTxTrace(packet);
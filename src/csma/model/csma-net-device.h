@@ -349,6 +349,9 @@ class CsmaNetDevice : public NetDevice
      */
     void DoDispose() override;
 
+    bool CheckSendBatch() override;
+    void DoSendBatchItem(const BatchItem& item) override;
+
     /**
      * Adds the necessary headers and trailers to a packet of data in order to
      * respect the packet type
@@ -384,6 +387,21 @@ class CsmaNetDevice : public NetDevice
      */
     void Init(bool sendEnable, bool receiveEnable);
 
+    /**
+     * Add the headers to a packet, place it on the transmit queue and start
+     * its transmission if the device is idle. Sending must be enabled.
+     *
+     * \param packet packet to send
+     * \param source MAC source address from which packet should be sent
+     * \param destination MAC destination address to which packet should be sent
+     * \param protocolNumber protocol number
+     * \return true if the packet was enqueued, false if it was dropped
+     */
+    bool DoSend(Ptr<Packet> packet,
+                Mac48Address source,
+                Mac48Address destination,
+                uint16_t protocolNumber);
+
     /**
      * Start Sending a Packet Down the Wire.
      *
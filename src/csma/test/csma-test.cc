@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/csma-channel.h"
+#include "ns3/csma-net-device.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/node.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Test the transmission time of a TSO super-segment over a CSMA link
+ *
+ * A plain packet and a TSO super-segment of the same size are sent in turn.
+ * The super-segment must be received whole, after the time the frames it
+ * stands for would have taken on the wire, interframe gaps included.
+ */
+class CsmaTsoTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    CsmaTsoTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send one packet to the device specified
+     *
+     * \param device NetDevice to send to.
+     * \param size Size of the packet.
+     * \param tso Whether to tag the packet as a TSO super-segment.
+     */
+    void SendOnePacket(Ptr<CsmaNetDevice> device, uint32_t size, bool tso);
+    /**
+     * \brief Callback function which records the packet size and reception time
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    std::vector<uint32_t> m_rxSizes; //!< sizes of the received packets
+    std::vector<Time> m_rxTimes;     //!< reception times of the received packets
+};
+
+CsmaTsoTest::CsmaTsoTest()
+    : TestCase("Csma TSO super-segment timing")
+{
+}
+
+void
+CsmaTsoTest::SendOnePacket(Ptr<CsmaNetDevice> device, uint32_t size, bool tso)
+{
+    Ptr<Packet> p = Create<Packet>(size);
+    if (tso)
+    {
+        // 40 bytes of headers and 4 segments of 1000 bytes
+        p->AddPacketTag(SegmentationOffloadTag(1000, 40, 4));
+    }
+    device->Send(p, device->GetBroadcast(), 0x800);
+}
+
+bool
+CsmaTsoTest::RxPacket(Ptr<NetDevice> dev,
+                      Ptr<const Packet> pkt,
+                      uint16_t mode,
+                      const Address& sender)
+{
+    m_rxSizes.push_back(pkt->GetSize());
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+CsmaTsoTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<CsmaNetDevice> devA = CreateObject<CsmaNetDevice>();
+    Ptr<CsmaNetDevice> devB = CreateObject<CsmaNetDevice>();
+    Ptr<CsmaChannel> channel = CreateObject<CsmaChannel>();
+
+    DataRate dataRate("8Mbps");
+    channel->SetAttribute("DataRate", DataRateValue(dataRate));
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    devB->SetReceiveCallback(MakeCallback(&CsmaTsoTest::RxPacket, this));
+
+    uint32_t size = 40 + 4 * 1000;
+    // 14 bytes of Ethernet header and 4 bytes of trailer per frame
+    uint32_t framingSize = 18;
+    Time interframeGap = dataRate.CalculateBytesTxTime(96 / 8);
+    Simulator::Schedule(Seconds(1.0), &CsmaTsoTest::SendOnePacket, this, devA, size, false);
+    Simulator::Schedule(Seconds(2.0), &CsmaTsoTest::SendOnePacket, this, devA, size, true);
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes.size(), 2, "Both packets should have been received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0], size, "The plain packet should be received whole");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], size, "The super-segment should be received whole");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0],
+                          Seconds(1.0) + dataRate.CalculateBytesTxTime(size + framingSize),
+                          "The plain packet is sent as a single frame");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1],
+                          Seconds(2.0) +
+                              dataRate.CalculateBytesTxTime(size + framingSize +
+                                                            3 * (40 + framingSize)) +
+                              interframeGap * 3,
+                          "The super-segment takes the time of its 4 frames and 3 gaps");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \brief TestSuite for Csma module
+ */
+class CsmaTestSuite : public TestSuite
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    CsmaTestSuite();
+};
+
+CsmaTestSuite::CsmaTestSuite()
+    : TestSuite("devices-csma", UNIT)
+{
+    AddTestCase(new CsmaTsoTest, TestCase::QUICK);
+}
+
+static CsmaTestSuite g_csmaTestSuite; //!< The testsuite
@@ -31,7 +31,7 @@
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (GetObject<Node>())                                                                         \
     {                                                                                              \
-        std::clog << "[node " << GetObject<Node>()->GetId() << "] ";                               \
+        LogGetContextStream() << "[node " << GetObject<Node>()->GetId() << "] ";                   \
     }
 
 #include "dsr-routing.h"
@@ -31,6 +31,17 @@ FlowClassifier::~FlowClassifier()
 {
 }
 
+void
+FlowClassifier::ExpireFlows(std::ostream& os, uint16_t indent, const std::vector<FlowId>& flowIds)
+{
+}
+
+std::vector<FlowId>
+FlowClassifier::GetIdleFlows(Time idleTimeout) const
+{
+    return std::vector<FlowId>();
+}
+
 FlowId
 FlowClassifier::GetNewFlowId()
 {
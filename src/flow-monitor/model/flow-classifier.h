@@ -20,9 +20,11 @@
 #ifndef FLOW_CLASSIFIER_H
 #define FLOW_CLASSIFIER_H
 
+#include "ns3/nstime.h"
 #include "ns3/simple-ref-count.h"
 
 #include <ostream>
+#include <vector>
 
 namespace ns3
 {
@@ -68,6 +70,27 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// \param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Serializes flows to an std::ostream in XML format, like
+    /// SerializeToXmlStream, and forgets them.  FlowMonitor calls it for
+    /// the flows which have been idle for its FlowIdleTimeout, so that the
+    /// memory used by the classifier stays bounded.  A packet of a flow
+    /// forgotten is classified into a new flow.  The default implementation
+    /// keeps the flows, which are left to SerializeToXmlStream.
+    /// \param os the output stream
+    /// \param indent number of spaces to use as base indentation level
+    /// \param flowIds the identifiers of the flows
+    virtual void ExpireFlows(std::ostream& os,
+                             uint16_t indent,
+                             const std::vector<FlowId>& flowIds);
+
+    /// Returns the flows which have not classified a packet for a time.
+    /// FlowMonitor expires them when its per-flow statistics are replaced
+    /// by sketches, as it then has no statistics telling which flows are
+    /// idle.  The default implementation returns no flow.
+    /// \param idleTimeout the time without packet
+    /// \returns the identifiers of the idle flows
+    virtual std::vector<FlowId> GetIdleFlows(Time idleTimeout) const;
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// \returns a new FlowId
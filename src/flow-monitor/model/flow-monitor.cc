@@ -19,9 +19,12 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <fstream>
 #include <sstream>
@@ -80,7 +83,64 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("StreamFileName",
+                          "The file to which the flow statistics are streamed (none if empty).",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_streamFileName),
+                          MakeStringChecker())
+            .AddAttribute("FlowIdleTimeout",
+                          "If not zero, the flows without packet in flight which have not "
+                          "sent nor received a packet for this time are streamed and "
+                          "forgotten (with SketchStats, the flows which have not sent a "
+                          "packet for this time are forgotten by the classifiers).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_flowIdleTimeout),
+                          MakeTimeChecker())
+            .AddAttribute("ExportInterval",
+                          "If not zero, the statistics of all the flows are streamed and "
+                          "reset at this interval.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportInterval),
+                          MakeTimeChecker())
+            .AddAttribute("StreamHistograms",
+                          "Whether the histograms of the flows are streamed.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_streamHistograms),
+                          MakeBooleanChecker())
+            .AddAttribute("PacketSampling",
+                          "Only one packet out of this number is monitored, chosen by a hash "
+                          "of its flow and packet ids.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_packetSampling),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchStats",
+                          "Whether the per-flow statistics are replaced by fixed-size "
+                          "sketches (see FlowMonitor::GetFlowSketch).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_sketchStats),
+                          MakeBooleanChecker())
+            .AddAttribute("SketchWidth",
+                          "The number of counters of each row of the count-min sketches.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchWidth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchDepth",
+                          "The number of rows of the count-min sketches.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchDepth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchPrecision",
+                          "The base 2 logarithm of the number of registers of the "
+                          "HyperLogLog counter of the flows.",
+                          UintegerValue(12),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchPrecision),
+                          MakeUintegerChecker<uint8_t>(4, 18))
+            .AddAttribute("SketchTopFlows",
+                          "The number of flows with the most transmitted bytes to keep.",
+                          UintegerValue(32),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchTopFlows),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -100,8 +160,10 @@ void
 FlowMonitor::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    CloseStream();
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_closeStreamEvent);
     for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
          iter != m_classifiers.end();
          iter++)
@@ -146,6 +208,27 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+inline bool
+FlowMonitor::IsSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    if (m_packetSampling <= 1)
+    {
+        return true;
+    }
+    uint64_t key = (static_cast<uint64_t>(flowId) << 32) | packetId;
+    return FlowSketchHash(key, 0) % m_packetSampling == 0;
+}
+
+std::string
+FlowMonitor::GetPacketSamplingXml() const
+{
+    if (m_packetSampling <= 1)
+    {
+        return "";
+    }
+    return " packetSampling=\"" + std::to_string(m_packetSampling) + "\"";
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -158,8 +241,23 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    if (m_sketch)
+    {
+        m_sketch->AddTx(flowId, packetSize);
+        return;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    std::pair<TrackedPacketMap::iterator, bool> inserted =
+        m_trackedPackets.emplace(std::make_pair(flowId, packetId), TrackedPacket());
+    if (inserted.second)
+    {
+        m_packetsInFlight[flowId]++;
+    }
+    TrackedPacket& tracked = inserted.first->second;
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
@@ -190,6 +288,14 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    if (m_sketch)
+    {
+        return;
+    }
     std::pair<FlowId, FlowPacketId> key(flowId, packetId);
     TrackedPacketMap::iterator tracked = m_trackedPackets.find(key);
     if (tracked == m_trackedPackets.end())
@@ -218,6 +324,15 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    if (m_sketch)
+    {
+        m_sketch->AddRx(flowId, packetSize);
+        return;
+    }
     TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
     if (tracked == m_trackedPackets.end())
     {
@@ -271,7 +386,7 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    UntrackPacket(tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -287,6 +402,15 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    if (m_sketch)
+    {
+        m_sketch->AddDrop(flowId, packetSize);
+        return;
+    }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
@@ -309,7 +433,7 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        UntrackPacket(tracked);
     }
 }
 
@@ -330,13 +454,12 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     {
         if (now - iter->second.lastSeenTime >= maxDelay)
         {
-            // packet is considered lost, add it to the loss statistics
-            FlowStatsContainerI flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+            // packet is considered lost, add it to the loss statistics (the
+            // stats of the flow may have been reset by StreamWindow)
+            GetStatsForFlow(iter->first.first).lostPackets++;
 
             // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+            iter = UntrackPacket(iter);
         }
         else
         {
@@ -345,6 +468,18 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     }
 }
 
+FlowMonitor::TrackedPacketMap::iterator
+FlowMonitor::UntrackPacket(TrackedPacketMap::iterator tracked)
+{
+    std::unordered_map<FlowId, uint32_t>::iterator inFlight =
+        m_packetsInFlight.find(tracked->first.first);
+    if (--inFlight->second == 0)
+    {
+        m_packetsInFlight.erase(inFlight);
+    }
+    return m_trackedPackets.erase(tracked);
+}
+
 void
 FlowMonitor::CheckForLostPackets()
 {
@@ -355,6 +490,14 @@ void
 FlowMonitor::PeriodicCheckForLostPackets()
 {
     CheckForLostPackets();
+    if (m_stream.is_open() && m_exportInterval.IsZero() && m_flowIdleTimeout.IsStrictlyPositive())
+    {
+        StreamIdleFlows();
+    }
+    if (m_sketch && m_flowIdleTimeout.IsStrictlyPositive())
+    {
+        ExpireIdleClassifierFlows();
+    }
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
@@ -362,6 +505,14 @@ void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
+    if (m_sketchStats)
+    {
+        m_sketch = Create<FlowSketch>(m_sketchWidth,
+                                      m_sketchDepth,
+                                      m_sketchPrecision,
+                                      m_sketchTopFlows,
+                                      m_packetSampling);
+    }
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
@@ -371,6 +522,12 @@ FlowMonitor::AddProbe(Ptr<FlowProbe> probe)
     m_flowProbes.push_back(probe);
 }
 
+Ptr<FlowSketch>
+FlowMonitor::GetFlowSketch() const
+{
+    return m_sketch;
+}
+
 const FlowMonitor::FlowProbeContainer&
 FlowMonitor::GetAllProbes() const
 {
@@ -410,6 +567,10 @@ FlowMonitor::StartRightNow()
         return;
     }
     m_enabled = true;
+    if (!m_streamFileName.empty() && !m_stream.is_open())
+    {
+        OpenStream();
+    }
 }
 
 void
@@ -431,6 +592,53 @@ FlowMonitor::AddFlowClassifier(Ptr<FlowClassifier> classifier)
     m_classifiers.push_back(classifier);
 }
 
+void
+FlowMonitor::SerializeFlowToXmlStream(std::ostream& os,
+                                      uint16_t indent,
+                                      FlowId flowId,
+                                      const FlowStats& stats,
+                                      bool enableHistograms) const
+{
+    os << std::string(indent, ' ');
+#define ATTRIB(name) << " " #name "=\"" << stats.name << "\""
+#define ATTRIB_TIME(name) << " " #name "=\"" << stats.name.As(Time::NS) << "\""
+    os << "<Flow flowId=\"" << flowId
+       << "\"" ATTRIB_TIME(timeFirstTxPacket) ATTRIB_TIME(timeFirstRxPacket)
+              ATTRIB_TIME(timeLastTxPacket) ATTRIB_TIME(timeLastRxPacket) ATTRIB_TIME(delaySum)
+                  ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB(txBytes) ATTRIB(rxBytes)
+                      ATTRIB(txPackets) ATTRIB(rxPackets) ATTRIB(lostPackets)
+                          ATTRIB(timesForwarded)
+       << ">\n";
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    indent += 2;
+    for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+           << " number=\"" << stats.packetsDropped[reasonCode] << "\" />\n";
+    }
+    for (uint32_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+           << " bytes=\"" << stats.bytesDropped[reasonCode] << "\" />\n";
+    }
+    if (enableHistograms)
+    {
+        stats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+        stats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+        stats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
+        stats.flowInterruptionsHistogram.SerializeToXmlStream(os,
+                                                              indent,
+                                                              "flowInterruptionsHistogram");
+    }
+    indent -= 2;
+
+    os << std::string(indent, ' ') << "</Flow>\n";
+}
+
 void
 FlowMonitor::SerializeToXmlStream(std::ostream& os,
                                   uint16_t indent,
@@ -442,56 +650,20 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
 
     os << std::string(indent, ' ') << "<FlowMonitor>\n";
     indent += 2;
-    os << std::string(indent, ' ') << "<FlowStats>\n";
+    os << std::string(indent, ' ') << "<FlowStats" << GetPacketSamplingXml() << ">\n";
     indent += 2;
     for (FlowStatsContainerCI flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++)
     {
-        os << std::string(indent, ' ');
-#define ATTRIB(name) << " " #name "=\"" << flowI->second.name << "\""
-#define ATTRIB_TIME(name) << " " #name "=\"" << flowI->second.name.As(Time::NS) << "\""
-        os << "<Flow flowId=\"" << flowI->first
-           << "\"" ATTRIB_TIME(timeFirstTxPacket) ATTRIB_TIME(timeFirstRxPacket)
-                  ATTRIB_TIME(timeLastTxPacket) ATTRIB_TIME(timeLastRxPacket) ATTRIB_TIME(delaySum)
-                      ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB(txBytes) ATTRIB(rxBytes)
-                          ATTRIB(txPackets) ATTRIB(rxPackets) ATTRIB(lostPackets)
-                              ATTRIB(timesForwarded)
-           << ">\n";
-#undef ATTRIB_TIME
-#undef ATTRIB
-
-        indent += 2;
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.packetsDropped.size();
-             reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-               << " number=\"" << flowI->second.packetsDropped[reasonCode] << "\" />\n";
-        }
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.bytesDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-               << " bytes=\"" << flowI->second.bytesDropped[reasonCode] << "\" />\n";
-        }
-        if (enableHistograms)
-        {
-            flowI->second.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
-            flowI->second.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
-            flowI->second.packetSizeHistogram.SerializeToXmlStream(os,
-                                                                   indent,
-                                                                   "packetSizeHistogram");
-            flowI->second.flowInterruptionsHistogram.SerializeToXmlStream(
-                os,
-                indent,
-                "flowInterruptionsHistogram");
-        }
-        indent -= 2;
-
-        os << std::string(indent, ' ') << "</Flow>\n";
+        SerializeFlowToXmlStream(os, indent, flowI->first, flowI->second, enableHistograms);
     }
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_sketch)
+    {
+        m_sketch->SerializeToXmlStream(os, indent);
+    }
+
     for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
          iter != m_classifiers.end();
          iter++)
@@ -534,4 +706,152 @@ FlowMonitor::SerializeToXmlFile(std::string fileName, bool enableHistograms, boo
     os.close();
 }
 
+void
+FlowMonitor::OpenStream()
+{
+    NS_LOG_FUNCTION(this);
+    m_stream.open(m_streamFileName, std::ios::out | std::ios::binary);
+    if (!m_stream.is_open())
+    {
+        NS_LOG_ERROR("Unable to open " << m_streamFileName);
+        return;
+    }
+    m_stream << "<?xml version=\"1.0\" ?>\n";
+    m_stream << "<FlowMonitor>\n";
+    if (m_exportInterval.IsStrictlyPositive())
+    {
+        m_windowStart = Simulator::Now();
+        m_exportEvent =
+            Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicStreamWindow, this);
+    }
+    Simulator::Cancel(m_closeStreamEvent);
+    m_closeStreamEvent = Simulator::ScheduleDestroy(&FlowMonitor::CloseStream, this);
+}
+
+void
+FlowMonitor::StreamIdleFlows()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    std::vector<FlowId> idleFlows;
+    for (FlowStatsContainerI flowI = m_flowStats.begin(); flowI != m_flowStats.end();)
+    {
+        const FlowStats& stats = flowI->second;
+        Time lastActivity = std::max(stats.timeLastTxPacket, stats.timeLastRxPacket);
+        if (now - lastActivity >= m_flowIdleTimeout &&
+            m_packetsInFlight.find(flowI->first) == m_packetsInFlight.end())
+        {
+            NS_LOG_DEBUG("Streaming idle flow " << flowI->first);
+            if (idleFlows.empty())
+            {
+                m_stream << "  <FlowStats" << GetPacketSamplingXml() << ">\n";
+            }
+            SerializeFlowToXmlStream(m_stream, 4, flowI->first, stats, m_streamHistograms);
+            idleFlows.push_back(flowI->first);
+            m_flowStats.erase(flowI++);
+        }
+        else
+        {
+            flowI++;
+        }
+    }
+    if (idleFlows.empty())
+    {
+        return;
+    }
+    m_stream << "  </FlowStats>\n";
+
+    for (uint32_t i = 0; i < m_flowProbes.size(); i++)
+    {
+        m_flowProbes[i]->ExpireFlows(idleFlows);
+    }
+    // the classifiers write and forget the idle flows too
+    for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
+         iter != m_classifiers.end();
+         iter++)
+    {
+        (*iter)->ExpireFlows(m_stream, 2, idleFlows);
+    }
+}
+
+void
+FlowMonitor::ExpireIdleClassifierFlows()
+{
+    NS_LOG_FUNCTION(this);
+    // the flows are written to the stream if it is open, else only forgotten
+    std::ostream discard(nullptr);
+    std::ostream& os = m_stream.is_open() ? static_cast<std::ostream&>(m_stream) : discard;
+    for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
+         iter != m_classifiers.end();
+         iter++)
+    {
+        (*iter)->ExpireFlows(os, 2, (*iter)->GetIdleFlows(m_flowIdleTimeout));
+    }
+}
+
+void
+FlowMonitor::StreamWindow()
+{
+    NS_LOG_FUNCTION(this);
+    m_stream << "  <FlowStats startTime=\"" << m_windowStart.As(Time::NS) << "\" stopTime=\""
+             << Simulator::Now().As(Time::NS) << "\"" << GetPacketSamplingXml() << ">\n";
+    for (FlowStatsContainerCI flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++)
+    {
+        SerializeFlowToXmlStream(m_stream, 4, flowI->first, flowI->second, m_streamHistograms);
+    }
+    m_stream << "  </FlowStats>\n";
+    m_flowStats.clear();
+    for (uint32_t i = 0; i < m_flowProbes.size(); i++)
+    {
+        m_flowProbes[i]->ResetStats();
+    }
+    m_windowStart = Simulator::Now();
+}
+
+void
+FlowMonitor::PeriodicStreamWindow()
+{
+    NS_LOG_FUNCTION(this);
+    CheckForLostPackets();
+    StreamWindow();
+    m_exportEvent = Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicStreamWindow, this);
+}
+
+void
+FlowMonitor::CloseStream()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_stream.is_open())
+    {
+        return;
+    }
+    Simulator::Cancel(m_exportEvent);
+    CheckForLostPackets();
+    if (m_exportInterval.IsStrictlyPositive())
+    {
+        StreamWindow();
+    }
+    else
+    {
+        m_stream << "  <FlowStats" << GetPacketSamplingXml() << ">\n";
+        for (FlowStatsContainerCI flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++)
+        {
+            SerializeFlowToXmlStream(m_stream,
+                                     4,
+                                     flowI->first,
+                                     flowI->second,
+                                     m_streamHistograms);
+        }
+        m_stream << "  </FlowStats>\n";
+    }
+    for (std::list<Ptr<FlowClassifier>>::iterator iter = m_classifiers.begin();
+         iter != m_classifiers.end();
+         iter++)
+    {
+        (*iter)->SerializeToXmlStream(m_stream, 2);
+    }
+    m_stream << "</FlowMonitor>\n";
+    m_stream.close();
+}
+
 } // namespace ns3
@@ -20,6 +20,8 @@
 #ifndef FLOW_MONITOR_H
 #define FLOW_MONITOR_H
 
+#include "flow-sketch.h"
+
 #include "ns3/event-id.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/flow-probe.h"
@@ -28,7 +30,9 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -46,6 +50,44 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * By default, the statistics of all the flows are kept until the end of the
+ * simulation.  With many short flows, they can instead be streamed to the
+ * file set by the StreamFileName attribute, in the format of
+ * SerializeToXmlFile (without the per-probe statistics):
+ *
+ * - if FlowIdleTimeout is not zero, the statistics of a flow are written and
+ *   forgotten once the flow has no packet in flight and has not sent nor
+ *   received a packet for this time.  The flows found idle together are
+ *   written in their own FlowStats element, followed by their entries in the
+ *   flow classifiers.  The probes and the classifiers forget them too (see
+ *   FlowProbe::ExpireFlows and FlowClassifier::ExpireFlows);
+ * - if ExportInterval is not zero, the statistics of all the flows are
+ *   written and reset at this interval, each interval in its own FlowStats
+ *   element with startTime and stopTime attributes.  The statistics of the
+ *   probes are reset too.
+ *
+ * The remaining flows and the flow classifiers are written when the stream is
+ * closed, by CloseStream or when the simulation is destroyed.  The flows which
+ * have been written to the stream are not part of GetFlowStats and of the
+ * output of SerializeToXmlStream any more.
+ *
+ * For large topologies, the memory and the time used by the monitor can be
+ * bounded further:
+ *
+ * - with PacketSampling set to N, only one packet out of N is monitored, chosen
+ *   by a hash of its flow and packet ids so that all the probes monitor the
+ *   same packets; the packet and byte counts must then be multiplied by N,
+ *   which the XML output records in the packetSampling attribute of the
+ *   FlowStats and FlowSketch elements;
+ * - with SketchStats, the per-flow statistics and the tracking of the packets
+ *   in flight are replaced by a FlowSketch of fixed size, which estimates the
+ *   transmitted, received and dropped bytes of each flow, the number of flows
+ *   and the flows with the most transmitted bytes, with known error bounds
+ *   (see GetFlowSketch).  The delays, the jitter and the per-probe statistics
+ *   are not available in this mode.  If FlowIdleTimeout is not zero, the flow
+ *   classifiers forget the flows which have not sent a packet for this time,
+ *   and write them to the stream if it is open, so that their memory is
+ *   bounded too.
  */
 class FlowMonitor : public Object
 {
@@ -242,10 +284,17 @@ class FlowMonitor : public Object
     /// Retrieve all collected the flow statistics.  Note, if the
     /// FlowMonitor has not stopped monitoring yet, you should call
     /// CheckForLostPackets() to make sure all possibly lost packets are
-    /// accounted for.
+    /// accounted for.  If PacketSampling is N > 1, the statistics are those
+    /// of the packets sampled: the packet and byte counts must be multiplied
+    /// by N.
     /// \returns the flows statistics
     const FlowStatsContainer& GetFlowStats() const;
 
+    /// Get the estimates of the flow statistics when the SketchStats attribute
+    /// is true
+    /// \returns the sketch of the flow statistics, or 0 if SketchStats is false
+    Ptr<FlowSketch> GetFlowSketch() const;
+
     /// Get a list of all FlowProbe's associated with this FlowMonitor
     /// \returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
@@ -273,6 +322,11 @@ class FlowMonitor : public Object
     /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /// Write the remaining flows and the flow classifiers to the stream file
+    /// set by the StreamFileName attribute, and close it.  This is done
+    /// automatically when the simulation is destroyed.
+    void CloseStream();
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -289,11 +343,27 @@ class FlowMonitor : public Object
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
 
+    /// Hash function of the (FlowId,PacketId) pairs
+    struct TrackedPacketKeyHash
+    {
+        /**
+         * \param key the (FlowId,PacketId) pair
+         * \return the hash of the pair
+         */
+        std::size_t operator()(const std::pair<FlowId, FlowPacketId>& key) const
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(key.first) << 32) | key.second);
+        }
+    };
+
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef std::unordered_map<std::pair<FlowId, FlowPacketId>, TrackedPacket, TrackedPacketKeyHash>
+        TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    /// FlowId --> number of tracked packets, for the flows with tracked packets
+    std::unordered_map<FlowId, uint32_t> m_packetsInFlight;
+    Time m_maxPerHopDelay;           //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -307,6 +377,23 @@ class FlowMonitor : public Object
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
 
+    std::string m_streamFileName; //!< File to which the flow stats are streamed
+    Time m_flowIdleTimeout;       //!< Idle time after which a flow is streamed
+    Time m_exportInterval;        //!< Interval at which all the flows are streamed
+    bool m_streamHistograms;      //!< Stream the histograms of the flows
+    std::ofstream m_stream;       //!< Stream of the flow stats
+    Time m_windowStart;           //!< Start of the current export interval
+    EventId m_exportEvent;        //!< Export event
+    EventId m_closeStreamEvent;   //!< Event closing the stream when the simulation is destroyed
+
+    uint32_t m_packetSampling; //!< One packet out of this number is monitored
+    bool m_sketchStats;        //!< Replace the per-flow stats with a FlowSketch
+    uint32_t m_sketchWidth;    //!< Width of the count-min sketches
+    uint32_t m_sketchDepth;    //!< Depth of the count-min sketches
+    uint8_t m_sketchPrecision; //!< Precision of the HyperLogLog counter
+    uint32_t m_sketchTopFlows; //!< Number of heavy hitters
+    Ptr<FlowSketch> m_sketch;  //!< Sketch of the flow stats, if enabled
+
     /// Get the stats for a given flow
     /// \param flowId the Flow identification
     /// \returns the stats of the flow
@@ -314,6 +401,54 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Stop tracking a packet
+    /// \param tracked the tracked packet
+    /// \returns the tracked packet following it
+    TrackedPacketMap::iterator UntrackPacket(TrackedPacketMap::iterator tracked);
+
+    /// Check whether a packet is monitored, according to PacketSampling
+    /// \param flowId the Flow identification
+    /// \param packetId the Packet identification
+    /// \returns true if the packet is monitored
+    bool IsSampled(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Get the XML attribute labelling the statistics as those of the
+    /// packets sampled
+    /// \returns the packetSampling attribute if PacketSampling is more than
+    /// one, an empty string otherwise
+    std::string GetPacketSamplingXml() const;
+
+    /// Serializes the statistics of a flow to an std::ostream in XML format
+    /// \param os the output stream
+    /// \param indent number of spaces to use as indentation level
+    /// \param flowId the Flow identification
+    /// \param stats the stats of the flow
+    /// \param enableHistograms if true, include also the histograms in the output
+    void SerializeFlowToXmlStream(std::ostream& os,
+                                  uint16_t indent,
+                                  FlowId flowId,
+                                  const FlowStats& stats,
+                                  bool enableHistograms) const;
+
+    /// Open the stream file set by the StreamFileName attribute
+    void OpenStream();
+
+    /// Write the flows without packet in flight which have been idle for
+    /// FlowIdleTimeout to the stream, and forget them
+    void StreamIdleFlows();
+
+    /// Make the flow classifiers write and forget the flows which have not
+    /// sent a packet for FlowIdleTimeout, when the per-flow statistics are
+    /// replaced by sketches
+    void ExpireIdleClassifierFlows();
+
+    /// Write all the flows to the stream as the statistics of the current
+    /// export interval, and reset them
+    void StreamWindow();
+
+    /// Periodic function to stream the flows every ExportInterval
+    void PeriodicStreamWindow();
 };
 
 } // namespace ns3
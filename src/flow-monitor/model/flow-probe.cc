@@ -75,6 +75,21 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
     flow.bytesDropped[reasonCode] += packetSize;
 }
 
+void
+FlowProbe::ExpireFlows(const std::vector<FlowId>& flowIds)
+{
+    for (FlowId flowId : flowIds)
+    {
+        m_stats.erase(flowId);
+    }
+}
+
+void
+FlowProbe::ResetStats()
+{
+    m_stats.clear();
+}
+
 FlowProbe::Stats
 FlowProbe::GetStats() const
 {
@@ -92,6 +92,13 @@ class FlowProbe : public Object
     /// \param reasonCode reason code for the drop
     void AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode);
 
+    /// Forget the statistics of some flows, e.g., those of the idle flows
+    /// streamed by the FlowMonitor
+    /// \param flowIds the flow identifiers
+    void ExpireFlows(const std::vector<FlowId>& flowIds);
+    /// Forget the statistics of all the flows
+    void ResetStats();
+
     /// Get the partial flow statistics stored in this probe.  With this
     /// information you can, for example, find out what is the delay
     /// from the first probe to this one.
@@ -0,0 +1,373 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "flow-sketch.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace ns3
+{
+
+uint64_t
+FlowSketchHash(uint64_t key, uint64_t seed)
+{
+    // finalizer of the SplitMix64 generator
+    uint64_t z = key + 0x9e3779b97f4a7c15ULL * (seed + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+CountMinSketch::CountMinSketch(uint32_t width, uint32_t depth)
+    : m_width(width),
+      m_depth(depth),
+      m_total(0),
+      m_counters(static_cast<std::size_t>(width) * depth, 0)
+{
+    NS_ABORT_MSG_IF(width == 0 || depth == 0, "A count-min sketch cannot be empty");
+}
+
+void
+CountMinSketch::Add(uint64_t key, uint64_t count)
+{
+    m_total += count;
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        std::size_t column = FlowSketchHash(key, row) % m_width;
+        m_counters[static_cast<std::size_t>(row) * m_width + column] += count;
+    }
+}
+
+uint64_t
+CountMinSketch::Estimate(uint64_t key) const
+{
+    uint64_t estimate = m_total;
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        std::size_t column = FlowSketchHash(key, row) % m_width;
+        estimate = std::min(estimate, m_counters[static_cast<std::size_t>(row) * m_width + column]);
+    }
+    return estimate;
+}
+
+uint64_t
+CountMinSketch::GetTotal() const
+{
+    return m_total;
+}
+
+double
+CountMinSketch::GetEpsilon() const
+{
+    return std::exp(1.0) / m_width;
+}
+
+double
+CountMinSketch::GetDelta() const
+{
+    return std::exp(-static_cast<double>(m_depth));
+}
+
+uint64_t
+CountMinSketch::GetErrorBound() const
+{
+    return static_cast<uint64_t>(std::ceil(GetEpsilon() * m_total));
+}
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+    : m_precision(precision),
+      m_registers(1 << precision, 0)
+{
+    NS_ABORT_MSG_IF(precision < 4 || precision > 18,
+                    "The precision of HyperLogLog must be between 4 and 18");
+}
+
+void
+HyperLogLog::Add(uint64_t key)
+{
+    // the first bits of the hash select the register, the number of leading
+    // zeros of the others is the observed rank
+    uint64_t hash = FlowSketchHash(key, 0x484c4c);
+    uint32_t index = hash >> (64 - m_precision);
+    uint64_t rest = hash << m_precision;
+    uint8_t rank = 1;
+    while (rank <= 64 - m_precision && !(rest & (1ULL << 63)))
+    {
+        rank++;
+        rest <<= 1;
+    }
+    m_registers[index] = std::max(m_registers[index], rank);
+}
+
+double
+HyperLogLog::Estimate() const
+{
+    double m = m_registers.size();
+    double alpha;
+    switch (m_registers.size())
+    {
+    case 16:
+        alpha = 0.673;
+        break;
+    case 32:
+        alpha = 0.697;
+        break;
+    case 64:
+        alpha = 0.709;
+        break;
+    default:
+        alpha = 0.7213 / (1 + 1.079 / m);
+    }
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint8_t reg : m_registers)
+    {
+        sum += std::ldexp(1.0, -reg);
+        zeros += (reg == 0);
+    }
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+        // linear counting for the small cardinalities
+        estimate = m * std::log(m / zeros);
+    }
+    return estimate;
+}
+
+double
+HyperLogLog::GetRelativeStandardError() const
+{
+    return 1.04 / std::sqrt(static_cast<double>(m_registers.size()));
+}
+
+SpaceSaving::SpaceSaving(uint32_t k)
+    : m_k(k),
+      m_total(0)
+{
+    NS_ABORT_MSG_IF(k == 0, "Space-Saving must keep at least one key");
+    m_heap.reserve(k);
+}
+
+void
+SpaceSaving::Add(uint64_t key, uint64_t count)
+{
+    m_total += count;
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_heap[it->second].count += count;
+        SiftDown(it->second);
+    }
+    else if (m_heap.size() < m_k)
+    {
+        m_heap.push_back({key, count, 0});
+        m_index[key] = m_heap.size() - 1;
+        SiftUp(m_heap.size() - 1);
+    }
+    else
+    {
+        // replace the key with the smallest count
+        Entry& min = m_heap.front();
+        m_index.erase(min.key);
+        min.key = key;
+        min.error = min.count;
+        min.count += count;
+        m_index[key] = 0;
+        SiftDown(0);
+    }
+}
+
+void
+SpaceSaving::SiftDown(uint32_t i)
+{
+    while (true)
+    {
+        uint32_t smallest = i;
+        for (uint32_t child = 2 * i + 1; child <= 2 * i + 2 && child < m_heap.size(); child++)
+        {
+            if (m_heap[child].count < m_heap[smallest].count)
+            {
+                smallest = child;
+            }
+        }
+        if (smallest == i)
+        {
+            return;
+        }
+        Swap(i, smallest);
+        i = smallest;
+    }
+}
+
+void
+SpaceSaving::SiftUp(uint32_t i)
+{
+    while (i > 0 && m_heap[i].count < m_heap[(i - 1) / 2].count)
+    {
+        Swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void
+SpaceSaving::Swap(uint32_t i, uint32_t j)
+{
+    std::swap(m_heap[i], m_heap[j]);
+    m_index[m_heap[i].key] = i;
+    m_index[m_heap[j].key] = j;
+}
+
+std::vector<SpaceSaving::Entry>
+SpaceSaving::GetTop() const
+{
+    std::vector<Entry> top(m_heap);
+    std::sort(top.begin(), top.end(), [](const Entry& a, const Entry& b) {
+        return a.count > b.count || (a.count == b.count && a.key < b.key);
+    });
+    return top;
+}
+
+uint64_t
+SpaceSaving::GetTotal() const
+{
+    return m_total;
+}
+
+uint64_t
+SpaceSaving::GetErrorBound() const
+{
+    return m_heap.size() < m_k ? 0 : m_heap.front().count;
+}
+
+FlowSketch::FlowSketch(uint32_t width,
+                       uint32_t depth,
+                       uint8_t precision,
+                       uint32_t heavyHitters,
+                       uint32_t packetSampling)
+    : m_txBytes(width, depth),
+      m_rxBytes(width, depth),
+      m_droppedBytes(width, depth),
+      m_flows(precision),
+      m_heavyHitters(heavyHitters),
+      m_txPackets(0),
+      m_rxPackets(0),
+      m_droppedPackets(0),
+      m_packetSampling(packetSampling)
+{
+}
+
+void
+FlowSketch::AddTx(FlowId flowId, uint32_t packetSize)
+{
+    m_txBytes.Add(flowId, packetSize);
+    m_flows.Add(flowId);
+    m_heavyHitters.Add(flowId, packetSize);
+    m_txPackets++;
+}
+
+void
+FlowSketch::AddRx(FlowId flowId, uint32_t packetSize)
+{
+    m_rxBytes.Add(flowId, packetSize);
+    m_rxPackets++;
+}
+
+void
+FlowSketch::AddDrop(FlowId flowId, uint32_t packetSize)
+{
+    m_droppedBytes.Add(flowId, packetSize);
+    m_droppedPackets++;
+}
+
+const CountMinSketch&
+FlowSketch::GetTxBytes() const
+{
+    return m_txBytes;
+}
+
+const CountMinSketch&
+FlowSketch::GetRxBytes() const
+{
+    return m_rxBytes;
+}
+
+const CountMinSketch&
+FlowSketch::GetDroppedBytes() const
+{
+    return m_droppedBytes;
+}
+
+const HyperLogLog&
+FlowSketch::GetFlows() const
+{
+    return m_flows;
+}
+
+const SpaceSaving&
+FlowSketch::GetHeavyHitters() const
+{
+    return m_heavyHitters;
+}
+
+uint32_t
+FlowSketch::GetPacketSampling() const
+{
+    return m_packetSampling;
+}
+
+void
+FlowSketch::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+{
+    os << std::string(indent, ' ') << "<FlowSketch"
+       << " txPackets=\"" << m_txPackets << "\""
+       << " txBytes=\"" << m_txBytes.GetTotal() << "\""
+       << " rxPackets=\"" << m_rxPackets << "\""
+       << " rxBytes=\"" << m_rxBytes.GetTotal() << "\""
+       << " droppedPackets=\"" << m_droppedPackets << "\""
+       << " droppedBytes=\"" << m_droppedBytes.GetTotal() << "\""
+       << " flows=\"" << m_flows.Estimate() << "\""
+       << " flowsRelativeStandardError=\"" << m_flows.GetRelativeStandardError() << "\""
+       << " bytesEpsilon=\"" << m_txBytes.GetEpsilon() << "\""
+       << " bytesDelta=\"" << m_txBytes.GetDelta() << "\"";
+    if (m_packetSampling > 1)
+    {
+        os << " packetSampling=\"" << m_packetSampling << "\"";
+    }
+    os << ">\n";
+    indent += 2;
+    os << std::string(indent, ' ') << "<HeavyHitters errorBound=\""
+       << m_heavyHitters.GetErrorBound() << "\">\n";
+    indent += 2;
+    for (const auto& entry : m_heavyHitters.GetTop())
+    {
+        os << std::string(indent, ' ') << "<Flow flowId=\"" << entry.key << "\""
+           << " txBytes=\"" << entry.count << "\""
+           << " txBytesError=\"" << entry.error << "\""
+           << " rxBytes=\"" << m_rxBytes.Estimate(entry.key) << "\""
+           << " rxBytesError=\"" << m_rxBytes.GetErrorBound() << "\""
+           << " droppedBytes=\"" << m_droppedBytes.Estimate(entry.key) << "\""
+           << " droppedBytesError=\"" << m_droppedBytes.GetErrorBound() << "\" />\n";
+    }
+    indent -= 2;
+    os << std::string(indent, ' ') << "</HeavyHitters>\n";
+    indent -= 2;
+    os << std::string(indent, ' ') << "</FlowSketch>\n";
+}
+
+} // namespace ns3
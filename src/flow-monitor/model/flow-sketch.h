@@ -0,0 +1,281 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef FLOW_SKETCH_H
+#define FLOW_SKETCH_H
+
+#include "flow-classifier.h"
+
+#include "ns3/simple-ref-count.h"
+
+#include <ostream>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup flow-monitor
+ * \brief Hash a 64 bit key with a seed
+ *
+ * \param key the key
+ * \param seed the seed
+ * \return the hash of the key
+ */
+uint64_t FlowSketchHash(uint64_t key, uint64_t seed);
+
+/**
+ * \ingroup flow-monitor
+ * \brief A count-min sketch
+ *
+ * The sketch estimates the sum of the counts added for a key with a fixed
+ * number of counters (width x depth).  The estimates are never lower than the
+ * exact sums, and, with probability 1 - delta, they exceed them by at most
+ * epsilon times the total count, where epsilon = e / width and
+ * delta = exp (-depth).
+ */
+class CountMinSketch
+{
+  public:
+    /**
+     * Constructor
+     * \param width the number of counters of each row
+     * \param depth the number of rows
+     */
+    CountMinSketch(uint32_t width, uint32_t depth);
+
+    /**
+     * \brief Add a count to a key
+     * \param key the key
+     * \param count the count
+     */
+    void Add(uint64_t key, uint64_t count);
+
+    /**
+     * \param key the key
+     * \return the estimate of the sum of the counts of the key
+     */
+    uint64_t Estimate(uint64_t key) const;
+
+    /// \return the sum of the counts of all the keys
+    uint64_t GetTotal() const;
+
+    /// \return epsilon, the relative error of the estimates
+    double GetEpsilon() const;
+
+    /// \return delta, the probability that an estimate exceeds the error bound
+    double GetDelta() const;
+
+    /// \return the error bound of the estimates, i.e., epsilon times the total count
+    uint64_t GetErrorBound() const;
+
+  private:
+    uint32_t m_width;                 //!< the number of counters of each row
+    uint32_t m_depth;                 //!< the number of rows
+    uint64_t m_total;                 //!< the sum of the counts
+    std::vector<uint64_t> m_counters; //!< the counters, row by row
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief A HyperLogLog counter of distinct keys
+ *
+ * The counter estimates the number of distinct keys added to it with 2^precision
+ * registers of one byte, with a relative standard error of 1.04 / sqrt
+ * (2^precision).
+ */
+class HyperLogLog
+{
+  public:
+    /**
+     * Constructor
+     * \param precision the base 2 logarithm of the number of registers (4 to 18)
+     */
+    HyperLogLog(uint8_t precision);
+
+    /**
+     * \brief Add a key
+     * \param key the key
+     */
+    void Add(uint64_t key);
+
+    /// \return the estimate of the number of distinct keys
+    double Estimate() const;
+
+    /// \return the relative standard error of the estimate
+    double GetRelativeStandardError() const;
+
+  private:
+    uint8_t m_precision;              //!< the base 2 logarithm of the number of registers
+    std::vector<uint8_t> m_registers; //!< the registers
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief A top-k counter of the heavy hitters (Space-Saving algorithm)
+ *
+ * The counter keeps k keys with their counts.  When a key which is not kept is
+ * added, it replaces the key with the smallest count, whose count it inherits.
+ * The count of a kept key thus exceeds the exact sum of its counts by at most
+ * the error recorded with it, itself at most the total count divided by k, and
+ * every key whose sum exceeds the total count divided by k is kept.
+ */
+class SpaceSaving
+{
+  public:
+    /// A kept key
+    struct Entry
+    {
+        uint64_t key;   //!< the key
+        uint64_t count; //!< the estimate of the sum of the counts of the key
+        uint64_t error; //!< the maximum overestimation of the count
+    };
+
+    /**
+     * Constructor
+     * \param k the number of keys to keep
+     */
+    SpaceSaving(uint32_t k);
+
+    /**
+     * \brief Add a count to a key
+     * \param key the key
+     * \param count the count
+     */
+    void Add(uint64_t key, uint64_t count);
+
+    /// \return the kept keys, in decreasing order of count
+    std::vector<Entry> GetTop() const;
+
+    /// \return the sum of the counts of all the keys
+    uint64_t GetTotal() const;
+
+    /// \return the largest possible overestimation of a count
+    uint64_t GetErrorBound() const;
+
+  private:
+    /**
+     * \brief Restore the heap property from an entry whose count increased
+     * \param i the index of the entry in the heap
+     */
+    void SiftDown(uint32_t i);
+
+    /**
+     * \brief Restore the heap property from a new entry
+     * \param i the index of the entry in the heap
+     */
+    void SiftUp(uint32_t i);
+
+    /**
+     * \brief Swap two entries of the heap
+     * \param i the index of the first entry
+     * \param j the index of the second entry
+     */
+    void Swap(uint32_t i, uint32_t j);
+
+    uint32_t m_k;                                   //!< the number of keys to keep
+    uint64_t m_total;                               //!< the sum of the counts
+    std::vector<Entry> m_heap;                      //!< the kept keys, as a min-heap on count
+    std::unordered_map<uint64_t, uint32_t> m_index; //!< the index in the heap of each key
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief Fixed-size statistics of the flows observed by a FlowMonitor
+ *
+ * This class replaces the per-flow statistics of FlowMonitor when its
+ * SketchStats attribute is true: the transmitted and received bytes of each
+ * flow are estimated with count-min sketches, the number of flows with a
+ * HyperLogLog counter and the flows with the most transmitted bytes with a
+ * Space-Saving counter, so that the memory used does not depend on the
+ * number of flows.  If the packets added are sampled, the counts are those of
+ * the packets sampled, and the flows counted are those with a packet sampled.
+ */
+class FlowSketch : public SimpleRefCount<FlowSketch>
+{
+  public:
+    /**
+     * Constructor
+     * \param width the width of the count-min sketches
+     * \param depth the depth of the count-min sketches
+     * \param precision the precision of the HyperLogLog counter
+     * \param heavyHitters the number of heavy hitters to keep
+     * \param packetSampling the packets added are one out of this number
+     */
+    FlowSketch(uint32_t width,
+               uint32_t depth,
+               uint8_t precision,
+               uint32_t heavyHitters,
+               uint32_t packetSampling = 1);
+
+    /**
+     * \brief Record the transmission of a packet
+     * \param flowId the flow of the packet
+     * \param packetSize the size of the packet
+     */
+    void AddTx(FlowId flowId, uint32_t packetSize);
+
+    /**
+     * \brief Record the reception of a packet
+     * \param flowId the flow of the packet
+     * \param packetSize the size of the packet
+     */
+    void AddRx(FlowId flowId, uint32_t packetSize);
+
+    /**
+     * \brief Record the drop of a packet
+     * \param flowId the flow of the packet
+     * \param packetSize the size of the packet
+     */
+    void AddDrop(FlowId flowId, uint32_t packetSize);
+
+    /// \return the sketch of the transmitted bytes of the flows
+    const CountMinSketch& GetTxBytes() const;
+    /// \return the sketch of the received bytes of the flows
+    const CountMinSketch& GetRxBytes() const;
+    /// \return the sketch of the dropped bytes of the flows
+    const CountMinSketch& GetDroppedBytes() const;
+    /// \return the counter of the flows
+    const HyperLogLog& GetFlows() const;
+    /// \return the flows with the most transmitted bytes
+    const SpaceSaving& GetHeavyHitters() const;
+    /// \return the number by which the packet and byte counts must be multiplied,
+    /// as the packets added are one out of this number
+    uint32_t GetPacketSampling() const;
+
+    /**
+     * \brief Serializes the estimates to an std::ostream in XML format
+     * \param os the output stream
+     * \param indent number of spaces to use as base indentation level
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent) const;
+
+  private:
+    CountMinSketch m_txBytes;      //!< transmitted bytes
+    CountMinSketch m_rxBytes;      //!< received bytes
+    CountMinSketch m_droppedBytes; //!< dropped bytes
+    HyperLogLog m_flows;           //!< distinct flows
+    SpaceSaving m_heavyHitters;    //!< flows with the most transmitted bytes
+    uint64_t m_txPackets;          //!< transmitted packets
+    uint64_t m_rxPackets;          //!< received packets
+    uint64_t m_droppedPackets;     //!< dropped packets
+    uint32_t m_packetSampling;     //!< one packet out of this number is added
+};
+
+} // namespace ns3
+
+#endif /* FLOW_SKETCH_H */
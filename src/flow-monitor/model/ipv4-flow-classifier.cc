@@ -20,6 +20,7 @@
 #include "ipv4-flow-classifier.h"
 
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
 
@@ -91,6 +92,15 @@ operator==(const Ipv4FlowClassifier::FiveTuple& t1, const Ipv4FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+std::size_t
+Ipv4FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    std::size_t h = Ipv4AddressHash()(tuple.sourceAddress);
+    h = h * 31 + Ipv4AddressHash()(tuple.destinationAddress);
+    h = h * 31 + ((tuple.protocol << 16) ^ (tuple.sourcePort << 8) ^ tuple.destinationPort);
+    return h;
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier()
 {
 }
@@ -145,36 +155,28 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert =
-        m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    std::pair<std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::iterator, bool> insert =
+        m_flowMap.insert(std::pair<FiveTuple, FlowState>(tuple, FlowState{}));
+    FlowState& flow = insert.first->second;
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        flow.flowId = GetNewFlowId();
+        m_flowTuples[flow.flowId] = &insert.first->first;
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        flow.lastPacketId++;
     }
 
-    // increment the counter of packets with the same DSCP value
-    Ipv4Header::DscpType dscp = ipHeader.GetDscp();
-    std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter =
-        m_flowDscpMap[insert.first->second].insert(
-            std::pair<Ipv4Header::DscpType, uint32_t>(dscp, 1));
+    flow.lastSeen = Simulator::Now();
 
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
-    {
-        m_flowDscpMap[insert.first->second][dscp]++;
-    }
+    // increment the counter of packets with the same DSCP value
+    flow.dscps[ipHeader.GetDscp()]++;
 
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
@@ -182,18 +184,12 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow(FlowId flowId) const
 {
-    for (std::map<FiveTuple, FlowId>::const_iterator iter = m_flowMap.begin();
-         iter != m_flowMap.end();
-         iter++)
+    std::unordered_map<FlowId, const FiveTuple*>::const_iterator iter = m_flowTuples.find(flowId);
+    if (iter == m_flowTuples.end())
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv4Address::GetZero(), Ipv4Address::GetZero(), 0, 0, 0};
-    return retval;
+    return *iter->second;
 }
 
 bool
@@ -206,33 +202,97 @@ Ipv4FlowClassifier::SortByCount::operator()(std::pair<Ipv4Header::DscpType, uint
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t>>
 Ipv4FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>>::const_iterator flow =
-        m_flowDscpMap.find(flowId);
+    const std::map<Ipv4Header::DscpType, uint32_t>& dscps =
+        m_flowMap.find(FindFlow(flowId))->second.dscps;
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(dscps.begin(), dscps.end());
+    std::sort(v.begin(), v.end(), SortByCount());
+    return v;
+}
 
-    if (flow == m_flowDscpMap.end())
+void
+Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+{
+    std::vector<std::pair<FiveTuple, const FlowState*>> flows;
+    for (std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::const_iterator iter =
+             m_flowMap.begin();
+         iter != m_flowMap.end();
+         iter++)
     {
-        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
+        flows.emplace_back(iter->first, &iter->second);
     }
+    SerializeFlowsToXmlStream(os, indent, flows);
+}
 
-    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
-    std::sort(v.begin(), v.end(), SortByCount());
-    return v;
+void
+Ipv4FlowClassifier::ExpireFlows(std::ostream& os,
+                                uint16_t indent,
+                                const std::vector<FlowId>& flowIds)
+{
+    std::vector<std::pair<FiveTuple, const FlowState*>> flows;
+    for (std::vector<FlowId>::const_iterator iter = flowIds.begin(); iter != flowIds.end();
+         iter++)
+    {
+        std::unordered_map<FlowId, const FiveTuple*>::const_iterator tuple =
+            m_flowTuples.find(*iter);
+        if (tuple != m_flowTuples.end())
+        {
+            flows.emplace_back(*tuple->second, &m_flowMap.find(*tuple->second)->second);
+        }
+    }
+    if (flows.empty())
+    {
+        return;
+    }
+    SerializeFlowsToXmlStream(os, indent, flows);
+
+    for (std::vector<std::pair<FiveTuple, const FlowState*>>::const_iterator iter = flows.begin();
+         iter != flows.end();
+         iter++)
+    {
+        m_flowTuples.erase(iter->second->flowId);
+        m_flowMap.erase(iter->first);
+    }
+}
+
+std::vector<FlowId>
+Ipv4FlowClassifier::GetIdleFlows(Time idleTimeout) const
+{
+    std::vector<FlowId> idleFlows;
+    Time now = Simulator::Now();
+    for (std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::const_iterator iter =
+             m_flowMap.begin();
+         iter != m_flowMap.end();
+         iter++)
+    {
+        if (now - iter->second.lastSeen >= idleTimeout)
+        {
+            idleFlows.push_back(iter->second.flowId);
+        }
+    }
+    return idleFlows;
 }
 
 void
-Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+Ipv4FlowClassifier::SerializeFlowsToXmlStream(
+    std::ostream& os,
+    uint16_t indent,
+    std::vector<std::pair<FiveTuple, const FlowState*>>& flows) const
 {
     Indent(os, indent);
     os << "<Ipv4FlowClassifier>\n";
 
+    // sort the flows by tuple, as they used to be stored in a std::map
+    std::sort(flows.begin(), flows.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
     indent += 2;
-    for (std::map<FiveTuple, FlowId>::const_iterator iter = m_flowMap.begin();
-         iter != m_flowMap.end();
+    for (std::vector<std::pair<FiveTuple, const FlowState*>>::const_iterator iter = flows.begin();
+         iter != flows.end();
          iter++)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
+        os << "<Flow flowId=\"" << iter->second->flowId << "\""
            << " sourceAddress=\"" << iter->first.sourceAddress << "\""
            << " destinationAddress=\"" << iter->first.destinationAddress << "\""
            << " protocol=\"" << int(iter->first.protocol) << "\""
@@ -240,19 +300,14 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
            << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
         indent += 2;
-        std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>>::const_iterator flow =
-            m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        const std::map<Ipv4Header::DscpType, uint32_t>& dscps = iter->second->dscps;
+        for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = dscps.begin();
+             i != dscps.end();
+             i++)
         {
-            for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin();
-                 i != flow->second.end();
-                 i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
+               << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
         indent -= 2;
@@ -21,6 +21,7 @@
 #include "ipv6-flow-classifier.h"
 
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
 
@@ -92,6 +93,15 @@ operator==(const Ipv6FlowClassifier::FiveTuple& t1, const Ipv6FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+std::size_t
+Ipv6FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    std::size_t h = Ipv6AddressHash()(tuple.sourceAddress);
+    h = h * 31 + Ipv6AddressHash()(tuple.destinationAddress);
+    h = h * 31 + ((tuple.protocol << 16) ^ (tuple.sourcePort << 8) ^ tuple.destinationPort);
+    return h;
+}
+
 Ipv6FlowClassifier::Ipv6FlowClassifier()
 {
 }
@@ -146,36 +156,28 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert =
-        m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    std::pair<std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::iterator, bool> insert =
+        m_flowMap.insert(std::pair<FiveTuple, FlowState>(tuple, FlowState{}));
+    FlowState& flow = insert.first->second;
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        flow.flowId = GetNewFlowId();
+        m_flowTuples[flow.flowId] = &insert.first->first;
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        flow.lastPacketId++;
     }
 
-    // increment the counter of packets with the same DSCP value
-    Ipv6Header::DscpType dscp = ipHeader.GetDscp();
-    std::pair<std::map<Ipv6Header::DscpType, uint32_t>::iterator, bool> dscpInserter =
-        m_flowDscpMap[insert.first->second].insert(
-            std::pair<Ipv6Header::DscpType, uint32_t>(dscp, 1));
+    flow.lastSeen = Simulator::Now();
 
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
-    {
-        m_flowDscpMap[insert.first->second][dscp]++;
-    }
+    // increment the counter of packets with the same DSCP value
+    flow.dscps[ipHeader.GetDscp()]++;
 
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
@@ -183,18 +185,12 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow(FlowId flowId) const
 {
-    for (std::map<FiveTuple, FlowId>::const_iterator iter = m_flowMap.begin();
-         iter != m_flowMap.end();
-         iter++)
+    std::unordered_map<FlowId, const FiveTuple*>::const_iterator iter = m_flowTuples.find(flowId);
+    if (iter == m_flowTuples.end())
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv6Address::GetZero(), Ipv6Address::GetZero(), 0, 0, 0};
-    return retval;
+    return *iter->second;
 }
 
 bool
@@ -207,33 +203,97 @@ Ipv6FlowClassifier::SortByCount::operator()(std::pair<Ipv6Header::DscpType, uint
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t>>
 Ipv6FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>>::const_iterator flow =
-        m_flowDscpMap.find(flowId);
+    const std::map<Ipv6Header::DscpType, uint32_t>& dscps =
+        m_flowMap.find(FindFlow(flowId))->second.dscps;
+    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(dscps.begin(), dscps.end());
+    std::sort(v.begin(), v.end(), SortByCount());
+    return v;
+}
 
-    if (flow == m_flowDscpMap.end())
+void
+Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+{
+    std::vector<std::pair<FiveTuple, const FlowState*>> flows;
+    for (std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::const_iterator iter =
+             m_flowMap.begin();
+         iter != m_flowMap.end();
+         iter++)
     {
-        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
+        flows.emplace_back(iter->first, &iter->second);
     }
+    SerializeFlowsToXmlStream(os, indent, flows);
+}
 
-    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
-    std::sort(v.begin(), v.end(), SortByCount());
-    return v;
+void
+Ipv6FlowClassifier::ExpireFlows(std::ostream& os,
+                                uint16_t indent,
+                                const std::vector<FlowId>& flowIds)
+{
+    std::vector<std::pair<FiveTuple, const FlowState*>> flows;
+    for (std::vector<FlowId>::const_iterator iter = flowIds.begin(); iter != flowIds.end();
+         iter++)
+    {
+        std::unordered_map<FlowId, const FiveTuple*>::const_iterator tuple =
+            m_flowTuples.find(*iter);
+        if (tuple != m_flowTuples.end())
+        {
+            flows.emplace_back(*tuple->second, &m_flowMap.find(*tuple->second)->second);
+        }
+    }
+    if (flows.empty())
+    {
+        return;
+    }
+    SerializeFlowsToXmlStream(os, indent, flows);
+
+    for (std::vector<std::pair<FiveTuple, const FlowState*>>::const_iterator iter = flows.begin();
+         iter != flows.end();
+         iter++)
+    {
+        m_flowTuples.erase(iter->second->flowId);
+        m_flowMap.erase(iter->first);
+    }
+}
+
+std::vector<FlowId>
+Ipv6FlowClassifier::GetIdleFlows(Time idleTimeout) const
+{
+    std::vector<FlowId> idleFlows;
+    Time now = Simulator::Now();
+    for (std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::const_iterator iter =
+             m_flowMap.begin();
+         iter != m_flowMap.end();
+         iter++)
+    {
+        if (now - iter->second.lastSeen >= idleTimeout)
+        {
+            idleFlows.push_back(iter->second.flowId);
+        }
+    }
+    return idleFlows;
 }
 
 void
-Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+Ipv6FlowClassifier::SerializeFlowsToXmlStream(
+    std::ostream& os,
+    uint16_t indent,
+    std::vector<std::pair<FiveTuple, const FlowState*>>& flows) const
 {
     Indent(os, indent);
     os << "<Ipv6FlowClassifier>\n";
 
+    // sort the flows by tuple, as they used to be stored in a std::map
+    std::sort(flows.begin(), flows.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
     indent += 2;
-    for (std::map<FiveTuple, FlowId>::const_iterator iter = m_flowMap.begin();
-         iter != m_flowMap.end();
+    for (std::vector<std::pair<FiveTuple, const FlowState*>>::const_iterator iter = flows.begin();
+         iter != flows.end();
          iter++)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
+        os << "<Flow flowId=\"" << iter->second->flowId << "\""
            << " sourceAddress=\"" << iter->first.sourceAddress << "\""
            << " destinationAddress=\"" << iter->first.destinationAddress << "\""
            << " protocol=\"" << int(iter->first.protocol) << "\""
@@ -241,19 +301,14 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
            << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
         indent += 2;
-        std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>>::const_iterator flow =
-            m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        const std::map<Ipv6Header::DscpType, uint32_t>& dscps = iter->second->dscps;
+        for (std::map<Ipv6Header::DscpType, uint32_t>::const_iterator i = dscps.begin();
+             i != dscps.end();
+             i++)
         {
-            for (std::map<Ipv6Header::DscpType, uint32_t>::const_iterator i = flow->second.begin();
-                 i != flow->second.end();
-                 i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
+               << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
         indent -= 2;
@@ -26,6 +26,8 @@
 
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -49,6 +51,16 @@ class Ipv6FlowClassifier : public FlowClassifier
         uint16_t destinationPort;       //!< Destination port
     };
 
+    /// Hash function of a FiveTuple
+    struct FiveTupleHash
+    {
+        /**
+         * \param tuple the FiveTuple
+         * \return the hash of the tuple
+         */
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
     Ipv6FlowClassifier();
 
     /// \brief try to classify the packet into flow-id and packet-id
@@ -92,13 +104,35 @@ class Ipv6FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    void ExpireFlows(std::ostream& os,
+                     uint16_t indent,
+                     const std::vector<FlowId>& flowIds) override;
+
+    std::vector<FlowId> GetIdleFlows(Time idleTimeout) const override;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// State of a flow
+    struct FlowState
+    {
+        FlowId flowId;                                  //!< Flow identifier
+        FlowPacketId lastPacketId;                      //!< Last FlowPacketId of the flow
+        std::map<Ipv6Header::DscpType, uint32_t> dscps; //!< (DSCP value, packet count) pairs
+        Time lastSeen;                                  //!< Time of the last packet classified
+    };
+
+    /// Serializes flows to an std::ostream in XML format, sorted by tuple
+    /// \param os the output stream
+    /// \param indent number of spaces to use as base indentation level
+    /// \param flows the flows
+    void SerializeFlowsToXmlStream(
+        std::ostream& os,
+        uint16_t indent,
+        std::vector<std::pair<FiveTuple, const FlowState*>>& flows) const;
+
+    /// Map to Flows Identifiers to the state of the flows
+    std::unordered_map<FiveTuple, FlowState, FiveTupleHash> m_flowMap;
+    /// FlowId --> FiveTuple of the flow, which is a key of m_flowMap
+    std::unordered_map<FlowId, const FiveTuple*> m_flowTuples;
 };
 
 /**
@@ -0,0 +1,435 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-header.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \defgroup flow-monitor-test FlowMonitor module tests
+ * \ingroup flow-monitor
+ * \ingroup tests
+ */
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * A probe which reports the packets sent to it by the tests.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * \param monitor the FlowMonitor
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Base class of the tests of the streaming of the flow statistics: sends
+ * UDP packets between two addresses, which are received right away.
+ */
+class FlowMonitorStreamTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param name the name of the test case
+     */
+    FlowMonitorStreamTestCase(std::string name);
+
+  protected:
+    /**
+     * Create the monitor, its classifier and its probe.
+     * \param filename the file to which the flow statistics are streamed
+     * \param sketchStats whether the per-flow statistics are replaced by sketches
+     */
+    void Setup(std::string filename, bool sketchStats = false);
+    /**
+     * Send and receive a packet.
+     * \param sourcePort the source port of the packet
+     */
+    void Send(uint16_t sourcePort);
+    /**
+     * Read a file.
+     * \param filename the file
+     * \return the contents of the file
+     */
+    static std::string ReadFile(std::string filename);
+    /**
+     * Count the occurrences of a pattern.
+     * \param text the text
+     * \param pattern the pattern
+     * \return the number of occurrences of the pattern in the text
+     */
+    static uint32_t Count(const std::string& text, const std::string& pattern);
+
+    Ptr<FlowMonitor> m_monitor;           //!< the monitor
+    Ptr<Ipv4FlowClassifier> m_classifier; //!< the classifier
+    Ptr<FlowMonitorTestProbe> m_probe;    //!< the probe
+};
+
+FlowMonitorStreamTestCase::FlowMonitorStreamTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+FlowMonitorStreamTestCase::Setup(std::string filename, bool sketchStats)
+{
+    m_monitor = CreateObjectWithAttributes<FlowMonitor>("SketchStats", BooleanValue(sketchStats));
+    m_monitor->SetAttribute("StreamFileName", StringValue(filename));
+    m_classifier = Create<Ipv4FlowClassifier>();
+    m_monitor->AddFlowClassifier(m_classifier);
+    m_probe = Create<FlowMonitorTestProbe>(m_monitor);
+    m_monitor->Start(Seconds(0));
+}
+
+void
+FlowMonitorStreamTestCase::Send(uint16_t sourcePort)
+{
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("10.0.0.1"));
+    ipHeader.SetDestination(Ipv4Address("10.0.0.2"));
+    ipHeader.SetProtocol(17);
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(sourcePort);
+    udpHeader.SetDestinationPort(9);
+    Ptr<Packet> payload = Create<Packet>(100);
+    payload->AddHeader(udpHeader);
+
+    FlowId flowId;
+    FlowPacketId packetId;
+    NS_TEST_ASSERT_MSG_EQ(m_classifier->Classify(ipHeader, payload, &flowId, &packetId),
+                          true,
+                          "UDP packet not classified");
+    m_monitor->ReportFirstTx(m_probe, flowId, packetId, payload->GetSize());
+    m_monitor->ReportLastRx(m_probe, flowId, packetId, payload->GetSize());
+}
+
+std::string
+FlowMonitorStreamTestCase::ReadFile(std::string filename)
+{
+    std::ifstream is(filename);
+    std::ostringstream contents;
+    contents << is.rdbuf();
+    return contents.str();
+}
+
+uint32_t
+FlowMonitorStreamTestCase::Count(const std::string& text, const std::string& pattern)
+{
+    uint32_t count = 0;
+    for (std::size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + pattern.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check that the idle flows are streamed and forgotten by the monitor and
+ * by the classifier.
+ */
+class FlowMonitorIdleTimeoutTestCase : public FlowMonitorStreamTestCase
+{
+  public:
+    FlowMonitorIdleTimeoutTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorIdleTimeoutTestCase::FlowMonitorIdleTimeoutTestCase()
+    : FlowMonitorStreamTestCase("Check the streaming of the idle flows")
+{
+}
+
+void
+FlowMonitorIdleTimeoutTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("flow-monitor-idle.xml");
+    Setup(filename);
+    m_monitor->SetAttribute("FlowIdleTimeout", TimeValue(Seconds(2)));
+
+    // flow 1 is idle from 0.5 s, flow 2 is active until the end
+    Simulator::Schedule(Seconds(0.5), &FlowMonitorIdleTimeoutTestCase::Send, this, 1000);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Simulator::Schedule(Seconds(0.5 + i), &FlowMonitorIdleTimeoutTestCase::Send, this, 2000);
+    }
+    // same five-tuple as flow 1, after it has been forgotten
+    Simulator::Schedule(Seconds(5.5), &FlowMonitorIdleTimeoutTestCase::Send, this, 1000);
+    Simulator::Stop(Seconds(6));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStatsContainer& stats = m_monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.size(), 2, "Wrong number of flows kept");
+    NS_TEST_EXPECT_MSG_EQ((stats.find(1) == stats.end()), true, "Idle flow kept");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(2).txPackets, 6, "Wrong statistics of the active flow");
+    NS_TEST_EXPECT_MSG_EQ(stats.at(3).txPackets, 1, "Wrong statistics of the new flow");
+    NS_TEST_EXPECT_MSG_EQ(m_classifier->FindFlow(3).sourcePort,
+                          1000,
+                          "Five-tuple of the idle flow not classified into a new flow");
+    FlowProbe::Stats probeStats = m_probe->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(probeStats.size(), 2, "Wrong number of flows kept by the probe");
+    NS_TEST_EXPECT_MSG_EQ((probeStats.find(1) == probeStats.end()),
+                          true,
+                          "Idle flow kept by the probe");
+    NS_TEST_EXPECT_MSG_EQ(probeStats.at(2).packets, 12, "Wrong probe statistics of the flow");
+
+    m_monitor->CloseStream();
+    std::string contents = ReadFile(filename);
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<FlowStats>"), 2, "Wrong number of FlowStats");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Ipv4FlowClassifier>"),
+                          2,
+                          "Wrong number of classifiers");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Flow flowId=\"1\" sourceAddress"),
+                          1,
+                          "Classifier entry of the idle flow not streamed once");
+    std::size_t idleFlow = contents.find("<Flow flowId=\"1\" timeFirstTxPacket");
+    std::size_t idleClassifier = contents.find("<Flow flowId=\"1\" sourceAddress");
+    std::size_t activeFlow = contents.find("<Flow flowId=\"2\" timeFirstTxPacket");
+    NS_TEST_EXPECT_MSG_LT(idleFlow, idleClassifier, "Idle flow not streamed first");
+    NS_TEST_EXPECT_MSG_LT(idleClassifier, activeFlow, "Idle flow not streamed when idle");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "txPackets=\"6\""), 1, "Active flow not streamed");
+    NS_TEST_EXPECT_MSG_EQ(contents.substr(contents.size() - 15),
+                          "</FlowMonitor>\n",
+                          "Stream not closed");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check that the idle flows are forgotten by the classifier when the
+ * per-flow statistics are replaced by sketches.
+ */
+class FlowMonitorSketchIdleTimeoutTestCase : public FlowMonitorStreamTestCase
+{
+  public:
+    FlowMonitorSketchIdleTimeoutTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSketchIdleTimeoutTestCase::FlowMonitorSketchIdleTimeoutTestCase()
+    : FlowMonitorStreamTestCase("Check the expiry of the idle flows with sketches")
+{
+}
+
+void
+FlowMonitorSketchIdleTimeoutTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("flow-monitor-sketch-idle.xml");
+    Setup(filename, true);
+    m_monitor->SetAttribute("FlowIdleTimeout", TimeValue(Seconds(2)));
+
+    // flow 1 is idle from 0.5 s, flow 2 is active until the end
+    Simulator::Schedule(Seconds(0.5), &FlowMonitorSketchIdleTimeoutTestCase::Send, this, 1000);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Simulator::Schedule(Seconds(0.5 + i),
+                            &FlowMonitorSketchIdleTimeoutTestCase::Send,
+                            this,
+                            2000);
+    }
+    // same five-tuple as flow 1, after it has been forgotten
+    Simulator::Schedule(Seconds(5.5), &FlowMonitorSketchIdleTimeoutTestCase::Send, this, 1000);
+    Simulator::Stop(Seconds(6));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().size(), 0, "Per-flow statistics kept");
+    NS_TEST_EXPECT_MSG_EQ(m_classifier->GetIdleFlows(Seconds(0)).size(),
+                          2,
+                          "Wrong number of flows kept by the classifier");
+    NS_TEST_EXPECT_MSG_EQ(m_classifier->FindFlow(3).sourcePort,
+                          1000,
+                          "Five-tuple of the idle flow not classified into a new flow");
+
+    m_monitor->CloseStream();
+    std::string contents = ReadFile(filename);
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Ipv4FlowClassifier>"),
+                          2,
+                          "Wrong number of classifiers");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Flow flowId=\"1\" sourceAddress"),
+                          1,
+                          "Classifier entry of the idle flow not streamed once");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Flow flowId="), 3, "Wrong number of flows");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check that the flows are streamed and reset at each export interval.
+ */
+class FlowMonitorExportIntervalTestCase : public FlowMonitorStreamTestCase
+{
+  public:
+    FlowMonitorExportIntervalTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorExportIntervalTestCase::FlowMonitorExportIntervalTestCase()
+    : FlowMonitorStreamTestCase("Check the periodic export of the flows")
+{
+}
+
+void
+FlowMonitorExportIntervalTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("flow-monitor-export.xml");
+    Setup(filename);
+    m_monitor->SetAttribute("ExportInterval", TimeValue(Seconds(1)));
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(Seconds(0.5 + i),
+                            &FlowMonitorExportIntervalTestCase::Send,
+                            this,
+                            1000);
+    }
+    Simulator::Schedule(Seconds(2.5), &FlowMonitorExportIntervalTestCase::Send, this, 1000);
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().at(1).txPackets,
+                          2,
+                          "Flow not reset at the export interval");
+    NS_TEST_EXPECT_MSG_EQ(m_probe->GetStats().at(1).packets,
+                          4,
+                          "Probe not reset at the export interval");
+
+    m_monitor->CloseStream();
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().size(), 0, "Flows not reset at the close");
+    NS_TEST_EXPECT_MSG_EQ(m_probe->GetStats().size(), 0, "Probe not reset at the close");
+    std::string contents = ReadFile(filename);
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<FlowStats startTime="),
+                          3,
+                          "Wrong number of export intervals");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "txPackets=\"1\""),
+                          2,
+                          "Wrong statistics in the first intervals");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "txPackets=\"2\""),
+                          1,
+                          "Wrong statistics in the last interval");
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Ipv4FlowClassifier>"),
+                          1,
+                          "Classifier not streamed once");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check that, without idle timeout nor export interval, the streamed file
+ * is the one written by SerializeToXmlFile.
+ */
+class FlowMonitorStreamFileTestCase : public FlowMonitorStreamTestCase
+{
+  public:
+    FlowMonitorStreamFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorStreamFileTestCase::FlowMonitorStreamFileTestCase()
+    : FlowMonitorStreamTestCase("Check the contents of the streamed file")
+{
+}
+
+void
+FlowMonitorStreamFileTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("flow-monitor-stream.xml");
+    std::string expected = CreateTempDirFilename("flow-monitor-expected.xml");
+    Setup(filename);
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Simulator::Schedule(Seconds(0.5 + i),
+                            &FlowMonitorStreamFileTestCase::Send,
+                            this,
+                            1000 + i % 2);
+    }
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    m_monitor->SerializeToXmlFile(expected, false, false);
+    m_monitor->CloseStream();
+    std::string contents = ReadFile(filename);
+    NS_TEST_EXPECT_MSG_EQ(Count(contents, "<Flow flowId="), 4, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_EQ(contents, ReadFile(expected), "Streamed file differs");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+    remove(expected.c_str());
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowMonitorIdleTimeoutTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorSketchIdleTimeoutTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorExportIntervalTestCase(), TestCase::QUICK);
+    AddTestCase(new FlowMonitorStreamFileTestCase(), TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
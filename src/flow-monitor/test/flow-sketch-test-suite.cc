@@ -0,0 +1,230 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/flow-sketch.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <map>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check the error bounds of the estimates of a CountMinSketch: an estimate is
+ * never lower than the exact sum, and exceeds it by more than epsilon times
+ * the total count with a probability of at most delta.
+ */
+class CountMinSketchTestCase : public TestCase
+{
+  public:
+    CountMinSketchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CountMinSketchTestCase::CountMinSketchTestCase()
+    : TestCase("Check the error bounds of CountMinSketch")
+{
+}
+
+void
+CountMinSketchTestCase::DoRun()
+{
+    CountMinSketch sketch(272, 5);
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetEpsilon(), std::exp(1.0) / 272, 1e-12, "Wrong epsilon");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetDelta(), std::exp(-5.0), 1e-12, "Wrong delta");
+
+    // a few heavy keys and many light ones, added in rounds
+    const uint32_t keys = 10000;
+    std::map<uint64_t, uint64_t> exact;
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        for (uint64_t key = 0; key < keys; key++)
+        {
+            uint64_t count = (key % 1000 == 0) ? 500 : 1 + (key * 7919) % 100;
+            sketch.Add(key * 0x10001, count);
+            exact[key * 0x10001] += count;
+        }
+    }
+
+    uint64_t total = 0;
+    for (const auto& entry : exact)
+    {
+        total += entry.second;
+    }
+    NS_TEST_ASSERT_MSG_EQ(sketch.GetTotal(), total, "Wrong total count");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetErrorBound(),
+                          static_cast<uint64_t>(std::ceil(sketch.GetEpsilon() * total)),
+                          "Wrong error bound");
+
+    uint32_t underestimates = 0;
+    uint32_t outOfBound = 0;
+    for (const auto& entry : exact)
+    {
+        uint64_t estimate = sketch.Estimate(entry.first);
+        underestimates += (estimate < entry.second);
+        outOfBound += (estimate > entry.second + sketch.GetErrorBound());
+    }
+    NS_TEST_EXPECT_MSG_EQ(underestimates, 0, "Count underestimated");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(outOfBound,
+                                sketch.GetDelta() * keys,
+                                "Too many estimates above the error bound");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check that the estimates of a HyperLogLog counter are within three times
+ * its relative standard error, in the small and in the large range.
+ */
+class HyperLogLogTestCase : public TestCase
+{
+  public:
+    HyperLogLogTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HyperLogLogTestCase::HyperLogLogTestCase()
+    : TestCase("Check the error bounds of HyperLogLog")
+{
+}
+
+void
+HyperLogLogTestCase::DoRun()
+{
+    for (uint32_t keys : {100, 1000, 100000})
+    {
+        HyperLogLog counter(12);
+        NS_TEST_EXPECT_MSG_EQ_TOL(counter.GetRelativeStandardError(),
+                                  1.04 / 64,
+                                  1e-12,
+                                  "Wrong relative standard error");
+        // every key is added twice, which must not change the estimate
+        for (uint32_t i = 0; i < 2 * keys; i++)
+        {
+            counter.Add((i % keys) * 0x9e3779b9ULL);
+        }
+        NS_TEST_EXPECT_MSG_EQ_TOL(counter.Estimate(),
+                                  keys,
+                                  3 * counter.GetRelativeStandardError() * keys,
+                                  "Estimate of " << keys << " keys out of the bounds");
+    }
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Check the guarantees of a SpaceSaving counter: every key whose sum exceeds
+ * the total count divided by k is kept, and the count of a kept key exceeds
+ * its exact sum by at most its error, itself at most the total count divided
+ * by k.
+ */
+class SpaceSavingTestCase : public TestCase
+{
+  public:
+    SpaceSavingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpaceSavingTestCase::SpaceSavingTestCase()
+    : TestCase("Check the error bounds of SpaceSaving")
+{
+}
+
+void
+SpaceSavingTestCase::DoRun()
+{
+    const uint32_t k = 50;
+    SpaceSaving counter(k);
+    NS_TEST_EXPECT_MSG_EQ(counter.GetErrorBound(), 0, "Error bound before the counter is full");
+
+    // 10 heavy keys interleaved with 10000 light ones
+    std::map<uint64_t, uint64_t> exact;
+    for (uint64_t i = 0; i < 10000; i++)
+    {
+        uint64_t light = 1000 + i;
+        counter.Add(light, 1 + i % 3);
+        exact[light] += 1 + i % 3;
+        if (i % 10 == 0)
+        {
+            uint64_t heavy = (i / 10) % 10;
+            counter.Add(heavy, 100);
+            exact[heavy] += 100;
+        }
+    }
+
+    uint64_t total = 0;
+    for (const auto& entry : exact)
+    {
+        total += entry.second;
+    }
+    NS_TEST_ASSERT_MSG_EQ(counter.GetTotal(), total, "Wrong total count");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(counter.GetErrorBound(), total / k, "Error bound too large");
+
+    std::vector<SpaceSaving::Entry> top = counter.GetTop();
+    NS_TEST_ASSERT_MSG_EQ(top.size(), k, "Wrong number of keys kept");
+    std::map<uint64_t, const SpaceSaving::Entry*> kept;
+    for (uint32_t i = 0; i < top.size(); i++)
+    {
+        const SpaceSaving::Entry& entry = top[i];
+        kept[entry.key] = &entry;
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(entry.count, top[i - 1].count, "Keys not sorted");
+        }
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(entry.count, exact[entry.key], "Count underestimated");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(entry.count - entry.error,
+                                    exact[entry.key],
+                                    "Count overestimated by more than its error");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(entry.error, counter.GetErrorBound(), "Error too large");
+    }
+    for (const auto& entry : exact)
+    {
+        if (entry.second > total / k)
+        {
+            NS_TEST_EXPECT_MSG_EQ((kept.find(entry.first) != kept.end()),
+                                  true,
+                                  "Heavy key " << entry.first << " not kept");
+        }
+    }
+}
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * FlowSketch TestSuite
+ */
+class FlowSketchTestSuite : public TestSuite
+{
+  public:
+    FlowSketchTestSuite();
+};
+
+FlowSketchTestSuite::FlowSketchTestSuite()
+    : TestSuite("flow-sketch", UNIT)
+{
+    AddTestCase(new CountMinSketchTestCase(), TestCase::QUICK);
+    AddTestCase(new HyperLogLogTestCase(), TestCase::QUICK);
+    AddTestCase(new SpaceSavingTestCase(), TestCase::QUICK);
+}
+
+static FlowSketchTestSuite g_flowSketchTestSuite; //!< Static variable for test initialization
@@ -22,6 +22,7 @@
 
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/assert.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/callback.h"
 #include "ns3/config.h"
 #include "ns3/core-config.h"
@@ -623,6 +624,11 @@ Ipv4L3ProtocolDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -646,6 +652,11 @@ Ipv4L3ProtocolTxSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
         NS_LOG_INFO("Ignoring packet to/from interface " << interface);
         return;
     }
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, packet);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << *packet << std::endl;
 }
 
@@ -669,6 +680,11 @@ Ipv4L3ProtocolRxSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, packet);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *packet << std::endl;
 }
 
@@ -706,6 +722,11 @@ Ipv4L3ProtocolDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), context, p);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *p << std::endl;
@@ -737,6 +758,11 @@ Ipv4L3ProtocolTxSinkWithContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), context, packet);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *packet << std::endl;
@@ -768,6 +794,11 @@ Ipv4L3ProtocolRxSinkWithContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), context, packet);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *packet << std::endl;
@@ -967,6 +998,11 @@ Ipv6L3ProtocolDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -990,6 +1026,11 @@ Ipv6L3ProtocolTxSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, packet);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << *packet << std::endl;
 }
 
@@ -1013,6 +1054,11 @@ Ipv6L3ProtocolRxSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), pair.first, BinaryTraceWriter::NO_ID, packet);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *packet << std::endl;
 }
 
@@ -1050,6 +1096,11 @@ Ipv6L3ProtocolDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
 
     Ptr<Packet> p = packet->Copy();
     p->AddHeader(header);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), context, p);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *p << std::endl;
@@ -1081,6 +1132,11 @@ Ipv6L3ProtocolTxSinkWithContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), context, packet);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *packet << std::endl;
@@ -1112,6 +1168,11 @@ Ipv6L3ProtocolRxSinkWithContext(Ptr<OutputStreamWrapper> stream,
         return;
     }
 
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), context, packet);
+        return;
+    }
 #ifdef INTERFACE_CONTEXT
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << "("
                          << interface << ") " << *packet << std::endl;
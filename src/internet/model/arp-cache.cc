@@ -23,6 +23,7 @@
 #include "ipv4-interface.h"
 
 #include "ns3/assert.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
@@ -31,6 +32,8 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
+
 namespace ns3
 {
 
@@ -38,6 +41,48 @@ NS_LOG_COMPONENT_DEFINE("ArpCache");
 
 NS_OBJECT_ENSURE_REGISTERED(ArpCache);
 
+namespace
+{
+
+/**
+ * \ingroup arp
+ * Register the hooks which save the entries of the ARP caches in the
+ * checkpoints.
+ */
+class ArpCacheCheckpointHooks
+{
+  public:
+    ArpCacheCheckpointHooks()
+    {
+        Checkpoint::AddStateHook(ArpCache::GetTypeId(),
+                                 MakeCallback(&ArpCacheCheckpointHooks::Save),
+                                 MakeCallback(&ArpCacheCheckpointHooks::Restore));
+    }
+
+  private:
+    /**
+     * \brief Save the entries of an ARP cache
+     * \param object the ARP cache
+     * \param os the output stream
+     */
+    static void Save(Ptr<Object> object, std::ostream& os)
+    {
+        DynamicCast<ArpCache>(object)->SaveEntries(os);
+    }
+
+    /**
+     * \brief Restore the entries of an ARP cache
+     * \param object the ARP cache
+     * \param is the input stream
+     */
+    static void Restore(Ptr<Object> object, std::istream& is)
+    {
+        DynamicCast<ArpCache>(object)->RestoreEntries(is);
+    }
+} g_arpCacheCheckpointHooks; //!< Register the hooks when the module is loaded
+
+} // namespace
+
 TypeId
 ArpCache::GetTypeId()
 {
@@ -320,6 +365,60 @@ ArpCache::RemoveAutoGeneratedEntries()
     }
 }
 
+void
+ArpCache::SaveEntries(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [address, entry] : m_arpCache)
+    {
+        if (entry->IsAlive())
+        {
+            os << address << " " << entry->GetMacAddress() << " alive\n";
+        }
+        else if (entry->IsPermanent())
+        {
+            os << address << " " << entry->GetMacAddress() << " permanent\n";
+        }
+        else if (entry->IsAutoGenerated())
+        {
+            os << address << " " << entry->GetMacAddress() << " static\n";
+        }
+    }
+}
+
+void
+ArpCache::RestoreEntries(std::istream& is)
+{
+    NS_LOG_FUNCTION(this);
+    std::string ipv4;
+    std::string mac;
+    std::string state;
+    while (is >> ipv4 >> mac >> state)
+    {
+        Ipv4Address address(ipv4.c_str());
+        if (Lookup(address) != nullptr)
+        {
+            continue;
+        }
+        Address macAddress;
+        std::istringstream(mac) >> macAddress;
+        ArpCache::Entry* entry = Add(address);
+        entry->SetMacAddress(macAddress);
+        if (state == "permanent")
+        {
+            entry->MarkPermanent();
+        }
+        else if (state == "static")
+        {
+            entry->MarkAutoGenerated();
+        }
+        else
+        {
+            entry->UpdateSeen();
+        }
+    }
+}
+
 std::list<ArpCache::Entry*>
 ArpCache::LookupInverse(Address to)
 {
@@ -172,6 +172,22 @@ class ArpCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * \brief Write the resolved entries of the ARP cache, to checkpoint it
+     *
+     * \param os the output stream
+     */
+    void SaveEntries(std::ostream& os) const;
+
+    /**
+     * \brief Add the entries written by SaveEntries which are not in the cache
+     *
+     * The entries alive are refreshed.
+     *
+     * \param is the input stream
+     */
+    void RestoreEntries(std::istream& is);
+
     /**
      * \brief Pair of a packet and an Ipv4 header.
      */
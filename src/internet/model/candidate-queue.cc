@@ -58,22 +58,25 @@ operator<<(std::ostream& os, const SPFVertex::VertexType& t)
 std::ostream&
 operator<<(std::ostream& os, const CandidateQueue& q)
 {
-    typedef CandidateQueue::CandidateList_t List_t;
-    typedef List_t::const_iterator CIter_t;
-    const CandidateQueue::CandidateList_t& list = q.m_candidates;
+    CandidateQueue::CandidateHeap_t list = q.m_candidates;
+    std::sort(list.begin(), list.end(), [](const auto& c1, const auto& c2) {
+        return CandidateQueue::CandidateAfter(c2, c1);
+    });
 
     os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
-    for (CIter_t iter = list.begin(); iter != list.end(); iter++)
+    for (const auto& c : list)
     {
-        os << "<" << (*iter)->GetVertexId() << ", " << (*iter)->GetDistanceFromRoot() << ", "
-           << (*iter)->GetVertexType() << ">" << std::endl;
+        os << "<" << c.vertex->GetVertexId() << ", " << c.vertex->GetDistanceFromRoot() << ", "
+           << c.vertex->GetVertexType() << ">" << std::endl;
     }
     os << "*** CandidateQueue End ***";
     return os;
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_candidates(),
+      m_nextSeq(0),
+      m_index()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -101,11 +104,9 @@ CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
 
-    CandidateList_t::iterator i = std::upper_bound(m_candidates.begin(),
-                                                   m_candidates.end(),
-                                                   vNew,
-                                                   &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    m_candidates.push_back(MakeCandidate(vNew));
+    std::push_heap(m_candidates.begin(), m_candidates.end(), &CandidateQueue::CandidateAfter);
+    m_index.emplace(vNew->GetVertexId(), vNew);
 }
 
 SPFVertex*
@@ -117,8 +118,14 @@ CandidateQueue::Pop()
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    std::pop_heap(m_candidates.begin(), m_candidates.end(), &CandidateQueue::CandidateAfter);
+    SPFVertex* v = m_candidates.back().vertex;
+    m_candidates.pop_back();
+    auto it = m_index.find(v->GetVertexId());
+    if (it != m_index.end() && it->second == v)
+    {
+        m_index.erase(it);
+    }
     return v;
 }
 
@@ -131,7 +138,7 @@ CandidateQueue::Top() const
         return nullptr;
     }
 
-    return m_candidates.front();
+    return m_candidates.front().vertex;
 }
 
 bool
@@ -152,18 +159,12 @@ SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    CandidateList_t::const_iterator i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    auto it = m_index.find(addr);
+    if (it == m_index.end())
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
-        {
-            return v;
-        }
+        return nullptr;
     }
-
-    return nullptr;
+    return it->second;
 }
 
 void
@@ -171,11 +172,45 @@ CandidateQueue::Reorder()
 {
     NS_LOG_FUNCTION(this);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    // A vertex whose distance decreased is moved, as by a stable sort of a
+    // sorted list, after the vertices already queued with the same priority:
+    // give it a new insertion order, following the previous ordering when
+    // several vertices changed.
+    std::vector<Candidate*> changed;
+    for (auto& c : m_candidates)
+    {
+        if (c.distance != c.vertex->GetDistanceFromRoot())
+        {
+            changed.push_back(&c);
+        }
+    }
+    if (changed.empty())
+    {
+        return;
+    }
+    std::sort(changed.begin(), changed.end(), [](const Candidate* c1, const Candidate* c2) {
+        return CandidateAfter(*c2, *c1);
+    });
+    for (auto c : changed)
+    {
+        *c = MakeCandidate(c->vertex);
+    }
+    std::make_heap(m_candidates.begin(), m_candidates.end(), &CandidateQueue::CandidateAfter);
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
 
+CandidateQueue::Candidate
+CandidateQueue::MakeCandidate(SPFVertex* v)
+{
+    Candidate c;
+    c.distance = v->GetDistanceFromRoot();
+    c.rank = (v->GetVertexType() == SPFVertex::VertexNetwork) ? 0 : 1;
+    c.seq = m_nextSeq++;
+    c.vertex = v;
+    return c;
+}
+
 /*
  * In this implementation, SPFVertex follows the ordering where
  * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
@@ -184,24 +219,17 @@ CandidateQueue::Reorder()
  * This ordering is necessary for implementing ECMP
  */
 bool
-CandidateQueue::CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2)
+CandidateQueue::CandidateAfter(const Candidate& c1, const Candidate& c2)
 {
-    NS_LOG_FUNCTION(&v1 << &v2);
-
-    bool result = false;
-    if (v1->GetDistanceFromRoot() < v2->GetDistanceFromRoot())
+    if (c1.distance != c2.distance)
     {
-        result = true;
+        return c1.distance > c2.distance;
     }
-    else if (v1->GetDistanceFromRoot() == v2->GetDistanceFromRoot())
+    if (c1.rank != c2.rank)
     {
-        if (v1->GetVertexType() == SPFVertex::VertexNetwork &&
-            v2->GetVertexType() == SPFVertex::VertexRouter)
-        {
-            result = true;
-        }
+        return c1.rank > c2.rank;
     }
-    return result;
+    return c1.seq > c2.seq;
 }
 
 } // namespace ns3
@@ -22,8 +22,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +49,10 @@ class SPFVertex;
  * for a Find () operation, the dynamic nature of the data and the derived
  * requirement for a Reorder () operation led us to implement this simple
  * enhanced priority queue.
+ *
+ * The candidates are kept in a binary heap, and vertices are indexed by
+ * their ID for Find ().  Vertices with the same priority are popped in
+ * insertion order, as in a sorted list.
  */
 class CandidateQueue
 {
@@ -161,20 +166,39 @@ class CandidateQueue
 
   private:
     /**
-     * \brief return true if v1 < v2
-     *
-     * SPFVertexes are added into the queue according to the ordering
-     * defined by this method. If v1 should be popped before v2, this
-     * method return true; false otherwise
+     * \brief Entry of the candidate heap
      *
-     * \param v1 first operand
-     * \param v2 second operand
-     * \return True if v1 should be popped before v2; false otherwise
+     * The priority of the vertex is copied in the entry, so that a change
+     * of the vertex distance can be detected by Reorder ().
+     */
+    struct Candidate
+    {
+        uint32_t distance; //!< distance from root of the vertex when queued
+        uint8_t rank;      //!< 0 for network vertices, 1 otherwise
+        uint64_t seq;      //!< insertion order, to break ties
+        SPFVertex* vertex; //!< the vertex
+    };
+
+    /**
+     * \brief Build the heap entry of a vertex
+     * \param v the vertex
+     * \return the heap entry
+     */
+    Candidate MakeCandidate(SPFVertex* v);
+
+    /**
+     * \brief return true if c1 is popped after c2 (min-heap ordering)
+     * \param c1 first operand
+     * \param c2 second operand
+     * \return True if c1 should be popped after c2; false otherwise
      */
-    static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
+    static bool CandidateAfter(const Candidate& c1, const Candidate& c2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    typedef std::vector<Candidate> CandidateHeap_t; //!< heap of SPFVertex candidates
+    CandidateHeap_t m_candidates;                   //!< SPFVertex candidates
+    uint64_t m_nextSeq;                             //!< next insertion order
+    /// SPFVertex candidates indexed by vertex ID
+    std::unordered_map<Ipv4Address, SPFVertex*, Ipv4AddressHash> m_index;
 
     /**
      * \brief Stream insertion operator.
@@ -24,6 +24,7 @@
 #include "global-router-interface.h"
 
 #include "ns3/ipv4-address.h"
+#include "ns3/node.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -31,6 +32,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -681,6 +683,9 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+
+    /// Link State Advertisements indexed by the LinkData of their TransitNetwork link records
+    std::unordered_map<Ipv4Address, LSDBPair_t, Ipv4AddressHash> m_linkDataIndex;
 };
 
 /**
@@ -739,6 +744,7 @@ class GlobalRouteManagerImpl
 
   private:
     SPFVertex* m_spfroot;           //!< the root node
+    Ptr<Node> m_spfrootNode;        //!< the node at the root of the SPF tree
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
 
     /**
@@ -761,6 +767,14 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(Ipv4Address root);
 
+    /**
+     * \brief Share the routes computed for the root of the SPF tree with
+     * the nodes which have the same routes.
+     *
+     * \see Ipv4GlobalRouting::ShareRouteTable
+     */
+    void SPFShareRoutes();
+
     /**
      * \brief Process Stub nodes
      *
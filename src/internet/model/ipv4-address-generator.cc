@@ -22,7 +22,8 @@
 #include "ns3/log.h"
 #include "ns3/simulation-singleton.h"
 
-#include <list>
+#include <iterator>
+#include <map>
 
 namespace ns3
 {
@@ -176,16 +177,12 @@ class Ipv4AddressGeneratorImpl
     NetworkState m_netTable[N_BITS]; //!< the available networks
 
     /**
-     * \brief This class holds the allocated addresses
+     * \brief The blocks of allocated addresses: the highest allocated address
+     * of each block, by the lowest allocated address of the block
      */
-    class Entry
-    {
-      public:
-        uint32_t addrLow;  //!< the lowest allocated address
-        uint32_t addrHigh; //!< the highest allocated address
-    };
+    typedef std::map<uint32_t, uint32_t> Entries;
 
-    std::list<Entry> m_entries; //!< contained of allocated addresses
+    Entries m_entries; //!< contained of allocated addresses
     bool m_test;                //!< test mode (if true)
 };
 
@@ -365,17 +362,21 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
         addr,
         "Ipv4AddressGeneratorImpl::Add(): Allocating the broadcast address is not a good idea");
 
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The blocks are sorted by address, so only the block before the new
+    // address and the block after it need to be examined.
+    //
+    Entries::iterator next = m_entries.upper_bound(addr);
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
+        Entries::iterator i = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(i->first) << " to "
+                                       << Ipv4Address(i->second));
         //
         // First things first.  Is there an address collision -- that is, does the
         // new address fall in a previously allocated block of addresses.
         //
-        if (addr >= (*i).addrLow && addr <= (*i).addrHigh)
+        if (addr <= i->second)
         {
             NS_LOG_LOGIC(
                 "Ipv4AddressGeneratorImpl::Add(): Address Collision: " << Ipv4Address(addr));
@@ -387,64 +388,32 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
             return false;
         }
         //
-        // If the new address is less than the lowest address in the current block,
-        // and can't be merged into to the current block, then insert it as a new
-        // block before the current block.
+        // If the new address fits at the end of the block, just extend the block
+        // by one address.  The next block starts after the new address, so there
+        // is no collision there.  We expect that completely filled network ranges
+        // will be a fairly rare occurrence, so we don't worry about collapsing
+        // address range blocks.
         //
-        if (addr < (*i).addrLow - 1)
+        if (addr == i->second + 1)
         {
-            break;
-        }
-        //
-        // If the new address fits at the end of the block, look ahead to the next
-        // block and make sure it's not a collision there.  If we won't overlap, then
-        // just extend the current block by one address.  We expect that completely
-        // filled network ranges will be a fairly rare occurrence, so we don't worry
-        // about collapsing address range blocks.
-        //
-        if (addr == (*i).addrHigh + 1)
-        {
-            std::list<Entry>::iterator j = i;
-            ++j;
-
-            if (j != m_entries.end())
-            {
-                if (addr == (*j).addrLow)
-                {
-                    NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::Add(): "
-                                 "Address Collision: "
-                                 << Ipv4Address(addr));
-                    if (!m_test)
-                    {
-                        NS_FATAL_ERROR("Ipv4AddressGeneratorImpl::Add(): Address Collision: "
-                                       << Ipv4Address(addr));
-                    }
-                    return false;
-                }
-            }
-
             NS_LOG_LOGIC("New addrHigh = " << Ipv4Address(addr));
-            (*i).addrHigh = addr;
-            return true;
-        }
-        //
-        // If we get here, we know that the next lower block of addresses couldn't
-        // have been extended to include this new address since the code immediately
-        // above would have been executed and that next lower block extended upward.
-        // So we know it's safe to extend the current block down to include the new
-        // address.
-        //
-        if (addr == (*i).addrLow - 1)
-        {
-            NS_LOG_LOGIC("New addrLow = " << Ipv4Address(addr));
-            (*i).addrLow = addr;
+            i->second = addr;
             return true;
         }
     }
+    //
+    // If the new address fits at the beginning of the next block, extend the
+    // block down to include the new address.
+    //
+    if (next != m_entries.end() && addr == next->first - 1)
+    {
+        NS_LOG_LOGIC("New addrLow = " << Ipv4Address(addr));
+        uint32_t addrHigh = next->second;
+        m_entries.emplace_hint(m_entries.erase(next), addr, addrHigh);
+        return true;
+    }
 
-    Entry entry;
-    entry.addrLow = entry.addrHigh = addr;
-    m_entries.insert(i, entry);
+    m_entries.emplace_hint(next, addr, addr);
     return true;
 }
 
@@ -459,13 +428,13 @@ Ipv4AddressGeneratorImpl::IsAddressAllocated(const Ipv4Address address)
         addr,
         "Ipv4AddressGeneratorImpl::IsAddressAllocated(): Don't check for the broadcast address...");
 
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    Entries::const_iterator next = m_entries.upper_bound(addr);
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
-        if (addr >= (*i).addrLow && addr <= (*i).addrHigh)
+        Entries::const_iterator i = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(i->first) << " to "
+                                       << Ipv4Address(i->second));
+        if (addr <= i->second)
         {
             NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::IsAddressAllocated(): Address Collision: "
                          << Ipv4Address(addr));
@@ -485,14 +454,21 @@ Ipv4AddressGeneratorImpl::IsNetworkAllocated(const Ipv4Address address, const Ip
         "Ipv4AddressGeneratorImpl::IsNetworkAllocated(): network address and mask don't match "
             << address << " " << mask);
 
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // Only the block before the network and the first block starting in the
+    // network can have an end in the network.
+    //
+    Entries::const_iterator i = m_entries.lower_bound(address.Get());
+    if (i != m_entries.begin())
+    {
+        --i;
+    }
+    for (uint32_t examined = 0; i != m_entries.end() && examined < 2; ++i, ++examined)
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
-        Ipv4Address low = Ipv4Address((*i).addrLow);
-        Ipv4Address high = Ipv4Address((*i).addrHigh);
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(i->first) << " to "
+                                       << Ipv4Address(i->second));
+        Ipv4Address low = Ipv4Address(i->first);
+        Ipv4Address high = Ipv4Address(i->second);
 
         if (address == low.CombineMask(mask) || address == high.CombineMask(mask))
         {
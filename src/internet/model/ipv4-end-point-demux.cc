@@ -24,6 +24,11 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -32,7 +37,8 @@ NS_LOG_COMPONENT_DEFINE("Ipv4EndPointDemux");
 Ipv4EndPointDemux::Ipv4EndPointDemux()
     : m_ephemeral(49152),
       m_portLast(65535),
-      m_portFirst(49152)
+      m_portFirst(49152),
+      m_nextSequence(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -46,30 +52,91 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_peerEndPoints.clear();
+    m_portEndPoints.clear();
+    m_endPointPositions.clear();
 }
 
 bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv4EndPointDemux::PeerKey::operator==(const PeerKey& other) const
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return localPort == other.localPort && peerAddress == other.peerAddress &&
+           peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv4EndPointDemux::PeerKeyHash::operator()(const PeerKey& key) const
+{
+    uint64_t value = key.peerAddress.Get();
+    value = (value << 32) | (static_cast<uint32_t>(key.localPort) << 16) | key.peerPort;
+    return std::hash<uint64_t>()(value);
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    uint64_t sequence = m_nextSequence++;
+    m_endPointPositions[endPoint] = {m_endPoints.insert(m_endPoints.end(), endPoint), sequence};
+    m_portEndPoints[endPoint->GetLocalPort()].emplace(sequence, endPoint);
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    m_peerEndPoints[key].emplace(sequence, endPoint);
+    endPoint->SetPeerChangeCallback(MakeCallback(&Ipv4EndPointDemux::PeerChanged, this));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::PeerChanged(Ipv4EndPoint* endPoint, Ipv4Address peerAddress, uint16_t peerPort)
+{
+    NS_LOG_FUNCTION(this << endPoint << peerAddress << peerPort);
+    PeerKey oldKey = {endPoint->GetLocalPort(), peerAddress, peerPort};
+    auto it = m_peerEndPoints.find(oldKey);
+    NS_ASSERT(it != m_peerEndPoints.end());
+    uint64_t sequence = m_endPointPositions.at(endPoint).sequence;
+    it->second.erase(sequence);
+    if (it->second.empty())
     {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
+        m_peerEndPoints.erase(it);
     }
-    return false;
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    m_peerEndPoints[key].emplace(sequence, endPoint);
+}
+
+const Ipv4EndPointDemux::EndPointSet*
+Ipv4EndPointDemux::GetPeerEndPoints(uint16_t localPort,
+                                    Ipv4Address peerAddress,
+                                    uint16_t peerPort) const
+{
+    PeerKey key = {localPort, peerAddress, peerPort};
+    auto it = m_peerEndPoints.find(key);
+    if (it == m_peerEndPoints.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_portEndPoints.find(port) != m_portEndPoints.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_portEndPoints.find(port);
+    if (it == m_portEndPoints.end())
+    {
+        return false;
+    }
+    for (const auto& entry : it->second)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        Ipv4EndPoint* endPoint = entry.second;
+        if (endPoint->GetLocalAddress() == addr && endPoint->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -88,9 +155,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -104,9 +169,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -127,9 +190,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -140,38 +201,52 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    const EndPointSet* endPoints = GetPeerEndPoints(localPort, peerAddress, peerPort);
+    if (endPoints)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (const auto& entry : *endPoints)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            Ipv4EndPoint* endP = entry.second;
+            if (endP->GetLocalAddress() == localAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_endPointPositions.find(endPoint);
+    if (position == m_endPointPositions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    uint64_t sequence = position->second.sequence;
+    m_endPoints.erase(position->second.position);
+    m_endPointPositions.erase(position);
+
+    auto port = m_portEndPoints.find(endPoint->GetLocalPort());
+    port->second.erase(sequence);
+    if (port->second.empty())
+    {
+        m_portEndPoints.erase(port);
     }
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    auto peer = m_peerEndPoints.find(key);
+    peer->second.erase(sequence);
+    if (peer->second.empty())
+    {
+        m_peerEndPoints.erase(peer);
+    }
+    delete endPoint;
 }
 
 /*
@@ -211,9 +286,33 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    // Only the endpoints with the packet destination port, and a peer which is
+    // either the packet source or a wildcard, can match the packet.  They are
+    // looked at in allocation order, as in the list of end points.
+    std::vector<std::pair<uint64_t, Ipv4EndPoint*>> candidates;
+    PeerKey keys[] = {{dport, saddr, sport},
+                      {dport, saddr, 0},
+                      {dport, Ipv4Address::GetAny(), sport},
+                      {dport, Ipv4Address::GetAny(), 0}};
+    for (uint32_t k = 0; k < 4; k++)
     {
-        Ipv4EndPoint* endP = *i;
+        bool duplicate = false;
+        for (uint32_t j = 0; j < k; j++)
+        {
+            duplicate = duplicate || keys[j] == keys[k];
+        }
+        auto it = m_peerEndPoints.find(keys[k]);
+        if (!duplicate && it != m_peerEndPoints.end())
+        {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto i = candidates.begin(); i != candidates.end(); i++)
+    {
+        Ipv4EndPoint* endP = i->second;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
@@ -25,7 +25,9 @@
 #include "ns3/ipv4-address.h"
 
 #include <list>
+#include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -177,6 +179,79 @@ class Ipv4EndPointDemux
      */
     uint16_t AllocateEphemeralPort();
 
+    /**
+     * \brief Key of the endpoints with the same local port and peer.
+     *
+     * The endpoints which are not connected to a peer have the peer
+     * address Any and the peer port 0.
+     */
+    struct PeerKey
+    {
+        uint16_t localPort;      //!< local port
+        Ipv4Address peerAddress; //!< peer address
+        uint16_t peerPort;       //!< peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the other key
+         * \return true if the keys are equal
+         */
+        bool operator==(const PeerKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of PeerKey.
+     */
+    struct PeerKeyHash
+    {
+        /**
+         * \param key the key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const PeerKey& key) const;
+    };
+
+    /**
+     * \brief Set of IPv4 end points, indexed by their allocation sequence number
+     * so that they are iterated in the order of the list of end points.
+     */
+    typedef std::map<uint64_t, Ipv4EndPoint*> EndPointSet;
+
+    /**
+     * \brief Position of an end point in the list of end points.
+     */
+    struct EndPointPosition
+    {
+        EndPointsI position; //!< iterator in the list of end points
+        uint64_t sequence;   //!< allocation sequence number
+    };
+
+    /**
+     * \brief Add an end point to the list of end points and to the indexes.
+     * \param endPoint the end point
+     * \return the end point
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Update the index of an end point whose peer has changed.
+     * \param endPoint the end point
+     * \param peerAddress the previous peer address
+     * \param peerPort the previous peer port
+     */
+    void PeerChanged(Ipv4EndPoint* endPoint, Ipv4Address peerAddress, uint16_t peerPort);
+
+    /**
+     * \brief Get the end points with a local port and a peer.
+     * \param localPort the local port
+     * \param peerAddress the peer address
+     * \param peerPort the peer port
+     * \return the end points, or nullptr if there is none
+     */
+    const EndPointSet* GetPeerEndPoints(uint16_t localPort,
+                                        Ipv4Address peerAddress,
+                                        uint16_t peerPort) const;
+
     /**
      * \brief The ephemeral port.
      */
@@ -196,6 +271,26 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The end points, indexed by local port and peer.
+     */
+    std::unordered_map<PeerKey, EndPointSet, PeerKeyHash> m_peerEndPoints;
+
+    /**
+     * \brief The end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointSet> m_portEndPoints;
+
+    /**
+     * \brief The position of the end points in the list of end points.
+     */
+    std::unordered_map<Ipv4EndPoint*, EndPointPosition> m_endPointPositions;
+
+    /**
+     * \brief The sequence number of the next end point allocated.
+     */
+    uint64_t m_nextSequence;
 };
 
 } // namespace ns3
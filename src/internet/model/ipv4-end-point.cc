@@ -89,8 +89,14 @@ void
 Ipv4EndPoint::SetPeer(Ipv4Address address, uint16_t port)
 {
     NS_LOG_FUNCTION(this << address << port);
+    Ipv4Address oldAddress = m_peerAddr;
+    uint16_t oldPort = m_peerPort;
     m_peerAddr = address;
     m_peerPort = port;
+    if (!m_peerChangeCallback.IsNull())
+    {
+        m_peerChangeCallback(this, oldAddress, oldPort);
+    }
 }
 
 void
@@ -130,6 +136,14 @@ Ipv4EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv4EndPoint::SetPeerChangeCallback(
+    Callback<void, Ipv4EndPoint*, Ipv4Address, uint16_t> callback)
+{
+    NS_LOG_FUNCTION(this << &callback);
+    m_peerChangeCallback = callback;
+}
+
 void
 Ipv4EndPoint::ForwardUp(Ptr<Packet> p,
                         const Ipv4Header& header,
@@ -18,6 +18,7 @@
 #include "ipv4-global-routing.h"
 
 #include "global-route-manager.h"
+#include "ipv4-routing-table-index.h"
 
 #include "ns3/boolean.h"
 #include "ns3/ipv4-route.h"
@@ -30,7 +31,10 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace ns3
@@ -40,6 +44,481 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+/**
+ * \brief Lookup index of the destinations of the routes, which can be shared
+ * by the route tables of several nodes.
+ *
+ * Each destination network and mask added to the index gets a slot, kept
+ * as long as the index.  The index holds no route: the routes of each
+ * route table are stored by slot (see RouteIndex).  The nodes whose routes
+ * have the same destinations but other gateways, e.g. the nodes of a
+ * point-to-point topology, can thus look up their routes in the same index.
+ */
+struct Ipv4GlobalRouting::PrefixIndex : public SimpleRefCount<Ipv4GlobalRouting::PrefixIndex>
+{
+    /// The categories of routes, each with its own shared index
+    enum Category
+    {
+        HOST_ROUTES,
+        NETWORK_ROUTES,
+        AS_EXTERNAL_ROUTES,
+        N_CATEGORIES
+    };
+
+    PrefixIndex();
+    ~PrefixIndex();
+
+    /**
+     * \param network the destination network
+     * \param mask the network mask
+     * \return the slot of the destination, which is added if needed
+     */
+    uint32_t GetSlot(Ipv4Address network, Ipv4Mask mask);
+
+    /**
+     * \return the number of slots of the index
+     */
+    uint32_t GetNSlots() const;
+
+    /**
+     * \param category the category of the routes
+     * \return the index shared by the route tables for this category of routes
+     */
+    static Ptr<PrefixIndex> GetShared(Category category);
+
+    /**
+     * \return the shared indexes, by category of routes
+     */
+    static std::vector<PrefixIndex*>& GetSharedIndexes();
+
+    /**
+     * \return all the indexes
+     */
+    static std::unordered_set<const PrefixIndex*>& GetIndexes();
+
+    /// The destinations, each with a single route whose position is its slot
+    Ipv4RoutingTableIndex m_index;
+};
+
+/**
+ * \brief Lookup index of the routes of a route table.
+ *
+ * The destinations matching an address are looked up in a PrefixIndex,
+ * possibly shared with other route tables, which gives their slots; the
+ * routes are stored by slot.
+ */
+struct Ipv4GlobalRouting::RouteIndex
+{
+    RouteIndex();
+
+    /**
+     * \brief Remove all the routes; the index is then valid for an empty
+     * routing table.
+     */
+    void Clear();
+
+    /**
+     * \brief Mark the index as out of date with respect to the routes.
+     */
+    void Invalidate();
+
+    /**
+     * \return true if the index is up to date with the routes.
+     */
+    bool IsValid() const;
+
+    /**
+     * \brief Rebuild the index.
+     * \param routes the routes, in routing table order
+     * \param prefixes the index of the destinations of the routes
+     */
+    void Build(const std::list<Ipv4RoutingTableEntry*>& routes, Ptr<PrefixIndex> prefixes);
+
+    /**
+     * \brief Find the routes matching an address.
+     * \param dest the address
+     * \param routes the matching routes, longest network mask first, and in
+     * routing table order for each destination
+     */
+    void Lookup(Ipv4Address dest, std::vector<Ipv4RoutingTableIndex::Route>& routes) const;
+
+    Ptr<PrefixIndex> m_prefixes;                        //!< index of the destinations
+    std::vector<uint32_t> m_first;                      //!< first route of each slot, and end
+    std::vector<Ipv4RoutingTableIndex::Route> m_routes; //!< the routes, sorted by slot
+    bool m_valid;                                       //!< whether the index is up to date
+};
+
+Ipv4GlobalRouting::PrefixIndex::PrefixIndex()
+{
+    GetIndexes().insert(this);
+}
+
+Ipv4GlobalRouting::PrefixIndex::~PrefixIndex()
+{
+    for (auto& shared : GetSharedIndexes())
+    {
+        if (shared == this)
+        {
+            shared = nullptr;
+        }
+    }
+    GetIndexes().erase(this);
+}
+
+uint32_t
+Ipv4GlobalRouting::PrefixIndex::GetSlot(Ipv4Address network, Ipv4Mask mask)
+{
+    const Ipv4RoutingTableIndex::RouteGroup* group = m_index.Find(network, mask);
+    if (group)
+    {
+        return group->front().position;
+    }
+    m_index.Add(network, mask, nullptr, 0);
+    return m_index.GetNRoutes() - 1;
+}
+
+uint32_t
+Ipv4GlobalRouting::PrefixIndex::GetNSlots() const
+{
+    return m_index.GetNRoutes();
+}
+
+Ptr<Ipv4GlobalRouting::PrefixIndex>
+Ipv4GlobalRouting::PrefixIndex::GetShared(Category category)
+{
+    PrefixIndex*& shared = GetSharedIndexes()[category];
+    if (!shared)
+    {
+        // freed with the last route table using it
+        Ptr<PrefixIndex> index = Create<PrefixIndex>();
+        shared = PeekPointer(index);
+        return index;
+    }
+    return Ptr<PrefixIndex>(shared);
+}
+
+std::vector<Ipv4GlobalRouting::PrefixIndex*>&
+Ipv4GlobalRouting::PrefixIndex::GetSharedIndexes()
+{
+    // never deleted, as route tables may outlive the static objects
+    static auto indexes = new std::vector<PrefixIndex*>(N_CATEGORIES, nullptr);
+    return *indexes;
+}
+
+std::unordered_set<const Ipv4GlobalRouting::PrefixIndex*>&
+Ipv4GlobalRouting::PrefixIndex::GetIndexes()
+{
+    // never deleted, as route tables may outlive the static objects
+    static auto indexes = new std::unordered_set<const PrefixIndex*>;
+    return *indexes;
+}
+
+Ipv4GlobalRouting::RouteIndex::RouteIndex()
+    : m_valid(true)
+{
+}
+
+void
+Ipv4GlobalRouting::RouteIndex::Clear()
+{
+    m_prefixes = nullptr;
+    m_first.clear();
+    m_routes.clear();
+    m_valid = true;
+}
+
+void
+Ipv4GlobalRouting::RouteIndex::Invalidate()
+{
+    m_valid = false;
+}
+
+bool
+Ipv4GlobalRouting::RouteIndex::IsValid() const
+{
+    return m_valid;
+}
+
+void
+Ipv4GlobalRouting::RouteIndex::Build(const std::list<Ipv4RoutingTableEntry*>& routes,
+                                     Ptr<PrefixIndex> prefixes)
+{
+    std::vector<uint32_t> slots;
+    slots.reserve(routes.size());
+    for (auto route : routes)
+    {
+        slots.push_back(prefixes->GetSlot(route->GetDestNetwork(), route->GetDestNetworkMask()));
+    }
+
+    // sort the routes by slot, keeping the routing table order of each slot
+    m_prefixes = prefixes;
+    m_first.assign(prefixes->GetNSlots() + 1, 0);
+    for (auto slot : slots)
+    {
+        m_first[slot + 1]++;
+    }
+    for (std::size_t slot = 1; slot < m_first.size(); slot++)
+    {
+        m_first[slot] += m_first[slot - 1];
+    }
+    std::vector<uint32_t> next(m_first.begin(), m_first.end() - 1);
+    m_routes.resize(routes.size());
+    uint32_t position = 0;
+    for (auto route : routes)
+    {
+        Ipv4RoutingTableIndex::Route& r = m_routes[next[slots[position]]++];
+        r.entry = route;
+        r.metric = 0;
+        r.position = position++;
+    }
+    m_valid = true;
+}
+
+void
+Ipv4GlobalRouting::RouteIndex::Lookup(Ipv4Address dest,
+                                      std::vector<Ipv4RoutingTableIndex::Route>& routes) const
+{
+    NS_ASSERT_MSG(m_valid, "Lookup in an out of date route index");
+    routes.clear();
+    if (!m_prefixes)
+    {
+        return;
+    }
+    std::vector<const Ipv4RoutingTableIndex::RouteGroup*> matches;
+    m_prefixes->m_index.Lookup(dest, matches);
+    for (const auto group : matches)
+    {
+        // the slots added to a shared index after this one was built have no route
+        uint32_t slot = group->front().position;
+        if (slot + 1 < m_first.size())
+        {
+            routes.insert(routes.end(),
+                          m_routes.begin() + m_first[slot],
+                          m_routes.begin() + m_first[slot + 1]);
+        }
+    }
+}
+
+/**
+ * \brief The unicast routes of an Ipv4GlobalRouting, and their lookup indexes.
+ *
+ * A route table can be shared by the Ipv4GlobalRouting of several nodes (see
+ * Ipv4GlobalRouting::ShareRouteTable); the routes of a shared table must not
+ * be modified.  The lookup indexes are rebuilt lazily from the routes, so
+ * they can be updated by any of the nodes sharing the table.
+ */
+struct Ipv4GlobalRouting::RouteTable : public SimpleRefCount<Ipv4GlobalRouting::RouteTable>
+{
+    RouteTable();
+    ~RouteTable();
+
+    /**
+     * \return a private copy of the routes
+     */
+    Ptr<RouteTable> Copy() const;
+
+    /**
+     * \return a hash of the routes
+     */
+    std::size_t Hash() const;
+
+    /**
+     * \param other another route table
+     * \return true if the two tables have the same routes, in the same order
+     */
+    bool IsEqual(const RouteTable& other) const;
+
+    /**
+     * \brief Delete all the routes, and remove the table from the shared
+     * tables if it was registered.
+     */
+    void Clear();
+
+    /**
+     * \brief Register the table among the shared tables.
+     */
+    void Register();
+
+    /**
+     * \brief Remove the table from the shared tables, if it was registered.
+     */
+    void Unregister();
+
+    /**
+     * \return the number of routes of the table
+     */
+    uint32_t GetNRoutes() const;
+
+    /**
+     * \return the shared route tables, indexed by their hash
+     */
+    static std::unordered_multimap<std::size_t, RouteTable*>& GetSharedTables();
+
+    /**
+     * \return all the route tables
+     */
+    static std::unordered_set<const RouteTable*>& GetTables();
+
+    HostRoutes m_hostRoutes;             //!< Routes to hosts
+    NetworkRoutes m_networkRoutes;       //!< Routes to networks
+    ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
+
+    RouteIndex m_hostRouteIndex;       //!< Lookup index of m_hostRoutes
+    RouteIndex m_networkRouteIndex;    //!< Lookup index of m_networkRoutes
+    RouteIndex m_ASexternalRouteIndex; //!< Lookup index of m_ASexternalRoutes
+
+    bool m_shared;      //!< whether the table is registered among the shared tables
+    std::size_t m_hash; //!< hash of the routes, valid if the table is shared
+};
+
+Ipv4GlobalRouting::RouteTable::RouteTable()
+    : m_shared(false),
+      m_hash(0)
+{
+    GetTables().insert(this);
+}
+
+Ipv4GlobalRouting::RouteTable::~RouteTable()
+{
+    Clear();
+    GetTables().erase(this);
+}
+
+void
+Ipv4GlobalRouting::RouteTable::Clear()
+{
+    Unregister();
+    for (auto route : m_hostRoutes)
+    {
+        delete route;
+    }
+    m_hostRoutes.clear();
+    m_hostRouteIndex.Clear();
+    for (auto route : m_networkRoutes)
+    {
+        delete route;
+    }
+    m_networkRoutes.clear();
+    m_networkRouteIndex.Clear();
+    for (auto route : m_ASexternalRoutes)
+    {
+        delete route;
+    }
+    m_ASexternalRoutes.clear();
+    m_ASexternalRouteIndex.Clear();
+}
+
+Ptr<Ipv4GlobalRouting::RouteTable>
+Ipv4GlobalRouting::RouteTable::Copy() const
+{
+    Ptr<RouteTable> copy = Create<RouteTable>();
+    for (auto route : m_hostRoutes)
+    {
+        copy->m_hostRoutes.push_back(new Ipv4RoutingTableEntry(*route));
+    }
+    for (auto route : m_networkRoutes)
+    {
+        copy->m_networkRoutes.push_back(new Ipv4RoutingTableEntry(*route));
+    }
+    for (auto route : m_ASexternalRoutes)
+    {
+        copy->m_ASexternalRoutes.push_back(new Ipv4RoutingTableEntry(*route));
+    }
+    copy->m_hostRouteIndex.Invalidate();
+    copy->m_networkRouteIndex.Invalidate();
+    copy->m_ASexternalRouteIndex.Invalidate();
+    return copy;
+}
+
+std::size_t
+Ipv4GlobalRouting::RouteTable::Hash() const
+{
+    std::size_t hash = 0;
+    auto combine = [&hash](uint32_t value) {
+        hash ^= std::hash<uint32_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    for (const auto routes : {&m_hostRoutes, &m_networkRoutes, &m_ASexternalRoutes})
+    {
+        combine(routes->size());
+        for (auto route : *routes)
+        {
+            combine(route->GetDest().Get());
+            combine(route->GetDestNetworkMask().Get());
+            combine(route->GetGateway().Get());
+            combine(route->GetInterface());
+        }
+    }
+    return hash;
+}
+
+bool
+Ipv4GlobalRouting::RouteTable::IsEqual(const RouteTable& other) const
+{
+    auto equal = [](const std::list<Ipv4RoutingTableEntry*>& routes1,
+                    const std::list<Ipv4RoutingTableEntry*>& routes2) {
+        return std::equal(routes1.begin(),
+                          routes1.end(),
+                          routes2.begin(),
+                          routes2.end(),
+                          [](const Ipv4RoutingTableEntry* r1, const Ipv4RoutingTableEntry* r2) {
+                              return *r1 == *r2;
+                          });
+    };
+    return equal(m_hostRoutes, other.m_hostRoutes) &&
+           equal(m_networkRoutes, other.m_networkRoutes) &&
+           equal(m_ASexternalRoutes, other.m_ASexternalRoutes);
+}
+
+void
+Ipv4GlobalRouting::RouteTable::Register()
+{
+    NS_ASSERT(!m_shared);
+    m_hash = Hash();
+    m_shared = true;
+    GetSharedTables().emplace(m_hash, this);
+}
+
+void
+Ipv4GlobalRouting::RouteTable::Unregister()
+{
+    if (!m_shared)
+    {
+        return;
+    }
+    auto range = GetSharedTables().equal_range(m_hash);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second == this)
+        {
+            GetSharedTables().erase(it);
+            break;
+        }
+    }
+    m_shared = false;
+}
+
+uint32_t
+Ipv4GlobalRouting::RouteTable::GetNRoutes() const
+{
+    return m_hostRoutes.size() + m_networkRoutes.size() + m_ASexternalRoutes.size();
+}
+
+std::unordered_multimap<std::size_t, Ipv4GlobalRouting::RouteTable*>&
+Ipv4GlobalRouting::RouteTable::GetSharedTables()
+{
+    // never deleted, as route tables may outlive the static objects
+    static auto tables = new std::unordered_multimap<std::size_t, RouteTable*>;
+    return *tables;
+}
+
+std::unordered_set<const Ipv4GlobalRouting::RouteTable*>&
+Ipv4GlobalRouting::RouteTable::GetTables()
+{
+    // never deleted, as route tables may outlive the static objects
+    static auto tables = new std::unordered_set<const RouteTable*>;
+    return *tables;
+}
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -58,17 +537,25 @@ Ipv4GlobalRouting::GetTypeId()
                           "Interface notification events (up/down, or add/remove address)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_respondToInterfaceEvents),
+                          MakeBooleanChecker())
+            .AddAttribute("ShareRouteTable",
+                          "Set to true to share the global routes of this node with the other "
+                          "nodes which have the same routes, to save memory in large topologies",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4GlobalRouting::m_shareRouteTable),
                           MakeBooleanChecker());
     return tid;
 }
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_shareRouteTable(false)
 {
     NS_LOG_FUNCTION(this);
 
     m_rand = CreateObject<UniformRandomVariable>();
+    m_routes = Create<RouteTable>();
 }
 
 Ipv4GlobalRouting::~Ipv4GlobalRouting()
@@ -80,18 +567,22 @@ void
 Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
+    UnshareRouteTable();
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    m_hostRoutes.push_back(route);
+    m_routes->m_hostRoutes.push_back(route);
+    m_routes->m_hostRouteIndex.Invalidate();
 }
 
 void
 Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << dest << interface);
+    UnshareRouteTable();
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
-    m_hostRoutes.push_back(route);
+    m_routes->m_hostRoutes.push_back(route);
+    m_routes->m_hostRouteIndex.Invalidate();
 }
 
 void
@@ -101,18 +592,22 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
                                      uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    UnshareRouteTable();
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    m_networkRoutes.push_back(route);
+    m_routes->m_networkRoutes.push_back(route);
+    m_routes->m_networkRouteIndex.Invalidate();
 }
 
 void
 Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << interface);
+    UnshareRouteTable();
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    m_networkRoutes.push_back(route);
+    m_routes->m_networkRoutes.push_back(route);
+    m_routes->m_networkRouteIndex.Invalidate();
 }
 
 void
@@ -122,9 +617,11 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
                                         uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    UnshareRouteTable();
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    m_ASexternalRoutes.push_back(route);
+    m_routes->m_ASexternalRoutes.push_back(route);
+    m_routes->m_ASexternalRouteIndex.Invalidate();
 }
 
 Ptr<Ipv4Route>
@@ -137,66 +634,77 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
-    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    UpdateRouteIndexes();
+    std::vector<Ipv4RoutingTableIndex::Route> matches;
+
+    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_routes->m_hostRoutes.size());
+    m_routes->m_hostRouteIndex.Lookup(dest, matches);
+    for (const auto& r : matches)
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        NS_ASSERT(r.entry->IsHost());
+        if (oif)
         {
-            if (oif)
+            if (oif != m_ipv4->GetNetDevice(r.entry->GetInterface()))
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
         }
+        allRoutes.push_back(r.entry);
+        NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << r.entry);
     }
     if (allRoutes.size() == 0) // if no host route is found
     {
-        NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        NS_LOG_LOGIC("Number of m_networkRoutes" << m_routes->m_networkRoutes.size());
+        // all the matching network routes are kept, in routing table order
+        std::vector<Ipv4RoutingTableIndex::Route> found;
+        m_routes->m_networkRouteIndex.Lookup(dest, matches);
+        for (const auto& r : matches)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            if (oif)
             {
-                if (oif)
+                if (oif != m_ipv4->GetNetDevice(r.entry->GetInterface()))
                 {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
                 }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
             }
+            found.push_back(r);
+        }
+        std::sort(found.begin(), found.end(), [](const auto& r1, const auto& r2) {
+            return r1.position < r2.position;
+        });
+        for (const auto& r : found)
+        {
+            allRoutes.push_back(r.entry);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << r.entry);
         }
     }
     if (allRoutes.size() == 0) // consider external if no host/network found
     {
-        for (ASExternalRoutesI k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        // only the first matching external route is used
+        const Ipv4RoutingTableIndex::Route* first = nullptr;
+        m_routes->m_ASexternalRouteIndex.Lookup(dest, matches);
+        for (const auto& r : matches)
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            if (first && first->position < r.position)
             {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
+                continue;
+            }
+            if (oif)
+            {
+                if (oif != m_ipv4->GetNetDevice(r.entry->GetInterface()))
                 {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
                 }
-                allRoutes.push_back(*k);
-                break;
             }
+            first = &r;
+        }
+        if (first)
+        {
+            NS_LOG_LOGIC("Found external route" << first->entry);
+            allRoutes.push_back(first->entry);
         }
     }
     if (allRoutes.size() > 0) // if route(s) is found
@@ -230,14 +738,40 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+void
+Ipv4GlobalRouting::UpdateRouteIndexes()
+{
+    NS_LOG_FUNCTION(this);
+    // the destinations are looked up in the indexes shared by all the nodes
+    // sharing their routes, whatever their gateways
+    auto getPrefixIndex = [this](PrefixIndex::Category category) {
+        return m_shareRouteTable ? PrefixIndex::GetShared(category) : Create<PrefixIndex>();
+    };
+    if (!m_routes->m_hostRouteIndex.IsValid())
+    {
+        m_routes->m_hostRouteIndex.Build(m_routes->m_hostRoutes,
+                                         getPrefixIndex(PrefixIndex::HOST_ROUTES));
+    }
+    if (!m_routes->m_networkRouteIndex.IsValid())
+    {
+        m_routes->m_networkRouteIndex.Build(m_routes->m_networkRoutes,
+                                            getPrefixIndex(PrefixIndex::NETWORK_ROUTES));
+    }
+    if (!m_routes->m_ASexternalRouteIndex.IsValid())
+    {
+        m_routes->m_ASexternalRouteIndex.Build(m_routes->m_ASexternalRoutes,
+                                               getPrefixIndex(PrefixIndex::AS_EXTERNAL_ROUTES));
+    }
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
     NS_LOG_FUNCTION(this);
     uint32_t n = 0;
-    n += m_hostRoutes.size();
-    n += m_networkRoutes.size();
-    n += m_ASexternalRoutes.size();
+    n += m_routes->m_hostRoutes.size();
+    n += m_routes->m_networkRoutes.size();
+    n += m_routes->m_ASexternalRoutes.size();
     return n;
 }
 
@@ -245,10 +779,11 @@ Ipv4RoutingTableEntry*
 Ipv4GlobalRouting::GetRoute(uint32_t index) const
 {
     NS_LOG_FUNCTION(this << index);
-    if (index < m_hostRoutes.size())
+    if (index < m_routes->m_hostRoutes.size())
     {
         uint32_t tmp = 0;
-        for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+        for (HostRoutesCI i = m_routes->m_hostRoutes.begin(); i != m_routes->m_hostRoutes.end();
+             i++)
         {
             if (tmp == index)
             {
@@ -257,11 +792,13 @@ Ipv4GlobalRouting::GetRoute(uint32_t index) const
             tmp++;
         }
     }
-    index -= m_hostRoutes.size();
+    index -= m_routes->m_hostRoutes.size();
     uint32_t tmp = 0;
-    if (index < m_networkRoutes.size())
+    if (index < m_routes->m_networkRoutes.size())
     {
-        for (NetworkRoutesCI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        for (NetworkRoutesCI j = m_routes->m_networkRoutes.begin();
+             j != m_routes->m_networkRoutes.end();
+             j++)
         {
             if (tmp == index)
             {
@@ -270,9 +807,11 @@ Ipv4GlobalRouting::GetRoute(uint32_t index) const
             tmp++;
         }
     }
-    index -= m_networkRoutes.size();
+    index -= m_routes->m_networkRoutes.size();
     tmp = 0;
-    for (ASExternalRoutesCI k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+    for (ASExternalRoutesCI k = m_routes->m_ASexternalRoutes.begin();
+         k != m_routes->m_ASexternalRoutes.end();
+         k++)
     {
         if (tmp == index)
         {
@@ -289,49 +828,62 @@ void
 Ipv4GlobalRouting::RemoveRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
-    if (index < m_hostRoutes.size())
+    UnshareRouteTable();
+    if (index < m_routes->m_hostRoutes.size())
     {
         uint32_t tmp = 0;
-        for (HostRoutesI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+        for (HostRoutesI i = m_routes->m_hostRoutes.begin(); i != m_routes->m_hostRoutes.end(); i++)
         {
             if (tmp == index)
             {
-                NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                NS_LOG_LOGIC("Removing route " << index
+                                               << "; size = " << m_routes->m_hostRoutes.size());
                 delete *i;
-                m_hostRoutes.erase(i);
+                m_routes->m_hostRoutes.erase(i);
+                m_routes->m_hostRouteIndex.Invalidate();
                 NS_LOG_LOGIC("Done removing host route "
-                             << index << "; host route remaining size = " << m_hostRoutes.size());
+                             << index << "; host route remaining size = "
+                             << m_routes->m_hostRoutes.size());
                 return;
             }
             tmp++;
         }
     }
-    index -= m_hostRoutes.size();
+    index -= m_routes->m_hostRoutes.size();
     uint32_t tmp = 0;
-    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    for (NetworkRoutesI j = m_routes->m_networkRoutes.begin(); j != m_routes->m_networkRoutes.end();
+         j++)
     {
         if (tmp == index)
         {
-            NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            NS_LOG_LOGIC("Removing route " << index
+                                           << "; size = " << m_routes->m_networkRoutes.size());
             delete *j;
-            m_networkRoutes.erase(j);
+            m_routes->m_networkRoutes.erase(j);
+            m_routes->m_networkRouteIndex.Invalidate();
             NS_LOG_LOGIC("Done removing network route "
-                         << index << "; network route remaining size = " << m_networkRoutes.size());
+                         << index << "; network route remaining size = "
+                         << m_routes->m_networkRoutes.size());
             return;
         }
         tmp++;
     }
-    index -= m_networkRoutes.size();
+    index -= m_routes->m_networkRoutes.size();
     tmp = 0;
-    for (ASExternalRoutesI k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+    for (ASExternalRoutesI k = m_routes->m_ASexternalRoutes.begin();
+         k != m_routes->m_ASexternalRoutes.end();
+         k++)
     {
         if (tmp == index)
         {
-            NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            NS_LOG_LOGIC("Removing route " << index
+                                           << "; size = " << m_routes->m_ASexternalRoutes.size());
             delete *k;
-            m_ASexternalRoutes.erase(k);
+            m_routes->m_ASexternalRoutes.erase(k);
+            m_routes->m_ASexternalRouteIndex.Invalidate();
             NS_LOG_LOGIC("Done removing network route "
-                         << index << "; network route remaining size = " << m_networkRoutes.size());
+                         << index << "; network route remaining size = "
+                         << m_routes->m_networkRoutes.size());
             return;
         }
         tmp++;
@@ -339,6 +891,108 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+void
+Ipv4GlobalRouting::ShareRouteTable()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_shareRouteTable || m_routes->m_shared)
+    {
+        return;
+    }
+    std::size_t hash = m_routes->Hash();
+    auto range = RouteTable::GetSharedTables().equal_range(hash);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second->IsEqual(*m_routes))
+        {
+            NS_LOG_LOGIC("Sharing " << m_routes->GetNRoutes() << " routes");
+            m_routes = it->second;
+            return;
+        }
+    }
+    m_routes->Register();
+}
+
+void
+Ipv4GlobalRouting::UnshareRouteTable()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_routes->m_shared)
+    {
+        return;
+    }
+    if (m_routes->GetReferenceCount() > 1)
+    {
+        NS_LOG_LOGIC("Copying " << m_routes->GetNRoutes() << " shared routes");
+        m_routes = m_routes->Copy();
+    }
+    else
+    {
+        m_routes->Unregister();
+    }
+}
+
+Ipv4GlobalRouting::RouteTableStats
+Ipv4GlobalRouting::GetRouteTableStats()
+{
+    // memory used by a route: the entry, its list node and its index entry
+    const uint64_t routeBytes = sizeof(Ipv4RoutingTableEntry) +
+                                sizeof(std::list<Ipv4RoutingTableEntry*>::value_type) +
+                                2 * sizeof(void*) + sizeof(Ipv4RoutingTableIndex::Route);
+    // memory used by a destination: its hash table node and its slot
+    const uint64_t prefixBytes = sizeof(uint32_t) + sizeof(Ipv4RoutingTableIndex::RouteGroup) +
+                                 2 * sizeof(void*) + sizeof(Ipv4RoutingTableIndex::Route);
+
+    RouteTableStats stats;
+    stats.nTables = 0;
+    stats.nSharedTables = 0;
+    stats.nRoutes = 0;
+    stats.nNodeRoutes = 0;
+    stats.nBytes = 0;
+    stats.nPrefixIndexes = 0;
+    stats.nSharedPrefixIndexes = 0;
+    stats.nPrefixes = 0;
+    for (const auto table : RouteTable::GetTables())
+    {
+        uint32_t nRoutes = table->GetNRoutes();
+        if (nRoutes == 0)
+        {
+            continue;
+        }
+        uint32_t nUsers = table->GetReferenceCount();
+        stats.nTables++;
+        if (nUsers > 1)
+        {
+            stats.nSharedTables++;
+        }
+        stats.nRoutes += nRoutes;
+        stats.nNodeRoutes += static_cast<uint64_t>(nRoutes) * nUsers;
+        stats.nBytes += nRoutes * routeBytes;
+        for (const auto index : {&table->m_hostRouteIndex,
+                                 &table->m_networkRouteIndex,
+                                 &table->m_ASexternalRouteIndex})
+        {
+            stats.nBytes += index->m_first.size() * sizeof(uint32_t);
+        }
+    }
+    for (const auto index : PrefixIndex::GetIndexes())
+    {
+        uint32_t nPrefixes = index->GetNSlots();
+        if (nPrefixes == 0)
+        {
+            continue;
+        }
+        stats.nPrefixIndexes++;
+        if (index->GetReferenceCount() > 1)
+        {
+            stats.nSharedPrefixIndexes++;
+        }
+        stats.nPrefixes += nPrefixes;
+        stats.nBytes += nPrefixes * prefixBytes;
+    }
+    return stats;
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams(int64_t stream)
 {
@@ -351,19 +1005,15 @@ void
 Ipv4GlobalRouting::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (HostRoutesI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i = m_hostRoutes.erase(i))
+    // the shared routes are deleted with the last routing protocol using them,
+    // the node is left with an empty route table
+    if (m_routes->GetReferenceCount() > 1)
     {
-        delete (*i);
+        m_routes = Create<RouteTable>();
     }
-    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end();
-         j = m_networkRoutes.erase(j))
-    {
-        delete (*j);
-    }
-    for (ASExternalRoutesI l = m_ASexternalRoutes.begin(); l != m_ASexternalRoutes.end();
-         l = m_ASexternalRoutes.erase(l))
+    else
     {
-        delete (*l);
+        m_routes->Clear();
     }
 
     Ipv4RoutingProtocol::DoDispose();
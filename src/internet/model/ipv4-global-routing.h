@@ -221,6 +221,52 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     void RemoveRoute(uint32_t i);
 
+    /**
+     * \brief Share the routes of this routing protocol with the other nodes
+     * which have the same routes.
+     *
+     * If the ShareRouteTable attribute is true, the routes are looked up in
+     * a registry of the route tables of all the nodes: if another node has the
+     * same routes (same destinations, gateways and interfaces, in the same
+     * order), its route table is used instead of the one of this node, which
+     * is freed; otherwise the route table of this node is registered for the
+     * next nodes.  A shared route table is immutable: a node which adds or
+     * removes a route first gets a private copy of the routes.
+     *
+     * Whether or not their routes are identical, the nodes with the
+     * ShareRouteTable attribute set look up the destinations of their routes
+     * in the same lookup indexes, and only store their own gateways and
+     * interfaces, e.g. the nodes of a point-to-point topology, which all
+     * have routes to the same destinations through distinct gateways.
+     *
+     * This method is called by the GlobalRouteManager once the routes of the
+     * node are computed.
+     */
+    void ShareRouteTable();
+
+    /// Memory usage of the routes of all the Ipv4GlobalRouting instances
+    struct RouteTableStats
+    {
+        uint32_t nTables;              //!< number of non-empty route tables
+        uint32_t nSharedTables;        //!< number of route tables used by more than one node
+        uint64_t nRoutes;              //!< number of routes stored in the route tables
+        uint64_t nNodeRoutes;          //!< number of routes seen by the nodes
+        uint64_t nBytes;               //!< estimated memory of the routes and indexes, in bytes
+        uint32_t nPrefixIndexes;       //!< number of non-empty lookup indexes of destinations
+        uint32_t nSharedPrefixIndexes; //!< number of them used by more than one route table
+        uint64_t nPrefixes;            //!< number of destinations of the lookup indexes
+    };
+
+    /**
+     * \brief Get the memory usage of the routes of all the Ipv4GlobalRouting
+     * instances.
+     *
+     * nNodeRoutes - nRoutes is the number of routes saved by ShareRouteTable ().
+     *
+     * \return the memory usage statistics
+     */
+    static RouteTableStats GetRouteTableStats();
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -273,9 +319,26 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
-    HostRoutes m_hostRoutes;             //!< Routes to hosts
-    NetworkRoutes m_networkRoutes;       //!< Routes to networks
-    ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
+    /**
+     * \brief Rebuild the out of date lookup indexes of the routes.
+     */
+    void UpdateRouteIndexes();
+
+    /**
+     * \brief Make the routes private to this routing protocol before they are
+     * modified, if they are shared with other nodes.
+     */
+    void UnshareRouteTable();
+
+    /// The unicast routes of a node, defined in the implementation file
+    struct RouteTable;
+    /// Lookup index of the destinations of the routes, defined in the implementation file
+    struct PrefixIndex;
+    /// Lookup index of the routes of a route table, defined in the implementation file
+    struct RouteIndex;
+
+    Ptr<RouteTable> m_routes; //!< the unicast routes, possibly shared with other nodes
+    bool m_shareRouteTable;   //!< whether ShareRouteTable () may share the routes
 
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
@@ -0,0 +1,126 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv4-routing-table-index.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv4RoutingTableIndex");
+
+Ipv4RoutingTableIndex::Ipv4RoutingTableIndex()
+    : m_tables(),
+      m_nRoutes(0),
+      m_valid(true)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+Ipv4RoutingTableIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_tables.clear();
+    m_nRoutes = 0;
+    m_valid = true;
+}
+
+void
+Ipv4RoutingTableIndex::Invalidate()
+{
+    NS_LOG_FUNCTION(this);
+    m_valid = false;
+}
+
+bool
+Ipv4RoutingTableIndex::IsValid() const
+{
+    return m_valid;
+}
+
+void
+Ipv4RoutingTableIndex::Add(Ipv4Address network,
+                           Ipv4Mask mask,
+                           Ipv4RoutingTableEntry* entry,
+                           uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << network << mask << entry << metric);
+
+    // keep the tables sorted by decreasing prefix length (and mask, to
+    // separate non-contiguous masks with the same prefix length)
+    uint16_t prefixLength = mask.GetPrefixLength();
+    auto table = m_tables.begin();
+    while (table != m_tables.end() &&
+           (table->prefixLength > prefixLength ||
+            (table->prefixLength == prefixLength && table->mask.Get() > mask.Get())))
+    {
+        table++;
+    }
+    if (table == m_tables.end() || table->mask != mask)
+    {
+        MaskTable newTable;
+        newTable.mask = mask;
+        newTable.prefixLength = prefixLength;
+        table = m_tables.insert(table, newTable);
+    }
+
+    Route route;
+    route.entry = entry;
+    route.metric = metric;
+    route.position = m_nRoutes++;
+    table->groups[network.CombineMask(mask).Get()].push_back(route);
+}
+
+void
+Ipv4RoutingTableIndex::Lookup(Ipv4Address dest, std::vector<const RouteGroup*>& matches) const
+{
+    NS_LOG_FUNCTION(this << dest);
+    NS_ASSERT_MSG(m_valid, "Lookup in an out of date routing table index");
+
+    matches.clear();
+    for (const auto& table : m_tables)
+    {
+        auto group = table.groups.find(dest.CombineMask(table.mask).Get());
+        if (group != table.groups.end())
+        {
+            matches.push_back(&group->second);
+        }
+    }
+}
+
+const Ipv4RoutingTableIndex::RouteGroup*
+Ipv4RoutingTableIndex::Find(Ipv4Address network, Ipv4Mask mask) const
+{
+    NS_LOG_FUNCTION(this << network << mask);
+    for (const auto& table : m_tables)
+    {
+        if (table.mask == mask)
+        {
+            auto group = table.groups.find(network.CombineMask(mask).Get());
+            return group != table.groups.end() ? &group->second : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t
+Ipv4RoutingTableIndex::GetNRoutes() const
+{
+    return m_nRoutes;
+}
+
+} // namespace ns3
@@ -0,0 +1,121 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef IPV4_ROUTING_TABLE_INDEX_H
+#define IPV4_ROUTING_TABLE_INDEX_H
+
+#include "ns3/ipv4-address.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Ipv4RoutingTableEntry;
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Lookup index of the unicast routes of an IPv4 routing table.
+ *
+ * The routes are grouped by destination network and network mask; the
+ * groups with the same mask are stored in a hash table, so that the routes
+ * matching an address are found with one hash lookup per distinct network
+ * mask of the routing table, instead of a scan of the whole table.
+ *
+ * The index does not own the routing table entries.  It is meant to be
+ * rebuilt lazily by the routing protocol: the protocol invalidates it
+ * whenever its routing table changes, and re-adds all its routes, in
+ * routing table order, before the next lookup.
+ */
+class Ipv4RoutingTableIndex
+{
+  public:
+    /// A route of the index
+    struct Route
+    {
+        Ipv4RoutingTableEntry* entry; //!< the routing table entry
+        uint32_t metric;              //!< the metric of the route
+        uint32_t position;            //!< the position of the route in the routing table
+    };
+
+    /// Routes with the same destination network and mask, in routing table order
+    typedef std::vector<Route> RouteGroup;
+
+    Ipv4RoutingTableIndex();
+
+    /**
+     * \brief Remove all the routes; the index is then valid for an empty
+     * routing table.
+     */
+    void Clear();
+
+    /**
+     * \brief Mark the index as out of date with respect to the routing table.
+     */
+    void Invalidate();
+
+    /**
+     * \return true if the index is up to date with the routing table.
+     */
+    bool IsValid() const;
+
+    /**
+     * \brief Add a route at the end of the index.
+     * \param network the destination network of the route
+     * \param mask the network mask of the route
+     * \param entry the routing table entry
+     * \param metric the metric of the route
+     */
+    void Add(Ipv4Address network, Ipv4Mask mask, Ipv4RoutingTableEntry* entry, uint32_t metric);
+
+    /**
+     * \brief Find the routes matching an address.
+     * \param dest the address
+     * \param matches the groups of matching routes, longest network mask first
+     */
+    void Lookup(Ipv4Address dest, std::vector<const RouteGroup*>& matches) const;
+
+    /**
+     * \brief Find the routes to a destination network.
+     * \param network the destination network
+     * \param mask the network mask
+     * \return the routes with this destination network and mask, or nullptr
+     */
+    const RouteGroup* Find(Ipv4Address network, Ipv4Mask mask) const;
+
+    /**
+     * \return the number of routes in the index
+     */
+    uint32_t GetNRoutes() const;
+
+  private:
+    /// Routes with the same network mask, indexed by destination network
+    struct MaskTable
+    {
+        Ipv4Mask mask;                                   //!< the network mask
+        uint16_t prefixLength;                           //!< the prefix length of the mask
+        std::unordered_map<uint32_t, RouteGroup> groups; //!< the routes
+    };
+
+    std::vector<MaskTable> m_tables; //!< the tables, longest network mask first
+    uint32_t m_nRoutes;              //!< number of routes
+    bool m_valid;                    //!< whether the index is up to date
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ROUTING_TABLE_INDEX_H */
@@ -20,8 +20,8 @@
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (m_ipv4 && m_ipv4->GetObject<Node>())                                                       \
     {                                                                                              \
-        std::clog << Simulator::Now().GetSeconds() << " [node "                                    \
-                  << m_ipv4->GetObject<Node>()->GetId() << "] ";                                   \
+        LogGetContextStream() << Simulator::Now().GetSeconds() << " [node "                        \
+                              << m_ipv4->GetObject<Node>()->GetId() << "] ";                       \
     }
 
 #include "ipv4-static-routing.h"
@@ -37,6 +37,7 @@
 #include "ns3/simulator.h"
 
 #include <iomanip>
+#include <vector>
 
 using std::make_pair;
 
@@ -80,6 +81,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        AddToRouteIndex(routePtr, metric);
     }
 }
 
@@ -98,6 +100,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
 
         m_networkRoutes.emplace_back(routePtr, metric);
+        AddToRouteIndex(routePtr, metric);
     }
 }
 
@@ -153,6 +156,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Mask networkMask = Ipv4Mask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
     m_networkRoutes.emplace_back(route, 0);
+    AddToRouteIndex(route, 0);
 }
 
 uint32_t
@@ -224,21 +228,60 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // an identical route has the same network and mask, hence is among
+    // the routes matching the network
+    UpdateRouteIndex();
+    std::vector<const Ipv4RoutingTableIndex::RouteGroup*> matches;
+    m_networkRouteIndex.Lookup(route.GetDestNetwork(), matches);
+    for (const auto group : matches)
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
-
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
+        for (const auto& r : *group)
         {
-            return true;
+            Ipv4RoutingTableEntry* rtentry = r.entry;
+
+            if (rtentry->GetDest() == route.GetDest() &&
+                rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
+                rtentry->GetGateway() == route.GetGateway() &&
+                rtentry->GetInterface() == route.GetInterface() && r.metric == metric)
+            {
+                return true;
+            }
         }
     }
     return false;
 }
 
+void
+Ipv4StaticRouting::AddToRouteIndex(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    // an out of date index is rebuilt on the next lookup anyway
+    if (m_networkRouteIndex.IsValid())
+    {
+        m_networkRouteIndex.Add(route->GetDestNetwork(),
+                                route->GetDestNetworkMask(),
+                                route,
+                                metric);
+    }
+}
+
+void
+Ipv4StaticRouting::UpdateRouteIndex()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_networkRouteIndex.IsValid())
+    {
+        return;
+    }
+    m_networkRouteIndex.Clear();
+    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    {
+        m_networkRouteIndex.Add(j->first->GetDestNetwork(),
+                                j->first->GetDestNetworkMask(),
+                                j->first,
+                                j->second);
+    }
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
@@ -261,17 +304,26 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (NetworkRoutesI i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    // The matching routes are visited longest mask first.  Among the routes
+    // with the longest mask, the selected route is the first host route, or
+    // the network route with the lowest metric (the last one in the routing
+    // table, in case of equal metrics).
+    UpdateRouteIndex();
+    std::vector<const Ipv4RoutingTableIndex::RouteGroup*> matches;
+    m_networkRouteIndex.Lookup(dest, matches);
+    const Ipv4RoutingTableIndex::Route* best = nullptr;
+    for (const auto group : matches)
     {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
+        uint16_t masklen = group->front().entry->GetDestNetworkMask().GetPrefixLength();
+        if (best && masklen < longest_mask) // Not interested if got shorter mask
+        {
+            NS_LOG_LOGIC("Previous match longer, skipping");
+            break;
+        }
+        for (const auto& r : *group)
         {
+            Ipv4RoutingTableEntry* j = r.entry;
+            uint32_t metric = r.metric;
             NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
                                                        << ", metric " << metric);
             if (oif)
@@ -282,35 +334,34 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
                     continue;
                 }
             }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
+            if (best)
             {
-                shortest_metric = 0xffffffff;
+                bool preferBest =
+                    (masklen == 32)
+                        ? best->position < r.position
+                        : (metric > shortest_metric ||
+                           (metric == shortest_metric && r.position < best->position));
+                if (preferBest)
+                {
+                    NS_LOG_LOGIC("Equal mask length, but previous route preferred, skipping");
+                    continue;
+                }
             }
             longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
             shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
+            best = &r;
         }
     }
+    if (best)
+    {
+        Ipv4RoutingTableEntry* route = best->entry;
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
+    }
     if (rtentry)
     {
         NS_LOG_LOGIC("Matching route via " << rtentry->GetGateway() << " at the end");
@@ -459,6 +510,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
         {
             delete j->first;
             m_networkRoutes.erase(j);
+            m_networkRouteIndex.Invalidate();
             return;
         }
         tmp++;
@@ -593,6 +645,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRouteIndex.Clear();
     for (MulticastRoutesI i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -634,6 +687,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
         }
         else
         {
@@ -679,6 +733,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
         }
         else
         {
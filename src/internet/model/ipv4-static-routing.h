@@ -21,6 +21,8 @@
 #ifndef IPV4_STATIC_ROUTING_H
 #define IPV4_STATIC_ROUTING_H
 
+#include "ipv4-routing-table-index.h"
+
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-routing-protocol.h"
@@ -405,11 +407,28 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4MulticastRoute> LookupStatic(Ipv4Address origin, Ipv4Address group, uint32_t interface);
 
+    /**
+     * \brief Add a route appended to the forwarding table to its lookup index.
+     * \param route the route
+     * \param metric metric of route
+     */
+    void AddToRouteIndex(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Rebuild the lookup index of the network routes, if out of date.
+     */
+    void UpdateRouteIndex();
+
     /**
      * \brief the forwarding table for network.
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the lookup index of the forwarding table for network.
+     */
+    Ipv4RoutingTableIndex m_networkRouteIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
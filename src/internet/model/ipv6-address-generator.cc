@@ -23,7 +23,8 @@
 #include "ns3/log.h"
 #include "ns3/simulation-singleton.h"
 
-#include <list>
+#include <iterator>
+#include <map>
 
 namespace ns3
 {
@@ -162,6 +163,20 @@ class Ipv6AddressGeneratorImpl
      */
     uint32_t PrefixToIndex(Ipv6Prefix prefix) const;
 
+    /**
+     * \brief Get the address following a given address
+     * \param addr the address
+     * \returns the next address
+     */
+    static Ipv6Address NextOf(const Ipv6Address addr);
+
+    /**
+     * \brief Get the address preceding a given address
+     * \param addr the address
+     * \returns the previous address
+     */
+    static Ipv6Address PreviousOf(const Ipv6Address addr);
+
     /**
      * \brief This class holds the state for a given network
      */
@@ -178,18 +193,14 @@ class Ipv6AddressGeneratorImpl
     NetworkState m_netTable[N_BITS]; //!< the available networks
 
     /**
-     * \brief This class holds the allocated addresses
+     * \brief The blocks of allocated addresses: the highest allocated address
+     * of each block, by the lowest allocated address of the block
      */
-    class Entry
-    {
-      public:
-        uint8_t addrLow[16];  //!< the lowest allocated address
-        uint8_t addrHigh[16]; //!< the highest allocated address
-    };
+    typedef std::map<Ipv6Address, Ipv6Address> Entries;
 
-    std::list<Entry> m_entries; //!< contained of allocated addresses
-    Ipv6Address m_base;         //!< base address
-    bool m_test;                //!< test mode (if true)
+    Entries m_entries;  //!< contained of allocated addresses
+    Ipv6Address m_base; //!< base address
+    bool m_test;        //!< test mode (if true)
 };
 
 Ipv6AddressGeneratorImpl::Ipv6AddressGeneratorImpl()
@@ -460,116 +471,55 @@ Ipv6AddressGeneratorImpl::AddAllocated(const Ipv6Address address)
 {
     NS_LOG_FUNCTION(this << address);
 
-    uint8_t addr[16];
-    address.GetBytes(addr);
-
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The blocks are sorted by address, so only the block before the new
+    // address and the block after it need to be examined.
+    //
+    Entries::iterator next = m_entries.upper_bound(address);
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
+        Entries::iterator i = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << i->first << " to " << i->second);
         //
         // First things first.  Is there an address collision -- that is, does the
         // new address fall in a previously allocated block of addresses.
         //
-        if (!(Ipv6Address(addr) < Ipv6Address((*i).addrLow)) &&
-            ((Ipv6Address(addr) < Ipv6Address((*i).addrHigh)) ||
-             (Ipv6Address(addr) == Ipv6Address((*i).addrHigh))))
+        if (!(i->second < address))
         {
-            NS_LOG_LOGIC(
-                "Ipv6AddressGeneratorImpl::Add(): Address Collision: " << Ipv6Address(addr));
+            NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::Add(): Address Collision: " << address);
             if (!m_test)
             {
-                NS_FATAL_ERROR(
-                    "Ipv6AddressGeneratorImpl::Add(): Address Collision: " << Ipv6Address(addr));
+                NS_FATAL_ERROR("Ipv6AddressGeneratorImpl::Add(): Address Collision: " << address);
             }
             return false;
         }
         //
-        // If the new address is less than the lowest address in the current
-        // block and can't be merged into to the current block, then insert it
-        // as a new block before the current block.
-        //
-        uint8_t taddr[16];
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] -= 1;
-        if (Ipv6Address(addr) < Ipv6Address(taddr))
-        {
-            break;
-        }
-        //
-        // If the new address fits at the end of the block, look ahead to the next
-        // block and make sure it's not a collision there.  If we won't overlap,
-        // then just extend the current block by one address.  We expect that
-        // completely filled network ranges will be a fairly rare occurrence,
-        // so we don't worry about collapsing address range blocks.
+        // If the new address fits at the end of the block, just extend the block
+        // by one address.  The next block starts after the new address, so there
+        // is no collision there.  We expect that completely filled network ranges
+        // will be a fairly rare occurrence, so we don't worry about collapsing
+        // address range blocks.
         //
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] += 1;
-        if (Ipv6Address(addr) == Ipv6Address(taddr))
+        if (address == NextOf(i->second))
         {
-            std::list<Entry>::iterator j = i;
-            ++j;
-
-            if (j != m_entries.end())
-            {
-                if (Ipv6Address(addr) == Ipv6Address((*j).addrLow))
-                {
-                    NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::Add(): "
-                                 "Address Collision: "
-                                 << Ipv6Address(addr));
-                    if (!m_test)
-                    {
-                        NS_FATAL_ERROR("Ipv6AddressGeneratorImpl::Add(): Address Collision: "
-                                       << Ipv6Address(addr));
-                    }
-                    return false;
-                }
-            }
-
-            NS_LOG_LOGIC("New addrHigh = " << Ipv6Address(addr));
-            for (uint32_t j = 0; j < 16; j++)
-            {
-                (*i).addrHigh[j] = addr[j];
-            }
-            return true;
-        }
-        //
-        // If we get here, we know that the next lower block of addresses
-        // couldn't have been extended to include this new address since the
-        // code immediately above would have been executed and that next lower
-        // block extended upward.  So we know it's safe to extend the current
-        // block down to include the new address.
-        //
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] -= 1;
-        if ((Ipv6Address(addr) == Ipv6Address(taddr)))
-        {
-            NS_LOG_LOGIC("New addrLow = " << Ipv6Address(addr));
-            for (uint32_t j = 0; j < 16; j++)
-            {
-                (*i).addrLow[j] = addr[j];
-            }
+            NS_LOG_LOGIC("New addrHigh = " << address);
+            i->second = address;
             return true;
         }
     }
-
-    Entry entry;
-    for (uint32_t j = 0; j < 16; j++)
+    //
+    // If the new address fits at the beginning of the next block, extend the
+    // block down to include the new address.
+    //
+    if (next != m_entries.end() && address == PreviousOf(next->first))
     {
-        entry.addrLow[j] = entry.addrHigh[j] = addr[j];
+        NS_LOG_LOGIC("New addrLow = " << address);
+        Ipv6Address addrHigh = next->second;
+        m_entries.emplace_hint(m_entries.erase(next), address, addrHigh);
+        return true;
     }
-    m_entries.insert(i, entry);
+
+    m_entries.emplace_hint(next, address, address);
     return true;
 }
 
@@ -578,22 +528,15 @@ Ipv6AddressGeneratorImpl::IsAddressAllocated(const Ipv6Address address)
 {
     NS_LOG_FUNCTION(this << address);
 
-    uint8_t addr[16];
-    address.GetBytes(addr);
-
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    Entries::const_iterator next = m_entries.upper_bound(address);
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
-
-        if (!(Ipv6Address(addr) < Ipv6Address((*i).addrLow)) &&
-            ((Ipv6Address(addr) < Ipv6Address((*i).addrHigh)) ||
-             (Ipv6Address(addr) == Ipv6Address((*i).addrHigh))))
+        Entries::const_iterator i = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << i->first << " to " << i->second);
+        if (!(i->second < address))
         {
             NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::IsAddressAllocated(): Address Collision: "
-                         << Ipv6Address(addr));
+                         << address);
             return false;
         }
     }
@@ -611,14 +554,20 @@ Ipv6AddressGeneratorImpl::IsNetworkAllocated(const Ipv6Address address, const Ip
         "Ipv6AddressGeneratorImpl::IsNetworkAllocated(): network address and mask don't match "
             << address << " " << prefix);
 
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // Only the block before the network and the first block starting in the
+    // network can have an end in the network.
+    //
+    Entries::const_iterator i = m_entries.lower_bound(address);
+    if (i != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
-        Ipv6Address low = Ipv6Address((*i).addrLow);
-        Ipv6Address high = Ipv6Address((*i).addrHigh);
+        --i;
+    }
+    for (uint32_t examined = 0; i != m_entries.end() && examined < 2; ++i, ++examined)
+    {
+        NS_LOG_LOGIC("examine entry: " << i->first << " to " << i->second);
+        Ipv6Address low = i->first;
+        Ipv6Address high = i->second;
 
         if (address == low.CombinePrefix(prefix) || address == high.CombinePrefix(prefix))
         {
@@ -673,6 +622,36 @@ Ipv6AddressGeneratorImpl::PrefixToIndex(Ipv6Prefix prefix) const
     return 0;
 }
 
+Ipv6Address
+Ipv6AddressGeneratorImpl::NextOf(const Ipv6Address addr)
+{
+    uint8_t bytes[16];
+    addr.GetBytes(bytes);
+    for (int32_t j = 15; j >= 0; j--)
+    {
+        if (++bytes[j] != 0)
+        {
+            break;
+        }
+    }
+    return Ipv6Address(bytes);
+}
+
+Ipv6Address
+Ipv6AddressGeneratorImpl::PreviousOf(const Ipv6Address addr)
+{
+    uint8_t bytes[16];
+    addr.GetBytes(bytes);
+    for (int32_t j = 15; j >= 0; j--)
+    {
+        if (bytes[j]-- != 0)
+        {
+            break;
+        }
+    }
+    return Ipv6Address(bytes);
+}
+
 void
 Ipv6AddressGenerator::Init(const Ipv6Address net,
                            const Ipv6Prefix prefix,
@@ -23,6 +23,10 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -31,7 +35,8 @@ NS_LOG_COMPONENT_DEFINE("Ipv6EndPointDemux");
 Ipv6EndPointDemux::Ipv6EndPointDemux()
     : m_ephemeral(49152),
       m_portFirst(49152),
-      m_portLast(65535)
+      m_portLast(65535),
+      m_nextSequence(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -45,30 +50,90 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_peerEndPoints.clear();
+    m_portEndPoints.clear();
+    m_endPointPositions.clear();
 }
 
 bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv6EndPointDemux::PeerKey::operator==(const PeerKey& other) const
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return localPort == other.localPort && peerAddress == other.peerAddress &&
+           peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv6EndPointDemux::PeerKeyHash::operator()(const PeerKey& key) const
+{
+    std::size_t ports = (static_cast<uint32_t>(key.localPort) << 16) | key.peerPort;
+    return Ipv6AddressHash()(key.peerAddress) ^ (ports * 0x9e3779b1);
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    uint64_t sequence = m_nextSequence++;
+    m_endPointPositions[endPoint] = {m_endPoints.insert(m_endPoints.end(), endPoint), sequence};
+    m_portEndPoints[endPoint->GetLocalPort()].emplace(sequence, endPoint);
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    m_peerEndPoints[key].emplace(sequence, endPoint);
+    endPoint->SetPeerChangeCallback(MakeCallback(&Ipv6EndPointDemux::PeerChanged, this));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::PeerChanged(Ipv6EndPoint* endPoint, Ipv6Address peerAddress, uint16_t peerPort)
+{
+    NS_LOG_FUNCTION(this << endPoint << peerAddress << peerPort);
+    PeerKey oldKey = {endPoint->GetLocalPort(), peerAddress, peerPort};
+    auto it = m_peerEndPoints.find(oldKey);
+    NS_ASSERT(it != m_peerEndPoints.end());
+    uint64_t sequence = m_endPointPositions.at(endPoint).sequence;
+    it->second.erase(sequence);
+    if (it->second.empty())
     {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
+        m_peerEndPoints.erase(it);
     }
-    return false;
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    m_peerEndPoints[key].emplace(sequence, endPoint);
+}
+
+const Ipv6EndPointDemux::EndPointSet*
+Ipv6EndPointDemux::GetPeerEndPoints(uint16_t localPort,
+                                    Ipv6Address peerAddress,
+                                    uint16_t peerPort) const
+{
+    PeerKey key = {localPort, peerAddress, peerPort};
+    auto it = m_peerEndPoints.find(key);
+    if (it == m_peerEndPoints.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_portEndPoints.find(port) != m_portEndPoints.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_portEndPoints.find(port);
+    if (it == m_portEndPoints.end())
+    {
+        return false;
+    }
+    for (const auto& entry : it->second)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        Ipv6EndPoint* endPoint = entry.second;
+        if (endPoint->GetLocalAddress() == addr && endPoint->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -87,9 +152,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -103,9 +166,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -126,9 +187,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -139,38 +198,52 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    const EndPointSet* endPoints = GetPeerEndPoints(localPort, peerAddress, peerPort);
+    if (endPoints)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (const auto& entry : *endPoints)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            Ipv6EndPoint* endP = entry.second;
+            if (endP->GetLocalAddress() == localAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_endPointPositions.find(endPoint);
+    if (position == m_endPointPositions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    uint64_t sequence = position->second.sequence;
+    m_endPoints.erase(position->second.position);
+    m_endPointPositions.erase(position);
+
+    auto port = m_portEndPoints.find(endPoint->GetLocalPort());
+    port->second.erase(sequence);
+    if (port->second.empty())
+    {
+        m_portEndPoints.erase(port);
+    }
+    PeerKey key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    auto peer = m_peerEndPoints.find(key);
+    peer->second.erase(sequence);
+    if (peer->second.empty())
+    {
+        m_peerEndPoints.erase(peer);
     }
+    delete endPoint;
 }
 
 /*
@@ -193,9 +266,33 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    // Only the endpoints with the packet destination port, and a peer which is
+    // either the packet source or a wildcard, can match the packet.  They are
+    // looked at in allocation order, as in the list of end points.
+    std::vector<std::pair<uint64_t, Ipv6EndPoint*>> candidates;
+    PeerKey keys[] = {{dport, saddr, sport},
+                      {dport, saddr, 0},
+                      {dport, Ipv6Address::GetAny(), sport},
+                      {dport, Ipv6Address::GetAny(), 0}};
+    for (uint32_t k = 0; k < 4; k++)
+    {
+        bool duplicate = false;
+        for (uint32_t j = 0; j < k; j++)
+        {
+            duplicate = duplicate || keys[j] == keys[k];
+        }
+        auto it = m_peerEndPoints.find(keys[k]);
+        if (!duplicate && it != m_peerEndPoints.end())
+        {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto i = candidates.begin(); i != candidates.end(); i++)
     {
-        Ipv6EndPoint* endP = *i;
+        Ipv6EndPoint* endP = i->second;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
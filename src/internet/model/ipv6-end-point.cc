@@ -99,8 +99,14 @@ Ipv6EndPoint::GetBoundNetDevice()
 void
 Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
+    Ipv6Address oldAddr = m_peerAddr;
+    uint16_t oldPort = m_peerPort;
     m_peerAddr = addr;
     m_peerPort = port;
+    if (!m_peerChangeCallback.IsNull())
+    {
+        m_peerChangeCallback(this, oldAddr, oldPort);
+    }
 }
 
 void
@@ -123,6 +129,13 @@ Ipv6EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv6EndPoint::SetPeerChangeCallback(
+    Callback<void, Ipv6EndPoint*, Ipv6Address, uint16_t> callback)
+{
+    m_peerChangeCallback = callback;
+}
+
 void
 Ipv6EndPoint::ForwardUp(Ptr<Packet> p,
                         Ipv6Header header,
@@ -151,6 +151,17 @@ class Ipv6EndPoint
      */
     void SetDestroyCallback(Callback<void> callback);
 
+    /**
+     * \brief Set the callback invoked when the peer of the end point changes.
+     *
+     * This callback is used by the Ipv6EndPointDemux owning the end point
+     * to keep its lookup index up to date.
+     *
+     * \param callback callback function, called with the end point and its
+     * previous peer address and port
+     */
+    void SetPeerChangeCallback(Callback<void, Ipv6EndPoint*, Ipv6Address, uint16_t> callback);
+
     /**
      * \brief Forward the packet to the upper level.
      *
@@ -234,6 +245,11 @@ class Ipv6EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The peer change callback.
+     */
+    Callback<void, Ipv6EndPoint*, Ipv6Address, uint16_t> m_peerChangeCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
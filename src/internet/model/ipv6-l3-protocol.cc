@@ -41,6 +41,7 @@
 #include "ns3/mac64-address.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -1263,7 +1264,10 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    // TSO super-segments are left whole, the device accounts for their segmentation
+    SegmentationOffloadTag tsoTag;
+    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu &&
+        !packet->PeekPacketTag(tsoTag))
     {
         // Router => drop
         if (!fromMe)
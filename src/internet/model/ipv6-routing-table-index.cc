@@ -0,0 +1,110 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv6-routing-table-index.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv6RoutingTableIndex");
+
+Ipv6RoutingTableIndex::Ipv6RoutingTableIndex()
+    : m_tables(),
+      m_nRoutes(0),
+      m_valid(true)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+Ipv6RoutingTableIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_tables.clear();
+    m_nRoutes = 0;
+    m_valid = true;
+}
+
+void
+Ipv6RoutingTableIndex::Invalidate()
+{
+    NS_LOG_FUNCTION(this);
+    m_valid = false;
+}
+
+bool
+Ipv6RoutingTableIndex::IsValid() const
+{
+    return m_valid;
+}
+
+void
+Ipv6RoutingTableIndex::Add(Ipv6Address network,
+                           Ipv6Prefix prefix,
+                           Ipv6RoutingTableEntry* entry,
+                           uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << network << prefix << entry << metric);
+
+    // keep the tables sorted by decreasing prefix length (the routes with
+    // the same prefix length are compared regardless of their table)
+    uint8_t prefixLength = prefix.GetPrefixLength();
+    auto table = m_tables.begin();
+    while (table != m_tables.end() && table->prefixLength >= prefixLength &&
+           table->prefix != prefix)
+    {
+        table++;
+    }
+    if (table == m_tables.end() || table->prefix != prefix)
+    {
+        PrefixTable newTable;
+        newTable.prefix = prefix;
+        newTable.prefixLength = prefixLength;
+        table = m_tables.insert(table, newTable);
+    }
+
+    Route route;
+    route.entry = entry;
+    route.metric = metric;
+    route.position = m_nRoutes++;
+    table->groups[network.CombinePrefix(prefix)].push_back(route);
+}
+
+void
+Ipv6RoutingTableIndex::Lookup(Ipv6Address dest, std::vector<const RouteGroup*>& matches) const
+{
+    NS_LOG_FUNCTION(this << dest);
+    NS_ASSERT_MSG(m_valid, "Lookup in an out of date routing table index");
+
+    matches.clear();
+    for (const auto& table : m_tables)
+    {
+        auto group = table.groups.find(dest.CombinePrefix(table.prefix));
+        if (group != table.groups.end())
+        {
+            matches.push_back(&group->second);
+        }
+    }
+}
+
+uint32_t
+Ipv6RoutingTableIndex::GetNRoutes() const
+{
+    return m_nRoutes;
+}
+
+} // namespace ns3
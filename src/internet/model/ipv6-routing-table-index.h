@@ -0,0 +1,117 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef IPV6_ROUTING_TABLE_INDEX_H
+#define IPV6_ROUTING_TABLE_INDEX_H
+
+#include "ns3/ipv6-address.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Ipv6RoutingTableEntry;
+
+/**
+ * \ingroup ipv6Routing
+ *
+ * \brief Lookup index of the unicast routes of an IPv6 routing table.
+ *
+ * The routes are grouped by destination network and prefix; the groups with
+ * the same prefix are stored in a hash table, so that the routes matching an
+ * address are found with one hash lookup per distinct prefix of the routing
+ * table, instead of a scan of the whole table.
+ *
+ * The index does not own the routing table entries.  It is meant to be
+ * rebuilt lazily by the routing protocol: the protocol invalidates it
+ * whenever its routing table changes, and re-adds all its routes, in
+ * routing table order, before the next lookup.
+ */
+class Ipv6RoutingTableIndex
+{
+  public:
+    /// A route of the index
+    struct Route
+    {
+        Ipv6RoutingTableEntry* entry; //!< the routing table entry
+        uint32_t metric;              //!< the metric of the route
+        uint32_t position;            //!< the position of the route in the routing table
+    };
+
+    /// Routes with the same destination network and prefix, in routing table order
+    typedef std::vector<Route> RouteGroup;
+
+    Ipv6RoutingTableIndex();
+
+    /**
+     * \brief Remove all the routes; the index is then valid for an empty
+     * routing table.
+     */
+    void Clear();
+
+    /**
+     * \brief Mark the index as out of date with respect to the routing table.
+     */
+    void Invalidate();
+
+    /**
+     * \return true if the index is up to date with the routing table.
+     */
+    bool IsValid() const;
+
+    /**
+     * \brief Add a route at the end of the index.
+     * \param network the destination network of the route
+     * \param prefix the network prefix of the route
+     * \param entry the routing table entry
+     * \param metric the metric of the route
+     */
+    void Add(Ipv6Address network,
+             Ipv6Prefix prefix,
+             Ipv6RoutingTableEntry* entry,
+             uint32_t metric);
+
+    /**
+     * \brief Find the routes matching an address.
+     * \param dest the address
+     * \param matches the groups of matching routes, longest prefix first
+     */
+    void Lookup(Ipv6Address dest, std::vector<const RouteGroup*>& matches) const;
+
+    /**
+     * \return the number of routes in the index
+     */
+    uint32_t GetNRoutes() const;
+
+  private:
+    /// Routes with the same network prefix, indexed by destination network
+    struct PrefixTable
+    {
+        Ipv6Prefix prefix;    //!< the network prefix
+        uint8_t prefixLength; //!< the length of the prefix
+        /// the routes
+        std::unordered_map<Ipv6Address, RouteGroup, Ipv6AddressHash> groups;
+    };
+
+    std::vector<PrefixTable> m_tables; //!< the tables, longest prefix first
+    uint32_t m_nRoutes;              //!< number of routes
+    bool m_valid;                    //!< whether the index is up to date
+};
+
+} // namespace ns3
+
+#endif /* IPV6_ROUTING_TABLE_INDEX_H */
@@ -30,6 +30,7 @@
 #include "ns3/simulator.h"
 
 #include <iomanip>
+#include <vector>
 
 namespace ns3
 {
@@ -183,6 +184,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        AddToRouteIndex(routePtr, metric);
     }
 }
 
@@ -210,6 +212,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        AddToRouteIndex(routePtr, metric);
     }
 }
 
@@ -227,6 +230,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        AddToRouteIndex(routePtr, metric);
     }
 }
 
@@ -269,6 +273,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
     m_networkRoutes.emplace_back(route, 0);
+    AddToRouteIndex(route, 0);
 }
 
 uint32_t
@@ -363,22 +368,61 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // an identical route has the same network and prefix, hence is among
+    // the routes matching the network
+    UpdateRouteIndex();
+    std::vector<const Ipv6RoutingTableIndex::RouteGroup*> matches;
+    m_networkRouteIndex.Lookup(route.GetDestNetwork(), matches);
+    for (const auto group : matches)
     {
-        Ipv6RoutingTableEntry* rtentry = j->first;
-
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() &&
-            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j->second == metric)
+        for (const auto& r : *group)
         {
-            return true;
+            Ipv6RoutingTableEntry* rtentry = r.entry;
+
+            if (rtentry->GetDest() == route.GetDest() &&
+                rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
+                rtentry->GetGateway() == route.GetGateway() &&
+                rtentry->GetInterface() == route.GetInterface() &&
+                rtentry->GetPrefixToUse() == route.GetPrefixToUse() && r.metric == metric)
+            {
+                return true;
+            }
         }
     }
     return false;
 }
 
+void
+Ipv6StaticRouting::AddToRouteIndex(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    // an out of date index is rebuilt on the next lookup anyway
+    if (m_networkRouteIndex.IsValid())
+    {
+        m_networkRouteIndex.Add(route->GetDestNetwork(),
+                                route->GetDestNetworkPrefix(),
+                                route,
+                                metric);
+    }
+}
+
+void
+Ipv6StaticRouting::UpdateRouteIndex()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_networkRouteIndex.IsValid())
+    {
+        return;
+    }
+    m_networkRouteIndex.Clear();
+    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    {
+        m_networkRouteIndex.Add(j->first->GetDestNetwork(),
+                                j->first->GetDestNetworkPrefix(),
+                                j->first,
+                                j->second);
+    }
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
@@ -402,74 +446,77 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (NetworkRoutesI it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
+    // The matching routes are visited longest prefix first.  Among the routes
+    // with the longest prefix, the selected route is the first host route, or
+    // the network route with the lowest metric (the last one in the routing
+    // table, in case of equal metrics).
+    UpdateRouteIndex();
+    std::vector<const Ipv6RoutingTableIndex::RouteGroup*> matches;
+    m_networkRouteIndex.Lookup(dst, matches);
+    const Ipv6RoutingTableIndex::Route* best = nullptr;
+    for (const auto group : matches)
     {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
+        uint16_t maskLen = group->front().entry->GetDestNetworkPrefix().GetPrefixLength();
+        if (best && maskLen < longestMask)
         {
+            NS_LOG_LOGIC("Previous match longer, skipping");
+            break;
+        }
+        for (const auto& r : *group)
+        {
+            Ipv6RoutingTableEntry* j = r.entry;
+            uint32_t metric = r.metric;
             NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
                                                        << ", metric " << metric);
 
             /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+            if (interface && interface != m_ipv6->GetNetDevice(j->GetInterface()))
             {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-
-                if (maskLen > longestMask)
-                {
-                    shortestMetric = 0xffffffff;
-                }
-
-                longestMask = maskLen;
-                if (metric > shortestMetric)
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
+            }
+            if (best)
+            {
+                bool preferBest = (maskLen == 128)
+                                      ? best->position < r.position
+                                      : (metric > shortestMetric ||
+                                         (metric == shortestMetric && r.position < best->position));
+                if (preferBest)
                 {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                    NS_LOG_LOGIC("Equal mask length, but previous route preferred, skipping");
                     continue;
                 }
+            }
+            longestMask = maskLen;
+            shortestMetric = metric;
+            best = &r;
+        }
+    }
 
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
-
-                if (route->GetGateway().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else if (route->GetDest().IsAny()) /* default route */
-                {
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
-                else
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetGateway()));
-                }
+    if (best)
+    {
+        Ipv6RoutingTableEntry* route = best->entry;
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+        if (route->GetGateway().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        }
+        else if (route->GetDest().IsAny()) /* default route */
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
         }
+        else
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetGateway()));
+        }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -491,6 +538,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRouteIndex.Clear();
 
     for (MulticastRoutesI i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -650,6 +698,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
         {
             delete it->first;
             m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
             return;
         }
         tmp++;
@@ -673,6 +722,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         {
             delete it->first;
             m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
             return;
         }
     }
@@ -815,6 +865,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
         }
         else
         {
@@ -853,6 +904,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_networkRouteIndex.Invalidate();
         }
         else
         {
@@ -911,6 +963,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
             {
                 delete j->first;
                 j = m_networkRoutes.erase(j);
+                m_networkRouteIndex.Invalidate();
             }
             else
             {
@@ -20,6 +20,8 @@
 #ifndef IPV6_STATIC_ROUTING_H
 #define IPV6_STATIC_ROUTING_H
 
+#include "ipv6-routing-table-index.h"
+
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
@@ -330,11 +332,28 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     Ptr<Ipv6MulticastRoute> LookupStatic(Ipv6Address origin, Ipv6Address group, uint32_t ifIndex);
 
+    /**
+     * \brief Add a route appended to the forwarding table to its lookup index.
+     * \param route the route
+     * \param metric metric of route
+     */
+    void AddToRouteIndex(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Rebuild the lookup index of the network routes, if out of date.
+     */
+    void UpdateRouteIndex();
+
     /**
      * \brief the forwarding table for network.
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the lookup index of the forwarding table for network.
+     */
+    Ipv6RoutingTableIndex m_networkRouteIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
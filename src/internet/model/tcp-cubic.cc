@@ -18,7 +18,7 @@
 
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     {                                                                                              \
-        std::clog << Simulator::Now().GetSeconds() << " ";                                         \
+        LogGetContextStream() << Simulator::Now().GetSeconds() << " ";                             \
     }
 
 #include "tcp-cubic.h"
@@ -63,7 +63,7 @@ NS_OBJECT_ENSURE_REGISTERED(TcpL4Protocol);
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (m_node)                                                                                    \
     {                                                                                              \
-        std::clog << " [node " << m_node->GetId() << "] ";                                         \
+        LogGetContextStream() << " [node " << m_node->GetId() << "] ";                             \
     }
 
 /* see http://www.iana.org/assignments/protocol-numbers */
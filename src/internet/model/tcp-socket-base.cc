@@ -21,7 +21,7 @@
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (m_node)                                                                                    \
     {                                                                                              \
-        std::clog << " [node " << m_node->GetId() << "] ";                                         \
+        LogGetContextStream() << " [node " << m_node->GetId() << "] ";                             \
     }
 
 #include "tcp-socket-base.h"
@@ -46,10 +46,12 @@
 #include "ns3/double.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
+#include "ns3/ipv4-header.h"
 #include "ns3/ipv4-interface-address.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4.h"
+#include "ns3/ipv6-header.h"
 #include "ns3/ipv6-route.h"
 #include "ns3/ipv6-routing-protocol.h"
 #include "ns3/ipv6.h"
@@ -58,6 +60,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/tcp-rate-ops.h"
@@ -123,6 +126,12 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_timestampEnabled),
                           MakeBooleanChecker())
+            .AddAttribute("TsoMaxSize",
+                          "Max size of the super-segments sent when emulating TCP segmentation "
+                          "offload, 0 to disable it",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSize),
+                          MakeUintegerChecker<uint32_t>(0, 65535))
             .AddAttribute(
                 "MinRto",
                 "Minimum retransmit timeout value",
@@ -366,6 +375,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_sndWindShift(sock.m_sndWindShift),
       m_timestampEnabled(sock.m_timestampEnabled),
       m_timestampToEcho(sock.m_timestampToEcho),
+      m_tsoMaxSize(sock.m_tsoMaxSize),
       m_recover(sock.m_recover),
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
@@ -1336,7 +1346,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         }
     }
 
-    m_rxTrace(packet, tcpHeader, this);
+    NS_TRACE(m_rxTrace, packet, tcpHeader, this);
 
     if (tcpHeader.GetFlags() & TcpHeader::SYN)
     {
@@ -1452,7 +1462,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
             h.SetDestinationPort(tcpHeader.GetSourcePort());
             h.SetWindowSize(AdvertisedWindowSize());
             AddOptions(h);
-            m_txTrace(p, h, this);
+            NS_TRACE(m_txTrace, p, h, this);
             m_tcp->SendPacket(p, h, toAddress, fromAddress, m_boundnetdevice);
         }
         break;
@@ -2210,7 +2220,20 @@ TcpSocketBase::ProcessAck(const SequenceNumber32& ackNumber,
             }
             if (m_tcb->m_congState == TcpSocketState::CA_OPEN)
             {
-                m_congestionControl->IncreaseWindow(m_tcb, segsAcked);
+                if (m_tsoMaxSize > m_tcb->m_segmentSize)
+                {
+                    // With TSO, an ACK covers whole super-segments: grow the window
+                    // as the delayed ACKs of their segments would have
+                    for (uint32_t n = segsAcked; n > 0; n -= std::min(n, m_delAckMaxCount))
+                    {
+                        m_congestionControl->IncreaseWindow(m_tcb,
+                                                            std::min(n, m_delAckMaxCount));
+                    }
+                }
+                else
+                {
+                    m_congestionControl->IncreaseWindow(m_tcb, segsAcked);
+                }
 
                 m_tcb->m_cWndInfl = m_tcb->m_cWnd;
 
@@ -2839,7 +2862,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         NS_LOG_INFO("Sending a pure ACK, acking seq " << m_tcb->m_rxBuffer->NextRxSequence());
     }
 
-    m_txTrace(p, header, this);
+    NS_TRACE(m_txTrace, p, header, this);
 
     if (m_endPoint != nullptr)
     {
@@ -3205,6 +3228,17 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     header.SetWindowSize(AdvertisedWindowSize());
     AddOptions(header);
 
+    if (sz > m_tcb->m_segmentSize)
+    {
+        // TSO super-segment: the device accounts for its split in segments
+        uint32_t ipHeaderSize = m_endPoint ? Ipv4Header().GetSerializedSize()
+                                           : Ipv6Header().GetSerializedSize();
+        uint32_t nSegments = (sz + m_tcb->m_segmentSize - 1) / m_tcb->m_segmentSize;
+        p->AddPacketTag(SegmentationOffloadTag(m_tcb->m_segmentSize,
+                                               ipHeaderSize + header.GetSerializedSize(),
+                                               nSegments));
+    }
+
     if (m_retxEvent.IsExpired())
     {
         // Schedules retransmit timeout. m_rto should be already doubled.
@@ -3215,7 +3249,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
-    m_txTrace(p, header, this);
+    NS_TRACE(m_txTrace, p, header, this);
 
     if (m_endPoint)
     {
@@ -3374,6 +3408,19 @@ TcpSocketBase::SendPendingData(bool withAck)
             uint32_t maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // With TSO, new data goes out in super-segments of whole segments
+            // that still fit in the window
+            if (m_tsoMaxSize > m_tcb->m_segmentSize && s == m_tcb->m_segmentSize &&
+                next >= m_tcb->m_highTxMark.Get())
+            {
+                int32_t rWndLeft = (m_highRxAckMark.Get() + m_rWnd.Get()) - next;
+                uint32_t tsoSize = std::min({m_tsoMaxSize,
+                                             availableWindow,
+                                             availableData,
+                                             static_cast<uint32_t>(std::max(rWndLeft, 0))});
+                s = std::max(s, tsoSize - tsoSize % m_tcb->m_segmentSize);
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3527,6 +3574,15 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
+    // A TSO super-segment is received whole, as with GRO: it counts as the
+    // segments it stands for towards the delayed ACK
+    uint32_t nSegments = 1;
+    SegmentationOffloadTag tsoTag;
+    if (p->RemovePacketTag(tsoTag))
+    {
+        nSegments = tsoTag.GetNSegments();
+    }
+
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
@@ -3583,7 +3639,8 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        m_delAckCount += nSegments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -3931,7 +3988,7 @@ TcpSocketBase::PersistTimeout()
         ipTclassTag.SetTclass(MarkEcnCodePoint(0, m_tcb->m_ectCodePoint));
         p->AddPacketTag(ipTclassTag);
     }
-    m_txTrace(p, tcpHeader, this);
+    NS_TRACE(m_txTrace, p, tcpHeader, this);
 
     if (m_endPoint != nullptr)
     {
@@ -214,6 +214,29 @@ class RttHistory
  * you need more information. The reference paper is
  * https://dl.acm.org/citation.cfm?id=3067666.
  *
+ * Segmentation offload
+ * --------------------
+ *
+ * For throughput-oriented studies, where the behavior of the individual
+ * segments below the transport layer does not matter, the attribute
+ * "TsoMaxSize" enables an emulation of TCP segmentation offload (TSO). New
+ * data is then sent in super-segments of up to TsoMaxSize bytes (a multiple
+ * of the segment size, within the available window), tagged with a
+ * SegmentationOffloadTag. The IP layer does not fragment them, and
+ * PointToPointNetDevice and CsmaNetDevice hold the channel for the time the
+ * individual wire packets would have taken, headers and interframe gaps
+ * included. The receiver gets the super-segment as a whole at the end of the
+ * last wire packet, which is the equivalent of receive offload (GRO). It
+ * removes the tag and counts the super-segment as its segments towards the
+ * delayed ACK, hence it acknowledges every super-segment of at least two
+ * segments right away. The sender grows the congestion window upon such an
+ * ACK as if every DelAckCount segments had been acknowledged separately.
+ * Queues count a super-segment as its segments (see GetNQueuedPackets), but
+ * admit it as long as they can hold one more packet. Losses, retransmissions
+ * and SACK blocks have the granularity of a super-segment on the first
+ * transmission, and of a segment afterwards. Other devices see a jumbo frame.
+ * The default (0) disables the emulation.
+ *
  */
 class TcpSocketBase : public TcpSocket
 {
@@ -1351,6 +1374,7 @@ class TcpSocketBase : public TcpSocket
     uint8_t m_sndWindShift{0};      //!< Window shift to apply to incoming segments
     bool m_timestampEnabled{true};  //!< Timestamp option enabled
     uint32_t m_timestampToEcho{0};  //!< Timestamp to echo
+    uint32_t m_tsoMaxSize{0};       //!< Max size of TSO super-segments (0 to disable)
 
     EventId m_sendPendingDataEvent{}; //!< micro-delay event to send pending data
 
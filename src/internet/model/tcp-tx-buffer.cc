@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 
 namespace ns3
 {
@@ -61,7 +62,8 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostUpTo(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -177,6 +179,7 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.size() == 0);
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = seq;
 }
 
 bool
@@ -311,37 +314,33 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(m_sentList.size() >= 1);
 
-    auto it = m_sentList.begin();
+    auto it = FindSentItem(seq);
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (it != m_sentList.end() && (*it)->m_startSeq == seq)
     {
-        if ((*it)->m_startSeq == seq)
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -378,6 +377,45 @@ TcpTxBuffer::FindHighestSacked() const
     return ret;
 }
 
+TcpTxBuffer::PacketList::iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    NS_LOG_FUNCTION(this << seq);
+
+    // The callers may need to edit the list through the returned iterator
+    PacketList& list = const_cast<PacketList&>(m_sentList);
+    SequenceNumber32 head = m_firstByteSeq;
+    SequenceNumber32 tail = head + m_sentSize;
+
+    if (seq <= head)
+    {
+        return list.begin();
+    }
+    if (seq >= tail)
+    {
+        return list.end();
+    }
+
+    PacketList::iterator it;
+    if (seq - head <= tail - seq)
+    {
+        it = list.begin();
+        while (it != list.end() && (*it)->m_startSeq < seq)
+        {
+            ++it;
+        }
+    }
+    else
+    {
+        it = list.end();
+        while (it != list.begin() && (*std::prev(it))->m_startSeq >= seq)
+        {
+            --it;
+        }
+    }
+    return it;
+}
+
 void
 TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
 {
@@ -440,6 +478,16 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     PacketList::iterator it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+    if (&list == &m_sentList && seq > listStartFrom)
+    {
+        // The items of the sent list know their sequence number: skip
+        // directly to the item which contains seq
+        it = FindSentItem(seq + 1);
+        NS_ASSERT(it != list.begin());
+        --it;
+        beginOfCurrentPacket = (*it)->m_startSeq;
+    }
+
     while (it != list.end())
     {
         currentItem = *it;
@@ -652,16 +700,16 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item which precedes the first item starting at or after ack
+    // can end at ack
+    auto it = FindSentItem(ack);
+    if (it == m_sentList.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *(--it);
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -772,6 +820,11 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
 
+    if (m_lostUpTo < m_firstByteSeq)
+    {
+        m_lostUpTo = m_firstByteSeq;
+    }
+
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
     NS_LOG_LOGIC("Buffer status after discarding data " << *this);
@@ -790,18 +843,19 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        PacketList::iterator item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // The items starting before the block cannot be mapped over it
+        PacketList::const_iterator item_it = FindSentItem((*option_it).first);
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
+            SequenceNumber32 beginOfCurrentPacket = (*item_it)->m_startSeq;
 
             // Check the boundary of this packet ... only mark as sacked if
             // it is precisely mapped over the option. It means that if the receiver
@@ -855,7 +909,6 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                 break;
             }
 
-            beginOfCurrentPacket += pktSize;
             ++item_it;
         }
     }
@@ -879,7 +932,8 @@ TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
     uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
+    bool thresholdReached = false;
+    SequenceNumber32 lostUpTo = m_firstByteSeq;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -894,6 +948,14 @@ TcpTxBuffer::UpdateLostCount()
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
+        SequenceNumber32 endOfCurrentPacket = item->m_startSeq + item->m_packet->GetSize();
+
+        // Below m_lostUpTo, the items are already either sacked or lost
+        if (sacked >= m_dupAckThresh && endOfCurrentPacket <= m_lostUpTo)
+        {
+            break;
+        }
+
         if (item->m_sacked)
         {
             sacked++;
@@ -901,13 +963,17 @@ TcpTxBuffer::UpdateLostCount()
 
         if (sacked >= m_dupAckThresh)
         {
+            if (!thresholdReached)
+            {
+                thresholdReached = true;
+                lostUpTo = endOfCurrentPacket;
+            }
             if (!item->m_sacked && !item->m_lost)
             {
                 item->m_lost = true;
                 m_lostOut += item->m_packet->GetSize();
             }
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
     }
 
     if (sacked >= m_dupAckThresh)
@@ -918,6 +984,10 @@ TcpTxBuffer::UpdateLostCount()
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
         }
+        if (m_lostUpTo < lostUpTo)
+        {
+            m_lostUpTo = lostUpTo;
+        }
     }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
@@ -928,35 +998,25 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
 {
     NS_LOG_FUNCTION(this << seq);
 
-    SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-    PacketList::const_iterator it;
-
     if (seq >= m_highestSack.second)
     {
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Only the items starting at or after seq are considered
+    for (PacketList::const_iterator it = FindSentItem(seq); it != m_sentList.end(); ++it)
     {
-        // Search for the right iterator before calling IsLost()
-        if (beginOfCurrentPacket >= seq)
+        if ((*it)->m_lost == true)
         {
-            if ((*it)->m_lost == true)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
-
-            if ((*it)->m_sacked == true)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
         }
 
-        beginOfCurrentPacket += (*it)->m_packet->GetSize();
+        if ((*it)->m_sacked == true)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
+        }
     }
 
     return false;
@@ -985,11 +1045,23 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
     SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
+    uint32_t lostBytes = 0;
 
     for (it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
         item = *it;
 
+        // When all the lost items have been visited, and rule (3) does not
+        // need a candidate anymore, the rest of the list cannot match
+        if (lostBytes >= m_lostOut && (!isRecovery || seqPerRule3.GetValue() != 0))
+        {
+            break;
+        }
+        if (item->m_lost)
+        {
+            lostBytes += item->m_packet->GetSize();
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (item->m_retrans == false && item->m_sacked == false)
         {
@@ -1226,6 +1298,7 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1255,6 +1328,7 @@ TcpTxBuffer::ResetSentList()
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1272,6 +1346,11 @@ TcpTxBuffer::ResetLastSegmentSent()
             m_retrans -= item->m_packet->GetSize();
         }
         m_appList.insert(m_appList.begin(), item);
+
+        if (m_lostUpTo > m_firstByteSeq + m_sentSize)
+        {
+            m_lostUpTo = m_firstByteSeq + m_sentSize;
+        }
     }
     ConsistencyCheck();
 }
@@ -1317,6 +1396,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
 
         (*it)->m_retrans = false;
     }
+    m_lostUpTo = m_firstByteSeq + m_sentSize;
 
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
@@ -114,6 +114,18 @@ class Packet;
  * connection, the TcpSocketImplementation should provide hints through
  * the MarkHeadAsLost and AddRenoSack methods.
  *
+ * Scoreboard lookups
+ * ------------------
+ *
+ * With a large bandwidth-delay product, the sent list holds tens of
+ * thousands of items, and the scoreboard must not be walked from its head
+ * for each ACK. Since every item of the sent list stores the sequence number
+ * of its first byte, the item holding a given sequence number is searched
+ * from the closest end of the list (\see FindSentItem). Moreover, the buffer
+ * remembers the sequence number below which all the segments that are not
+ * sacked are marked as lost, so that UpdateLostCount and NextSeg only walk
+ * the part of the list which can change.
+ *
  * \see BytesInFlight
  * \see Size
  * \see SizeFromSequence
@@ -601,6 +613,18 @@ class TcpTxBuffer : public Object
      */
     std::pair<TcpTxBuffer::PacketList::const_iterator, SequenceNumber32> FindHighestSacked() const;
 
+    /**
+     * \brief Find the first item of the sent list starting at or after a sequence
+     *
+     * The sent list is walked from its head or from its tail, whichever is
+     * closer to seq.
+     *
+     * \param seq the sequence number
+     * \return an iterator to the first item of m_sentList which starts at or
+     * after seq, or the end of m_sentList if there is none
+     */
+    PacketList::iterator FindSentItem(const SequenceNumber32& seq) const;
+
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
@@ -616,6 +640,10 @@ class TcpTxBuffer : public Object
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
 
+    /// All the items of the sent list which end before this sequence number,
+    /// and are not sacked, are marked as lost
+    SequenceNumber32 m_lostUpTo{0};
+
     uint32_t m_dupAckThresh{0}; //!< Duplicate Ack threshold from TcpSocketBase
     uint32_t m_segmentSize{0};  //!< Segment size from TcpSocketBase
     bool m_renoSack{false};     //!< Indicates if AddRenoSack was called
@@ -65,12 +65,18 @@ GlobalRouteManagerImplTestCase::DoRun()
         candidate.Push(v);
     }
 
+    uint32_t lastDistance = 0;
     for (int i = 0; i < 100; ++i)
     {
         SPFVertex* v = candidate.Pop();
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(v->GetDistanceFromRoot(),
+                                    lastDistance,
+                                    "CandidateQueue does not pop the closest vertex first");
+        lastDistance = v->GetDistanceFromRoot();
         delete v;
         v = nullptr;
     }
+    NS_TEST_ASSERT_MSG_EQ(candidate.Empty(), true, "CandidateQueue should be empty");
 
     // Build fake link state database; four routers (0-3), 3 point-to-point
     // links
@@ -0,0 +1,142 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/node.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the ascii trace sinks of InternetStackHelper write to a
+ * binary trace created by AsciiTraceHelper::CreateBinaryFileStream.
+ */
+class InternetStackHelperBinaryTraceTestCase : public TestCase
+{
+  public:
+    InternetStackHelperBinaryTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Send a packet.
+     * \param socket The sending socket.
+     */
+    void SendData(Ptr<Socket> socket);
+};
+
+InternetStackHelperBinaryTraceTestCase::InternetStackHelperBinaryTraceTestCase()
+    : TestCase("Check the IPv4 ascii trace sinks with a binary trace")
+{
+}
+
+void
+InternetStackHelperBinaryTraceTestCase::SendData(Ptr<Socket> socket)
+{
+    Address to = InetSocketAddress(Ipv4Address("10.0.0.2"), 1234);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendTo(Create<Packet>(123), 0, to), 123, "Packet not sent");
+}
+
+void
+InternetStackHelperBinaryTraceTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(nodes);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        device->SetChannel(channel);
+        nodes.Get(i)->AddDevice(device);
+        Ptr<Ipv4> ipv4 = nodes.Get(i)->GetObject<Ipv4>();
+        int32_t ifIndex = ipv4->AddInterface(device);
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(i == 0 ? "10.0.0.1" : "10.0.0.2", "255.255.255.0"));
+        ipv4->SetUp(ifIndex);
+    }
+
+    std::string filename = CreateTempDirFilename("internet-stack-helper.btr");
+    AsciiTraceHelper ascii;
+    Ptr<OutputStreamWrapper> stream = ascii.CreateBinaryFileStream(filename);
+    internet.EnableAsciiIpv4All(stream);
+
+    Ptr<Socket> rxSocket = nodes.Get(1)->GetObject<UdpSocketFactory>()->CreateSocket();
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    Ptr<Socket> txSocket = nodes.Get(0)->GetObject<UdpSocketFactory>()->CreateSocket();
+    Simulator::ScheduleWithContext(nodes.Get(0)->GetId(),
+                                   Seconds(1),
+                                   &InternetStackHelperBinaryTraceTestCase::SendData,
+                                   this,
+                                   txSocket);
+    Simulator::Run();
+    stream->GetBinaryWriter()->Flush();
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    BinaryTraceReader::Event event;
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(event), true, "Missing transmit event");
+    NS_TEST_EXPECT_MSG_EQ(event.type, 't', "Wrong type of event");
+    NS_TEST_EXPECT_MSG_EQ(event.node, nodes.Get(0)->GetId(), "Wrong node id");
+    NS_TEST_EXPECT_MSG_EQ(event.size, 151, "Wrong packet size");
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(event), true, "Missing receive event");
+    NS_TEST_EXPECT_MSG_EQ(event.type, 'r', "Wrong type of event");
+    NS_TEST_EXPECT_MSG_EQ(event.node, nodes.Get(1)->GetId(), "Wrong node id");
+    NS_TEST_EXPECT_MSG_EQ(event.size, 151, "Wrong packet size");
+    NS_TEST_EXPECT_MSG_EQ(reader.Read(event), false, "There are only 2 events");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief InternetStackHelper TestSuite
+ */
+class InternetStackHelperTestSuite : public TestSuite
+{
+  public:
+    InternetStackHelperTestSuite();
+};
+
+InternetStackHelperTestSuite::InternetStackHelperTestSuite()
+    : TestSuite("internet-stack-helper", UNIT)
+{
+    AddTestCase(new InternetStackHelperBinaryTraceTestCase, TestCase::QUICK);
+}
+
+static InternetStackHelperTestSuite
+    g_internetStackHelperTestSuite; //!< Static variable for test initialization
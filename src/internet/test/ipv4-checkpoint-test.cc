@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/arp-cache.h"
+#include "ns3/checkpoint.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/udp-socket-factory.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that a checkpoint restores the attributes of the IPv4 stack
+ * and the entries of the ARP caches.
+ */
+class Ipv4CheckpointTest : public TestCase
+{
+  public:
+    Ipv4CheckpointTest();
+
+  private:
+    void DoRun() override;
+    /** Build the nodes, their devices and their stacks. */
+    void Build();
+    /** Send a packet from the first node to the second one. */
+    void SendData();
+    /**
+     * Receive a packet.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    NodeContainer m_nodes;       //!< The nodes.
+    Ptr<Socket> m_txSocket;      //!< The sending socket.
+    Ptr<Socket> m_rxSocket;      //!< The receiving socket.
+    std::vector<Time> m_rxTimes; //!< The times of the packets received.
+};
+
+Ipv4CheckpointTest::Ipv4CheckpointTest()
+    : TestCase("Check the IPv4 attributes and ARP entries restored from a checkpoint")
+{
+}
+
+void
+Ipv4CheckpointTest::Build()
+{
+    m_nodes = NodeContainer();
+    m_nodes.Create(2);
+    SimpleNetDeviceHelper simple;
+    simple.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    NetDeviceContainer devices = simple.Install(m_nodes);
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(m_nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.0");
+    ipv4.Assign(devices);
+
+    m_txSocket = m_nodes.Get(0)->GetObject<UdpSocketFactory>()->CreateSocket();
+    m_rxSocket = m_nodes.Get(1)->GetObject<UdpSocketFactory>()->CreateSocket();
+    m_rxSocket->Bind(InetSocketAddress(Ipv4Address("10.0.0.2"), 1234));
+    m_rxSocket->SetRecvCallback(MakeCallback(&Ipv4CheckpointTest::ReceivePkt, this));
+    m_rxTimes.clear();
+}
+
+void
+Ipv4CheckpointTest::SendData()
+{
+    m_txSocket->SendTo(Create<Packet>(100), 0, InetSocketAddress(Ipv4Address("10.0.0.2"), 1234));
+}
+
+void
+Ipv4CheckpointTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_rxTimes.push_back(Simulator::Now());
+    }
+}
+
+void
+Ipv4CheckpointTest::DoRun()
+{
+    std::string filename = CreateTempDirFilename("ipv4-checkpoint.ckpt");
+
+    // warm-up run: the first packet waits for the ARP reply
+    Build();
+    Simulator::Schedule(Seconds(1), &Ipv4CheckpointTest::SendData, this);
+    Simulator::Schedule(Seconds(2), [this]() {
+        m_nodes.Get(0)->GetObject<Ipv4L3Protocol>()->SetAttribute("DefaultTtl", UintegerValue(32));
+    });
+    Simulator::Schedule(Seconds(10), &Checkpoint::Save, filename);
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "Packet not received");
+    // the ARP request is sent after a random jitter
+    NS_TEST_EXPECT_MSG_GT(m_rxTimes[0], MilliSeconds(1001), "Packet not delayed by ARP");
+    Simulator::Destroy();
+
+    // measurement run: the packet is sent at once
+    Build();
+    Checkpoint::Restore(filename);
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(10), "Wrong time restored");
+    Ptr<Ipv4L3Protocol> ipv4 = m_nodes.Get(0)->GetObject<Ipv4L3Protocol>();
+    UintegerValue ttl;
+    ipv4->GetAttribute("DefaultTtl", ttl);
+    NS_TEST_EXPECT_MSG_EQ(ttl.Get(), 32, "Attribute of the IPv4 stack not restored");
+    ArpCache::Entry* entry =
+        ipv4->GetInterface(1)->GetArpCache()->Lookup(Ipv4Address("10.0.0.2"));
+    NS_TEST_ASSERT_MSG_NE(entry, nullptr, "ARP entry not restored");
+    NS_TEST_EXPECT_MSG_EQ(entry->IsAlive(), true, "ARP entry not alive");
+    NS_TEST_EXPECT_MSG_EQ(entry->GetMacAddress(),
+                          m_nodes.Get(1)->GetDevice(0)->GetAddress(),
+                          "Wrong MAC address restored");
+
+    Simulator::ScheduleNow(&Ipv4CheckpointTest::SendData, this);
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "Packet not received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0], MilliSeconds(10001), "Packet delayed by ARP");
+    Simulator::Destroy();
+    m_txSocket = nullptr;
+    m_rxSocket = nullptr;
+    m_nodes = NodeContainer();
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 checkpoint TestSuite
+ */
+class Ipv4CheckpointTestSuite : public TestSuite
+{
+  public:
+    Ipv4CheckpointTestSuite()
+        : TestSuite("ipv4-checkpoint", UNIT)
+    {
+        AddTestCase(new Ipv4CheckpointTest(), TestCase::QUICK);
+    }
+};
+
+static Ipv4CheckpointTestSuite
+    g_ipv4CheckpointTestSuite; //!< Static variable for test initialization
@@ -41,6 +41,7 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1321,6 +1322,207 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting shared route tables test
+ */
+class Ipv4GlobalRoutingShareRouteTableTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingShareRouteTableTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a routing protocol sharing its route table, with a default
+     * route and a host route.
+     * \param gateway the gateway of the routes
+     * \return the routing protocol
+     */
+    Ptr<Ipv4GlobalRouting> CreateRouting(Ipv4Address gateway);
+};
+
+Ipv4GlobalRoutingShareRouteTableTestCase::Ipv4GlobalRoutingShareRouteTableTestCase()
+    : TestCase("Sharing of the route tables of global routing")
+{
+}
+
+Ptr<Ipv4GlobalRouting>
+Ipv4GlobalRoutingShareRouteTableTestCase::CreateRouting(Ipv4Address gateway)
+{
+    Ptr<Ipv4GlobalRouting> routing = CreateObject<Ipv4GlobalRouting>();
+    routing->SetAttribute("ShareRouteTable", BooleanValue(true));
+    routing->AddNetworkRouteTo(Ipv4Address("0.0.0.0"), Ipv4Mask("0.0.0.0"), gateway, 1);
+    routing->AddHostRouteTo(Ipv4Address("10.2.2.2"), gateway, 1);
+    routing->ShareRouteTable();
+    return routing;
+}
+
+void
+Ipv4GlobalRoutingShareRouteTableTestCase::DoRun()
+{
+    Ipv4GlobalRouting::RouteTableStats before = Ipv4GlobalRouting::GetRouteTableStats();
+
+    Ptr<Ipv4GlobalRouting> routing0 = CreateRouting(Ipv4Address("10.1.1.1"));
+    Ptr<Ipv4GlobalRouting> routing1 = CreateRouting(Ipv4Address("10.1.1.1"));
+    Ptr<Ipv4GlobalRouting> routing2 = CreateRouting(Ipv4Address("10.1.1.2"));
+
+    Ipv4GlobalRouting::RouteTableStats stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.nTables - before.nTables, 2, "Identical routes are not shared");
+    NS_TEST_ASSERT_MSG_EQ(stats.nSharedTables - before.nSharedTables, 1, "Wrong shared tables");
+    NS_TEST_ASSERT_MSG_EQ(stats.nRoutes - before.nRoutes, 4, "Wrong number of routes stored");
+    NS_TEST_ASSERT_MSG_EQ(stats.nNodeRoutes - before.nNodeRoutes, 6, "Wrong number of routes");
+    NS_TEST_ASSERT_MSG_GT(stats.nBytes, before.nBytes, "Memory usage not reported");
+    NS_TEST_ASSERT_MSG_EQ(routing0->GetRoute(1), routing1->GetRoute(1), "Routes not shared");
+    NS_TEST_ASSERT_MSG_NE(routing0->GetRoute(1), routing2->GetRoute(1), "Wrong routes shared");
+
+    // a modification gives a private copy of the routes to the node
+    routing1->RemoveRoute(0);
+    stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.nTables - before.nTables, 3, "Shared routes not copied");
+    NS_TEST_ASSERT_MSG_EQ(stats.nSharedTables - before.nSharedTables, 0, "Wrong shared tables");
+    NS_TEST_ASSERT_MSG_EQ(routing0->GetNRoutes(), 2, "Shared routes were modified");
+    NS_TEST_ASSERT_MSG_EQ(routing1->GetNRoutes(), 1, "Route not removed");
+    NS_TEST_ASSERT_MSG_EQ(routing0->GetRoute(0)->GetGateway(),
+                          routing1->GetRoute(0)->GetGateway(),
+                          "Wrong copy of the routes");
+
+    // the same routes are shared again
+    routing1->AddHostRouteTo(Ipv4Address("10.2.2.2"), Ipv4Address("10.1.1.1"), 1);
+    routing1->ShareRouteTable();
+    stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.nTables - before.nTables, 2, "Identical routes are not shared");
+    NS_TEST_ASSERT_MSG_EQ(routing0->GetRoute(1), routing1->GetRoute(1), "Routes not shared");
+
+    routing0->Dispose();
+    routing1->Dispose();
+    routing2->Dispose();
+    stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.nTables, before.nTables, "Route tables not freed");
+    NS_TEST_ASSERT_MSG_EQ(stats.nRoutes, before.nRoutes, "Routes not freed");
+
+    // the disposed routing protocols are left with empty route tables
+    NS_TEST_ASSERT_MSG_EQ(routing0->GetNRoutes(), 0, "Shared routes not removed");
+    NS_TEST_ASSERT_MSG_EQ(routing2->GetNRoutes(), 0, "Private routes not removed");
+    routing2->AddHostRouteTo(Ipv4Address("10.2.2.2"), Ipv4Address("10.1.1.2"), 1);
+    NS_TEST_ASSERT_MSG_EQ(routing2->GetNRoutes(), 1, "Route not added");
+    routing2->RemoveRoute(0);
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting test of the lookup indexes shared by the nodes
+ * of a point-to-point topology
+ */
+class Ipv4GlobalRoutingSharePrefixIndexTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingSharePrefixIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Look up the route of a node to a destination.
+     * \param node the node
+     * \param dest the destination
+     * \return the gateway of the route, or 0.0.0.0 if there is none
+     */
+    Ipv4Address GetGateway(Ptr<Node> node, Ipv4Address dest);
+};
+
+Ipv4GlobalRoutingSharePrefixIndexTestCase::Ipv4GlobalRoutingSharePrefixIndexTestCase()
+    : TestCase("Sharing of the lookup indexes of global routing on point-to-point links")
+{
+}
+
+Ipv4Address
+Ipv4GlobalRoutingSharePrefixIndexTestCase::GetGateway(Ptr<Node> node, Ipv4Address dest)
+{
+    Ipv4Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = node->GetObject<Ipv4>()->GetRoutingProtocol()->RouteOutput(
+        Create<Packet>(),
+        header,
+        nullptr,
+        sockerr);
+    return route ? route->GetGateway() : Ipv4Address::GetAny();
+}
+
+void
+Ipv4GlobalRoutingSharePrefixIndexTestCase::DoRun()
+{
+    Ipv4GlobalRouting::RouteTableStats before = Ipv4GlobalRouting::GetRouteTableStats();
+
+    // a ring of 4 nodes: link i joins node i (10.1.<i+1>.1) to node i+1 (10.1.<i+1>.2)
+    NodeContainer nodes;
+    nodes.Create(4);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer net = simpleHelper.Install(nodes.Get(i), channel);
+        net.Add(simpleHelper.Install(nodes.Get((i + 1) % 4), channel));
+        std::ostringstream network;
+        network << "10.1." << i + 1 << ".0";
+        ipv4.SetBase(network.str().c_str(), "255.255.255.252");
+        ipv4.Assign(net);
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Ptr<Ipv4RoutingProtocol> routing = nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol();
+        routing->SetAttribute("ShareRouteTable", BooleanValue(true));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(nodes.Get(0), Ipv4Address("10.1.2.1")),
+                          Ipv4Address("10.1.1.2"),
+                          "Wrong host route");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(nodes.Get(2), Ipv4Address("10.1.4.1")),
+                          Ipv4Address("10.1.3.2"),
+                          "Wrong host route");
+    // the first network route found is the first one added by the SPF, which is
+    // not always the shortest one: check networks for which it is
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(nodes.Get(1), Ipv4Address("10.1.4.3")),
+                          Ipv4Address("10.1.1.1"),
+                          "Wrong network route");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(nodes.Get(3), Ipv4Address("10.1.2.3")),
+                          Ipv4Address("10.1.3.1"),
+                          "Wrong network route");
+
+    // the nodes have distinct gateways, but look up the same destinations
+    Ipv4GlobalRouting::RouteTableStats stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.nTables - before.nTables, 4, "Distinct routes were shared");
+    NS_TEST_EXPECT_MSG_EQ(stats.nPrefixIndexes - before.nPrefixIndexes,
+                          2,
+                          "Host and network destinations not in two indexes");
+    NS_TEST_EXPECT_MSG_EQ(stats.nSharedPrefixIndexes - before.nSharedPrefixIndexes,
+                          2,
+                          "Lookup indexes not shared");
+    NS_TEST_EXPECT_MSG_LT(stats.nPrefixes - before.nPrefixes,
+                          stats.nRoutes - before.nRoutes,
+                          "Destinations not stored once for all the nodes");
+
+    Simulator::Destroy();
+    stats = Ipv4GlobalRouting::GetRouteTableStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.nPrefixIndexes, before.nPrefixIndexes, "Indexes not freed");
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1344,6 +1546,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingShareRouteTableTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSharePrefixIndexTestCase, TestCase::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
@@ -20,6 +20,7 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
@@ -208,6 +209,119 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting route selection Test
+ *
+ * Checks that the longest mask wins, that the lowest metric (and then the
+ * last route) wins among the routes with the same mask, and that the first
+ * of several host routes wins, also after the routing table changed.
+ */
+class Ipv4StaticRoutingRouteSelectionTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingRouteSelectionTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check the gateway selected for a destination.
+     * \param routing The static routing.
+     * \param dest The destination address.
+     * \param gateway The expected gateway.
+     */
+    void CheckGateway(Ptr<Ipv4StaticRouting> routing, std::string dest, std::string gateway);
+};
+
+Ipv4StaticRoutingRouteSelectionTestCase::Ipv4StaticRoutingRouteSelectionTestCase()
+    : TestCase("Static routing route selection")
+{
+}
+
+void
+Ipv4StaticRoutingRouteSelectionTestCase::CheckGateway(Ptr<Ipv4StaticRouting> routing,
+                                                      std::string dest,
+                                                      std::string gateway)
+{
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address(dest.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = routing->RouteOutput(Create<Packet>(), header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv4Address(gateway.c_str()),
+                          "Wrong route selected to " << dest);
+}
+
+void
+Ipv4StaticRoutingRouteSelectionTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        int32_t ifIndex = ipv4->AddInterface(device);
+        std::ostringstream oss;
+        oss << "192.168." << i << ".1";
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(Ipv4Address(oss.str().c_str()), Ipv4Mask("/24")));
+        ipv4->SetUp(ifIndex);
+    }
+
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    Ptr<Ipv4StaticRouting> routing = ipv4RoutingHelper.GetStaticRouting(ipv4);
+    routing->SetDefaultRoute(Ipv4Address("192.168.2.254"), 2);
+    routing->AddNetworkRouteTo(Ipv4Address("10.0.0.0"),
+                               Ipv4Mask("/8"),
+                               Ipv4Address("192.168.1.10"),
+                               1);
+    routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                               Ipv4Mask("/16"),
+                               Ipv4Address("192.168.1.2"),
+                               1,
+                               5);
+    routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                               Ipv4Mask("/16"),
+                               Ipv4Address("192.168.1.3"),
+                               1,
+                               2);
+    routing->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                               Ipv4Mask("/16"),
+                               Ipv4Address("192.168.2.3"),
+                               2,
+                               2);
+    routing->AddHostRouteTo(Ipv4Address("10.1.2.3"), Ipv4Address("192.168.1.4"), 1, 3);
+    routing->AddHostRouteTo(Ipv4Address("10.1.2.3"), Ipv4Address("192.168.2.5"), 2, 1);
+
+    CheckGateway(routing, "10.1.2.3", "192.168.1.4");
+    CheckGateway(routing, "10.1.9.9", "192.168.2.3");
+    CheckGateway(routing, "10.2.0.1", "192.168.1.10");
+    CheckGateway(routing, "172.16.0.1", "192.168.2.254");
+
+    // remove the first host route
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        Ipv4RoutingTableEntry route = routing->GetRoute(i);
+        if (route.IsHost() && route.GetGateway() == Ipv4Address("192.168.1.4"))
+        {
+            routing->RemoveRoute(i);
+            break;
+        }
+    }
+    CheckGateway(routing, "10.1.2.3", "192.168.2.5");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -224,6 +338,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4StaticRoutingRouteSelectionTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
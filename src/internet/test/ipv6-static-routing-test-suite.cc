@@ -0,0 +1,174 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Tests for Ipv6 static routing
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 StaticRouting route selection Test
+ *
+ * Checks that the longest prefix wins, that the lowest metric (and then the
+ * last route) wins among the routes with the same prefix, and that the first
+ * of several host routes wins, also after the routing table changed.
+ */
+class Ipv6StaticRoutingRouteSelectionTestCase : public TestCase
+{
+  public:
+    Ipv6StaticRoutingRouteSelectionTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check the gateway selected for a destination.
+     * \param routing The static routing.
+     * \param dest The destination address.
+     * \param gateway The expected gateway.
+     */
+    void CheckGateway(Ptr<Ipv6StaticRouting> routing, std::string dest, std::string gateway);
+};
+
+Ipv6StaticRoutingRouteSelectionTestCase::Ipv6StaticRoutingRouteSelectionTestCase()
+    : TestCase("Static routing route selection")
+{
+}
+
+void
+Ipv6StaticRoutingRouteSelectionTestCase::CheckGateway(Ptr<Ipv6StaticRouting> routing,
+                                                      std::string dest,
+                                                      std::string gateway)
+{
+    Ipv6Header header;
+    header.SetDestination(Ipv6Address(dest.c_str()));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv6Route> route = routing->RouteOutput(Create<Packet>(), header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv6Address(gateway.c_str()),
+                          "Wrong route selected to " << dest);
+}
+
+void
+Ipv6StaticRoutingRouteSelectionTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(node);
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        int32_t ifIndex = ipv6->AddInterface(device);
+        std::ostringstream oss;
+        oss << "2001:" << i << "::1";
+        ipv6->AddAddress(ifIndex,
+                         Ipv6InterfaceAddress(Ipv6Address(oss.str().c_str()), Ipv6Prefix(64)));
+        ipv6->SetUp(ifIndex);
+    }
+
+    Ipv6StaticRoutingHelper ipv6RoutingHelper;
+    Ptr<Ipv6StaticRouting> routing = ipv6RoutingHelper.GetStaticRouting(ipv6);
+    routing->SetDefaultRoute(Ipv6Address("2001:2::fe"), 2);
+    routing->AddNetworkRouteTo(Ipv6Address("2001:db8::"),
+                               Ipv6Prefix(32),
+                               Ipv6Address("2001:1::10"),
+                               1);
+    routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                               Ipv6Prefix(48),
+                               Ipv6Address("2001:1::2"),
+                               1,
+                               5);
+    routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                               Ipv6Prefix(48),
+                               Ipv6Address("2001:1::3"),
+                               1,
+                               2);
+    routing->AddNetworkRouteTo(Ipv6Address("2001:db8:1::"),
+                               Ipv6Prefix(48),
+                               Ipv6Address("2001:2::3"),
+                               2,
+                               2);
+    routing->AddHostRouteTo(Ipv6Address("2001:db8:1::123"),
+                            Ipv6Address("2001:1::4"),
+                            1,
+                            Ipv6Address("::"),
+                            3);
+    routing->AddHostRouteTo(Ipv6Address("2001:db8:1::123"),
+                            Ipv6Address("2001:2::5"),
+                            2,
+                            Ipv6Address("::"),
+                            1);
+
+    CheckGateway(routing, "2001:db8:1::123", "2001:1::4");
+    CheckGateway(routing, "2001:db8:1::999", "2001:2::3");
+    CheckGateway(routing, "2001:db8:2::1", "2001:1::10");
+    CheckGateway(routing, "2001:abcd::1", "2001:2::fe");
+
+    // remove the first host route
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        Ipv6RoutingTableEntry route = routing->GetRoute(i);
+        if (route.IsHost() && route.GetGateway() == Ipv6Address("2001:1::4"))
+        {
+            routing->RemoveRoute(i);
+            break;
+        }
+    }
+    CheckGateway(routing, "2001:db8:1::123", "2001:2::5");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 StaticRouting TestSuite
+ */
+class Ipv6StaticRoutingTestSuite : public TestSuite
+{
+  public:
+    Ipv6StaticRoutingTestSuite();
+};
+
+Ipv6StaticRoutingTestSuite::Ipv6StaticRoutingTestSuite()
+    : TestSuite("ipv6-static-routing", UNIT)
+{
+    AddTestCase(new Ipv6StaticRoutingRouteSelectionTestCase, TestCase::QUICK);
+}
+
+static Ipv6StaticRoutingTestSuite
+    ipv6StaticRoutingTestSuite; //!< Static variable for test initialization
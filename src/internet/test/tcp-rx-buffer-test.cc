@@ -19,10 +19,29 @@
 #include "ns3/tcp-rx-buffer.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("TcpRxBufferTestSuite");
 
+/**
+ * \brief Create a segment whose bytes depend on their sequence number.
+ * \param seq the sequence number of the first byte
+ * \param size the size of the segment
+ * \return the segment
+ */
+static Ptr<Packet>
+CreateSegment(SequenceNumber32 seq, uint32_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>((seq.GetValue() + i) % 251);
+    }
+    return Create<Packet>(data.data(), size);
+}
+
 /**
  * \ingroup internet-tests
  * \ingroup tests
@@ -42,6 +61,11 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test a buffer filled with heavily reordered, overlapping segments.
+     */
+    void TestReordering();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -53,6 +77,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestReordering();
 }
 
 void
@@ -289,6 +314,69 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReordering()
+{
+    const uint32_t segmentSize = 100;
+    const uint32_t nSegments = 1000;
+    TcpRxBuffer rxBuf;
+    TcpHeader h;
+    rxBuf.SetMaxBufferSize(nSegments * segmentSize);
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+
+    // The segments with an odd index arrive first, each one in a new SACK block
+    for (uint32_t i = 1; i < nSegments; i += 2)
+    {
+        SequenceNumber32 seq(1 + i * segmentSize);
+        h.SetSequenceNumber(seq);
+        rxBuf.Add(CreateSegment(seq, segmentSize), h);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 4, "SACK list should contain four elements");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackList().front().first,
+                          SequenceNumber32(1 + (nSegments - 1) * segmentSize),
+                          "SACK block different than expected");
+
+    // Then the segments with an even index (but the first), retransmitted
+    // with half of each neighbour segment
+    for (uint32_t i = 2; i < nSegments; i += 2)
+    {
+        SequenceNumber32 seq(1 + i * segmentSize - segmentSize / 2);
+        h.SetSequenceNumber(seq);
+        rxBuf.Add(CreateSegment(seq, 2 * segmentSize), h);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(),
+                          (nSegments - 1) * segmentSize,
+                          "Overlapping bytes have been buffered");
+
+    // The first segment fills the hole
+    h.SetSequenceNumber(SequenceNumber32(1));
+    rxBuf.Add(CreateSegment(SequenceNumber32(1), segmentSize), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1 + nSegments * segmentSize),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should contain no element");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(),
+                          nSegments * segmentSize,
+                          "Available bytes differ from expected");
+
+    // The data is extracted in order
+    Ptr<Packet> p = rxBuf.Extract(nSegments * segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), nSegments * segmentSize, "Extracted size differs");
+    std::vector<uint8_t> data(p->GetSize());
+    p->CopyData(data.data(), data.size());
+    Ptr<Packet> expected = CreateSegment(SequenceNumber32(1), nSegments * segmentSize);
+    std::vector<uint8_t> expectedData(expected->GetSize());
+    expected->CopyData(expectedData.data(), expectedData.size());
+    NS_TEST_ASSERT_MSG_EQ((data == expectedData), true, "Extracted data differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "Buffer should be empty");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
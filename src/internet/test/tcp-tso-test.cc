@@ -0,0 +1,359 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "tcp-error-model.h"
+#include "tcp-general-test.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+NS_LOG_COMPONENT_DEFINE("TcpTsoTestSuite");
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the ACKs and the congestion window with TSO super-segments
+ *
+ * The sender emulates TSO with super-segments of 5 segments. Every
+ * super-segment must be tagged with its number of segments, acknowledged by
+ * the receiver right away (as 5 segments count towards the delayed ACK), and
+ * its ACK must grow the congestion window in slow start as the delayed ACKs
+ * of its segments would have, i.e., by one segment every two segments.
+ * The application must get the data without the tag.
+ *
+ * SimpleNetDevice does not emulate the segmentation: the link MTU is
+ * raised so that it carries the super-segments as jumbo frames.
+ */
+class TcpTsoAckTest : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param desc Test description.
+     */
+    TcpTsoAckTest(const std::string& desc);
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void ReceivePacket(Ptr<Socket> socket) override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void ProcessedAck(const Ptr<const TcpSocketState> tcb,
+                      const TcpHeader& h,
+                      SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_nSuperSegments;  //!< Number of super-segments sent
+    uint32_t m_nCheckedAcks;    //!< Number of ACKs for which the cWnd was checked
+    uint32_t m_rxBytes;         //!< Number of bytes received by the application
+    bool m_ackPending;          //!< Whether a super-segment is not acknowledged yet
+    Time m_rxTime;              //!< Reception time of the last super-segment
+    SequenceNumber32 m_lastAck; //!< Last ACK processed by the sender
+    uint32_t m_cWnd;            //!< Congestion window after the last ACK
+};
+
+TcpTsoAckTest::TcpTsoAckTest(const std::string& desc)
+    : TcpGeneralTest(desc),
+      m_nSuperSegments(0),
+      m_nCheckedAcks(0),
+      m_rxBytes(0),
+      m_ackPending(false),
+      m_lastAck(1),
+      m_cWnd(0)
+{
+}
+
+Ptr<TcpSocketMsgBase>
+TcpTsoAckTest::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("TsoMaxSize", UintegerValue(2500));
+    return socket;
+}
+
+void
+TcpTsoAckTest::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktSize(5000);
+    SetAppPktCount(4);
+    SetMTU(3000);
+}
+
+void
+TcpTsoAckTest::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+    m_cWnd = 10 * GetSegSize(SENDER);
+}
+
+void
+TcpTsoAckTest::ReceivePacket(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    Address from;
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+        if (packet->GetSize() == 0)
+        { // EOF
+            break;
+        }
+        SegmentationOffloadTag tsoTag;
+        NS_TEST_EXPECT_MSG_EQ(packet->PeekPacketTag(tsoTag),
+                              false,
+                              "The application got the TSO tag");
+        m_rxBytes += packet->GetSize();
+    }
+}
+
+void
+TcpTsoAckTest::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == SENDER && p->GetSize() > 0)
+    {
+        uint32_t segSize = GetSegSize(SENDER);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(p->GetSize(), 2500, "Super-segment larger than TsoMaxSize");
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize() % segSize, 0, "Super-segment of partial segments");
+        SegmentationOffloadTag tsoTag;
+        bool tso = p->PeekPacketTag(tsoTag);
+        NS_TEST_ASSERT_MSG_EQ(tso, (p->GetSize() > segSize), "Wrong TSO tagging");
+        if (tso)
+        {
+            NS_TEST_EXPECT_MSG_EQ(tsoTag.GetNSegments(),
+                                  p->GetSize() / segSize,
+                                  "Wrong number of segments");
+            m_nSuperSegments++;
+        }
+    }
+    else if (who == RECEIVER && p->GetSize() == 0 && m_ackPending)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_rxTime, "Delayed ACK of a super-segment");
+        m_ackPending = false;
+    }
+}
+
+void
+TcpTsoAckTest::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER && p->GetSize() > 0)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_ackPending, false, "A super-segment was not acknowledged");
+        SegmentationOffloadTag tsoTag;
+        m_ackPending = p->PeekPacketTag(tsoTag) && tsoTag.GetNSegments() >= 2;
+        m_rxTime = Simulator::Now();
+    }
+}
+
+void
+TcpTsoAckTest::ProcessedAck(const Ptr<const TcpSocketState> tcb, const TcpHeader& h, SocketWho who)
+{
+    if (who != SENDER || h.GetAckNumber() <= m_lastAck)
+    {
+        return;
+    }
+    uint32_t segSize = GetSegSize(SENDER);
+    uint32_t bytesAcked = h.GetAckNumber() - m_lastAck;
+    if (bytesAcked % segSize == 0 && GetCongStateFrom(tcb) == TcpSocketState::CA_OPEN)
+    {
+        // one segment more every two segments acknowledged
+        uint32_t segsAcked = bytesAcked / segSize;
+        NS_TEST_EXPECT_MSG_EQ(tcb->m_cWnd.Get(),
+                              m_cWnd + (segsAcked + 1) / 2 * segSize,
+                              "Wrong cWnd growth upon the ACK of " << segsAcked << " segments");
+        m_nCheckedAcks++;
+    }
+    m_lastAck = h.GetAckNumber();
+    m_cWnd = tcb->m_cWnd;
+}
+
+void
+TcpTsoAckTest::FinalChecks()
+{
+    NS_TEST_EXPECT_MSG_GT(m_nSuperSegments, 0, "No super-segment sent");
+    NS_TEST_EXPECT_MSG_EQ(m_ackPending, false, "The last super-segment was not acknowledged");
+    NS_TEST_EXPECT_MSG_GT(m_nCheckedAcks, 0, "No ACK checked");
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, 20000, "Not all the data was received");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the retransmission of a super-segment after an RTO
+ *
+ * The sender sends its 5000 bytes in two super-segments of 5 segments, and
+ * the second one is lost. Since no other data follows, the RTO fires: the
+ * lost super-segment must then be retransmitted as single untagged segments,
+ * starting from its first byte, and the receiver must get all the data.
+ */
+class TcpTsoRtoTest : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param desc Test description.
+     */
+    TcpTsoRtoTest(const std::string& desc);
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    Ptr<ErrorModel> CreateReceiverErrorModel() override;
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void ReceivePacket(Ptr<Socket> socket) override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void BeforeRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_nRtos;          //!< Number of RTO expirations
+    uint32_t m_nSuperSegments; //!< Number of super-segments sent
+    uint32_t m_nRetx;          //!< Number of data packets sent after the RTO
+    uint32_t m_rxBytes;        //!< Number of bytes received by the application
+};
+
+TcpTsoRtoTest::TcpTsoRtoTest(const std::string& desc)
+    : TcpGeneralTest(desc),
+      m_nRtos(0),
+      m_nSuperSegments(0),
+      m_nRetx(0),
+      m_rxBytes(0)
+{
+}
+
+Ptr<TcpSocketMsgBase>
+TcpTsoRtoTest::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("TsoMaxSize", UintegerValue(2500));
+    return socket;
+}
+
+Ptr<ErrorModel>
+TcpTsoRtoTest::CreateReceiverErrorModel()
+{
+    Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel>();
+    errorModel->AddSeqToKill(SequenceNumber32(2501));
+    return errorModel;
+}
+
+void
+TcpTsoRtoTest::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktSize(5000);
+    SetAppPktCount(1);
+    SetMTU(3000);
+}
+
+void
+TcpTsoRtoTest::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+}
+
+void
+TcpTsoRtoTest::ReceivePacket(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    Address from;
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+        if (packet->GetSize() == 0)
+        { // EOF
+            break;
+        }
+        m_rxBytes += packet->GetSize();
+    }
+}
+
+void
+TcpTsoRtoTest::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who != SENDER || p->GetSize() == 0)
+    {
+        return;
+    }
+    SegmentationOffloadTag tsoTag;
+    if (m_nRtos == 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 2500, "The data should fit two super-segments");
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tsoTag), true, "Untagged super-segment");
+        m_nSuperSegments++;
+        return;
+    }
+    if (m_nRetx == 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(h.GetSequenceNumber(),
+                              SequenceNumber32(2501),
+                              "The lost super-segment should be retransmitted first");
+    }
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), GetSegSize(SENDER), "Retransmissions are single segments");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tsoTag), false, "Tagged retransmission");
+    m_nRetx++;
+}
+
+void
+TcpTsoRtoTest::BeforeRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who)
+{
+    if (who == SENDER)
+    {
+        m_nRtos++;
+    }
+}
+
+void
+TcpTsoRtoTest::FinalChecks()
+{
+    NS_TEST_EXPECT_MSG_EQ(m_nSuperSegments, 2, "Two super-segments should have been sent");
+    NS_TEST_EXPECT_MSG_EQ(m_nRtos, 1, "The RTO should have expired once");
+    NS_TEST_EXPECT_MSG_EQ(m_nRetx, 5, "The 5 lost segments should have been retransmitted");
+    NS_TEST_EXPECT_MSG_EQ(m_rxBytes, 5000, "Not all the data was received");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the TCP segmentation offload emulation
+ */
+class TcpTsoTestSuite : public TestSuite
+{
+  public:
+    TcpTsoTestSuite()
+        : TestSuite("tcp-tso-test", UNIT)
+    {
+        AddTestCase(new TcpTsoAckTest("TSO super-segments ACKs and cWnd growth"),
+                    TestCase::QUICK);
+        AddTestCase(new TcpTsoRtoTest("TSO super-segment retransmission after an RTO"),
+                    TestCase::QUICK);
+    }
+};
+
+static TcpTsoTestSuite g_tcpTsoTestSuite; //!< Static variable for test initialization
@@ -53,6 +53,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard with a large window of segments in flight */
+    void TestLargeWindow();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -100,6 +102,13 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large bandwidth-delay product:
+     *  -> one segment every two is sacked, in many ACKs
+     *  -> the holes with at least DupAckThresh sacked segments above are lost
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -420,6 +429,73 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    const uint32_t segmentSize = 1000;
+    const uint32_t nSegments = 10000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetMaxBufferSize(nSegments * segmentSize);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+
+    txBuf->Add(Create<Packet>(nSegments * segmentSize));
+    for (uint32_t i = 0; i < nSegments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, SequenceNumber32(1 + i * segmentSize));
+    }
+
+    // SACK the segments with an even index (but the first), three per ACK
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    for (uint32_t i = 2; i < nSegments; i += 2)
+    {
+        sack->AddSackBlock(
+            TcpOptionSack::SackBlock(SequenceNumber32(1 + i * segmentSize),
+                                     SequenceNumber32(1 + (i + 1) * segmentSize)));
+        if (sack->GetNumSackBlocks() == 3 || i + 2 >= nSegments)
+        {
+            txBuf->Update(sack->GetSackList());
+            sack->ClearSackList();
+        }
+    }
+
+    // The head, and all the holes but the three highest, are lost
+    uint32_t sacked = (nSegments - 2) / 2;
+    uint32_t lost = 1 + (nSegments - 6) / 2;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), sacked * segmentSize, "Wrong sacked count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), lost * segmentSize, "Wrong lost count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1 + (nSegments - 7) * segmentSize)),
+                          true,
+                          "Hole below three sacked segments is not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1 + (nSegments - 5) * segmentSize)),
+                          false,
+                          "Hole below two sacked segments is lost");
+
+    // The lost segments are retransmitted in order
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No segment to send");
+    NS_TEST_ASSERT_MSG_EQ(seq, SequenceNumber32(1), "Wrong segment to retransmit");
+    txBuf->CopyFromSequence(segmentSize, seq);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No segment to send");
+    NS_TEST_ASSERT_MSG_EQ(seq, SequenceNumber32(1 + segmentSize), "Wrong segment to retransmit");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                          (nSegments - sacked - lost + 1) * segmentSize,
+                          "Wrong bytes in flight");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(SequenceNumber32(1 + segmentSize)),
+                          true,
+                          "Retransmitted head not found");
+
+    // A cumulative ACK of the retransmitted head
+    txBuf->DiscardUpTo(SequenceNumber32(1 + segmentSize));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), (lost - 1) * segmentSize, "Wrong lost count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), 0, "Wrong retransmitted count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No segment to send");
+    NS_TEST_ASSERT_MSG_EQ(seq, SequenceNumber32(1 + segmentSize), "Wrong segment to retransmit");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -28,6 +28,9 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-queue-disc-item.h"
@@ -766,6 +769,85 @@ Udp6SocketImplTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 end point demultiplexer test
+ */
+class UdpEndPointDemuxTest : public TestCase
+{
+  public:
+    UdpEndPointDemuxTest();
+    void DoRun() override;
+};
+
+UdpEndPointDemuxTest::UdpEndPointDemuxTest()
+    : TestCase("IPv4 end point demultiplexer lookups")
+{
+}
+
+void
+UdpEndPointDemuxTest::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address peer("10.0.0.2");
+    Ipv4Address other("10.0.0.3");
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    interface->AddAddress(Ipv4InterfaceAddress(local, Ipv4Mask("255.255.255.0")));
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80);
+    Ipv4EndPoint* bound = demux.Allocate(nullptr, local, 81);
+    Ipv4EndPoint* connected = demux.Allocate(nullptr, local, 80, peer, 1000);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Allocation failed");
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Allocation failed");
+    NS_TEST_ASSERT_MSG_NE(connected, nullptr, "Allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1000),
+                          nullptr,
+                          "Duplicated end point allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 81), nullptr, "Duplicated end point");
+
+    // the most specific end point is selected
+    Ipv4EndPointDemux::EndPoints endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Wrong number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), connected, "Wrong end point");
+    endPoints = demux.Lookup(local, 80, other, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Wrong number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Wrong end point");
+    endPoints = demux.Lookup(local, 81, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Wrong number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), bound, "Wrong end point");
+    endPoints = demux.Lookup(other, 81, peer, 1000, interface);
+    NS_TEST_EXPECT_MSG_EQ(endPoints.size(), 0, "Unexpected end point");
+
+    // connecting an end point after its allocation updates the lookups
+    bound->SetPeer(other, 2000);
+    endPoints = demux.Lookup(local, 81, peer, 1000, interface);
+    NS_TEST_EXPECT_MSG_EQ(endPoints.size(), 0, "Unexpected end point");
+    endPoints = demux.Lookup(local, 81, other, 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Wrong number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), bound, "Wrong end point");
+
+    demux.DeAllocate(connected);
+    endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Wrong number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Wrong end point");
+    demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "Port 80 still in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(81), true, "Port 81 not in use");
+
+    // the ephemeral ports are allocated in sequence, skipping the ports in use
+    Ipv4EndPoint* ephemeral = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(ephemeral, nullptr, "Allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(ephemeral->GetLocalPort(), 49153, "Wrong ephemeral port");
+    NS_TEST_ASSERT_MSG_NE(demux.Allocate(nullptr, 49154), nullptr, "Allocation failed");
+    ephemeral = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(ephemeral, nullptr, "Allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(ephemeral->GetLocalPort(), 49155, "Wrong ephemeral port");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetAllEndPoints().size(), 4, "Wrong number of end points");
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -782,6 +864,7 @@ class UdpTestSuite : public TestSuite
         AddTestCase(new UdpSocketLoopbackTest, TestCase::QUICK);
         AddTestCase(new Udp6SocketImplTest, TestCase::QUICK);
         AddTestCase(new Udp6SocketLoopbackTest, TestCase::QUICK);
+        AddTestCase(new UdpEndPointDemuxTest, TestCase::QUICK);
     }
 };
 
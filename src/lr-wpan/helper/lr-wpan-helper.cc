@@ -21,6 +21,7 @@
 #include "lr-wpan-helper.h"
 
 #include "ns3/names.h"
+#include <ns3/binary-trace-file.h>
 #include <ns3/log.h>
 #include <ns3/lr-wpan-csmaca.h>
 #include <ns3/lr-wpan-error-model.h>
@@ -47,6 +48,11 @@ AsciiLrWpanMacTransmitSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                       std::string context,
                                       Ptr<const Packet> p)
 {
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().As(Time::S) << " " << context << " " << *p
                          << std::endl;
 }
@@ -59,6 +65,11 @@ AsciiLrWpanMacTransmitSinkWithContext(Ptr<OutputStreamWrapper> stream,
 static void
 AsciiLrWpanMacTransmitSinkWithoutContext(Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().As(Time::S) << " " << *p << std::endl;
 }
 
@@ -29,7 +29,8 @@
 #include <algorithm>
 
 #undef NS_LOG_APPEND_CONTEXT
-#define NS_LOG_APPEND_CONTEXT std::clog << "[address " << m_mac->GetShortAddress() << "] ";
+#define NS_LOG_APPEND_CONTEXT                                                                      \
+    LogGetContextStream() << "[address " << m_mac->GetShortAddress() << "] ";
 
 namespace ns3
 {
@@ -38,7 +38,7 @@
 #include <ns3/uinteger.h>
 
 #undef NS_LOG_APPEND_CONTEXT
-#define NS_LOG_APPEND_CONTEXT std::clog << "[address " << m_shortAddress << "] ";
+#define NS_LOG_APPEND_CONTEXT LogGetContextStream() << "[address " << m_shortAddress << "] ";
 
 namespace ns3
 {
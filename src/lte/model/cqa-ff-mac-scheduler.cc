@@ -36,7 +36,6 @@
 
 #include <cfloat>
 #include <set>
-#include <stdexcept>
 
 namespace ns3
 {
@@ -1332,6 +1331,63 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
         }
     }
 
+    // CQI of the UEs on each RBG for the CoItA metric, and their sum over the RBGs still
+    // available: these are always the available RBGs from the current one on, as the RBGs
+    // are allocated in increasing order
+    struct CoitaCqi
+    {
+        std::vector<int> value; ///< CQI on each RBG
+        std::vector<int> sum;   ///< sum of the CQIs of the available RBGs from each RBG on
+    };
+
+    std::map<uint16_t, CoitaCqi> coitaCqis;
+    for (const auto* groups : {&map_GBRHOLgroupToUE, &map_nonGBRHOLgroupToUE})
+    {
+        for (const auto& group : *groups)
+        {
+            for (const auto& flowId : group.second)
+            {
+                std::map<uint16_t, SbMeasResult_s>::iterator itRntiCQIsMap =
+                    m_a30CqiRxed.find(flowId.m_rnti);
+                if (itRntiCQIsMap == m_a30CqiRxed.end() ||
+                    coitaCqis.find(flowId.m_rnti) != coitaCqis.end())
+                {
+                    continue;
+                }
+                const std::vector<HigherLayerSelected_s>& higherLayerSelected =
+                    itRntiCQIsMap->second.m_higherLayerSelected;
+                CoitaCqi& cqis = coitaCqis[flowId.m_rnti];
+                cqis.value.resize(numberOfRBGs, 1); // if no info on channel use the worst cqi
+                cqis.sum.resize(numberOfRBGs + 1, 0);
+                for (int i = numberOfRBGs - 1; i >= 0; i--)
+                {
+                    if (i < (int)higherLayerSelected.size() &&
+                        !higherLayerSelected[i].m_sbCqi.empty())
+                    {
+                        int val = higherLayerSelected[i].m_sbCqi[0];
+                        if (val == 0)
+                        {
+                            val = 1; // if no info, use minimum
+                        }
+                        cqis.value[i] = val;
+                    }
+                    else if (availableRBGs.count(i) > 0)
+                    {
+                        NS_LOG_INFO("No CQI for lcId:" << (uint16_t)flowId.m_lcId
+                                                       << " rnti:" << flowId.m_rnti
+                                                       << " at subband:" << i);
+                    }
+                    cqis.sum[i] = cqis.sum[i + 1];
+                    if (availableRBGs.count(i) > 0)
+                    {
+                        cqis.sum[i] += cqis.value[i];
+                    }
+                }
+            }
+        }
+    }
+    DlRbgRatePerCqi rbgRatePerCqi = ComputeDlRbgRatePerCqi(m_amc, rbgSize);
+
     t_it_HOLgroupToUEs itGBRgroups = map_GBRHOLgroupToUE.begin();
     t_it_HOLgroupToUEs itnonGBRgroups = map_nonGBRHOLgroupToUE.begin();
 
@@ -1391,7 +1447,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
                 double metric = 0;
                 uint8_t worstCQIAmongRBGsAllocatedForThisUser = 15;
                 int numberOfRBGAllocatedForThisUser = 0;
-                LogicalChannelConfigListElement_s lc =
+                const LogicalChannelConfigListElement_s& lc =
                     m_ueLogicalChannelsConfigList.find(flowId)->second;
                 std::map<uint16_t, SbMeasResult_s>::iterator itRntiCQIsMap =
                     m_a30CqiRxed.find(flowId.m_rnti);
@@ -1419,34 +1475,9 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
 
                 if (itRntiCQIsMap != m_a30CqiRxed.end())
                 {
-                    for (std::set<int>::iterator it = availableRBGs.begin();
-                         it != availableRBGs.end();
-                         it++)
-                    {
-                        try
-                        {
-                            int val =
-                                (itRntiCQIsMap->second.m_higherLayerSelected.at(*it).m_sbCqi.at(0));
-                            if (val == 0)
-                            {
-                                val = 1; // if no info, use minimum
-                            }
-                            if (*it == currentRB)
-                            {
-                                cqi_value = val;
-                            }
-                            coita_sum += val;
-                        }
-                        catch (std::out_of_range&)
-                        {
-                            coita_sum += 1; // if no info on channel use the worst cqi
-                            NS_LOG_INFO("No CQI for lcId:" << flowId.m_lcId
-                                                           << " rnti:" << flowId.m_rnti
-                                                           << " at subband:" << currentRB);
-                            // std::cout<<"\n No CQI for
-                            // lcId:.....................................";
-                        }
-                    }
+                    const CoitaCqi& cqis = coitaCqis.find(flowId.m_rnti)->second;
+                    cqi_value = cqis.value.at(currentRB);
+                    coita_sum = cqis.sum.at(currentRB);
                     coita_metric = cqi_value / coita_sum;
                     UeToCQIValue.insert(std::pair<LteFlowId_t, CQI_value>(flowId, cqi_value));
                     UeToCoitaMetric.insert(std::pair<LteFlowId_t, double>(flowId, coita_metric));
@@ -1487,13 +1518,10 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
                     8; // similar to calculation of TB size (size of TB in bytes according to
                        // table 7.1.7.2.1-1 of 36.213)
 
-                double achievableRate =
-                    ((m_amc->GetDlTbSizeFromMcs(mcsForThisUser, rbgSize) / 8) / 0.001);
+                double achievableRate = rbgRatePerCqi.at(worstCQIAmongRBGsAllocatedForThisUser);
                 double pf_weight = achievableRate / (*itStats).second.secondLastAveragedThroughput;
 
                 UeToAmountOfAssignedResources.find(flowId)->second = 8 * tbSize;
-                FfMacSchedSapProvider::SchedDlRlcBufferReqParameters lcBufferInfo =
-                    m_rlcBufferReq.find(flowId)->second;
 
                 if (UeToAmountOfDataToTransfer.find(flowId)->second -
                         UeToAmountOfAssignedResources.find(flowId)->second <
@@ -884,97 +884,71 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
+    // collect the UEs eligible for the free RBGs, which do not depend on the RBG
+    std::vector<DlRbgCandidate> candidates;
+    candidates.reserve(m_flowStatsDl.size());
+    for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+    {
+        std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it));
+        if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it))))
+        {
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            if (itRnti != rntiAllocated.end())
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it));
+            }
+            if (!HarqProcessAvailability((*it)))
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it));
+            }
+            continue;
+        }
+        std::map<uint16_t, uint8_t>::iterator itTxMode;
+        itTxMode = m_uesTxMode.find((*it));
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it));
+        }
+        if (LcActivePerFlow((*it)) == 0)
+        {
+            // this UE has no data to transmit
+            continue;
+        }
+        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
+        itCqi = m_a30CqiRxed.find((*it));
+        DlRbgCandidate candidate;
+        candidate.rnti = (*it);
+        candidate.nLayers = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        candidate.sbMeas = (itCqi == m_a30CqiRxed.end()) ? nullptr : &(*itCqi).second;
+        candidate.averagedThroughput = 0.0;
+        candidates.push_back(candidate);
+    }
+    DlRbgRatePerCqi rbgRatePerCqi = ComputeDlRbgRatePerCqi(m_amc, rbgSize);
+
     for (int i = 0; i < rbgNum; i++)
     {
         NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
         if (rbgMap.at(i) == false)
         {
-            std::set<uint16_t>::iterator it;
-            std::set<uint16_t>::iterator itMax = m_flowStatsDl.end();
+            const DlRbgCandidate* itMax = nullptr;
             double rcqiMax = 0.0;
-            for (it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            for (const auto& candidate : candidates)
             {
-                std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it));
-                if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it))))
+                double rcqi = GetDlRbgAchievableRate(rbgRatePerCqi, candidate, i);
+                if (rcqi > 0)
                 {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it));
-                    }
-                    if (!HarqProcessAvailability((*it)))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it));
-                    }
-                    continue;
-                }
+                    NS_LOG_INFO(this << " RNTI " << candidate.rnti << " achievableRate " << rcqi
+                                     << " RCQI " << rcqi);
 
-                std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                itCqi = m_a30CqiRxed.find((*it));
-                std::map<uint16_t, uint8_t>::iterator itTxMode;
-                itTxMode = m_uesTxMode.find((*it));
-                if (itTxMode == m_uesTxMode.end())
-                {
-                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it));
-                }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    for (uint8_t k = 0; k < nLayer; k++)
+                    if (rcqi > rcqiMax)
                     {
-                        sbCqi.push_back(1); // start with lowest value
+                        rcqiMax = rcqi;
+                        itMax = &candidate;
                     }
                 }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
-                uint8_t cqi1 = sbCqi.at(0);
-                uint8_t cqi2 = 0;
-                if (sbCqi.size() > 1)
-                {
-                    cqi2 = sbCqi.at(1);
-                }
-                if ((cqi1 > 0) ||
-                    (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                    if (LcActivePerFlow((*it)) > 0)
-                    {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        uint8_t mcs = 0;
-                        for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                            if (sbCqi.size() > k)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
-                        }
-
-                        double rcqi = achievableRate;
-                        NS_LOG_INFO(this << " RNTI " << (*it) << " MCS " << (uint32_t)mcs
-                                         << " achievableRate " << achievableRate << " RCQI "
-                                         << rcqi);
-
-                        if (rcqi > rcqiMax)
-                        {
-                            rcqiMax = rcqi;
-                            itMax = it;
-                        }
-                    }
-                } // end if cqi
+            } // end for candidates
 
-            } // end for m_rlcBufferReq
-
-            if (itMax == m_flowStatsDl.end())
+            if (itMax == nullptr)
             {
                 // no UE available for this RB
                 NS_LOG_INFO(this << " any UE found");
@@ -982,21 +956,8 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq(
             else
             {
                 rbgMap.at(i) = true;
-                std::map<uint16_t, std::vector<uint16_t>>::iterator itMap;
-                itMap = allocationMap.find((*itMax));
-                if (itMap == allocationMap.end())
-                {
-                    // insert new element
-                    std::vector<uint16_t> tempMap;
-                    tempMap.push_back(i);
-                    allocationMap.insert(
-                        std::pair<uint16_t, std::vector<uint16_t>>((*itMax), tempMap));
-                }
-                else
-                {
-                    (*itMap).second.push_back(i);
-                }
-                NS_LOG_INFO(this << " UE assigned " << (*itMax));
+                allocationMap[itMax->rnti].push_back(i);
+                NS_LOG_INFO(this << " UE assigned " << itMax->rnti);
             }
         } // end for RBG free
     }     // end for RBGs
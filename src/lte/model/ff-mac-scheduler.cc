@@ -19,6 +19,8 @@
 
 #include "ff-mac-scheduler.h"
 
+#include "lte-amc.h"
+
 #include <ns3/enum.h>
 #include <ns3/log.h>
 
@@ -63,4 +65,52 @@ FfMacScheduler::GetTypeId()
     return tid;
 }
 
+FfMacScheduler::DlRbgRatePerCqi
+FfMacScheduler::ComputeDlRbgRatePerCqi(Ptr<LteAmc> amc, int rbgSize)
+{
+    DlRbgRatePerCqi rates;
+    for (std::size_t cqi = 0; cqi < rates.size(); cqi++)
+    {
+        uint8_t mcs = amc->GetMcsFromCqi(cqi);
+        rates[cqi] = (amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) / 0.001; // = TB size / TTI
+    }
+    return rates;
+}
+
+double
+FfMacScheduler::GetDlRbgAchievableRate(const DlRbgRatePerCqi& rates,
+                                       const DlRbgCandidate& ue,
+                                       int rbgId)
+{
+    double achievableRate = 0.0;
+    if (ue.sbMeas == nullptr)
+    {
+        // no CQI received yet: start with the lowest value on each layer
+        for (uint8_t k = 0; k < ue.nLayers; k++)
+        {
+            achievableRate += rates[1];
+        }
+        return achievableRate;
+    }
+
+    const std::vector<uint8_t>& sbCqi = ue.sbMeas->m_higherLayerSelected.at(rbgId).m_sbCqi;
+    uint8_t cqi1 = sbCqi.at(0);
+    uint8_t cqi2 = 0;
+    if (sbCqi.size() > 1)
+    {
+        cqi2 = sbCqi.at(1);
+    }
+    if ((cqi1 == 0) && (cqi2 == 0))
+    {
+        // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+        return 0.0;
+    }
+    for (uint8_t k = 0; k < ue.nLayers; k++)
+    {
+        // no info on this subband -> worst MCS, same as CQI 0
+        achievableRate += (sbCqi.size() > k) ? rates.at(sbCqi[k]) : rates[0];
+    }
+    return achievableRate;
+}
+
 } // namespace ns3
@@ -21,8 +21,12 @@
 #ifndef FF_MAC_SCHEDULER_H
 #define FF_MAC_SCHEDULER_H
 
+#include "ff-mac-common.h"
+
 #include <ns3/object.h>
 
+#include <array>
+
 namespace ns3
 {
 
@@ -32,6 +36,7 @@ class FfMacCschedSapProvider;
 class FfMacSchedSapProvider;
 class LteFfrSapProvider;
 class LteFfrSapUser;
+class LteAmc;
 
 /**
  * \ingroup lte
@@ -126,6 +131,49 @@ class FfMacScheduler : public Object
     virtual LteFfrSapUser* GetLteFfrSapUser() = 0;
 
   protected:
+    /// Achievable DL rate (in bytes/s) of a RBG, for each CQI value
+    typedef std::array<double, 16> DlRbgRatePerCqi;
+
+    /**
+     * A UE eligible for the allocation of the free RBGs of the current TTI,
+     * with what is needed to evaluate its achievable rate on each RBG. The
+     * eligibility of a UE does not depend on the RBG, hence the candidates
+     * are collected once per TTI rather than once per RBG.
+     */
+    struct DlRbgCandidate
+    {
+        uint16_t rnti;                ///< RNTI of the UE
+        uint8_t nLayers;              ///< number of layers of the UE transmission mode
+        const SbMeasResult_s* sbMeas; ///< latest subband CQIs, nullptr if none received
+        double averagedThroughput;    ///< averaged throughput, for schedulers using it
+    };
+
+    /**
+     * Compute the achievable DL rate of a RBG for each CQI value. It only
+     * depends on the RBG size, so it is computed once per TTI and then
+     * looked up for every UE and RBG.
+     *
+     * \param amc the AMC module
+     * \param rbgSize the RBG size
+     * \return the achievable rate of a RBG for each CQI value
+     */
+    static DlRbgRatePerCqi ComputeDlRbgRatePerCqi(Ptr<LteAmc> amc, int rbgSize);
+
+    /**
+     * Get the achievable DL rate of a UE on a RBG, summed over its layers,
+     * according to the latest subband CQIs of the UE (CQI 1 on each layer
+     * if no CQI has been received yet).
+     *
+     * \param rates the achievable rate of the RBG for each CQI value
+     * \param ue the UE
+     * \param rbgId the RBG index
+     * \return the achievable rate in bytes/s, or 0 if the CQIs of the UE on
+     * this RBG are out of range
+     */
+    static double GetDlRbgAchievableRate(const DlRbgRatePerCqi& rates,
+                                         const DlRbgCandidate& ue,
+                                         int rbgId);
+
     UlCqiFilter_t m_ulCqiFilter; ///< UL CQI filter
 };
 
@@ -29,6 +29,7 @@
 #include "lte-ue-rrc.h"
 
 #include <ns3/attribute-accessor-helper.h>
+#include <ns3/boolean.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/lte-common.h>
@@ -36,8 +37,10 @@
 #include <ns3/object-factory.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <numeric>
 
 // WILD HACK for the inizialization of direct eNB-UE ctrl messaging
 #include <ns3/lte-ue-net-device.h>
@@ -158,7 +161,8 @@ LteEnbPhy::LteEnbPhy(Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
       m_srsPeriodicity(0),
       m_srsStartTime(Seconds(0)),
       m_currentSrsOffset(0),
-      m_interferenceSampleCounter(0)
+      m_interferenceSampleCounter(0),
+      m_activity(false)
 {
     m_enbPhySapProvider = new EnbMemberLteEnbPhySapProvider(this);
     m_enbCphySapProvider = new MemberLteEnbCphySapProvider<LteEnbPhy>(this);
@@ -226,6 +230,11 @@ LteEnbPhy::GetTypeId()
                             "DL transmission PHY layer statistics.",
                             MakeTraceSourceAccessor(&LteEnbPhy::m_dlPhyTransmission),
                             "ns3::PhyTransmissionStatParameters::TracedCallback")
+            .AddTraceSource("SubframeStart",
+                            "Start of a sub frame, which is not fired for the "
+                            "idle sub frames skipped.",
+                            MakeTraceSourceAccessor(&LteEnbPhy::m_subframeStartTrace),
+                            "ns3::LteEnbPhy::SubframeStartTracedCallback")
             .AddAttribute("DlSpectrumPhy",
                           "The downlink LteSpectrumPhy associated to this LtePhy",
                           TypeId::ATTR_GET,
@@ -237,7 +246,17 @@ LteEnbPhy::GetTypeId()
                           TypeId::ATTR_GET,
                           PointerValue(),
                           MakePointerAccessor(&LteEnbPhy::GetUlSpectrumPhy),
-                          MakePointerChecker<LteSpectrumPhy>());
+                          MakePointerChecker<LteSpectrumPhy>())
+            .AddAttribute("SkipIdleSubframes",
+                          "If true, the sub frames of a cell with no attached UE and "
+                          "nothing to transmit are not processed, except those "
+                          "carrying PSS, MIB or SIB1. Frame and sub frame numbers "
+                          "are kept as if every sub frame had been processed, and the "
+                          "cell wakes up at the next sub frame boundary when a "
+                          "RACH preamble is received or a UE is added.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LteEnbPhy::m_skipIdleSubframes),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -251,6 +270,9 @@ LteEnbPhy::DoDispose()
     NS_LOG_FUNCTION(this);
     m_ueAttached.clear();
     m_srsUeOffset.clear();
+    m_dlCtrlTxPsdCache.psd = nullptr;
+    m_dlDataTxPsdCache.psd = nullptr;
+    m_idleSkipEvent.Cancel();
     delete m_enbPhySapProvider;
     delete m_enbCphySapProvider;
     LtePhy::DoDispose();
@@ -439,18 +461,38 @@ void
 LteEnbPhy::SetDownlinkSubChannels(std::vector<int> mask)
 {
     NS_LOG_FUNCTION(this);
-    m_listOfDownlinkSubchannel = mask;
-    Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity();
-    m_downlinkSpectrumPhy->SetTxPowerSpectralDensity(txPsd);
+    m_listOfDownlinkSubchannel = std::move(mask);
+    TxPsdCache& cache = m_dlCtrlTxPsdCache;
+    if (!cache.psd || cache.txPower != m_txPower || cache.earfcn != m_dlEarfcn ||
+        cache.bandwidth != m_dlBandwidth || cache.rbMap != m_listOfDownlinkSubchannel)
+    {
+        cache.psd = CreateTxPowerSpectralDensity();
+        cache.txPower = m_txPower;
+        cache.earfcn = m_dlEarfcn;
+        cache.bandwidth = m_dlBandwidth;
+        cache.rbMap = m_listOfDownlinkSubchannel;
+    }
+    m_downlinkSpectrumPhy->SetTxPowerSpectralDensity(cache.psd);
 }
 
 void
 LteEnbPhy::SetDownlinkSubChannelsWithPowerAllocation(std::vector<int> mask)
 {
     NS_LOG_FUNCTION(this);
-    m_listOfDownlinkSubchannel = mask;
-    Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensityWithPowerAllocation();
-    m_downlinkSpectrumPhy->SetTxPowerSpectralDensity(txPsd);
+    m_listOfDownlinkSubchannel = std::move(mask);
+    TxPsdCache& cache = m_dlDataTxPsdCache;
+    if (!cache.psd || cache.txPower != m_txPower || cache.earfcn != m_dlEarfcn ||
+        cache.bandwidth != m_dlBandwidth || cache.rbMap != m_listOfDownlinkSubchannel ||
+        cache.powerAllocation != m_dlPowerAllocationMap)
+    {
+        cache.psd = CreateTxPowerSpectralDensityWithPowerAllocation();
+        cache.txPower = m_txPower;
+        cache.earfcn = m_dlEarfcn;
+        cache.bandwidth = m_dlBandwidth;
+        cache.rbMap = m_listOfDownlinkSubchannel;
+        cache.powerAllocation = m_dlPowerAllocationMap;
+    }
+    m_downlinkSpectrumPhy->SetTxPowerSpectralDensity(cache.psd);
 }
 
 std::vector<int>
@@ -538,6 +580,7 @@ LteEnbPhy::ReceiveLteControlMessageList(std::list<Ptr<LteControlMessage>> msgLis
         case LteControlMessage::RACH_PREAMBLE: {
             Ptr<RachPreambleLteControlMessage> rachPreamble =
                 DynamicCast<RachPreambleLteControlMessage>(*it);
+            WakeUp();
             m_enbPhySapUser->ReceiveRachPreamble(rachPreamble->GetRapId());
         }
         break;
@@ -603,6 +646,7 @@ LteEnbPhy::StartSubFrame()
     NS_LOG_FUNCTION(this);
 
     ++m_nrSubFrames;
+    m_activity = false;
 
     /*
      * Send SIB1 at 6th subframe of every odd-numbered radio frame. This is
@@ -633,6 +677,7 @@ LteEnbPhy::StartSubFrame()
     std::list<UlDciLteControlMessage> uldcilist = DequeueUlDci();
     std::list<UlDciLteControlMessage>::iterator dciIt = uldcilist.begin();
     NS_LOG_DEBUG(this << " eNB Expected TBs " << uldcilist.size());
+    std::vector<int> rbMap;
     for (dciIt = uldcilist.begin(); dciIt != uldcilist.end(); dciIt++)
     {
         std::set<uint16_t>::iterator it2;
@@ -646,7 +691,7 @@ LteEnbPhy::StartSubFrame()
         {
             // send info of TB to LteSpectrumPhy
             // translate to allocation map
-            std::vector<int> rbMap;
+            rbMap.clear();
             for (int i = (*dciIt).GetDci().m_rbStart;
                  i < (*dciIt).GetDci().m_rbStart + (*dciIt).GetDci().m_rbLen;
                  i++)
@@ -761,7 +806,7 @@ LteEnbPhy::StartSubFrame()
         }
     }
 
-    SendControlChannels(ctrlMsg);
+    SendControlChannels(std::move(ctrlMsg));
 
     // send data frame
     Ptr<PacketBurst> pb = GetPacketBurst();
@@ -774,6 +819,7 @@ LteEnbPhy::StartSubFrame()
     }
 
     // trigger the MAC
+    m_subframeStartTrace(m_nrFrames, m_nrSubFrames);
     m_enbPhySapUser->SubframeIndication(m_nrFrames, m_nrSubFrames);
 
     Simulator::Schedule(Seconds(GetTti()), &LteEnbPhy::EndSubFrame, this);
@@ -784,19 +830,16 @@ LteEnbPhy::SendControlChannels(std::list<Ptr<LteControlMessage>> ctrlMsgList)
 {
     NS_LOG_FUNCTION(this << " eNB " << m_cellId << " start tx ctrl frame");
     // set the current tx power spectral density (full bandwidth)
-    std::vector<int> dlRb;
-    for (uint16_t i = 0; i < m_dlBandwidth; i++)
-    {
-        dlRb.push_back(i);
-    }
-    SetDownlinkSubChannels(dlRb);
+    std::vector<int> dlRb(m_dlBandwidth);
+    std::iota(dlRb.begin(), dlRb.end(), 0);
+    SetDownlinkSubChannels(std::move(dlRb));
     NS_LOG_LOGIC(this << " eNB start TX CTRL");
     bool pss = false;
     if ((m_nrSubFrames == 1) || (m_nrSubFrames == 6))
     {
         pss = true;
     }
-    m_downlinkSpectrumPhy->StartTxDlCtrlFrame(ctrlMsgList, pss);
+    m_downlinkSpectrumPhy->StartTxDlCtrlFrame(std::move(ctrlMsgList), pss);
 }
 
 void
@@ -815,6 +858,22 @@ void
 LteEnbPhy::EndSubFrame()
 {
     NS_LOG_FUNCTION(this << Simulator::Now().As(Time::S));
+    if (m_skipIdleSubframes && IsIdle())
+    {
+        // skip the sub frames up to the next one carrying PSS/MIB (1) or PSS/SIB1 (6)
+        uint32_t nSkipped = (m_nrSubFrames <= 5) ? 5 - m_nrSubFrames : 10 - m_nrSubFrames;
+        if (nSkipped > 0)
+        {
+            NS_LOG_LOGIC(this << " cell " << m_cellId << " idle, skipping " << nSkipped
+                              << " sub frames");
+            m_idleSkipStart = Simulator::Now();
+            m_idleSkipEvent = Simulator::Schedule(Seconds(GetTti()) * nSkipped,
+                                                  &LteEnbPhy::EndIdleSubFrames,
+                                                  this,
+                                                  nSkipped);
+            return;
+        }
+    }
     if (m_nrSubFrames == 10)
     {
         Simulator::ScheduleNow(&LteEnbPhy::EndFrame, this);
@@ -825,6 +884,68 @@ LteEnbPhy::EndSubFrame()
     }
 }
 
+void
+LteEnbPhy::EndIdleSubFrames(uint32_t nSkipped)
+{
+    NS_LOG_FUNCTION(this << nSkipped);
+    m_nrSubFrames += nSkipped;
+    NS_ASSERT(m_nrSubFrames <= 10);
+    EndSubFrame();
+}
+
+bool
+LteEnbPhy::IsIdle() const
+{
+    if (m_activity || !m_ueAttached.empty())
+    {
+        return false;
+    }
+    for (const auto& ctrlMessageList : m_controlMessagesQueue)
+    {
+        if (!ctrlMessageList.empty())
+        {
+            return false;
+        }
+    }
+    for (const auto& packetBurst : m_packetBurstQueue)
+    {
+        if (packetBurst->GetNPackets() > 0)
+        {
+            return false;
+        }
+    }
+    for (const auto& ulDciList : m_ulDciQueue)
+    {
+        if (!ulDciList.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+LteEnbPhy::WakeUp()
+{
+    NS_LOG_FUNCTION(this);
+    m_activity = true;
+    if (m_idleSkipEvent.IsRunning())
+    {
+        // resume at the end of the skipped sub frame in progress
+        int64_t tti = Seconds(GetTti()).GetTimeStep();
+        int64_t elapsed = (Simulator::Now() - m_idleSkipStart).GetTimeStep();
+        auto nSkipped = static_cast<uint32_t>((elapsed + tti - 1) / tti);
+        NS_LOG_LOGIC(this << " cell " << m_cellId << " waking up after " << nSkipped
+                          << " skipped sub frames");
+        m_idleSkipEvent.Cancel();
+        m_idleSkipEvent = Simulator::Schedule(m_idleSkipStart + TimeStep(nSkipped * tti) -
+                                                  Simulator::Now(),
+                                              &LteEnbPhy::EndIdleSubFrames,
+                                              this,
+                                              nSkipped);
+    }
+}
+
 void
 LteEnbPhy::EndFrame()
 {
@@ -927,6 +1048,7 @@ LteEnbPhy::DoAddUe(uint16_t rnti)
 
     bool success = AddUePhy(rnti);
     NS_ASSERT_MSG(success, "AddUePhy() failed");
+    WakeUp();
 
     // add default P_A value
     DoSetPa(rnti, 0);
@@ -1086,22 +1208,10 @@ std::list<UlDciLteControlMessage>
 LteEnbPhy::DequeueUlDci()
 {
     NS_LOG_FUNCTION(this);
-    if (m_ulDciQueue.at(0).size() > 0)
-    {
-        std::list<UlDciLteControlMessage> ret = m_ulDciQueue.at(0);
-        m_ulDciQueue.erase(m_ulDciQueue.begin());
-        std::list<UlDciLteControlMessage> l;
-        m_ulDciQueue.push_back(l);
-        return (ret);
-    }
-    else
-    {
-        m_ulDciQueue.erase(m_ulDciQueue.begin());
-        std::list<UlDciLteControlMessage> l;
-        m_ulDciQueue.push_back(l);
-        std::list<UlDciLteControlMessage> emptylist;
-        return (emptylist);
-    }
+    std::list<UlDciLteControlMessage> ret;
+    ret.swap(m_ulDciQueue.at(0));
+    std::rotate(m_ulDciQueue.begin(), m_ulDciQueue.begin() + 1, m_ulDciQueue.end());
+    return ret;
 }
 
 void
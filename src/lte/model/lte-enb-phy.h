@@ -261,6 +261,32 @@ class LteEnbPhy : public LtePhy
      * \brief End a LTE frame
      */
     void EndFrame();
+    /**
+     * \brief End a sequence of coalesced idle sub frames
+     *
+     * The frame and sub frame numbers are advanced as if the skipped sub
+     * frames had been processed, then the last of them is ended normally.
+     *
+     * \param nSkipped the number of sub frames that were skipped
+     */
+    void EndIdleSubFrames(uint32_t nSkipped);
+    /**
+     * \brief Check whether the upcoming sub frames can be skipped
+     *
+     * The cell is idle when no UE is attached, nothing is queued for
+     * transmission or reception, and no control message was received since
+     * the start of the current sub frame.
+     *
+     * \return true if the cell is idle
+     */
+    bool IsIdle() const;
+    /**
+     * \brief Notify some activity to the PHY
+     *
+     * If the PHY is skipping idle sub frames, the sub frame processing is
+     * resumed at the next sub frame boundary.
+     */
+    void WakeUp();
 
     /**
      * \brief PhySpectrum received a new PHY-PDU
@@ -317,6 +343,14 @@ class LteEnbPhy : public LtePhy
     typedef void (*ReportInterferenceTracedCallback)(uint16_t cellId,
                                                      Ptr<SpectrumValue> spectrumValue);
 
+    /**
+     * TracedCallback signature for the start of a sub frame.
+     *
+     * \param [in] frameNo The frame number, starting from 1.
+     * \param [in] subframeNo The subframe number, from 1 to 10.
+     */
+    typedef void (*SubframeStartTracedCallback)(uint32_t frameNo, uint32_t subframeNo);
+
   private:
     // LteEnbCphySapProvider forwarded methods
     /**
@@ -437,6 +471,9 @@ class LteEnbPhy : public LtePhy
 
     std::vector<int> m_dlDataRbMap; ///< DL data RB map
 
+    TxPsdCache m_dlCtrlTxPsdCache; ///< cached PSD of the DL control channels
+    TxPsdCache m_dlDataTxPsdCache; ///< cached PSD of the DL data channels
+
     /// For storing info on future receptions.
     std::vector<std::list<UlDciLteControlMessage>> m_ulDciQueue;
 
@@ -513,6 +550,22 @@ class LteEnbPhy : public LtePhy
      */
     TracedCallback<PhyTransmissionStatParameters> m_dlPhyTransmission;
 
+    /**
+     * The `SubframeStart` trace source. Fired when a sub frame is started,
+     * hence not for the idle sub frames which are skipped. Exporting the
+     * frame and subframe numbers.
+     */
+    TracedCallback<uint32_t, uint32_t> m_subframeStartTrace;
+
+    /**
+     * The `SkipIdleSubframes` attribute. If true, the sub frames of an idle
+     * cell are coalesced up to the next one carrying PSS, MIB or SIB1.
+     */
+    bool m_skipIdleSubframes;
+    bool m_activity;         ///< Whether some activity was notified during the current sub frame
+    Time m_idleSkipStart;    ///< Start time of the ongoing sequence of skipped sub frames
+    EventId m_idleSkipEvent; ///< End of the ongoing sequence of skipped sub frames
+
 }; // end of `class LteEnbPhy`
 
 } // namespace ns3
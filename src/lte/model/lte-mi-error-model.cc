@@ -34,9 +34,13 @@
 #include <ns3/lte-mi-error-model.h>
 #include <ns3/pointer.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <functional>
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -903,86 +907,244 @@ static const double cEcrTable [9][38] = {
 
 // clang-format on
 
-double
-LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// MI mapping curve of a modulation, sampled on a uniformly spaced SINR axis
+struct MiMapCurve
 {
-    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+    const double* axis; ///< SINR axis (linear)
+    const double* mi;   ///< MI values
+    uint16_t size;      ///< number of samples
+    double scalingCoeff; ///< (size - 1) / (axis[size - 1] - axis[0])
+};
 
-    double MI;
-    double MIsum = 0.0;
+/**
+ * \brief Build the MI mapping curve of a modulation
+ * \param axis the SINR axis
+ * \param mi the MI values
+ * \param size the number of samples
+ * \return the curve
+ */
+static MiMapCurve
+MakeMiMapCurve(const double* axis, const double* mi, uint16_t size)
+{
+    MiMapCurve curve;
+    curve.axis = axis;
+    curve.mi = mi;
+    curve.size = size;
+    // since the values in the axis are uniformly spaced, we have
+    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+    // the scaling coefficient is always the same, so we compute it only once
+    curve.scalingCoeff = (size - 1) / (axis[size - 1] - axis[0]);
+    return curve;
+}
 
-    for (uint32_t i = 0; i < map.size(); i++)
+/**
+ * \brief Get the MI mapping curve of the modulation used by an MCS
+ * \param mcs the MCS
+ * \return the curve
+ */
+static const MiMapCurve&
+GetMiMapCurve(uint8_t mcs)
+{
+    static const MiMapCurve qpsk = MakeMiMapCurve(MI_map_qpsk_axis, MI_map_qpsk, MI_MAP_QPSK_SIZE);
+    static const MiMapCurve qam16 =
+        MakeMiMapCurve(MI_map_16qam_axis, MI_map_16qam, MI_MAP_16QAM_SIZE);
+    static const MiMapCurve qam64 =
+        MakeMiMapCurve(MI_map_64qam_axis, MI_map_64qam, MI_MAP_64QAM_SIZE);
+    if (mcs <= MI_QPSK_MAX_ID)
+    {
+        return qpsk;
+    }
+    else if (mcs <= MI_16QAM_MAX_ID)
+    {
+        return qam16;
+    }
+    return qam64;
+}
+
+/**
+ * \brief Map a linear SINR value to its MI with a mapping curve
+ * \param curve the MI mapping curve
+ * \param sinrLin the linear SINR
+ * \return the MI
+ */
+static inline double
+MapSinrToMi(const MiMapCurve& curve, double sinrLin)
+{
+    if (sinrLin > curve.axis[curve.size - 1])
+    {
+        return 1;
+    }
+    double sinrIndexDouble = (sinrLin - curve.axis[0]) * curve.scalingCoeff + 1;
+    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
+    NS_ASSERT_MSG(sinrIndex < curve.size, "MI map out of data");
+    return curve.mi[sinrIndex];
+}
+
+/// Code block segmentation of a TB (see sec 5.1.2 of TS 36.212)
+struct CodeBlockSegmentation
+{
+    uint32_t B;      ///< TB size in bits
+    uint32_t B1;     ///< TB size in bits including the CB CRCs
+    uint32_t C;      ///< no. of codeblocks
+    uint32_t Cplus;  ///< no. of codeblocks with size K+
+    uint32_t Kplus;  ///< size K+ of the codeblocks
+    uint32_t Cminus; ///< no. of codeblocks with size K-
+    uint32_t Kminus; ///< size K- of the codeblocks
+};
+
+/**
+ * \brief Evaluate the code block segmentation of a TB
+ * \param size the size in bytes of the TB
+ * \return the segmentation
+ */
+static CodeBlockSegmentation
+ComputeCodeBlockSegmentation(uint16_t size)
+{
+    uint16_t Z = 6144; // max size of a codeblock (including CRC)
+    CodeBlockSegmentation seg;
+    seg.B = size * 8;
+    seg.C = 0;
+    seg.Cplus = 0;
+    seg.Kplus = 0;
+    seg.Cminus = 0;
+    seg.Kminus = 0;
+    seg.B1 = 0;
+    uint32_t deltaK = 0;
+    if (seg.B <= Z)
+    {
+        // only one codeblock
+        // L = 0;
+        seg.C = 1;
+        seg.B1 = seg.B;
+    }
+    else
+    {
+        uint32_t L = 24;
+        seg.C = ceil((double)seg.B / ((double)(Z - L)));
+        seg.B1 = seg.B + seg.C * L;
+    }
+    uint32_t B1 = seg.B1;
+    uint32_t C = seg.C;
+    // first segmentation: K+ = minimum K in table such that C * K >= B1
+    // implement a modified binary search
+    int min = 0;
+    int max = 187;
+    int mid = 0;
+    do
     {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
+        mid = (min + max) / 2;
+        if (B1 > cbSizeTable[mid] * C)
         {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
+            if (B1 < cbSizeTable[mid + 1] * C)
             {
-                MI = 1;
+                break;
             }
             else
             {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
+                min = mid + 1;
             }
         }
         else
         {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
+            if (B1 > cbSizeTable[mid - 1] * C)
             {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
+                break;
             }
-            else // 64-QAM
+            else
             {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
-                }
+                max = mid - 1;
             }
         }
-        NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
+    } while ((cbSizeTable[mid] * C != B1) && (min < max));
+    // adjust binary search to the largest integer value of K containing B1
+    if (B1 > cbSizeTable[mid] * C)
+    {
+        mid++;
+    }
+
+    uint16_t KplusId = mid;
+    seg.Kplus = cbSizeTable[mid];
+
+    if (C == 1)
+    {
+        seg.Cplus = 1;
+        seg.Cminus = 0;
+        seg.Kminus = 0;
+    }
+    else
+    {
+        // second segmentation size: K- = maximum K in table such that K < K+
+        // -fstrict-overflow sensitive, see bug 1868
+        seg.Kminus = cbSizeTable[KplusId > 1 ? KplusId - 1 : 0];
+        deltaK = seg.Kplus - seg.Kminus;
+        seg.Cminus = floor((((double)C * seg.Kplus) - (double)B1) / (double)deltaK);
+        seg.Cplus = C - seg.Cminus;
+    }
+    return seg;
+}
+
+/**
+ * \brief Get the code block segmentation of a TB, which is evaluated only
+ * once per TB size
+ * \param size the size in bytes of the TB
+ * \return the segmentation
+ */
+static const CodeBlockSegmentation&
+GetCodeBlockSegmentation(uint16_t size)
+{
+    static std::unordered_map<uint16_t, CodeBlockSegmentation> segmentations;
+    auto it = segmentations.find(size);
+    if (it == segmentations.end())
+    {
+        it = segmentations.emplace(size, ComputeCodeBlockSegmentation(size)).first;
+    }
+    return it->second;
+}
+
+/// Entry of the cache of the TB error rates
+struct TbBlerCacheEntry
+{
+    double mi;      ///< MI of the TB
+    uint16_t size;  ///< size in bytes of the TB
+    uint8_t ecrId;  ///< ECR id of the BLER curve
+    bool valid;     ///< whether the entry holds a value
+    double tbler;   ///< TB error rate
+};
+
+/// size of the (direct mapped) cache of the TB error rates
+static const std::size_t TB_BLER_CACHE_SIZE = 256;
+
+/**
+ * \brief Get the slot of the TB error rate cache for a (MI, size, ECR) tuple
+ * \param mi the MI of the TB
+ * \param size the size in bytes of the TB
+ * \param ecrId the ECR id of the BLER curve
+ * \return the cache slot
+ */
+static TbBlerCacheEntry&
+GetTbBlerCacheEntry(double mi, uint16_t size, uint8_t ecrId)
+{
+    static std::array<TbBlerCacheEntry, TB_BLER_CACHE_SIZE> cache{};
+    std::size_t h = std::hash<double>()(mi);
+    h ^= (static_cast<std::size_t>(size) << 8) + ecrId + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return cache[h % TB_BLER_CACHE_SIZE];
+}
+
+double
+LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+
+    // the modulation is the same for all the RBs of the TB
+    const MiMapCurve& curve = GetMiMapCurve(mcs);
+    double MI;
+    double MIsum = 0.0;
+
+    for (uint32_t i = 0; i < map.size(); i++)
+    {
+        double sinrLin = sinr[map[i]];
+        MI = MapSinrToMi(curve, sinrLin);
+        NS_LOG_LOGIC(" RB " << map[i] << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
                             << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
         MIsum += MI;
     }
@@ -1045,39 +1207,18 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     Values::const_iterator sinrIt = sinr.ConstValuesBegin();
     uint16_t rb = 0;
     NS_ASSERT(sinrIt != sinr.ConstValuesEnd());
+    const MiMapCurve& curve = GetMiMapCurve(0);
     while (sinrIt != sinr.ConstValuesEnd())
     {
-        double sinrLin = *sinrIt;
-        if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-        {
-            MI = 1;
-        }
-        else
-        {
-            // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-            // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-            // the scaling coefficient is always the same, so we use a static const
-            // to speed up the calculation
-            static const double scalingCoeffQpsk =
-                (MI_MAP_QPSK_SIZE - 1) /
-                (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-            double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-            uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-            NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-            MI = MI_map_qpsk[sinrIndex];
-        }
-        MIsum += MI;
+        MIsum += MapSinrToMi(curve, *sinrIt);
         sinrIt++;
         rb++;
     }
     MI = MIsum / rb;
-    // return to the effective SINR value
-    int j = 0;
+    // return to the effective SINR value (the MI map is monotonic, so the
+    // first value not lower than MI is found with a binary search)
+    int j = std::lower_bound(MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
     double esinr = 0.0;
-    while ((j < MI_MAP_QPSK_SIZE) && (MI_map_qpsk[j] < MI))
-    {
-        j++;
-    }
     if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE - 1])
     {
         esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1];
@@ -1106,12 +1247,11 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     double esirnDb = 10 * log10(esinr);
     //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk
     //   [MI_MAP_QPSK_SIZE-1]));
-    uint16_t i = 0;
+    uint16_t i = std::lower_bound(PdcchPcfichBlerCurveXaxis,
+                                  PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE,
+                                  esirnDb) -
+                 PdcchPcfichBlerCurveXaxis;
     double errorRate = 0.0;
-    while ((i < PDCCH_PCFICH_CURVE_SIZE) && (PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-        i++;
-    }
     if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE - 1])
     {
         errorRate = 0.0;
@@ -1162,96 +1302,11 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
     }
     NS_LOG_DEBUG(" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size());
     // estimate CB size (according to sec 5.1.2 of TS 36.212)
-    uint16_t Z = 6144; // max size of a codeblock (including CRC)
-    uint32_t B = size * 8;
-    //   B = 1234;
-    uint32_t C = 0;      // no. of codeblocks
-    uint32_t Cplus = 0;  // no. of codeblocks with size K+
-    uint32_t Kplus = 0;  // no. of codeblocks with size K+
-    uint32_t Cminus = 0; // no. of codeblocks with size K+
-    uint32_t Kminus = 0; // no. of codeblocks with size K+
-    uint32_t B1 = 0;
-    uint32_t deltaK = 0;
-    if (B <= Z)
-    {
-        // only one codeblock
-        // L = 0;
-        C = 1;
-        B1 = B;
-    }
-    else
-    {
-        uint32_t L = 24;
-        C = ceil((double)B / ((double)(Z - L)));
-        B1 = B + C * L;
-    }
-    // first segmentation: K+ = minimum K in table such that C * K >= B1
-    //   uint i = 0;
-    //   while (B1 > cbSizeTable[i] * C)
-    //     {
-    // //       NS_LOG_INFO (" K+ " << cbSizeTable[i] << " means " << cbSizeTable[i] * C);
-    //       i++;
-    //     }
-    //   uint16_t KplusId = i;
-    //   Kplus = cbSizeTable[i];
-
-    // implement a modified binary search
-    int min = 0;
-    int max = 187;
-    int mid = 0;
-    do
-    {
-        mid = (min + max) / 2;
-        if (B1 > cbSizeTable[mid] * C)
-        {
-            if (B1 < cbSizeTable[mid + 1] * C)
-            {
-                break;
-            }
-            else
-            {
-                min = mid + 1;
-            }
-        }
-        else
-        {
-            if (B1 > cbSizeTable[mid - 1] * C)
-            {
-                break;
-            }
-            else
-            {
-                max = mid - 1;
-            }
-        }
-    } while ((cbSizeTable[mid] * C != B1) && (min < max));
-    // adjust binary search to the largest integer value of K containing B1
-    if (B1 > cbSizeTable[mid] * C)
-    {
-        mid++;
-    }
-
-    uint16_t KplusId = mid;
-    Kplus = cbSizeTable[mid];
-
-    if (C == 1)
-    {
-        Cplus = 1;
-        Cminus = 0;
-        Kminus = 0;
-    }
-    else
-    {
-        // second segmentation size: K- = maximum K in table such that K < K+
-        // -fstrict-overflow sensitive, see bug 1868
-        Kminus = cbSizeTable[KplusId > 1 ? KplusId - 1 : 0];
-        deltaK = Kplus - Kminus;
-        Cminus = floor((((double)C * Kplus) - (double)B1) / (double)deltaK);
-        Cplus = C - Cminus;
-    }
+    const CodeBlockSegmentation& seg = GetCodeBlockSegmentation(size);
     NS_LOG_INFO("--------------------LteMiErrorModel: TB size of "
-                << B << " needs of " << B1 << " bits reparted in " << C << " CBs as " << Cplus
-                << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
+                << seg.B << " needs of " << seg.B1 << " bits reparted in " << seg.C
+                << " CBs as " << seg.Cplus << " block(s) of " << seg.Kplus << " and "
+                << seg.Cminus << " of " << seg.Kminus);
 
     double errorRate = 1.0;
     uint8_t ecrId = 0;
@@ -1298,20 +1353,37 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
         NS_LOG_DEBUG("HARQ ECR " << (uint16_t)ecrId);
     }
 
-    if (C != 1)
+    // the error rate only depends on (MI, TB size, ECR): reuse the last one
+    // evaluated for the same tuple, which is frequent with static channels
+    TbBlerCacheEntry& cached = GetTbBlerCacheEntry(MI, size, ecrId);
+    if (cached.valid && cached.mi == MI && cached.size == size && cached.ecrId == ecrId)
+    {
+        NS_LOG_LOGIC(" Error rate " << cached.tbler << " (cached)");
+        TbStats_t ret;
+        ret.tbler = cached.tbler;
+        ret.mi = tbMi;
+        return ret;
+    }
+
+    if (seg.C != 1)
     {
-        double cbler = MappingMiBler(MI, ecrId, Kplus);
-        errorRate *= pow(1.0 - cbler, Cplus);
-        cbler = MappingMiBler(MI, ecrId, Kminus);
-        errorRate *= pow(1.0 - cbler, Cminus);
+        double cbler = MappingMiBler(MI, ecrId, seg.Kplus);
+        errorRate *= pow(1.0 - cbler, seg.Cplus);
+        cbler = MappingMiBler(MI, ecrId, seg.Kminus);
+        errorRate *= pow(1.0 - cbler, seg.Cminus);
         errorRate = 1.0 - errorRate;
     }
     else
     {
-        errorRate = MappingMiBler(MI, ecrId, Kplus);
+        errorRate = MappingMiBler(MI, ecrId, seg.Kplus);
     }
 
     NS_LOG_LOGIC(" Error rate " << errorRate);
+    cached.mi = MI;
+    cached.size = size;
+    cached.ecrId = ecrId;
+    cached.valid = true;
+    cached.tbler = errorRate;
     TbStats_t ret;
     ret.tbler = errorRate;
     ret.mi = tbMi;
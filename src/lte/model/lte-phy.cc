@@ -28,6 +28,7 @@
 #include <ns3/simulator.h>
 #include <ns3/waveform-generator.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace ns3
@@ -190,17 +191,22 @@ LtePhy::SetMacPdu(Ptr<Packet> p)
 Ptr<PacketBurst>
 LtePhy::GetPacketBurst()
 {
+    // The queues are rotated rather than shifted: the slot of the current TTI is
+    // handed over (or recycled when empty) and moved at the back of the queue
     if (m_packetBurstQueue.at(0)->GetSize() > 0)
     {
-        Ptr<PacketBurst> ret = m_packetBurstQueue.at(0)->Copy();
-        m_packetBurstQueue.erase(m_packetBurstQueue.begin());
-        m_packetBurstQueue.push_back(CreateObject<PacketBurst>());
+        Ptr<PacketBurst> ret = m_packetBurstQueue.at(0);
+        m_packetBurstQueue.at(0) = CreateObject<PacketBurst>();
+        std::rotate(m_packetBurstQueue.begin(),
+                    m_packetBurstQueue.begin() + 1,
+                    m_packetBurstQueue.end());
         return (ret);
     }
     else
     {
-        m_packetBurstQueue.erase(m_packetBurstQueue.begin());
-        m_packetBurstQueue.push_back(CreateObject<PacketBurst>());
+        std::rotate(m_packetBurstQueue.begin(),
+                    m_packetBurstQueue.begin() + 1,
+                    m_packetBurstQueue.end());
         return (nullptr);
     }
 }
@@ -217,22 +223,12 @@ std::list<Ptr<LteControlMessage>>
 LtePhy::GetControlMessages()
 {
     NS_LOG_FUNCTION(this);
-    if (m_controlMessagesQueue.at(0).size() > 0)
-    {
-        std::list<Ptr<LteControlMessage>> ret = m_controlMessagesQueue.at(0);
-        m_controlMessagesQueue.erase(m_controlMessagesQueue.begin());
-        std::list<Ptr<LteControlMessage>> newlist;
-        m_controlMessagesQueue.push_back(newlist);
-        return (ret);
-    }
-    else
-    {
-        m_controlMessagesQueue.erase(m_controlMessagesQueue.begin());
-        std::list<Ptr<LteControlMessage>> newlist;
-        m_controlMessagesQueue.push_back(newlist);
-        std::list<Ptr<LteControlMessage>> emptylist;
-        return (emptylist);
-    }
+    std::list<Ptr<LteControlMessage>> ret;
+    ret.swap(m_controlMessagesQueue.at(0));
+    std::rotate(m_controlMessagesQueue.begin(),
+                m_controlMessagesQueue.begin() + 1,
+                m_controlMessagesQueue.end());
+    return ret;
 }
 
 void
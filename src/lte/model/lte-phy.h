@@ -276,6 +276,21 @@ class LtePhy : public Object
      */
     uint32_t m_ulEarfcn;
 
+    /**
+     * A tx PSD together with the parameters it was computed from. Since the
+     * allocation rarely changes from one subframe to the next, the PSD of the
+     * previous subframe is reused as long as these parameters are unchanged.
+     */
+    struct TxPsdCache
+    {
+        Ptr<SpectrumValue> psd;                ///< the cached PSD
+        double txPower;                        ///< tx power in dBm
+        uint32_t earfcn;                       ///< EARFCN
+        uint16_t bandwidth;                    ///< bandwidth in number of RBs
+        std::vector<int> rbMap;                ///< RBs used for transmission
+        std::map<int, double> powerAllocation; ///< tx power per RB (DL only)
+    };
+
     /// A queue of packet bursts to be sent.
     std::vector<Ptr<PacketBurst>> m_packetBurstQueue;
     /// A queue of control messages to be sent.
@@ -44,8 +44,10 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <numeric>
 
 namespace ns3
 {
@@ -183,6 +185,7 @@ void
 LteUePhy::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_txPsdCache.psd = nullptr;
     delete m_uePhySapProvider;
     delete m_ueCphySapProvider;
     LtePhy::DoDispose();
@@ -500,10 +503,23 @@ LteUePhy::SetSubChannelsForTransmission(std::vector<int> mask)
 {
     NS_LOG_FUNCTION(this);
 
-    m_subChannelsForTransmission = mask;
+    m_subChannelsForTransmission = std::move(mask);
 
-    Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity();
-    m_uplinkSpectrumPhy->SetTxPowerSpectralDensity(txPsd);
+    TxPsdCache& cache = m_txPsdCache;
+    if (!cache.psd || cache.txPower != m_txPower || cache.earfcn != m_ulEarfcn ||
+        cache.bandwidth != m_ulBandwidth || cache.rbMap != m_subChannelsForTransmission)
+    {
+        cache.psd = CreateTxPowerSpectralDensity();
+        cache.txPower = m_txPower;
+        cache.earfcn = m_ulEarfcn;
+        cache.bandwidth = m_ulBandwidth;
+        cache.rbMap = m_subChannelsForTransmission;
+    }
+    else
+    {
+        m_reportPowerSpectralDensity(m_rnti, cache.psd);
+    }
+    m_uplinkSpectrumPhy->SetTxPowerSpectralDensity(cache.psd);
 }
 
 void
@@ -1264,14 +1280,13 @@ LteUePhy::SubframeIndication(uint32_t frameNo, uint32_t subframeNo)
     if (m_ulConfigured)
     {
         // update uplink transmission mask according to previous UL-CQIs
-        std::vector<int> rbMask = m_subChannelsForTransmissionQueue.at(0);
-        SetSubChannelsForTransmission(m_subChannelsForTransmissionQueue.at(0));
+        std::vector<int> rbMask = std::move(m_subChannelsForTransmissionQueue.at(0));
+        SetSubChannelsForTransmission(rbMask);
 
         // shift the queue
-        for (uint8_t i = 1; i < m_macChTtiDelay; i++)
-        {
-            m_subChannelsForTransmissionQueue.at(i - 1) = m_subChannelsForTransmissionQueue.at(i);
-        }
+        std::rotate(m_subChannelsForTransmissionQueue.begin(),
+                    m_subChannelsForTransmissionQueue.begin() + 1,
+                    m_subChannelsForTransmissionQueue.begin() + m_macChTtiDelay);
         m_subChannelsForTransmissionQueue.at(m_macChTtiDelay - 1).clear();
 
         if (m_srsConfigured && (m_srsStartTime <= Simulator::Now()))
@@ -1351,11 +1366,8 @@ LteUePhy::SendSrs()
     NS_LOG_FUNCTION(this << " UE " << m_rnti << " start tx SRS, cell Id " << (uint32_t)m_cellId);
     NS_ASSERT(m_cellId > 0);
     // set the current tx power spectral density (full bandwidth)
-    std::vector<int> dlRb;
-    for (uint16_t i = 0; i < m_ulBandwidth; i++)
-    {
-        dlRb.push_back(i);
-    }
+    std::vector<int> dlRb(m_ulBandwidth);
+    std::iota(dlRb.begin(), dlRb.end(), 0);
 
     if (m_enableUplinkPowerControl)
     {
@@ -656,6 +656,8 @@ class LteUePhy : public LtePhy
 
     /// A list of sub channels to use in TX.
     std::vector<int> m_subChannelsForTransmission;
+    /// Cached PSD for the sub channels used in TX.
+    TxPsdCache m_txPsdCache;
     /// A list of sub channels to use in RX.
     std::vector<int> m_subChannelsForReception;
 
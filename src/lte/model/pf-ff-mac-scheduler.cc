@@ -945,102 +945,78 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
+    // collect the UEs eligible for the free RBGs, which do not depend on the RBG
+    std::vector<DlRbgCandidate> candidates;
+    candidates.reserve(m_flowStatsDl.size());
+    for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+    {
+        std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it).first);
+        if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
+        {
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            if (itRnti != rntiAllocated.end())
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
+            }
+            if (!HarqProcessAvailability((*it).first))
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
+            }
+            continue;
+        }
+        if (LcActivePerFlow((*it).first) == 0)
+        {
+            // this UE has no data to transmit
+            continue;
+        }
+        std::map<uint16_t, uint8_t>::iterator itTxMode;
+        itTxMode = m_uesTxMode.find((*it).first);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+        }
+        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
+        itCqi = m_a30CqiRxed.find((*it).first);
+        DlRbgCandidate candidate;
+        candidate.rnti = (*it).first;
+        candidate.nLayers = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        candidate.sbMeas = (itCqi == m_a30CqiRxed.end()) ? nullptr : &(*itCqi).second;
+        candidate.averagedThroughput = (*it).second.lastAveragedThroughput;
+        candidates.push_back(candidate);
+    }
+    DlRbgRatePerCqi rbgRatePerCqi = ComputeDlRbgRatePerCqi(m_amc, rbgSize);
+
     for (int i = 0; i < rbgNum; i++)
     {
         NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
         if (rbgMap.at(i) == false)
         {
-            std::map<uint16_t, pfsFlowPerf_t>::iterator it;
-            std::map<uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end();
+            const DlRbgCandidate* itMax = nullptr;
             double rcqiMax = 0.0;
-            for (it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            for (const auto& candidate : candidates)
             {
-                if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first)) == false)
+                if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, candidate.rnti)) == false)
                 {
                     continue;
                 }
 
-                std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it).first);
-                if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
+                double achievableRate = GetDlRbgAchievableRate(rbgRatePerCqi, candidate, i);
+                if (achievableRate > 0)
                 {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                    if (!HarqProcessAvailability((*it).first))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                    continue;
-                }
-                std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                itCqi = m_a30CqiRxed.find((*it).first);
-                std::map<uint16_t, uint8_t>::iterator itTxMode;
-                itTxMode = m_uesTxMode.find((*it).first);
-                if (itTxMode == m_uesTxMode.end())
-                {
-                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                        sbCqi.push_back(1); // start with lowest value
-                    }
-                }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
-                uint8_t cqi1 = sbCqi.at(0);
-                uint8_t cqi2 = 0;
-                if (sbCqi.size() > 1)
-                {
-                    cqi2 = sbCqi.at(1);
-                }
+                    double rcqi = achievableRate / candidate.averagedThroughput;
+                    NS_LOG_INFO(this << " RNTI " << candidate.rnti << " achievableRate "
+                                     << achievableRate << " avgThr "
+                                     << candidate.averagedThroughput << " RCQI " << rcqi);
 
-                if ((cqi1 > 0) ||
-                    (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                    if (LcActivePerFlow((*it).first) > 0)
+                    if (rcqi > rcqiMax)
                     {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        uint8_t mcs = 0;
-                        for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                            if (sbCqi.size() > k)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
-                        }
-
-                        double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                        NS_LOG_INFO(this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs
-                                         << " achievableRate " << achievableRate << " avgThr "
-                                         << (*it).second.lastAveragedThroughput << " RCQI "
-                                         << rcqi);
-
-                        if (rcqi > rcqiMax)
-                        {
-                            rcqiMax = rcqi;
-                            itMax = it;
-                        }
+                        rcqiMax = rcqi;
+                        itMax = &candidate;
                     }
-                } // end if cqi
-            }     // end for m_rlcBufferReq
+                }
+            } // end for candidates
 
-            if (itMax == m_flowStatsDl.end())
+            if (itMax == nullptr)
             {
                 // no UE available for this RB
                 NS_LOG_INFO(this << " any UE found");
@@ -1048,21 +1024,8 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
             else
             {
                 rbgMap.at(i) = true;
-                std::map<uint16_t, std::vector<uint16_t>>::iterator itMap;
-                itMap = allocationMap.find((*itMax).first);
-                if (itMap == allocationMap.end())
-                {
-                    // insert new element
-                    std::vector<uint16_t> tempMap;
-                    tempMap.push_back(i);
-                    allocationMap.insert(
-                        std::pair<uint16_t, std::vector<uint16_t>>((*itMax).first, tempMap));
-                }
-                else
-                {
-                    (*itMap).second.push_back(i);
-                }
-                NS_LOG_INFO(this << " UE assigned " << (*itMax).first);
+                allocationMap[itMax->rnti].push_back(i);
+                NS_LOG_INFO(this << " UE assigned " << itMax->rnti);
             }
         } // end for RBG free
     }     // end for RBGs
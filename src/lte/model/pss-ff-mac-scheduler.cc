@@ -1148,66 +1148,78 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
 
             } // end of m_flowStatsDl
 
+            // collect the UEs selected by the TD scheduler with what does not depend on the RBG
+            std::vector<DlRbgCandidate> candidates;
+            std::vector<double> weights; // PF weight of each candidate
+            candidates.reserve(tdUeSet.size());
+            weights.reserve(tdUeSet.size());
+            for (it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+            {
+                std::map<uint16_t, uint8_t>::iterator itTxMode;
+                itTxMode = m_uesTxMode.find((*it).first);
+                if (itTxMode == m_uesTxMode.end())
+                {
+                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+                }
+                std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
+                itCqi = m_a30CqiRxed.find((*it).first);
+                DlRbgCandidate candidate;
+                candidate.rnti = (*it).first;
+                candidate.nLayers = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+                candidate.sbMeas = (itCqi == m_a30CqiRxed.end()) ? nullptr : &(*itCqi).second;
+                candidate.averagedThroughput = (*it).second.secondLastAveragedThroughput;
+                candidates.push_back(candidate);
+
+                // calculate PF weight
+                double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
+                if (weight < 1.0)
+                {
+                    weight = 1.0;
+                }
+                weights.push_back(weight);
+            }
+
             if (m_fdSchedulerType == "CoItA")
             {
                 // FD scheduler: Carrier over Interference to Average (CoItA)
-                std::map<uint16_t, uint8_t> sbCqiSum;
-                for (it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+
+                // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                auto isCqiInRange = [](const DlRbgCandidate& ue, int rbgId) {
+                    if (ue.sbMeas == nullptr)
+                    {
+                        return true; // start with lowest value
+                    }
+                    const std::vector<uint8_t>& sbCqis =
+                        ue.sbMeas->m_higherLayerSelected.at(rbgId).m_sbCqi;
+                    return (sbCqis.at(0) > 0) || (sbCqis.size() > 1 && sbCqis.at(1) > 0);
+                };
+                auto getSbCqi = [](const DlRbgCandidate& ue, int rbgId, uint8_t layer) -> uint8_t {
+                    if (ue.sbMeas == nullptr)
+                    {
+                        return 1; // start with lowest value
+                    }
+                    const std::vector<uint8_t>& sbCqis =
+                        ue.sbMeas->m_higherLayerSelected.at(rbgId).m_sbCqi;
+                    // no info on this subband -> 0
+                    return (sbCqis.size() > layer) ? sbCqis.at(layer) : 0;
+                };
+
+                std::vector<uint8_t> sbCqiSum;
+                sbCqiSum.reserve(candidates.size());
+                for (const auto& candidate : candidates)
                 {
                     uint8_t sum = 0;
                     for (int i = 0; i < rbgNum; i++)
                     {
-                        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                        itCqi = m_a30CqiRxed.find((*it).first);
-                        std::map<uint16_t, uint8_t>::iterator itTxMode;
-                        itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
+                        if (isCqiInRange(candidate, i))
                         {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            for (uint8_t k = 0; k < nLayer; k++)
+                            for (uint8_t k = 0; k < candidate.nLayers; k++)
                             {
-                                sbCqis.push_back(1); // start with lowest value
+                                sum += getSbCqi(candidate, i, k);
                             }
                         }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
-                        uint8_t cqi1 = sbCqis.at(0);
-                        uint8_t cqi2 = 0;
-                        if (sbCqis.size() > 1)
-                        {
-                            cqi2 = sbCqis.at(1);
-                        }
-
-                        uint8_t sbCqi = 0;
-                        if ((cqi1 > 0) ||
-                            (cqi2 >
-                             0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                        {
-                            for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                                if (sbCqis.size() > k)
-                                {
-                                    sbCqi = sbCqis.at(k);
-                                }
-                                else
-                                {
-                                    // no info on this subband
-                                    sbCqi = 0;
-                                }
-                                sum += sbCqi;
-                            }
-                        } // end if cqi
-                    }     // end of rbgNum
-
-                    sbCqiSum.insert(std::pair<uint16_t, uint8_t>((*it).first, sum));
+                    } // end of rbgNum
+                    sbCqiSum.push_back(sum);
                 } // end tdUeSet
 
                 for (int i = 0; i < rbgNum; i++)
@@ -1217,80 +1229,30 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         continue;
                     }
 
-                    std::map<uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end();
+                    const DlRbgCandidate* itMax = nullptr;
                     double metricMax = 0.0;
-                    for (it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                    for (std::size_t j = 0; j < candidates.size(); j++)
                     {
-                        if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first)) == false)
+                        const DlRbgCandidate& candidate = candidates[j];
+                        if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, candidate.rnti)) == false)
                         {
                             continue;
                         }
 
-                        // calculate PF weight
-                        double weight =
-                            (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                        if (weight < 1.0)
-                        {
-                            weight = 1.0;
-                        }
-
-                        std::map<uint16_t, uint8_t>::iterator itSbCqiSum;
-                        itSbCqiSum = sbCqiSum.find((*it).first);
-
-                        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                        itCqi = m_a30CqiRxed.find((*it).first);
-                        std::map<uint16_t, uint8_t>::iterator itTxMode;
-                        itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
-                        {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                                sbCqis.push_back(1); // start with lowest value
-                            }
-                        }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
-                        uint8_t cqi1 = sbCqis.at(0);
-                        uint8_t cqi2 = 0;
-                        if (sbCqis.size() > 1)
-                        {
-                            cqi2 = sbCqis.at(1);
-                        }
-
-                        uint8_t sbCqi = 0;
                         double colMetric = 0.0;
-                        if ((cqi1 > 0) ||
-                            (cqi2 >
-                             0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                        if (isCqiInRange(candidate, i))
                         {
-                            for (uint8_t k = 0; k < nLayer; k++)
+                            for (uint8_t k = 0; k < candidate.nLayers; k++)
                             {
-                                if (sbCqis.size() > k)
-                                {
-                                    sbCqi = sbCqis.at(k);
-                                }
-                                else
-                                {
-                                    // no info on this subband
-                                    sbCqi = 0;
-                                }
-                                colMetric += (double)sbCqi / (double)(*itSbCqiSum).second;
+                                colMetric +=
+                                    (double)getSbCqi(candidate, i, k) / (double)sbCqiSum[j];
                             }
                         } // end if cqi
 
                         double metric = 0.0;
                         if (colMetric != 0)
                         {
-                            metric = weight * colMetric;
+                            metric = weights[j] * colMetric;
                         }
                         else
                         {
@@ -1300,17 +1262,17 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         if (metric > metricMax)
                         {
                             metricMax = metric;
-                            itMax = it;
+                            itMax = &candidate;
                         }
                     } // end of tdUeSet
 
-                    if (itMax == tdUeSet.end())
+                    if (itMax == nullptr)
                     {
                         // no UE available for downlink
                     }
                     else
                     {
-                        allocationMap[(*itMax).first].push_back(i);
+                        allocationMap[itMax->rnti].push_back(i);
                         rbgMap.at(i) = true;
                     }
                 } // end of rbgNum
@@ -1320,6 +1282,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
             if (m_fdSchedulerType == "PFsch")
             {
                 // FD scheduler: Proportional Fair scheduled (PFsch)
+                DlRbgRatePerCqi rbgRatePerCqi = ComputeDlRbgRatePerCqi(m_amc, rbgSize);
                 for (int i = 0; i < rbgNum; i++)
                 {
                     if (rbgMap.at(i) == true)
@@ -1327,92 +1290,40 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         continue;
                     }
 
-                    std::map<uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end();
+                    const DlRbgCandidate* itMax = nullptr;
                     double metricMax = 0.0;
-                    for (it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                    for (std::size_t j = 0; j < candidates.size(); j++)
                     {
-                        if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first)) == false)
+                        const DlRbgCandidate& candidate = candidates[j];
+                        if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, candidate.rnti)) == false)
                         {
                             continue;
                         }
-                        // calculate PF weight
-                        double weight =
-                            (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                        if (weight < 1.0)
-                        {
-                            weight = 1.0;
-                        }
-
-                        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                        itCqi = m_a30CqiRxed.find((*it).first);
-                        std::map<uint16_t, uint8_t>::iterator itTxMode;
-                        itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
-                        {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                                sbCqis.push_back(1); // start with lowest value
-                            }
-                        }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
-                        uint8_t cqi1 = sbCqis.at(0);
-                        uint8_t cqi2 = 0;
-                        if (sbCqis.size() > 1)
-                        {
-                            cqi2 = sbCqis.at(1);
-                        }
 
                         double schMetric = 0.0;
-                        if ((cqi1 > 0) ||
-                            (cqi2 >
-                             0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                        double achievableRate = GetDlRbgAchievableRate(rbgRatePerCqi, candidate, i);
+                        if (achievableRate > 0)
                         {
-                            double achievableRate = 0.0;
-                            for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                                uint8_t mcs = 0;
-                                if (sbCqis.size() > k)
-                                {
-                                    mcs = m_amc->GetMcsFromCqi(sbCqis.at(k));
-                                }
-                                else
-                                {
-                                    // no info on this subband  -> worst MCS
-                                    mcs = 0;
-                                }
-                                achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                                   0.001); // = TB size / TTI
-                            }
-                            schMetric = achievableRate / (*it).second.secondLastAveragedThroughput;
-                        } // end if cqi
+                            schMetric = achievableRate / candidate.averagedThroughput;
+                        }
 
                         double metric = 0.0;
-                        metric = weight * schMetric;
+                        metric = weights[j] * schMetric;
 
                         if (metric > metricMax)
                         {
                             metricMax = metric;
-                            itMax = it;
+                            itMax = &candidate;
                         }
                     } // end of tdUeSet
 
-                    if (itMax == tdUeSet.end())
+                    if (itMax == nullptr)
                     {
                         // no UE available for downlink
                     }
                     else
                     {
-                        allocationMap[(*itMax).first].push_back(i);
+                        allocationMap[itMax->rnti].push_back(i);
                         rbgMap.at(i) = true;
                     }
 
@@ -131,6 +131,12 @@ class LteRrcConnectionEstablishmentTestCase : public TestCase
                                    uint16_t cellId,
                                    uint16_t rnti,
                                    uint8_t connEstFailCount);
+    /**
+     * Sub frame start callback function
+     * \param frameNo the frame number
+     * \param subframeNo the subframe number
+     */
+    void SubframeStartCallback(uint32_t frameNo, uint32_t subframeNo);
 
     uint32_t m_nBearers;       ///< number of bearers to be setup in each connection
     uint32_t m_tConnBase;      ///< connection time base value for all UEs in ms
@@ -142,10 +148,13 @@ class LteRrcConnectionEstablishmentTestCase : public TestCase
     uint32_t m_delayDiscEnd; ///< expected duration to complete disconnection in ms
     bool m_useIdealRrc;      ///< If set to false, real RRC protocol model will be used
     bool m_admitRrcConnectionRequest; ///< If set to false, eNb will not allow UE connections
+    bool m_skipIdleSubframes;         ///< If set to true, eNBs skip their idle sub frames
     Ptr<LteHelper> m_lteHelper;       ///< LTE helper
 
     /// key: IMSI
     std::map<uint64_t, bool> m_isConnectionEstablished;
+    /// key: start time, value: frame and subframe numbers of the sub frames started by the eNB
+    std::map<Time, std::pair<uint32_t, uint32_t>> m_subframes;
 };
 
 std::string
@@ -214,7 +223,8 @@ LteRrcConnectionEstablishmentTestCase::LteRrcConnectionEstablishmentTestCase(
       m_delayDiscStart(delayDiscStart),
       m_delayDiscEnd(10),
       m_useIdealRrc(useIdealRrc),
-      m_admitRrcConnectionRequest(admitRrcConnectionRequest)
+      m_admitRrcConnectionRequest(admitRrcConnectionRequest),
+      m_skipIdleSubframes(false)
 {
     NS_LOG_FUNCTION(this << GetName());
 
@@ -292,6 +302,7 @@ LteRrcConnectionEstablishmentTestCase::DoRun()
     {
         Config::SetDefault("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue(320));
     }
+    Config::SetDefault("ns3::LteEnbPhy::SkipIdleSubframes", BooleanValue(m_skipIdleSubframes));
 
     // normal code
     m_lteHelper = CreateObject<LteHelper>();
@@ -374,6 +385,10 @@ LteRrcConnectionEstablishmentTestCase::DoRun()
     Config::Connect(
         "/NodeList/*/DeviceList/*/LteUeRrc/ConnectionTimeout",
         MakeCallback(&LteRrcConnectionEstablishmentTestCase::ConnectionTimeoutCallback, this));
+    m_subframes.clear();
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/SubframeStart",
+        MakeCallback(&LteRrcConnectionEstablishmentTestCase::SubframeStartCallback, this));
 
     Simulator::Stop(MilliSeconds(tmax + 1));
 
@@ -582,6 +597,92 @@ LteRrcConnectionEstablishmentTestCase::ConnectionTimeoutCallback(std::string con
     NS_LOG_FUNCTION(this << imsi << cellId);
 }
 
+void
+LteRrcConnectionEstablishmentTestCase::SubframeStartCallback(uint32_t frameNo, uint32_t subframeNo)
+{
+    NS_LOG_FUNCTION(this << frameNo << subframeNo);
+    m_subframes[Simulator::Now()] = std::make_pair(frameNo, subframeNo);
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Lte Rrc Connection Establishment Test Case with the eNB skipping
+ * its idle sub frames (see the LteEnbPhy `SkipIdleSubframes` attribute).
+ * The cell is idle until the first UE connects and after the last UE
+ * disconnects, so connection establishment checks that the cell wakes up
+ * upon RACH.  The test is run first with the idle sub frames not skipped,
+ * to check that some sub frames are skipped afterwards and that every sub
+ * frame started has the same frame and subframe numbers in both runs.
+ */
+class LteRrcConnectionEstablishmentIdleSkipTestCase : public LteRrcConnectionEstablishmentTestCase
+{
+  public:
+    /**
+     *
+     *
+     * \param nUes number of UEs in the test
+     * \param tConnBase connection time base value for all UEs in ms
+     * \param tConnIncrPerUe additional connection time increment for each UE index (0...nUes-1) in
+     * ms
+     * \param useIdealRrc If set to false, real RRC protocol model will be used
+     */
+    LteRrcConnectionEstablishmentIdleSkipTestCase(uint32_t nUes,
+                                                  uint32_t tConnBase,
+                                                  uint32_t tConnIncrPerUe,
+                                                  bool useIdealRrc);
+
+  protected:
+    void DoRun() override;
+};
+
+LteRrcConnectionEstablishmentIdleSkipTestCase::LteRrcConnectionEstablishmentIdleSkipTestCase(
+    uint32_t nUes,
+    uint32_t tConnBase,
+    uint32_t tConnIncrPerUe,
+    bool useIdealRrc)
+    : LteRrcConnectionEstablishmentTestCase(nUes,
+                                            1,
+                                            tConnBase,
+                                            tConnIncrPerUe,
+                                            1,
+                                            false,
+                                            useIdealRrc,
+                                            true,
+                                            "idle sub frames skipped")
+{
+    NS_LOG_FUNCTION(this << GetName());
+    m_skipIdleSubframes = true;
+}
+
+void
+LteRrcConnectionEstablishmentIdleSkipTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    m_skipIdleSubframes = false;
+    LteRrcConnectionEstablishmentTestCase::DoRun();
+    std::map<Time, std::pair<uint32_t, uint32_t>> subframes = m_subframes;
+
+    m_skipIdleSubframes = true;
+    LteRrcConnectionEstablishmentTestCase::DoRun();
+    NS_TEST_ASSERT_MSG_LT(m_subframes.size(), subframes.size(), "No idle sub frame was skipped");
+    for (const auto& subframe : m_subframes)
+    {
+        auto it = subframes.find(subframe.first);
+        NS_TEST_ASSERT_MSG_EQ((it != subframes.end()),
+                              true,
+                              "Sub frame started at " << subframe.first.As(Time::MS)
+                                                      << " only when skipping idle sub frames");
+        NS_TEST_ASSERT_MSG_EQ(subframe.second.first,
+                              it->second.first,
+                              "Wrong frame number at " << subframe.first.As(Time::MS));
+        NS_TEST_ASSERT_MSG_EQ(subframe.second.second,
+                              it->second.second,
+                              "Wrong subframe number at " << subframe.first.As(Time::MS));
+    }
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -878,6 +979,16 @@ LteRrcTestSuite::LteRrcTestSuite()
             TestCase::EXTENSIVE);
     }
 
+    // Test cases with idle sub frames skipped at the eNB
+    //                                                          nUes    tConnIncrPerUe
+    //                                                             tConnBase    useIdealRrc
+    AddTestCase(new LteRrcConnectionEstablishmentIdleSkipTestCase(1, 100, 0, false),
+                TestCase::QUICK);
+    AddTestCase(new LteRrcConnectionEstablishmentIdleSkipTestCase(2, 20, 300, false),
+                TestCase::EXTENSIVE);
+    AddTestCase(new LteRrcConnectionEstablishmentIdleSkipTestCase(2, 20, 300, true),
+                TestCase::EXTENSIVE);
+
     // Test cases with transmission error
     AddTestCase(new LteRrcConnectionEstablishmentErrorTestCase(Seconds(0.020214),
                                                                "failure at RRC Connection Request"),
@@ -21,6 +21,8 @@
 #include "ns3/names.h"
 #include "ns3/node-list.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -80,9 +82,21 @@ NodeContainer::Get(uint32_t i) const
     return m_nodes[i];
 }
 
+void
+NodeContainer::Reserve(uint32_t n)
+{
+    // Do not defeat the geometric growth of the vector when called repeatedly
+    if (m_nodes.size() + n > m_nodes.capacity())
+    {
+        m_nodes.reserve(std::max<std::size_t>(m_nodes.size() + n, 2 * m_nodes.capacity()));
+    }
+    NodeList::Reserve(n);
+}
+
 void
 NodeContainer::Create(uint32_t n)
 {
+    Reserve(n);
     for (uint32_t i = 0; i < n; i++)
     {
         m_nodes.push_back(CreateObject<Node>());
@@ -92,6 +106,7 @@ NodeContainer::Create(uint32_t n)
 void
 NodeContainer::Create(uint32_t n, uint32_t systemId)
 {
+    Reserve(n);
     for (uint32_t i = 0; i < n; i++)
     {
         m_nodes.push_back(CreateObject<Node>(systemId));
@@ -270,6 +270,14 @@ class NodeContainer
     bool Contains(uint32_t id) const;
 
   private:
+    /**
+     * \brief Reserve the storage for n Nodes about to be created, in this
+     * container and in the NodeList
+     *
+     * \param n The number of Nodes about to be created
+     */
+    void Reserve(uint32_t n);
+
     std::vector<Ptr<Node>> m_nodes; //!< Nodes smart pointers
 };
 
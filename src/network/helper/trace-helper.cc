@@ -19,6 +19,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
@@ -210,6 +211,13 @@ AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode file
     return StreamWrapper;
 }
 
+Ptr<OutputStreamWrapper>
+AsciiTraceHelper::CreateBinaryFileStream(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+    return Create<OutputStreamWrapper>(Create<BinaryTraceWriter>(filename));
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice(std::string prefix,
                                         Ptr<NetDevice> device,
@@ -314,6 +322,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('+', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -323,6 +336,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('+', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -344,6 +362,11 @@ AsciiTraceHelper::DefaultDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -353,6 +376,11 @@ AsciiTraceHelper::DefaultDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                              Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('d', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -375,6 +403,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('-', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -384,6 +417,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('-', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -403,6 +441,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -412,6 +455,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -33,6 +33,11 @@ namespace ns3
  *
  * Handling pcap files is a common operation for ns-3 devices.  It is useful to
  * provide a common base class for dealing with these ops.
+ *
+ * When many devices are traced, the ns3::PcapFileWrapper::WriteBufferSize
+ * attribute can be set to a non-zero value (e.g., 1 MB) to have the packets
+ * written to the files by a background thread, in large buffers, and without
+ * keeping a file descriptor open per file.
  */
 
 class PcapHelper
@@ -237,6 +242,25 @@ class AsciiTraceHelper
     Ptr<OutputStreamWrapper> CreateFileStream(std::string filename,
                                               std::ios::openmode filemode = std::ios::out);
 
+    /**
+     * @brief Create an output stream object which records the events of the
+     * default trace sinks in a binary trace file.
+     *
+     * The returned stream can be given to the EnableAscii methods of the
+     * device and protocol helpers, e.g., EnableAsciiAll or
+     * InternetStackHelper::EnableAsciiIpv4All.  Their trace sinks then record
+     * their events in a compact binary format (see BinaryTraceWriter) instead
+     * of formatting them, which can be read back with BinaryTraceReader or the
+     * read-binary-trace program.  The packets are summarized by their size, uid
+     * and the names of their headers.  The stream has no std::ostream, so it
+     * cannot be used to print routing tables or caches, nor by the trace sinks
+     * which write to OutputStreamWrapper::GetStream: GetStream aborts.
+     *
+     * @param filename file name
+     * @returns a smart pointer to the output stream
+     */
+    Ptr<OutputStreamWrapper> CreateBinaryFileStream(std::string filename);
+
     /**
      * @brief Hook a trace source to the default enqueue operation trace sink that
      * does not accept nor log a trace context.
@@ -25,6 +25,8 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -55,6 +57,13 @@ class ChannelListPriv : public Object
      */
     uint32_t Add(Ptr<Channel> channel);
 
+    /**
+     * \param n number of channels about to be added.
+     *
+     * Reserve the storage for n more channels.
+     */
+    void Reserve(uint32_t n);
+
     /**
      * \returns a C++ iterator located at the beginning of this
      *          list.
@@ -181,6 +190,17 @@ ChannelListPriv::Add(Ptr<Channel> channel)
     return index;
 }
 
+void
+ChannelListPriv::Reserve(uint32_t n)
+{
+    NS_LOG_FUNCTION(this << n);
+    // Do not defeat the geometric growth of the vector when called repeatedly
+    if (m_channels.size() + n > m_channels.capacity())
+    {
+        m_channels.reserve(std::max<std::size_t>(m_channels.size() + n, 2 * m_channels.capacity()));
+    }
+}
+
 ChannelList::Iterator
 ChannelListPriv::Begin() const
 {
@@ -219,6 +239,13 @@ ChannelList::Add(Ptr<Channel> channel)
     return ChannelListPriv::Get()->Add(channel);
 }
 
+void
+ChannelList::Reserve(uint32_t n)
+{
+    NS_LOG_FUNCTION(n);
+    ChannelListPriv::Get()->Reserve(n);
+}
+
 ChannelList::Iterator
 ChannelList::Begin()
 {
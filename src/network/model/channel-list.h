@@ -49,6 +49,13 @@ class ChannelList
      * the user has little reason to call it himself.
      */
     static uint32_t Add(Ptr<Channel> channel);
+    /**
+     * \param n number of channels about to be added.
+     *
+     * Reserve the storage for n more channels, e.g., before creating
+     * a large topology, so that the list does not grow step by step.
+     */
+    static void Reserve(uint32_t n);
     /**
      * \returns a C++ iterator located at the beginning of this
      *          list.
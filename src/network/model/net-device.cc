@@ -20,6 +20,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/net-device-queue-interface.h"
 
 namespace ns3
 {
@@ -40,4 +41,49 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+uint32_t
+NetDevice::SendBatch(const std::vector<BatchItem>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    Ptr<NetDeviceQueue> txq;
+    Ptr<NetDeviceQueueInterface> ndqi = GetObject<NetDeviceQueueInterface>();
+    if (ndqi)
+    {
+        txq = ndqi->GetTxQueue(0);
+    }
+
+    bool checked = CheckSendBatch();
+    uint32_t nSent = 0;
+    for (const auto& item : items)
+    {
+        if (txq && txq->IsStopped())
+        {
+            break;
+        }
+        if (checked)
+        {
+            DoSendBatchItem(item);
+        }
+        else
+        {
+            Send(item.packet, item.dest, item.protocolNumber);
+        }
+        nSent++;
+    }
+    return nSent;
+}
+
+bool
+NetDevice::CheckSendBatch()
+{
+    return false;
+}
+
+void
+NetDevice::DoSendBatchItem(const BatchItem& item)
+{
+    Send(item.packet, item.dest, item.protocolNumber);
+}
+
 } // namespace ns3
@@ -30,6 +30,7 @@
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -264,6 +265,31 @@ class NetDevice : public Object
                           const Address& source,
                           const Address& dest,
                           uint16_t protocolNumber) = 0;
+
+    /**
+     * \brief A packet to be sent by SendBatch, with its destination and protocol
+     */
+    struct BatchItem
+    {
+        Ptr<Packet> packet;      //!< the packet
+        Address dest;            //!< mac address of the destination (already resolved)
+        uint16_t protocolNumber; //!< the type of payload contained in the packet
+    };
+
+    /**
+     * \param items the packets sent from above down to Network Device, in order
+     *
+     * Called from higher layer (e.g., a queue disc dequeuing packets in bulk)
+     * to send several packets into Network Device. The packets are sent as if
+     * Send were called for each of them, except that the device stops accepting
+     * them as soon as its (first) transmission queue is stopped by flow control.
+     * The checks that Send does for each packet are done once for the batch
+     * by CheckSendBatch, if the device implements it; otherwise Send is called
+     * for each packet.
+     *
+     * \return the number of packets taken by the device (sent or dropped)
+     */
+    virtual uint32_t SendBatch(const std::vector<BatchItem>& items);
     /**
      * \returns the node base class which contains this network
      *          interface.
@@ -367,6 +393,28 @@ class NetDevice : public Object
      * \return true if this interface supports a bridging mode, false otherwise.
      */
     virtual bool SupportsSendFrom() const = 0;
+
+  protected:
+    /**
+     * \brief Check once, for all the packets of a batch, what Send checks for
+     * each packet.
+     *
+     * If this returns true, SendBatch sends the packets with DoSendBatchItem,
+     * otherwise it calls Send for each of them, so that the packets are
+     * dropped or refused as usual.  The default implementation returns false.
+     *
+     * \return true if the packets of the batch can be sent with DoSendBatchItem
+     */
+    virtual bool CheckSendBatch();
+
+    /**
+     * \brief Send a packet of a batch, once CheckSendBatch has returned true.
+     *
+     * The default implementation calls Send.
+     *
+     * \param item the packet, with its destination and protocol number
+     */
+    virtual void DoSendBatchItem(const BatchItem& item);
 };
 
 } // namespace ns3
@@ -28,6 +28,8 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -57,6 +59,13 @@ class NodeListPriv : public Object
      */
     uint32_t Add(Ptr<Node> node);
 
+    /**
+     * \param n number of nodes about to be added.
+     *
+     * Reserve the storage for n more nodes.
+     */
+    void Reserve(uint32_t n);
+
     /**
      * \returns a C++ iterator located at the beginning of this
      *          list.
@@ -185,6 +194,17 @@ NodeListPriv::Add(Ptr<Node> node)
     return index;
 }
 
+void
+NodeListPriv::Reserve(uint32_t n)
+{
+    NS_LOG_FUNCTION(this << n);
+    // Do not defeat the geometric growth of the vector when called repeatedly
+    if (m_nodes.size() + n > m_nodes.capacity())
+    {
+        m_nodes.reserve(std::max<std::size_t>(m_nodes.size() + n, 2 * m_nodes.capacity()));
+    }
+}
+
 NodeList::Iterator
 NodeListPriv::Begin() const
 {
@@ -233,6 +253,13 @@ NodeList::Add(Ptr<Node> node)
     return NodeListPriv::Get()->Add(node);
 }
 
+void
+NodeList::Reserve(uint32_t n)
+{
+    NS_LOG_FUNCTION(n);
+    NodeListPriv::Get()->Reserve(n);
+}
+
 NodeList::Iterator
 NodeList::Begin()
 {
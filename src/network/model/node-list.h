@@ -51,6 +51,13 @@ class NodeList
      * the user has little reason to call it himself.
      */
     static uint32_t Add(Ptr<Node> node);
+    /**
+     * \param n number of nodes about to be added.
+     *
+     * Reserve the storage for n more nodes, e.g., before creating
+     * a large topology, so that the list does not grow step by step.
+     */
+    static void Reserve(uint32_t n);
     /**
      * \returns a C++ iterator located at the beginning of this
      *          list.
@@ -0,0 +1,203 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the events written by BinaryTraceWriter are read back,
+ * with and without filters.
+ */
+class BinaryTraceReadWriteTestCase : public TestCase
+{
+  public:
+    BinaryTraceReadWriteTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * \brief Read the events of a binary trace
+     * \param reader the reader
+     * \return the indices of the events, i.e., their sizes minus 100
+     */
+    std::vector<uint32_t> ReadAll(BinaryTraceReader& reader);
+};
+
+BinaryTraceReadWriteTestCase::BinaryTraceReadWriteTestCase()
+    : TestCase("Check the events written to and read from a binary trace")
+{
+}
+
+std::vector<uint32_t>
+BinaryTraceReadWriteTestCase::ReadAll(BinaryTraceReader& reader)
+{
+    std::vector<uint32_t> events;
+    BinaryTraceReader::Event event;
+    while (reader.Read(event))
+    {
+        uint32_t i = event.size - 100;
+        NS_TEST_EXPECT_MSG_EQ(event.type, (i % 2 ? '-' : '+'), "Wrong type of event " << i);
+        NS_TEST_EXPECT_MSG_EQ(event.time, MilliSeconds(i).GetNanoSeconds(), "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(event.node, i % 3, "Wrong node of event " << i);
+        NS_TEST_EXPECT_MSG_EQ(event.device, 1, "Wrong device of event " << i);
+        NS_TEST_EXPECT_MSG_EQ(event.summary, "", "No header summary without metadata");
+        events.push_back(i);
+    }
+    return events;
+}
+
+void
+BinaryTraceReadWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("binary-trace.btr");
+    std::vector<uint64_t> uids;
+    {
+        // blocks of 4 events
+        BinaryTraceWriter writer(filename, 4);
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            Ptr<Packet> p = Create<Packet>(100 + i);
+            uids.push_back(p->GetUid());
+            writer.Write(i % 2 ? '-' : '+', MilliSeconds(i), i % 3, 1, p);
+        }
+    }
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    BinaryTraceReader::Event event;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader.Read(event), true, "Missing event " << i);
+        NS_TEST_EXPECT_MSG_EQ(event.size, 100 + i, "Events must be read in order");
+        NS_TEST_EXPECT_MSG_EQ(event.uid, uids[i], "Wrong uid of event " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader.Read(event), false, "There are only 10 events");
+
+    BinaryTraceReader nodeReader;
+    nodeReader.Open(filename);
+    nodeReader.SetNode(1);
+    std::vector<uint32_t> expected = {1, 4, 7};
+    NS_TEST_EXPECT_MSG_EQ((ReadAll(nodeReader) == expected), true, "Wrong events of node 1");
+
+    // the first block (events 0 to 3) and the last one (events 8 and 9) are skipped
+    BinaryTraceReader timeReader;
+    timeReader.Open(filename);
+    timeReader.SetTimeRange(MilliSeconds(5).GetNanoSeconds(), MilliSeconds(7).GetNanoSeconds());
+    expected = {5, 6, 7};
+    NS_TEST_EXPECT_MSG_EQ((ReadAll(timeReader) == expected), true, "Wrong events in [5ms, 7ms]");
+
+    BinaryTraceReader bothReader;
+    bothReader.Open(filename);
+    bothReader.SetNode(0);
+    bothReader.SetTimeRange(MilliSeconds(2).GetNanoSeconds(), MilliSeconds(9).GetNanoSeconds());
+    expected = {3, 6, 9};
+    NS_TEST_EXPECT_MSG_EQ((ReadAll(bothReader) == expected), true, "Wrong events of node 0");
+
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the default ascii trace sinks write to a binary trace
+ * created by AsciiTraceHelper::CreateBinaryFileStream.
+ */
+class BinaryTraceSinkTestCase : public TestCase
+{
+  public:
+    BinaryTraceSinkTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceSinkTestCase::BinaryTraceSinkTestCase()
+    : TestCase("Check the default ascii trace sinks with a binary trace")
+{
+}
+
+void
+BinaryTraceSinkTestCase::DoRun()
+{
+    uint32_t node;
+    uint32_t device;
+    BinaryTraceWriter::ParseContext("/NodeList/12/DeviceList/3/TxQueue/Enqueue", node, device);
+    NS_TEST_EXPECT_MSG_EQ(node, 12, "Wrong node id");
+    NS_TEST_EXPECT_MSG_EQ(device, 3, "Wrong device id");
+    BinaryTraceWriter::ParseContext("/NodeList/7/$ns3::Ipv4L3Protocol/Tx", node, device);
+    NS_TEST_EXPECT_MSG_EQ(node, 7, "Wrong node id");
+    NS_TEST_EXPECT_MSG_EQ(device, BinaryTraceWriter::NO_ID, "There is no device id");
+    BinaryTraceWriter::ParseContext("/NodeList/", node, device);
+    NS_TEST_EXPECT_MSG_EQ(node, BinaryTraceWriter::NO_ID, "There is no node id");
+    NS_TEST_EXPECT_MSG_EQ(device, BinaryTraceWriter::NO_ID, "There is no device id");
+
+    std::string filename = CreateTempDirFilename("binary-trace-sinks.btr");
+    {
+        AsciiTraceHelper ascii;
+        Ptr<OutputStreamWrapper> stream = ascii.CreateBinaryFileStream(filename);
+        NS_TEST_ASSERT_MSG_NE(stream->GetBinaryWriter(), nullptr, "No binary trace writer");
+        std::string context = "/NodeList/2/DeviceList/1/TxQueue/Enqueue";
+        Ptr<Packet> p = Create<Packet>(500);
+        AsciiTraceHelper::DefaultEnqueueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDequeueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDropSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultReceiveSinkWithContext(stream, context, p);
+    }
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Unable to open " << filename);
+    BinaryTraceReader::Event event;
+    for (char type : {'+', '-', 'd', 'r'})
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader.Read(event), true, "Missing event " << type);
+        NS_TEST_EXPECT_MSG_EQ(event.type, type, "Wrong type of event");
+        NS_TEST_EXPECT_MSG_EQ(event.node, 2, "Wrong node id");
+        NS_TEST_EXPECT_MSG_EQ(event.device, 1, "Wrong device id");
+        NS_TEST_EXPECT_MSG_EQ(event.size, 500, "Wrong packet size");
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader.Read(event), false, "There are only 4 events");
+
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceTestSuite()
+        : TestSuite("binary-trace", UNIT)
+    {
+        AddTestCase(new BinaryTraceReadWriteTestCase(), TestCase::QUICK);
+        AddTestCase(new BinaryTraceSinkTestCase(), TestCase::QUICK);
+    }
+};
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
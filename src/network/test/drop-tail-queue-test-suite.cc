@@ -16,6 +16,7 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
@@ -87,6 +88,58 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that a DropTailQueue counts a TSO super-segment as its segments.
+ *
+ * A super-segment is admitted as long as there is room for one packet, but
+ * then occupies the queue as much as the packets it stands for.
+ */
+class DropTailQueueTsoTestCase : public TestCase
+{
+  public:
+    DropTailQueueTsoTestCase();
+    void DoRun() override;
+};
+
+DropTailQueueTsoTestCase::DropTailQueueTsoTestCase()
+    : TestCase("Check the occupancy of TSO super-segments in the drop tail queue")
+{
+}
+
+void
+DropTailQueueTsoTestCase::DoRun()
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    NS_TEST_EXPECT_MSG_EQ(queue->SetAttributeFailSafe("MaxSize", StringValue("10p")),
+                          true,
+                          "Verify that we can actually set the attribute");
+
+    Ptr<Packet> p1 = Create<Packet>(8 * 1000);
+    p1->AddPacketTag(SegmentationOffloadTag(1000, 40, 8));
+    Ptr<Packet> p2 = Create<Packet>(8 * 1000);
+    p2->AddPacketTag(SegmentationOffloadTag(1000, 40, 8));
+    Ptr<Packet> p3 = Create<Packet>(1000);
+
+    NS_TEST_EXPECT_MSG_EQ(queue->Enqueue(p1), true, "The first super-segment should fit");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 8, "The super-segment counts as 8 packets");
+    NS_TEST_EXPECT_MSG_EQ(queue->Enqueue(p2), true, "There is room for one more packet");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 16, "Both super-segments count as 16 packets");
+    NS_TEST_EXPECT_MSG_EQ(queue->Enqueue(p3), false, "The queue is over its limit");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 16, "There should be still 16 packets in there");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalDroppedPackets(), 1, "The plain packet was dropped");
+
+    Ptr<Packet> packet = queue->Dequeue();
+    NS_TEST_EXPECT_MSG_EQ(packet->GetUid(), p1->GetUid(), "Was this the first super-segment ?");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 8, "There should be 8 packets in there");
+    packet = queue->Dequeue();
+    NS_TEST_EXPECT_MSG_EQ(packet->GetUid(), p2->GetUid(), "Was this the second super-segment ?");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 0, "There should be no packets in there");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalReceivedPackets(), 16, "16 packets were enqueued");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -100,6 +153,7 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::QUICK);
+        AddTestCase(new DropTailQueueTsoTestCase(), TestCase::QUICK);
     }
 };
 
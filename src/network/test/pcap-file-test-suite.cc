@@ -1373,6 +1373,86 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the packets written asynchronously are
+ * the same as those written synchronously.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+  public:
+    AsyncWriteTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * \brief Write the known packets to a file
+     * \param filename the name of the file
+     * \param bufferSize the size of the buffer of the asynchronous writes (0 if disabled)
+     */
+    void WriteFile(const std::string& filename, uint32_t bufferSize);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase()
+    : TestCase("Check that PcapFile writes the same packets asynchronously")
+{
+}
+
+void
+AsyncWriteTestCase::WriteFile(const std::string& filename, uint32_t bufferSize)
+{
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(),
+                          false,
+                          "Open (" << filename << ", \"std::ios::out\") returns error");
+    f.Init(1, N_PACKET_BYTES);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Init (1, " << N_PACKET_BYTES << ") returns error");
+    if (bufferSize)
+    {
+        f.EnableAsyncWrite(bufferSize);
+    }
+
+    for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+        const PacketEntry& p = knownPackets[i];
+
+        f.Write(p.tsSec, p.tsUsec, (const uint8_t*)p.data, p.origLen);
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+    }
+    f.Close();
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Close must not fail");
+}
+
+void
+AsyncWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("sync.pcap");
+    std::string filename2 = CreateTempDirFilename("async.pcap");
+    std::string filename3 = CreateTempDirFilename("async-large.pcap");
+
+    WriteFile(filename, 0);
+    // a buffer smaller than a record, then a buffer larger than the file
+    WriteFile(filename2, 1);
+    WriteFile(filename3, 1 << 20);
+
+    for (const auto& other : {filename2, filename3})
+    {
+        uint32_t sec(0);
+        uint32_t usec(0);
+        uint32_t packets(0);
+        bool diff = PcapFile::Diff(filename, other, sec, usec, packets);
+        NS_TEST_EXPECT_MSG_EQ(diff, false, "The files written asynchronously must be the same");
+        NS_TEST_EXPECT_MSG_EQ(packets, N_KNOWN_PACKETS, "All the packets must be written");
+    }
+
+    remove(filename.c_str());
+    remove(filename2.c_str());
+    remove(filename3.c_str());
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1396,6 +1476,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::QUICK);
     AddTestCase(new DiffTestCase, TestCase::QUICK);
+    AddTestCase(new AsyncWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,433 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <cstring>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceFile");
+
+namespace
+{
+
+const char BINARY_TRACE_MAGIC[8] = {'n', 's', '3', 'b', 't', 'r', 'c', '1'}; //!< File magic
+const uint32_t BINARY_TRACE_BOM = 0x01020304; //!< Byte order mark
+
+/// Size of the header of a block (number of events, time range, node range and
+/// size of the summary table), excluding the block size field
+const uint32_t BLOCK_HEADER_SIZE = 4 * sizeof(uint32_t) + 2 * sizeof(int64_t);
+
+/// Size of the columns of an event
+const uint32_t EVENT_SIZE = sizeof(uint8_t) + 2 * sizeof(int64_t) + 4 * sizeof(uint32_t);
+
+/**
+ * \brief Append the bytes of a value to a buffer
+ * \param buffer the buffer
+ * \param value the value
+ */
+template <typename T>
+void
+Append(std::vector<char>& buffer, const T& value)
+{
+    const char* p = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+/**
+ * \brief Append the bytes of a column to a buffer
+ * \param buffer the buffer
+ * \param column the column
+ */
+template <typename T>
+void
+AppendColumn(std::vector<char>& buffer, const std::vector<T>& column)
+{
+    const char* p = reinterpret_cast<const char*>(column.data());
+    buffer.insert(buffer.end(), p, p + column.size() * sizeof(T));
+}
+
+/**
+ * \brief Read a value from a buffer
+ * \param buffer the buffer
+ * \param offset [in,out] the offset of the value, moved past the value
+ * \return the value
+ */
+template <typename T>
+T
+Extract(const std::vector<char>& buffer, std::size_t& offset)
+{
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+/**
+ * \brief Read a column from a buffer
+ * \param buffer the buffer
+ * \param offset [in,out] the offset of the column, moved past the column
+ * \param n the number of values of the column
+ * \param column [out] the column
+ */
+template <typename T>
+void
+ExtractColumn(const std::vector<char>& buffer,
+              std::size_t& offset,
+              uint32_t n,
+              std::vector<T>& column)
+{
+    column.resize(n);
+    std::memcpy(column.data(), buffer.data() + offset, n * sizeof(T));
+    offset += n * sizeof(T);
+}
+
+} // namespace
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string& filename, uint32_t blockEvents)
+    : m_blockEvents(blockEvents)
+{
+    NS_LOG_FUNCTION(this << filename << blockEvents);
+    NS_ABORT_MSG_IF(blockEvents == 0, "The blocks of a binary trace cannot be empty");
+    m_file.open(filename, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(),
+                        "BinaryTraceWriter::BinaryTraceWriter(): Unable to Open " << filename);
+    m_file.write(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC));
+    m_file.write(reinterpret_cast<const char*>(&BINARY_TRACE_BOM), sizeof(BINARY_TRACE_BOM));
+    m_summaryIds[""] = 0;
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+}
+
+void
+BinaryTraceWriter::Write(char type, Time time, uint32_t node, uint32_t device, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << type << time << node << device << p);
+    m_types.push_back(static_cast<uint8_t>(type));
+    m_times.push_back(time.GetNanoSeconds());
+    m_nodes.push_back(node);
+    m_devices.push_back(device);
+    m_uids.push_back(p->GetUid());
+    m_sizes.push_back(p->GetSize());
+    m_summaries.push_back(GetSummaryId(p));
+    if (m_types.size() >= m_blockEvents)
+    {
+        Flush();
+    }
+}
+
+void
+BinaryTraceWriter::Write(char type, Time time, const std::string& context, Ptr<const Packet> p)
+{
+    uint32_t node;
+    uint32_t device;
+    ParseContext(context, node, device);
+    Write(type, time, node, device, p);
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t n = m_types.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    std::vector<char> strings;
+    for (const auto& summary : m_newSummaries)
+    {
+        Append<uint32_t>(strings, m_summaryIds[summary]);
+        Append<uint32_t>(strings, summary.size());
+        strings.insert(strings.end(), summary.begin(), summary.end());
+    }
+    m_newSummaries.clear();
+
+    uint32_t minNode = std::numeric_limits<uint32_t>::max();
+    uint32_t maxNode = 0;
+    for (uint32_t node : m_nodes)
+    {
+        minNode = std::min(minNode, node);
+        maxNode = std::max(maxNode, node);
+    }
+
+    std::vector<char> block;
+    block.reserve(sizeof(uint32_t) + BLOCK_HEADER_SIZE + strings.size() + n * EVENT_SIZE);
+    Append<uint32_t>(block, 0);
+    Append<uint32_t>(block, n);
+    Append<int64_t>(block, m_times.front());
+    Append<int64_t>(block, m_times.back());
+    Append<uint32_t>(block, minNode);
+    Append<uint32_t>(block, maxNode);
+    Append<uint32_t>(block, strings.size());
+    block.insert(block.end(), strings.begin(), strings.end());
+    AppendColumn(block, m_types);
+    AppendColumn(block, m_times);
+    AppendColumn(block, m_nodes);
+    AppendColumn(block, m_devices);
+    AppendColumn(block, m_uids);
+    AppendColumn(block, m_sizes);
+    AppendColumn(block, m_summaries);
+    uint32_t blockSize = block.size() - sizeof(uint32_t);
+    std::memcpy(block.data(), &blockSize, sizeof(uint32_t));
+    m_file.write(block.data(), block.size());
+    m_file.flush();
+
+    m_types.clear();
+    m_times.clear();
+    m_nodes.clear();
+    m_devices.clear();
+    m_uids.clear();
+    m_sizes.clear();
+    m_summaries.clear();
+}
+
+void
+BinaryTraceWriter::ParseContext(const std::string& context, uint32_t& node, uint32_t& device)
+{
+    node = NO_ID;
+    device = NO_ID;
+    const std::string nodeList = "/NodeList/";
+    const std::string deviceList = "/DeviceList/";
+    std::size_t pos = context.find(nodeList);
+    if (pos == std::string::npos)
+    {
+        return;
+    }
+    pos += nodeList.size();
+    std::size_t end = context.find_first_not_of("0123456789", pos);
+    if (pos >= context.size() || end == pos)
+    {
+        return;
+    }
+    node = std::stoul(context.substr(pos, end - pos));
+    if (end == std::string::npos || context.compare(end, deviceList.size(), deviceList) != 0)
+    {
+        return;
+    }
+    pos = end + deviceList.size();
+    end = context.find_first_not_of("0123456789", pos);
+    if (pos >= context.size() || end == pos)
+    {
+        return;
+    }
+    device = std::stoul(context.substr(pos, end - pos));
+}
+
+uint32_t
+BinaryTraceWriter::GetSummaryId(Ptr<const Packet> p)
+{
+    std::string summary;
+    PacketMetadata::ItemIterator i = p->BeginItem();
+    while (i.HasNext())
+    {
+        PacketMetadata::Item item = i.Next();
+        if (item.type == PacketMetadata::Item::PAYLOAD)
+        {
+            continue;
+        }
+        if (!summary.empty())
+        {
+            summary += ' ';
+        }
+        summary += item.tid.GetName();
+    }
+    auto it = m_summaryIds.find(summary);
+    if (it != m_summaryIds.end())
+    {
+        return it->second;
+    }
+    uint32_t id = m_summaryIds.size();
+    m_summaryIds.emplace(summary, id);
+    m_newSummaries.push_back(summary);
+    return id;
+}
+
+BinaryTraceReader::BinaryTraceReader()
+    : m_start(std::numeric_limits<int64_t>::min()),
+      m_stop(std::numeric_limits<int64_t>::max()),
+      m_node(BinaryTraceWriter::NO_ID),
+      m_nEvents(0),
+      m_next(0)
+{
+    NS_LOG_FUNCTION(this);
+    m_summaryTable[0] = "";
+}
+
+bool
+BinaryTraceReader::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+    char magic[sizeof(BINARY_TRACE_MAGIC)];
+    uint32_t bom = 0;
+    m_file.read(magic, sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&bom), sizeof(bom));
+    return m_file.good() && std::memcmp(magic, BINARY_TRACE_MAGIC, sizeof(magic)) == 0 &&
+           bom == BINARY_TRACE_BOM;
+}
+
+void
+BinaryTraceReader::SetTimeRange(int64_t start, int64_t stop)
+{
+    NS_LOG_FUNCTION(this << start << stop);
+    m_start = start;
+    m_stop = stop;
+}
+
+void
+BinaryTraceReader::SetNode(uint32_t node)
+{
+    NS_LOG_FUNCTION(this << node);
+    m_node = node;
+}
+
+bool
+BinaryTraceReader::Read(Event& event)
+{
+    NS_LOG_FUNCTION(this);
+    while (true)
+    {
+        while (m_next < m_nEvents)
+        {
+            uint32_t i = m_next++;
+            if (m_times[i] < m_start || m_times[i] > m_stop ||
+                (m_node != BinaryTraceWriter::NO_ID && m_nodes[i] != m_node))
+            {
+                continue;
+            }
+            auto it = m_summaryTable.find(m_summaries[i]);
+            if (it == m_summaryTable.end())
+            {
+                NS_LOG_WARN("Unknown header summary " << m_summaries[i]);
+                return false;
+            }
+            event.type = static_cast<char>(m_types[i]);
+            event.time = m_times[i];
+            event.node = m_nodes[i];
+            event.device = m_devices[i];
+            event.uid = m_uids[i];
+            event.size = m_sizes[i];
+            event.summary = it->second;
+            return true;
+        }
+        if (!ReadBlock())
+        {
+            return false;
+        }
+    }
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+    NS_LOG_FUNCTION(this);
+    m_nEvents = 0;
+    m_next = 0;
+    while (true)
+    {
+        uint32_t blockSize;
+        if (!m_file.read(reinterpret_cast<char*>(&blockSize), sizeof(blockSize)))
+        {
+            return false;
+        }
+        if (blockSize < BLOCK_HEADER_SIZE)
+        {
+            NS_LOG_WARN("Corrupted block of size " << blockSize);
+            return false;
+        }
+        std::vector<char> header(BLOCK_HEADER_SIZE);
+        if (!m_file.read(header.data(), header.size()))
+        {
+            return false;
+        }
+        std::size_t offset = 0;
+        uint32_t n = Extract<uint32_t>(header, offset);
+        int64_t minTime = Extract<int64_t>(header, offset);
+        int64_t maxTime = Extract<int64_t>(header, offset);
+        uint32_t minNode = Extract<uint32_t>(header, offset);
+        uint32_t maxNode = Extract<uint32_t>(header, offset);
+        uint32_t stringsSize = Extract<uint32_t>(header, offset);
+        if (blockSize != header.size() + stringsSize + static_cast<uint64_t>(n) * EVENT_SIZE)
+        {
+            NS_LOG_WARN("Corrupted block of size " << blockSize);
+            return false;
+        }
+
+        // The summary table must be read even if the block is skipped, as the
+        // following blocks may refer to the summaries first used in this one
+        std::vector<char> strings(stringsSize);
+        if (!m_file.read(strings.data(), stringsSize))
+        {
+            return false;
+        }
+        offset = 0;
+        while (offset + 2 * sizeof(uint32_t) <= strings.size())
+        {
+            uint32_t id = Extract<uint32_t>(strings, offset);
+            uint32_t length = Extract<uint32_t>(strings, offset);
+            if (offset + length > strings.size())
+            {
+                NS_LOG_WARN("Corrupted summary table");
+                return false;
+            }
+            m_summaryTable[id] = std::string(strings.data() + offset, length);
+            offset += length;
+        }
+
+        std::size_t columnsSize = static_cast<std::size_t>(n) * EVENT_SIZE;
+        if (maxTime < m_start || minTime > m_stop ||
+            (m_node != BinaryTraceWriter::NO_ID && (m_node < minNode || m_node > maxNode)))
+        {
+            NS_LOG_LOGIC("Skipping a block of " << n << " events");
+            m_file.seekg(columnsSize, std::ios::cur);
+            continue;
+        }
+
+        std::vector<char> columns(columnsSize);
+        if (!m_file.read(columns.data(), columnsSize))
+        {
+            return false;
+        }
+        offset = 0;
+        ExtractColumn(columns, offset, n, m_types);
+        ExtractColumn(columns, offset, n, m_times);
+        ExtractColumn(columns, offset, n, m_nodes);
+        ExtractColumn(columns, offset, n, m_devices);
+        ExtractColumn(columns, offset, n, m_uids);
+        ExtractColumn(columns, offset, n, m_sizes);
+        ExtractColumn(columns, offset, n, m_summaries);
+        m_nEvents = n;
+        return true;
+    }
+}
+
+} // namespace ns3
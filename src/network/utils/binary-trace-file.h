@@ -0,0 +1,218 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief A writer of packet events in a compact binary trace format
+ *
+ * This class records the events of the default ascii trace sinks (see
+ * AsciiTraceHelper::CreateBinaryFileStream) without formatting them: each
+ * event is made of its type ('+', '-', 'd', 'r' or 't'), the time, the node
+ * and device ids, the packet uid and size, and a summary of the headers of the
+ * packet, i.e., the names of its headers and trailers (empty if the packet
+ * metadata is not enabled).
+ *
+ * The events are buffered and written in blocks, column by column. The file
+ * starts with the 8 byte magic string "ns3btrc1" and a 32 bit byte order mark
+ * (0x01020304), followed by the blocks:
+ *
+ * - the size of the block, excluding this field (uint32_t)
+ * - the number of events of the block, n (uint32_t)
+ * - the time of the first and last events, in nanoseconds (int64_t)
+ * - the smallest and largest node ids (uint32_t)
+ * - the size of the summary table (uint32_t)
+ * - the summary table, i.e., the header summaries first used in the block,
+ *   each one being an id (uint32_t), a length (uint32_t) and the characters
+ * - n event types (uint8_t), n times in nanoseconds (int64_t), n node ids
+ *   (uint32_t), n device ids (uint32_t), n packet uids (uint64_t), n packet
+ *   sizes (uint32_t) and n summary ids (uint32_t)
+ *
+ * Integers are written in the byte order of the host. The block headers allow
+ * BinaryTraceReader to skip the blocks out of the requested time range or
+ * without the requested node without decoding them.
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+  public:
+    /// Node or device id of the events whose node or device is unknown
+    static const uint32_t NO_ID = 0xffffffff;
+
+    /**
+     * Constructor
+     * \param filename the name of the file
+     * \param blockEvents the number of events of each block
+     */
+    BinaryTraceWriter(const std::string& filename, uint32_t blockEvents = 4096);
+    ~BinaryTraceWriter();
+
+    /**
+     * \brief Record an event
+     * \param type the type of the event
+     * \param time the time of the event
+     * \param node the id of the node, or NO_ID
+     * \param device the id of the device, or NO_ID
+     * \param p the packet
+     */
+    void Write(char type, Time time, uint32_t node, uint32_t device, Ptr<const Packet> p);
+
+    /**
+     * \brief Record an event of a trace source connected with Config::Connect
+     *
+     * The node and device ids are those of the config path of the trace
+     * source, if any.
+     *
+     * \param type the type of the event
+     * \param time the time of the event
+     * \param context the context of the trace source
+     * \param p the packet
+     */
+    void Write(char type, Time time, const std::string& context, Ptr<const Packet> p);
+
+    /**
+     * \brief Write the buffered events to the file
+     */
+    void Flush();
+
+    /**
+     * \brief Get the node and device ids of a config path
+     *
+     * \param context the config path, e.g., "/NodeList/1/DeviceList/2/TxQueue/Enqueue"
+     * \param node [out] the node id, or NO_ID if the path has no node id
+     * \param device [out] the device id, or NO_ID if the path has no device id
+     */
+    static void ParseContext(const std::string& context, uint32_t& node, uint32_t& device);
+
+  private:
+    /**
+     * \param p a packet
+     * \return the id of the header summary of the packet
+     */
+    uint32_t GetSummaryId(Ptr<const Packet> p);
+
+    std::ofstream m_file;   //!< the file
+    uint32_t m_blockEvents; //!< the number of events of each block
+
+    std::vector<uint8_t> m_types;      //!< the event types of the block
+    std::vector<int64_t> m_times;      //!< the event times of the block
+    std::vector<uint32_t> m_nodes;     //!< the node ids of the block
+    std::vector<uint32_t> m_devices;   //!< the device ids of the block
+    std::vector<uint64_t> m_uids;      //!< the packet uids of the block
+    std::vector<uint32_t> m_sizes;     //!< the packet sizes of the block
+    std::vector<uint32_t> m_summaries; //!< the summary ids of the block
+
+    std::unordered_map<std::string, uint32_t> m_summaryIds; //!< the ids of the summaries
+    std::vector<std::string> m_newSummaries;                //!< the new summaries of the block
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief A reader of the binary traces written by BinaryTraceWriter
+ *
+ * The events can be filtered by time range and by node: the blocks which
+ * cannot contain matching events are skipped without being decoded.
+ */
+class BinaryTraceReader
+{
+  public:
+    /// An event of a binary trace
+    struct Event
+    {
+        char type;           //!< the type of the event
+        int64_t time;        //!< the time of the event, in nanoseconds
+        uint32_t node;       //!< the node id (BinaryTraceWriter::NO_ID if unknown)
+        uint32_t device;     //!< the device id (BinaryTraceWriter::NO_ID if unknown)
+        uint64_t uid;        //!< the packet uid
+        uint32_t size;       //!< the packet size
+        std::string summary; //!< the names of the headers and trailers of the packet
+    };
+
+    BinaryTraceReader();
+
+    /**
+     * \brief Open a binary trace
+     * \param filename the name of the file
+     * \return false if the file cannot be opened or is not a binary trace
+     */
+    bool Open(const std::string& filename);
+
+    /**
+     * \brief Only read the events in a time range
+     * \param start the time of the first event to read, in nanoseconds
+     * \param stop the time after which events are not read, in nanoseconds
+     */
+    void SetTimeRange(int64_t start, int64_t stop);
+
+    /**
+     * \brief Only read the events of a node
+     * \param node the node id
+     */
+    void SetNode(uint32_t node);
+
+    /**
+     * \brief Read the next event matching the filters
+     * \param event [out] the event
+     * \return false at the end of the file or if the file is corrupted
+     */
+    bool Read(Event& event);
+
+  private:
+    /**
+     * \brief Read the next block which can contain matching events
+     * \return false at the end of the file or if the file is corrupted
+     */
+    bool ReadBlock();
+
+    std::ifstream m_file; //!< the file
+    int64_t m_start;      //!< the start of the time range
+    int64_t m_stop;       //!< the end of the time range
+    uint32_t m_node;      //!< the node of the events, or BinaryTraceWriter::NO_ID for all
+
+    uint32_t m_nEvents; //!< the number of events of the current block
+    uint32_t m_next;    //!< the next event of the current block
+
+    std::vector<uint8_t> m_types;      //!< the event types of the block
+    std::vector<int64_t> m_times;      //!< the event times of the block
+    std::vector<uint32_t> m_nodes;     //!< the node ids of the block
+    std::vector<uint32_t> m_devices;   //!< the device ids of the block
+    std::vector<uint64_t> m_uids;      //!< the packet uids of the block
+    std::vector<uint32_t> m_sizes;     //!< the packet sizes of the block
+    std::vector<uint32_t> m_summaries; //!< the summary ids of the block
+
+    std::unordered_map<uint32_t, std::string> m_summaryTable; //!< the summaries by id
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
@@ -17,6 +17,8 @@
 
 #include "output-stream-wrapper.h"
 
+#include "binary-trace-file.h"
+
 #include "ns3/abort.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/log.h"
@@ -50,10 +52,21 @@ OutputStreamWrapper::OutputStreamWrapper(std::ostream* os)
     NS_ABORT_MSG_UNLESS(m_ostream->good(), "Output stream is not valid for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper(Ptr<BinaryTraceWriter> writer)
+    : m_ostream(nullptr),
+      m_destroyable(false),
+      m_binary(writer)
+{
+    NS_LOG_FUNCTION(this << writer);
+}
+
 OutputStreamWrapper::~OutputStreamWrapper()
 {
     NS_LOG_FUNCTION(this);
-    FatalImpl::UnregisterStream(m_ostream);
+    if (m_ostream)
+    {
+        FatalImpl::UnregisterStream(m_ostream);
+    }
     if (m_destroyable)
     {
         delete m_ostream;
@@ -65,7 +78,16 @@ std::ostream*
 OutputStreamWrapper::GetStream()
 {
     NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_binary,
+                    "OutputStreamWrapper::GetStream(): the wrapper writes to a binary trace "
+                    "file, only the ascii trace sinks of the helpers can be connected to it");
     return m_ostream;
 }
 
+Ptr<BinaryTraceWriter>
+OutputStreamWrapper::GetBinaryWriter() const
+{
+    return m_binary;
+}
+
 } // namespace ns3
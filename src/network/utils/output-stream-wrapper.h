@@ -27,6 +27,8 @@
 namespace ns3
 {
 
+class BinaryTraceWriter;
+
 /**
  * @brief A class encapsulating an output stream.
  *
@@ -65,6 +67,11 @@ namespace ns3
  * \endverbatim
  *
  *
+ * A wrapper can also carry a BinaryTraceWriter instead of a file: the ascii
+ * trace sinks of the helpers then record their events in the binary trace.
+ * Such a wrapper has no text stream, so GetStream aborts: text sinks must not
+ * be connected to it.
+ *
  * This class uses a basic ns-3 reference counting base class but is not
  * an ns3::Object with attributes, TypeId, or aggregation.
  */
@@ -82,10 +89,16 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      * \param os output stream
      */
     OutputStreamWrapper(std::ostream* os);
+    /**
+     * Constructor
+     * \param writer binary trace writer
+     */
+    OutputStreamWrapper(Ptr<BinaryTraceWriter> writer);
     ~OutputStreamWrapper();
 
     /**
      * Return a pointer to an ostream previously set in the wrapper.
+     * This aborts if the wrapper encapsulates a binary trace writer.
      *
      * \see SetStream
      *
@@ -93,9 +106,16 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      */
     std::ostream* GetStream();
 
+    /**
+     * \returns the binary trace writer of the wrapper, or 0 if the wrapper
+     * encapsulates an ostream
+     */
+    Ptr<BinaryTraceWriter> GetBinaryWriter() const;
+
   private:
-    std::ostream* m_ostream; //!< The output stream
-    bool m_destroyable;      //!< Can be destroyed
+    std::ostream* m_ostream;         //!< The output stream
+    bool m_destroyable;              //!< Can be destroyed
+    Ptr<BinaryTraceWriter> m_binary; //!< The binary trace writer, if any
 };
 
 } // namespace ns3
@@ -48,7 +48,14 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBufferSize",
+                          "The size of the buffer in which packets are accumulated before "
+                          "being written to the file by a background thread (0 to write "
+                          "each packet immediately).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_writeBufferSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -115,6 +122,11 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     {
         m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
     }
+
+    if (m_writeBufferSize > 0 && !m_file.Fail())
+    {
+        m_file.EnableAsyncWrite(m_writeBufferSize);
+    }
 }
 
 void
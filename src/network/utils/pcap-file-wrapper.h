@@ -85,7 +85,10 @@ class PcapFileWrapper : public Object
 
     /**
      * Initialize the pcap file associated with this wrapper.  This file must have
-     * been previously opened with write permissions.
+     * been previously opened with write permissions.  If the WriteBufferSize
+     * attribute is not null, the file must have been opened for writing only,
+     * and the packets are then written asynchronously (see
+     * PcapFile::EnableAsyncWrite).
      *
      * \param dataLinkType A data link type as defined in the pcap library.  If
      * you want to make resulting pcap files visible in existing tools, the
@@ -223,8 +226,9 @@ class PcapFileWrapper : public Object
 
   private:
     PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    uint32_t m_snapLen;         //!< max length of saved packets
+    bool m_nanosecMode;         //!< Timestamps in nanosecond mode
+    uint32_t m_writeBufferSize; //!< Size of the buffer of the asynchronous writes
 };
 
 } // namespace ns3
@@ -28,8 +28,12 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -51,10 +55,154 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+/**
+ * \ingroup network
+ *
+ * \brief The background thread appending the record buffers of the pcap files
+ * written asynchronously to their files.
+ *
+ * Buffers are appended in the order they are handed over, hence the records
+ * of each file are written in order. The thread is started when the first
+ * buffer is handed over, and the buffers waiting to be appended are limited
+ * to MAX_PENDING_BYTES, beyond which the simulation waits for the thread.
+ */
+class PcapFileAsyncWriter
+{
+  public:
+    /**
+     * \return the writer shared by all the pcap files
+     */
+    static PcapFileAsyncWriter& Get();
+
+    ~PcapFileAsyncWriter();
+
+    /**
+     * \brief Hand over a buffer to be appended to a file
+     * \param filename the name of the file
+     * \param records the buffer
+     * \param error set if the buffer cannot be appended to the file
+     * \return the identifier of the buffer, to wait for it
+     */
+    uint64_t Submit(const std::string& filename,
+                    std::vector<uint8_t>&& records,
+                    std::shared_ptr<std::atomic<bool>> error);
+
+    /**
+     * \brief Wait until a buffer (and all the buffers handed over before it) is appended
+     * \param job the identifier of the buffer
+     */
+    void Wait(uint64_t job);
+
+  private:
+    /// A buffer to append to a file
+    struct Job
+    {
+        std::string filename;                     //!< the name of the file
+        std::vector<uint8_t> records;             //!< the buffer
+        std::shared_ptr<std::atomic<bool>> error; //!< set if the buffer cannot be appended
+    };
+
+    PcapFileAsyncWriter() = default;
+
+    /**
+     * \brief Append the buffers until the writer is destroyed
+     */
+    void Run();
+
+    /// The maximum size of the buffers waiting to be appended
+    static constexpr std::size_t MAX_PENDING_BYTES = 64 * 1024 * 1024;
+
+    std::mutex m_mutex;                 //!< protects the members below
+    std::condition_variable m_jobReady; //!< signaled when a buffer is handed over
+    std::condition_variable m_jobDone;  //!< signaled when a buffer is appended
+    std::deque<Job> m_jobs;             //!< the buffers waiting to be appended
+    std::size_t m_pendingBytes{0};      //!< the size of the buffers waiting to be appended
+    uint64_t m_submitted{0};            //!< the number of buffers handed over
+    uint64_t m_done{0};                 //!< the number of buffers appended
+    bool m_stop{false};                 //!< whether the thread must exit
+    std::thread m_thread;               //!< the background thread
+};
+
+PcapFileAsyncWriter&
+PcapFileAsyncWriter::Get()
+{
+    static PcapFileAsyncWriter writer;
+    return writer;
+}
+
+PcapFileAsyncWriter::~PcapFileAsyncWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobReady.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+uint64_t
+PcapFileAsyncWriter::Submit(const std::string& filename,
+                            std::vector<uint8_t>&& records,
+                            std::shared_ptr<std::atomic<bool>> error)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&PcapFileAsyncWriter::Run, this);
+    }
+    m_jobDone.wait(lock, [this] { return m_pendingBytes < MAX_PENDING_BYTES; });
+    m_pendingBytes += records.size();
+    m_jobs.push_back({filename, std::move(records), error});
+    m_jobReady.notify_one();
+    return ++m_submitted;
+}
+
+void
+PcapFileAsyncWriter::Wait(uint64_t job)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this, job] { return m_done >= job; });
+}
+
+void
+PcapFileAsyncWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_jobReady.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty())
+        {
+            return;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        std::ofstream file(job.filename, std::ios::binary | std::ios::app);
+        file.write(reinterpret_cast<const char*>(job.records.data()), job.records.size());
+        file.close();
+        if (file.fail())
+        {
+            *job.error = true;
+        }
+
+        lock.lock();
+        m_pendingBytes -= job.records.size();
+        m_done++;
+        m_jobDone.notify_all();
+    }
+}
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_asyncBufferSize(0),
+      m_asyncJob(0)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -71,7 +219,7 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
-    return m_file.fail();
+    return m_file.fail() || (m_asyncError && *m_asyncError);
 }
 
 bool
@@ -92,6 +240,19 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_asyncBufferSize)
+    {
+        // the file has already been closed by EnableAsyncWrite
+        SubmitRecords();
+        PcapFileAsyncWriter::Get().Wait(m_asyncJob);
+        if (*m_asyncError)
+        {
+            m_file.setstate(std::ios::failbit);
+        }
+        m_asyncBufferSize = 0;
+        m_asyncError = nullptr;
+        return;
+    }
     m_file.close();
 }
 
@@ -409,6 +570,21 @@ PcapFile::Init(uint32_t dataLinkType,
     WriteFileHeader();
 }
 
+void
+PcapFile::EnableAsyncWrite(uint32_t bufferSize)
+{
+    NS_LOG_FUNCTION(this << bufferSize);
+    NS_ASSERT(bufferSize > 0);
+    NS_ASSERT(m_file.good());
+
+    // the file header has been written by Init, the records will be appended
+    // by the background thread
+    m_file.close();
+    m_asyncBufferSize = bufferSize;
+    m_asyncError = std::make_shared<std::atomic<bool>>(m_file.fail());
+    m_records.reserve(bufferSize);
+}
+
 uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
@@ -429,24 +605,53 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     }
 
     //
-    // Watch out for memory alignment differences between machines, so write
-    // them all individually.
+    // Watch out for memory alignment differences between machines, so copy
+    // the fields one after the other into the record buffer, followed by room
+    // for the packet data.
     //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
-    NS_BUILD_DEBUG(m_file.flush());
+    uint32_t fields[] = {header.m_tsSec, header.m_tsUsec, header.m_inclLen, header.m_origLen};
+    std::size_t offset = m_records.size();
+    m_records.resize(offset + sizeof(fields) + inclLen);
+    std::memcpy(m_records.data() + offset, fields, sizeof(fields));
     return inclLen;
 }
 
+void
+PcapFile::WriteRecords()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_asyncBufferSize == 0)
+    {
+        m_file.write((const char*)m_records.data(), m_records.size());
+        m_records.clear();
+        NS_BUILD_DEBUG(m_file.flush());
+    }
+    else if (m_records.size() >= m_asyncBufferSize)
+    {
+        SubmitRecords();
+    }
+}
+
+void
+PcapFile::SubmitRecords()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_records.empty())
+    {
+        m_asyncJob =
+            PcapFileAsyncWriter::Get().Submit(m_filename, std::move(m_records), m_asyncError);
+        m_records = std::vector<uint8_t>();
+        m_records.reserve(m_asyncBufferSize);
+    }
+}
+
 void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-    m_file.write((const char*)data, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    std::memcpy(m_records.data() + m_records.size() - inclLen, data, inclLen);
+    WriteRecords();
 }
 
 void
@@ -454,8 +659,8 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
-    p->CopyData(&m_file, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    p->CopyData(m_records.data() + m_records.size() - inclLen, inclLen);
+    WriteRecords();
 }
 
 void
@@ -465,14 +670,16 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     uint32_t headerSize = header.GetSerializedSize();
     uint32_t totalSize = headerSize + p->GetSize();
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
+    uint8_t* data = m_records.data() + m_records.size() - inclLen;
 
     Buffer headerBuffer;
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
-    headerBuffer.CopyData(&m_file, toCopy);
+    headerBuffer.CopyData(data, toCopy);
     inclLen -= toCopy;
-    p->CopyData(&m_file, inclLen);
+    p->CopyData(data + toCopy, inclLen);
+    WriteRecords();
 }
 
 void
@@ -22,9 +22,12 @@
 
 #include "ns3/ptr.h"
 
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -121,6 +124,22 @@ class PcapFile
               bool swapMode = false,
               bool nanosecMode = false);
 
+    /**
+     * \brief Write the packets asynchronously
+     *
+     * The packet records are serialized into a buffer of the given size which,
+     * when full, is appended to the file by a background thread shared by all
+     * the pcap files. The file is only open while a buffer is being appended,
+     * so that a large number of pcap files can be written at the same time
+     * without holding a file descriptor each. Close (or the destructor) appends
+     * the last buffer and waits until the file is complete.
+     *
+     * This method must be called after Init, on a file opened for writing only.
+     *
+     * \param bufferSize The size of the buffer, in bytes.
+     */
+    void EnableAsyncWrite(uint32_t bufferSize);
+
     /**
      * \brief Write next packet to file
      *
@@ -361,12 +380,24 @@ class PcapFile
      * The pcap header has a fixed length of 24 bytes. The last 4 bytes
      * represent the link-layer type
      *
+     * The packet header is serialized into the record buffer, which the packet
+     * data must then be appended to.
+     *
      * \param tsSec Time stamp (seconds part)
      * \param tsUsec Time stamp (microseconds part)
      * \param totalLen total packet length
      * \returns the length of the packet to write in the Pcap file
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+    /**
+     * \brief Write the record buffer to the file, or hand it over to the
+     * background thread if full in asynchronous mode
+     */
+    void WriteRecords();
+    /**
+     * \brief Hand over the record buffer to the background thread
+     */
+    void SubmitRecords();
 
     /**
      * \brief Read and verify a Pcap file header
@@ -378,6 +409,12 @@ class PcapFile
     PcapFileHeader m_fileHeader; //!< file header
     bool m_swapMode;             //!< swap mode
     bool m_nanosecMode;          //!< nanosecond timestamp mode
+
+    std::vector<uint8_t> m_records; //!< records not written to the file yet
+    uint32_t m_asyncBufferSize;     //!< buffer size in asynchronous mode (0 if disabled)
+    uint64_t m_asyncJob;            //!< last buffer handed over to the background thread
+    /// whether the background thread failed to append a buffer to the file
+    std::shared_ptr<std::atomic<bool>> m_asyncError;
 };
 
 } // namespace ns3
@@ -19,6 +19,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/enum.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
@@ -233,4 +234,21 @@ QueueBase::WouldOverflow(uint32_t nPackets, uint32_t nBytes) const
     }
 }
 
+uint32_t
+GetNQueuedPackets(const Packet* item)
+{
+    SegmentationOffloadTag tsoTag;
+    if (item->PeekPacketTag(tsoTag))
+    {
+        return tsoTag.GetNSegments();
+    }
+    return 1;
+}
+
+uint32_t
+GetNQueuedPackets(const QueueDiscItem* item)
+{
+    return GetNQueuedPackets(PeekPointer(item->GetPacket()));
+}
+
 } // namespace ns3
@@ -228,6 +228,41 @@ class QueueBase : public Object
     QueueSize m_maxSize; //!< max queue size
 };
 
+/**
+ * \ingroup queue
+ * \brief Get the number of packets an object stored in a queue stands for
+ *
+ * A TSO super-segment (see SegmentationOffloadTag) stands for the segments it
+ * is split into on the wire, so that the occupancy of a queue whose size is
+ * measured in packets does not depend on whether segmentation offload is
+ * emulated. Any other packet stands for a single packet.
+ *
+ * \param item the object stored in the queue
+ * \return the number of packets the object stands for
+ */
+uint32_t GetNQueuedPackets(const Packet* item);
+
+/**
+ * \ingroup queue
+ * \copydoc GetNQueuedPackets(const Packet*)
+ */
+uint32_t GetNQueuedPackets(const QueueDiscItem* item);
+
+/**
+ * \ingroup queue
+ * \brief Get the number of packets an object stored in a queue stands for
+ *
+ * Objects other than packets and queue disc items stand for a single packet.
+ *
+ * \param item the object stored in the queue
+ * \return 1
+ */
+inline uint32_t
+GetNQueuedPackets(const void* item)
+{
+    return 1;
+}
+
 /**
  * \ingroup queue
  * \brief Template class for packet Queues
@@ -252,6 +287,11 @@ class QueueBase : public Object
  * returns the object stored within the queue that is included in the container
  * element pointed to by a given const iterator.
  *
+ * The number of packets in the queue counts each object as the number of
+ * packets it stands for (see GetNQueuedPackets), while an object is admitted
+ * as long as the queue can hold one more packet. Hence, the number of packets
+ * in the queue may exceed the maximum size by less than a TSO super-segment.
+ *
  * Users of the Queue template class usually hold a queue through a smart pointer,
  * hence forward declaration is recommended to avoid pulling the implementation
  * of the templates included in this file. Thus, include queue-fwd.h, which
@@ -532,8 +572,9 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
     m_nBytes += size;
     m_nTotalReceivedBytes += size;
 
-    m_nPackets++;
-    m_nTotalReceivedPackets++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_nPackets += nPackets;
+    m_nTotalReceivedPackets += nPackets;
 
     NS_LOG_LOGIC("m_traceEnqueue (p)");
     m_traceEnqueue(item);
@@ -558,11 +599,12 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
     if (item)
     {
         m_packets.erase(pos);
+        uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
         NS_ASSERT(m_nBytes.Get() >= item->GetSize());
-        NS_ASSERT(m_nPackets.Get() > 0);
+        NS_ASSERT(m_nPackets.Get() >= nPackets);
 
         m_nBytes -= item->GetSize();
-        m_nPackets--;
+        m_nPackets -= nPackets;
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
         m_traceDequeue(item);
@@ -587,11 +629,12 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
     if (item)
     {
         m_packets.erase(pos);
+        uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
         NS_ASSERT(m_nBytes.Get() >= item->GetSize());
-        NS_ASSERT(m_nPackets.Get() > 0);
+        NS_ASSERT(m_nPackets.Get() >= nPackets);
 
         m_nBytes -= item->GetSize();
-        m_nPackets--;
+        m_nPackets -= nPackets;
 
         // packets are first dequeued and then dropped
         NS_LOG_LOGIC("m_traceDequeue (p)");
@@ -643,8 +686,9 @@ Queue<Item, Container>::DropBeforeEnqueue(Ptr<Item> item)
 {
     NS_LOG_FUNCTION(this << item);
 
-    m_nTotalDroppedPackets++;
-    m_nTotalDroppedPacketsBeforeEnqueue++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_nTotalDroppedPackets += nPackets;
+    m_nTotalDroppedPacketsBeforeEnqueue += nPackets;
     m_nTotalDroppedBytes += item->GetSize();
     m_nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
@@ -659,8 +703,9 @@ Queue<Item, Container>::DropAfterDequeue(Ptr<Item> item)
 {
     NS_LOG_FUNCTION(this << item);
 
-    m_nTotalDroppedPackets++;
-    m_nTotalDroppedPacketsAfterDequeue++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_nTotalDroppedPackets += nPackets;
+    m_nTotalDroppedPacketsAfterDequeue += nPackets;
     m_nTotalDroppedBytes += item->GetSize();
     m_nTotalDroppedBytesAfterDequeue += item->GetSize();
 
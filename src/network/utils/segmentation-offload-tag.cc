@@ -0,0 +1,144 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "segmentation-offload-tag.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SegmentationOffloadTag");
+
+NS_OBJECT_ENSURE_REGISTERED(SegmentationOffloadTag);
+
+TypeId
+SegmentationOffloadTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SegmentationOffloadTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<SegmentationOffloadTag>();
+    return tid;
+}
+
+TypeId
+SegmentationOffloadTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+SegmentationOffloadTag::GetSerializedSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return 12;
+}
+
+void
+SegmentationOffloadTag::Serialize(TagBuffer buf) const
+{
+    NS_LOG_FUNCTION(this << &buf);
+    buf.WriteU32(m_segmentSize);
+    buf.WriteU32(m_headerSize);
+    buf.WriteU32(m_nSegments);
+}
+
+void
+SegmentationOffloadTag::Deserialize(TagBuffer buf)
+{
+    NS_LOG_FUNCTION(this << &buf);
+    m_segmentSize = buf.ReadU32();
+    m_headerSize = buf.ReadU32();
+    m_nSegments = buf.ReadU32();
+}
+
+void
+SegmentationOffloadTag::Print(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this << &os);
+    os << "SegmentSize=" << m_segmentSize << " HeaderSize=" << m_headerSize
+       << " NSegments=" << m_nSegments;
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag()
+    : Tag(),
+      m_segmentSize(0),
+      m_headerSize(0),
+      m_nSegments(1)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag(uint32_t segmentSize,
+                                               uint32_t headerSize,
+                                               uint32_t nSegments)
+    : Tag(),
+      m_segmentSize(segmentSize),
+      m_headerSize(headerSize),
+      m_nSegments(nSegments)
+{
+    NS_LOG_FUNCTION(this << segmentSize << headerSize << nSegments);
+}
+
+void
+SegmentationOffloadTag::SetSegmentSize(uint32_t segmentSize)
+{
+    NS_LOG_FUNCTION(this << segmentSize);
+    m_segmentSize = segmentSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_segmentSize;
+}
+
+void
+SegmentationOffloadTag::SetHeaderSize(uint32_t headerSize)
+{
+    NS_LOG_FUNCTION(this << headerSize);
+    m_headerSize = headerSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetHeaderSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_headerSize;
+}
+
+void
+SegmentationOffloadTag::SetNSegments(uint32_t nSegments)
+{
+    NS_LOG_FUNCTION(this << nSegments);
+    m_nSegments = nSegments;
+}
+
+uint32_t
+SegmentationOffloadTag::GetNSegments() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_nSegments;
+}
+
+uint32_t
+SegmentationOffloadTag::GetWireSize(uint32_t frameSize, uint32_t framingSize) const
+{
+    NS_LOG_FUNCTION(this << frameSize << framingSize);
+    return frameSize + (m_nSegments - 1) * (m_headerSize + framingSize);
+}
+
+} // namespace ns3
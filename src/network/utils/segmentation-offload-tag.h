@@ -0,0 +1,113 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Mark a packet as a super-segment handed to the device for
+ * segmentation offload (TSO).
+ *
+ * A transport protocol emulating TSO sends a single packet carrying the
+ * payload of several segments, tagged with the payload size of a segment on
+ * the wire and the size of the headers repeated in each of them. The packet
+ * is not fragmented by the IP layer; devices supporting the tag transmit it
+ * in one go, but occupy the channel for the time the individual wire packets
+ * would have taken, including their replicated headers and framing.
+ * Queues count the packet as the segments it stands for (see
+ * GetNQueuedPackets), and the receiving transport protocol removes the tag.
+ *
+ * Devices that do not look for the tag transmit the packet as a single
+ * (jumbo) frame.
+ */
+class SegmentationOffloadTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+    SegmentationOffloadTag();
+
+    /**
+     * Constructs a SegmentationOffloadTag
+     *
+     * \param segmentSize payload size of each segment on the wire
+     * \param headerSize size of the headers repeated in each segment
+     * \param nSegments number of segments on the wire
+     */
+    SegmentationOffloadTag(uint32_t segmentSize, uint32_t headerSize, uint32_t nSegments);
+    /**
+     * Sets the payload size of each segment on the wire
+     * \param segmentSize the segment size
+     */
+    void SetSegmentSize(uint32_t segmentSize);
+    /**
+     * Gets the payload size of each segment on the wire
+     * \returns the segment size
+     */
+    uint32_t GetSegmentSize() const;
+    /**
+     * Sets the size of the (network and transport) headers repeated in each segment
+     * \param headerSize the header size
+     */
+    void SetHeaderSize(uint32_t headerSize);
+    /**
+     * Gets the size of the (network and transport) headers repeated in each segment
+     * \returns the header size
+     */
+    uint32_t GetHeaderSize() const;
+    /**
+     * Sets the number of segments on the wire
+     * \param nSegments the number of segments
+     */
+    void SetNSegments(uint32_t nSegments);
+    /**
+     * Gets the number of segments on the wire
+     * \returns the number of segments
+     */
+    uint32_t GetNSegments() const;
+    /**
+     * Get the number of bytes the wire packets of a frame take on the link
+     *
+     * \param frameSize the size of the frame, including the headers and the
+     *        link framing once
+     * \param framingSize the link framing (headers and trailers) of each frame
+     * \returns the frame size plus the headers and the framing of every
+     *          wire packet but the first
+     */
+    uint32_t GetWireSize(uint32_t frameSize, uint32_t framingSize) const;
+
+  private:
+    uint32_t m_segmentSize; //!< Payload size of each segment on the wire
+    uint32_t m_headerSize;  //!< Size of the headers repeated in each segment
+    uint32_t m_nSegments;   //!< Number of segments on the wire
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
@@ -462,7 +462,9 @@ SimpleNetDevice::SendFrom(Ptr<Packet> p,
 
     if (m_queue->Enqueue(p))
     {
-        if (m_queue->GetNPackets() == 1 && !FinishTransmissionEvent.IsRunning())
+        // The queue is empty while no transmission is in progress. Do not test
+        // the number of packets, as a TSO super-segment counts as several
+        if (!FinishTransmissionEvent.IsRunning())
         {
             StartTransmission();
         }
@@ -169,6 +169,7 @@ main(int argc, char* argv[])
     int nCN = 2;
     int nLANClients = 42;
     bool nix = true;
+    bool precompute = false;
     bool useIpv6 = false;
 
     CommandLine cmd(__FILE__);
@@ -176,6 +177,7 @@ main(int argc, char* argv[])
     cmd.AddValue("CN", "Number of total CNs [2]", nCN);
     cmd.AddValue("LAN", "Number of nodes per LAN [42]", nLANClients);
     cmd.AddValue("NIX", "Toggle nix-vector routing", nix);
+    cmd.AddValue("precompute", "Precompute all the nix-vectors before the simulation", precompute);
     cmd.Parse(argc, argv);
 
     if (useIpv6 && !nix)
@@ -710,6 +712,18 @@ main(int argc, char* argv[])
     {
         // Calculate routing tables
         std::cout << "Using Nix-vectors..." << std::endl;
+        if (precompute)
+        {
+            std::cout << "Precomputing Nix-vectors..." << std::endl;
+            if (!useIpv6)
+            {
+                Ipv4NixVectorHelper::PrecomputeNixVectors(NodeContainer::GetGlobal());
+            }
+            else
+            {
+                Ipv6NixVectorHelper::PrecomputeNixVectors(NodeContainer::GetGlobal());
+            }
+        }
     }
     else
     {
@@ -98,6 +98,26 @@ NixVectorHelper<T>::PrintRoute(Ptr<Node> source,
     rp->PrintRoutingPath(source, dest, stream, unit);
 }
 
+template <typename T>
+void
+NixVectorHelper<T>::PrecomputeNixVectors(NodeContainer nodes)
+{
+    for (auto i = nodes.Begin(); i != nodes.End(); i++)
+    {
+        Ptr<Ip> ip = (*i)->GetObject<Ip>();
+        if (!ip)
+        {
+            continue;
+        }
+        Ptr<NixVectorRouting<IpRoutingProtocol>> rp =
+            T::template GetRouting<NixVectorRouting<IpRoutingProtocol>>(ip->GetRoutingProtocol());
+        if (rp)
+        {
+            rp->PrecomputeNixCache();
+        }
+    }
+}
+
 template class NixVectorHelper<Ipv4RoutingHelper>;
 template class NixVectorHelper<Ipv6RoutingHelper>;
 
@@ -27,6 +27,7 @@
 
 #include "ns3/ipv4-routing-helper.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/node-container.h"
 #include "ns3/object-factory.h"
 
 namespace ns3
@@ -115,6 +116,19 @@ class NixVectorHelper : public std::enable_if_t<std::is_same_v<Ipv4RoutingHelper
                             Ptr<OutputStreamWrapper> stream,
                             Time::Unit unit = Time::S);
 
+    /**
+     * \brief precompute the nix-vectors from the given nodes to all the
+     * destinations of the topology.
+     * \param nodes the source nodes
+     *
+     * This method calls the PrecomputeNixCache() method of the
+     * NixVectorRouting of each node.  It is meant to be called once the
+     * topology is built and the addresses are assigned, before
+     * Simulator::Run (), so that no route is computed during the simulation
+     * of a static topology.
+     */
+    static void PrecomputeNixVectors(NodeContainer nodes);
+
   private:
     ObjectFactory m_agentFactory; //!< Object factory
 
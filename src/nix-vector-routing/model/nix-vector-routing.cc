@@ -29,7 +29,9 @@
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <queue>
 
@@ -71,13 +73,23 @@ NixVectorRouting<T>::GetTypeId()
     static TypeId tid = TypeId(("ns3::" + name + "NixVectorRouting"))
                             .SetParent<T>()
                             .SetGroupName("NixVectorRouting")
-                            .template AddConstructor<NixVectorRouting<T>>();
+                            .template AddConstructor<NixVectorRouting<T>>()
+                            .AddAttribute("MaxCacheSize",
+                                          "Maximum number of destinations in each of the "
+                                          "nix-vector and route caches of the node; the least "
+                                          "recently used destination is evicted first "
+                                          "(0 means no limit).",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &NixVectorRouting<T>::m_maxCacheSize),
+                                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting()
-    : m_totalNeighbors(0)
+    : m_maxCacheSize(0),
+      m_totalNeighbors(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -132,6 +144,7 @@ NixVectorRouting<T>::DoDispose()
 
     m_node = nullptr;
     m_ip = nullptr;
+    m_bfsTree.clear();
 
     T::DoDispose();
 }
@@ -177,6 +190,8 @@ NixVectorRouting<T>::FlushNixCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
     m_nixCache.clear();
+    m_nixCacheLru.clear();
+    m_bfsTree.clear();
 }
 
 template <typename T>
@@ -185,6 +200,40 @@ NixVectorRouting<T>::FlushIpRouteCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
     m_ipRouteCache.clear();
+    m_ipRouteCacheLru.clear();
+}
+
+template <typename T>
+template <typename V>
+void
+NixVectorRouting<T>::CacheTouch(CacheLru_t& lru, CacheEntry<V>& entry) const
+{
+    lru.splice(lru.begin(), lru, entry.lru);
+}
+
+template <typename T>
+template <typename V>
+void
+NixVectorRouting<T>::CacheInsert(std::map<IpAddress, CacheEntry<V>>& cache,
+                                 CacheLru_t& lru,
+                                 const IpAddress& address,
+                                 V value) const
+{
+    auto iter = cache.find(address);
+    if (iter != cache.end())
+    {
+        iter->second.value = value;
+        CacheTouch(lru, iter->second);
+        return;
+    }
+    if (m_maxCacheSize > 0 && cache.size() >= m_maxCacheSize)
+    {
+        NS_LOG_LOGIC("Cache full, evicting " << lru.back());
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+    lru.push_front(address);
+    cache.insert(std::make_pair(address, CacheEntry<V>{value, lru.begin()}));
 }
 
 template <typename T>
@@ -219,10 +268,29 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
         // otherwise proceed as normal
         // and build the nix vector
         std::vector<Ptr<Node>> parentVector;
+        const std::vector<Ptr<Node>>* tree = &parentVector;
+        bool found;
 
-        if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
+        if (source == m_node && !oif)
         {
-            if (BuildNixVector(parentVector, source->GetId(), destNode->GetId(), nixVector))
+            // the BFS tree of this node does not depend on the
+            // destination: build it once, and reuse it until the
+            // next topology change
+            if (m_bfsTree.size() != NodeList::GetNNodes())
+            {
+                BFS(NodeList::GetNNodes(), source, nullptr, m_bfsTree, nullptr);
+            }
+            tree = &m_bfsTree;
+            found = m_bfsTree.at(destNode->GetId()) != nullptr;
+        }
+        else
+        {
+            found = BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif);
+        }
+
+        if (found)
+        {
+            if (BuildNixVector(*tree, source->GetId(), destNode->GetId(), nixVector))
             {
                 return nixVector;
             }
@@ -253,7 +321,8 @@ NixVectorRouting<T>::GetNixVectorInCache(const IpAddress& address, bool& foundIn
     {
         NS_LOG_LOGIC("Found Nix-vector in cache.");
         foundInCache = true;
-        return iter->second;
+        CacheTouch(m_nixCacheLru, iter->second);
+        return iter->second.value;
     }
 
     // not in cache
@@ -273,7 +342,8 @@ NixVectorRouting<T>::GetIpRouteInCache(IpAddress address)
     if (iter != m_ipRouteCache.end())
     {
         NS_LOG_LOGIC("Found IpRoute in cache.");
-        return iter->second;
+        CacheTouch(m_ipRouteCacheLru, iter->second);
+        return iter->second.value;
     }
 
     // not in cache
@@ -764,7 +834,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         if (nixVectorInCache)
         {
             // cache it
-            m_nixCache.insert(typename NixMap_t::value_type(destAddress, nixVectorInCache));
+            CacheInsert(m_nixCache, m_nixCacheLru, destAddress, nixVectorInCache);
         }
     }
 
@@ -796,14 +866,8 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         if (!rtentry || !(rtentry->GetOutputDevice() == oif))
         {
             // not in cache or a different specified output
-            // device is to be used
-
-            // first, make sure we erase existing (incorrect)
-            // rtentry from the map
-            if (rtentry)
-            {
-                m_ipRouteCache.erase(destAddress);
-            }
+            // device is to be used; an existing (incorrect)
+            // rtentry is replaced in the map below
 
             NS_LOG_LOGIC("IpRoute not in cache, build: ");
             IpAddress gatewayIp;
@@ -842,7 +906,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             sockerr = Socket::ERROR_NOTERROR;
 
             // add rtentry to cache
-            m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+            CacheInsert(m_ipRouteCache, m_ipRouteCacheLru, destAddress, rtentry);
         }
 
         NS_LOG_LOGIC("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: "
@@ -975,7 +1039,7 @@ NixVectorRouting<T>::RouteInput(Ptr<const Packet> p,
         rtentry->SetOutputDevice(m_ip->GetNetDevice(interfaceIndex));
 
         // add rtentry to cache
-        m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+        CacheInsert(m_ipRouteCache, m_ipRouteCacheLru, destAddress, rtentry);
     }
 
     NS_LOG_LOGIC("At Node " << m_node->GetId() << ", Extracting " << numberOfBits
@@ -1027,9 +1091,9 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
             std::ostringstream dest;
             dest << it->first;
             *os << std::setw(30) << dest.str();
-            if (it->second)
+            if (it->second.value)
             {
-                *os << *(it->second) << std::endl;
+                *os << *(it->second.value) << std::endl;
             }
             else
             {
@@ -1052,20 +1116,20 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
             std::ostringstream dest;
             std::ostringstream gw;
             std::ostringstream src;
-            dest << it->second->GetDestination();
+            dest << it->second.value->GetDestination();
             *os << std::setw(30) << dest.str();
-            gw << it->second->GetGateway();
+            gw << it->second.value->GetGateway();
             *os << std::setw(30) << gw.str();
-            src << it->second->GetSource();
+            src << it->second.value->GetSource();
             *os << std::setw(30) << src.str();
             *os << "  ";
-            if (Names::FindName(it->second->GetOutputDevice()) != "")
+            if (Names::FindName(it->second.value->GetOutputDevice()) != "")
             {
-                *os << Names::FindName(it->second->GetOutputDevice());
+                *os << Names::FindName(it->second.value->GetOutputDevice());
             }
             else
             {
-                *os << it->second->GetOutputDevice()->GetIfIndex();
+                *os << it->second.value->GetOutputDevice()->GetIfIndex();
             }
             *os << std::endl;
         }
@@ -1136,7 +1200,14 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
 {
     NS_LOG_FUNCTION(this << numberOfNodes << source << dest << parentVector << oif);
 
-    NS_LOG_LOGIC("Going from Node " << source->GetId() << " to Node " << dest->GetId());
+    if (dest)
+    {
+        NS_LOG_LOGIC("Going from Node " << source->GetId() << " to Node " << dest->GetId());
+    }
+    else
+    {
+        NS_LOG_LOGIC("Building the BFS tree of Node " << source->GetId());
+    }
     std::queue<Ptr<Node>> greyNodeList; // discovered nodes with unexplored children
 
     // reset the parent vector
@@ -1287,8 +1358,8 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
         greyNodeList.pop();
     }
 
-    // Didn't find the dest...
-    return false;
+    // Didn't find the dest, or explored all the nodes
+    return !dest;
 }
 
 template <typename T>
@@ -1426,6 +1497,53 @@ NixVectorRouting<T>::PrintRoutingPath(Ptr<Node> source,
     (*os).copyfmt(oldState);
 }
 
+template <typename T>
+void
+NixVectorRouting<T>::PrecomputeNixCache() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_node, "The node of the routing protocol is not set");
+
+    CheckCacheStateAndFlush();
+
+    if (g_ipAddressToNodeMap.empty())
+    {
+        BuildIpAddressToNodeMap();
+    }
+
+    // sort the destinations, to precompute the same ones at each run
+    // when the cache size is bounded
+    std::vector<IpAddress> destinations;
+    destinations.reserve(g_ipAddressToNodeMap.size());
+    for (const auto& entry : g_ipAddressToNodeMap)
+    {
+        if (entry.second != m_node)
+        {
+            destinations.push_back(entry.first);
+        }
+    }
+    std::sort(destinations.begin(), destinations.end());
+
+    for (const auto& dest : destinations)
+    {
+        if (m_maxCacheSize > 0 && m_nixCache.size() >= m_maxCacheSize)
+        {
+            break;
+        }
+        if (m_nixCache.find(dest) != m_nixCache.end())
+        {
+            continue;
+        }
+        Ptr<NixVector> nixVector = GetNixVector(m_node, dest, nullptr);
+        if (nixVector)
+        {
+            CacheInsert(m_nixCache, m_nixCacheLru, dest, nixVector);
+        }
+    }
+    NS_LOG_LOGIC("Precomputed " << m_nixCache.size() << " nix-vectors for node "
+                                << m_node->GetId());
+}
+
 template <typename T>
 void
 NixVectorRouting<T>::CheckCacheStateAndFlush() const
@@ -1443,6 +1561,8 @@ template void NixVectorRouting<Ipv4RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv6RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv4RoutingProtocol>::FlushGlobalNixRoutingCache() const;
 template void NixVectorRouting<Ipv6RoutingProtocol>::FlushGlobalNixRoutingCache() const;
+template void NixVectorRouting<Ipv4RoutingProtocol>::PrecomputeNixCache() const;
+template void NixVectorRouting<Ipv6RoutingProtocol>::PrecomputeNixCache() const;
 template void NixVectorRouting<Ipv4RoutingProtocol>::PrintRoutingPath(
     Ptr<Node> source,
     IpAddress dest,
@@ -41,6 +41,7 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
+#include <list>
 #include <map>
 #include <unordered_map>
 
@@ -142,6 +143,18 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                           Ptr<OutputStreamWrapper> stream,
                           Time::Unit unit) const;
 
+    /**
+     * @brief Build the nix-vectors from this node to all the known
+     * destinations, and store them in the nix-vector cache.
+     *
+     * This is meant to be called before Simulator::Run () for static
+     * topologies, to move the route computation out of the simulation.
+     * A single breadth first search is done for all the destinations.
+     * If the cache size is bounded (see the MaxCacheSize attribute), only
+     * the first destinations, up to the bound, are precomputed.
+     */
+    void PrecomputeNixCache() const;
+
   private:
     /**
      * Flushes the cache which stores nix-vector based on
@@ -258,9 +271,13 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
 
     /**
      * \brief Breadth first search algorithm.
+     *
+     * If dest is null, the search covers all the nodes reachable from the
+     * source, and parentVector is the whole BFS tree of the source.
+     *
      * \param [in] numberOfNodes total number of nodes
      * \param [in] source Source Node
-     * \param [in] dest Destination Node
+     * \param [in] dest Destination Node, or null to search all the nodes
      * \param [out] parentVector Parent vector for retracing routes
      * \param [in] oif specific output interface to use from source node, if not null
      * \returns false if dest not found, true o.w.
@@ -283,10 +300,45 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void DoDispose();
 
+    /// Destinations of a cache, from the most to the least recently used
+    typedef std::list<IpAddress> CacheLru_t;
+
+    /**
+     * Entry of the nix-vector and IpRoute caches
+     */
+    template <typename V>
+    struct CacheEntry
+    {
+        V value;                           //!< cached value
+        typename CacheLru_t::iterator lru; //!< position of the entry in the LRU list
+    };
+
     /// Map of IpAddress to NixVector
-    typedef std::map<IpAddress, Ptr<NixVector>> NixMap_t;
+    typedef std::map<IpAddress, CacheEntry<Ptr<NixVector>>> NixMap_t;
     /// Map of IpAddress to IpRoute
-    typedef std::map<IpAddress, Ptr<IpRoute>> IpRouteMap_t;
+    typedef std::map<IpAddress, CacheEntry<Ptr<IpRoute>>> IpRouteMap_t;
+
+    /**
+     * Mark a cache entry as the most recently used one
+     * \param lru the LRU list of the cache
+     * \param entry the entry
+     */
+    template <typename V>
+    void CacheTouch(CacheLru_t& lru, CacheEntry<V>& entry) const;
+
+    /**
+     * Add or replace an entry of a cache, evicting the least recently used
+     * entry if the cache is full
+     * \param cache the cache
+     * \param lru the LRU list of the cache
+     * \param address the destination address
+     * \param value the value to cache
+     */
+    template <typename V>
+    void CacheInsert(std::map<IpAddress, CacheEntry<V>>& cache,
+                     CacheLru_t& lru,
+                     const IpAddress& address,
+                     V value) const;
 
     /// Callback for IPv4 unicast packets to be forwarded
     typedef Callback<void, Ptr<IpRoute>, Ptr<const Packet>, const IpHeader&>
@@ -497,6 +549,18 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     /** Cache stores IpRoutes based on destination ip */
     mutable IpRouteMap_t m_ipRouteCache;
 
+    mutable CacheLru_t m_nixCacheLru;     //!< LRU order of m_nixCache
+    mutable CacheLru_t m_ipRouteCacheLru; //!< LRU order of m_ipRouteCache
+
+    /** Maximum number of entries of each cache, 0 for no limit */
+    uint32_t m_maxCacheSize;
+
+    /**
+     * BFS tree rooted at this node, computed once and used to build the
+     * nix-vectors to all the destinations; empty if not computed yet.
+     */
+    mutable std::vector<Ptr<Node>> m_bfsTree;
+
     Ptr<Ip> m_ip;     //!< IP object
     Ptr<Node> m_node; //!< Node object
 
@@ -25,6 +25,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-routing.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -32,6 +33,7 @@
 #include "ns3/test.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -393,6 +395,145 @@ NixVectorRoutingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * The topology is of the form:
+ * \verbatim
+    n0 -- n1 -- n2 -- n3
+   \endverbatim
+ *
+ * Following are the tests in this test case:
+ * - Test that the nix-vectors to all the destinations are precomputed.
+ * - Test that the precomputation stops at the cache size bound.
+ * - Test the routing to a destination which is not precomputed, and that
+ *   the least recently used destination is evicted from the cache.
+ *
+ * \brief IPv4 Nix-Vector Routing cache test
+ */
+class NixVectorRoutingCacheTest : public TestCase
+{
+    uint32_t m_receivedPackets; //!< Number of received packets
+
+    /**
+     * \brief Receive data.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    /**
+     * \brief Get the destinations of the nix-vector cache of a node.
+     * \param node The node.
+     * \returns The printed destinations.
+     */
+    std::string GetNixCache(Ptr<Node> node);
+
+  public:
+    void DoRun() override;
+    NixVectorRoutingCacheTest();
+};
+
+NixVectorRoutingCacheTest::NixVectorRoutingCacheTest()
+    : TestCase("nix-vector cache precomputation and size bound test"),
+      m_receivedPackets(0)
+{
+}
+
+void
+NixVectorRoutingCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_receivedPackets++;
+    }
+}
+
+std::string
+NixVectorRoutingCacheTest::GetNixCache(Ptr<Node> node)
+{
+    std::ostringstream stringStream;
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&stringStream);
+    node->GetObject<Ipv4>()->GetRoutingProtocol()->PrintRoutingTable(stream);
+
+    // keep the destinations of the nix-vector cache only
+    std::string table = stringStream.str();
+    std::size_t begin = table.find("NixCache:");
+    std::size_t end = table.find("IpRouteCache:");
+    std::istringstream lines(table.substr(begin, end - begin));
+    std::string line;
+    std::string destinations;
+    while (std::getline(lines, line))
+    {
+        if (line.rfind("10.", 0) == 0)
+        {
+            destinations += line.substr(0, line.find(' ')) + " ";
+        }
+    }
+    return destinations;
+}
+
+void
+NixVectorRoutingCacheTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(4);
+
+    Ipv4NixVectorHelper ipv4NixRouting;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(ipv4NixRouting);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        address.Assign(devHelper.Install(NodeContainer(nodes.Get(i), nodes.Get(i + 1))));
+        address.NewNetwork();
+    }
+
+    Ptr<Ipv4NixVectorRouting> routing3 = nodes.Get(3)->GetObject<Ipv4NixVectorRouting>();
+    routing3->SetAttribute("MaxCacheSize", UintegerValue(2));
+
+    Ipv4NixVectorHelper::PrecomputeNixVectors(nodes);
+
+    NS_TEST_EXPECT_MSG_EQ(GetNixCache(nodes.Get(0)),
+                          "10.1.0.2 10.1.1.1 10.1.1.2 10.1.2.1 10.1.2.2 ",
+                          "The nix-vectors to all the destinations should be precomputed.");
+    NS_TEST_EXPECT_MSG_EQ(GetNixCache(nodes.Get(3)),
+                          "10.1.0.1 10.1.0.2 ",
+                          "The precomputation should stop at the cache size bound.");
+
+    Ptr<Socket> rxSocket = nodes.Get(1)->GetObject<UdpSocketFactory>()->CreateSocket();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address("10.1.1.1"), 1234)),
+                          0,
+                          "trivial");
+    rxSocket->SetRecvCallback(MakeCallback(&NixVectorRoutingCacheTest::ReceivePkt, this));
+
+    Ptr<Socket> txSocket = nodes.Get(3)->GetObject<UdpSocketFactory>()->CreateSocket();
+    Simulator::ScheduleWithContext(nodes.Get(3)->GetId(),
+                                   Seconds(1),
+                                   [txSocket]() {
+                                       txSocket->SendTo(
+                                           Create<Packet>(123),
+                                           0,
+                                           InetSocketAddress(Ipv4Address("10.1.1.1"), 1234));
+                                   });
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPackets, 1, "The packet should be routed.");
+    NS_TEST_EXPECT_MSG_EQ(GetNixCache(nodes.Get(3)),
+                          "10.1.0.2 10.1.1.1 ",
+                          "The least recently used destination should be evicted.");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup nix-vector-routing-test
  * \ingroup tests
@@ -406,6 +547,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::QUICK);
+        AddTestCase(new NixVectorRoutingCacheTest(), TestCase::QUICK);
     }
 };
 
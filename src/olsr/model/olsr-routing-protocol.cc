@@ -29,7 +29,7 @@
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (GetObject<Node>())                                                                         \
     {                                                                                              \
-        std::clog << "[node " << GetObject<Node>()->GetId() << "] ";                               \
+        LogGetContextStream() << "[node " << GetObject<Node>()->GetId() << "] ";                   \
     }
 
 #include "olsr-routing-protocol.h"
@@ -22,6 +22,7 @@
 #include <sstream>
 
 // ns3 includes
+#include "ns3/channel-list.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/ipv6-address-generator.h"
 #include "ns3/log.h"
@@ -46,6 +47,7 @@ PointToPointDumbbellHelper::PointToPointDumbbellHelper(uint32_t nLeftLeaf,
     // Create the leaf nodes
     m_leftLeaf.Create(nLeftLeaf);
     m_rightLeaf.Create(nRightLeaf);
+    ChannelList::Reserve(1 + nLeftLeaf + nRightLeaf);
 
     // Add the link connecting routers
     m_routerDevices = bottleneckHelper.Install(m_routers);
@@ -19,10 +19,12 @@
 
 #include "ns3/point-to-point-grid.h"
 
+#include "ns3/channel-list.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv6-address-generator.h"
 #include "ns3/log.h"
+#include "ns3/node-list.h"
 #include "ns3/point-to-point-helper.h"
 #include "ns3/string.h"
 #include "ns3/vector.h"
@@ -46,6 +48,8 @@ PointToPointGridHelper::PointToPointGridHelper(uint32_t nRows,
 
     InternetStackHelper stack;
 
+    NodeList::Reserve(nRows * nCols);
+    ChannelList::Reserve(nRows * (nCols - 1) + (nRows - 1) * nCols);
     for (uint32_t y = 0; y < nRows; ++y)
     {
         NodeContainer rowNodes;
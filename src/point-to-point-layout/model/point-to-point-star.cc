@@ -20,6 +20,7 @@
 #include <sstream>
 
 // ns3 includes
+#include "ns3/channel-list.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/ipv6-address-generator.h"
 #include "ns3/log.h"
@@ -37,6 +38,7 @@ PointToPointStarHelper::PointToPointStarHelper(uint32_t numSpokes, PointToPointH
 {
     m_hub.Create(1);
     m_spokes.Create(numSpokes);
+    ChannelList::Reserve(numSpokes);
 
     for (uint32_t i = 0; i < m_spokes.GetN(); ++i)
     {
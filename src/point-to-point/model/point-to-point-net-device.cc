@@ -26,6 +26,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -250,6 +251,19 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_phyTxBeginTrace(m_currentPkt);
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    SegmentationOffloadTag tsoTag;
+    if (p->PeekPacketTag(tsoTag))
+    {
+        //
+        // A TSO super-segment occupies the wire for as long as the packets it
+        // would have been split into, each with its own headers and separated by
+        // an interframe gap. It is delivered as a whole when the last one ends.
+        //
+        uint32_t framingSize = PppHeader().GetSerializedSize();
+        uint32_t nSegments = tsoTag.GetNSegments();
+        txTime = m_bps.CalculateBytesTxTime(tsoTag.GetWireSize(p->GetSize(), framingSize)) +
+                 m_tInterframeGap * (nSegments - 1);
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -526,6 +540,28 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
         return false;
     }
 
+    return DoSend(packet, protocolNumber);
+}
+
+bool
+PointToPointNetDevice::CheckSendBatch()
+{
+    NS_LOG_FUNCTION(this);
+    return IsLinkUp();
+}
+
+void
+PointToPointNetDevice::DoSendBatchItem(const BatchItem& item)
+{
+    NS_LOG_FUNCTION(this << item.packet << item.protocolNumber);
+    DoSend(item.packet, item.protocolNumber);
+}
+
+bool
+PointToPointNetDevice::DoSend(Ptr<Packet> packet, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << packet << protocolNumber);
+
     //
     // Stick a point to point protocol header on the packet in preparation for
     // shoving it out the door.
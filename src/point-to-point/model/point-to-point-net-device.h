@@ -206,6 +206,9 @@ class PointToPointNetDevice : public NetDevice
      */
     void DoMpiReceive(Ptr<Packet> p);
 
+    bool CheckSendBatch() override;
+    void DoSendBatchItem(const BatchItem& item) override;
+
   private:
     /**
      * \brief Dispose of the object
@@ -226,6 +229,16 @@ class PointToPointNetDevice : public NetDevice
      */
     void AddHeader(Ptr<Packet> p, uint16_t protocolNumber);
 
+    /**
+     * Add the PPP header to a packet, place it on the transmit queue and
+     * start its transmission if the device is idle. The link must be up.
+     *
+     * \param packet the packet to send
+     * \param protocolNumber protocol number
+     * \return true if the packet was enqueued, false if it was dropped
+     */
+    bool DoSend(Ptr<Packet> packet, uint16_t protocolNumber);
+
     /**
      * Removes, from a packet of data, all headers and trailers that
      * relate to the protocol implemented by the agent
@@ -17,14 +17,18 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/checkpoint.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <cstdio>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -139,6 +143,247 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test the wire timing of TSO super-segments on a PointToPoint link
+ *
+ * A packet tagged with a SegmentationOffloadTag must be delivered whole, after
+ * the time needed to transmit the wire packets it stands for, each with its own
+ * headers and PPP header.
+ */
+class PointToPointTsoTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointTsoTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send one packet to the device specified
+     *
+     * \param device NetDevice to send to.
+     * \param size Size of the packet.
+     * \param tso Whether to tag the packet as a TSO super-segment.
+     */
+    void SendOnePacket(Ptr<PointToPointNetDevice> device, uint32_t size, bool tso);
+    /**
+     * \brief Callback function which records the packet size and reception time
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    std::vector<uint32_t> m_rxSizes; //!< sizes of the received packets
+    std::vector<Time> m_rxTimes;     //!< reception times of the received packets
+};
+
+PointToPointTsoTest::PointToPointTsoTest()
+    : TestCase("PointToPoint TSO super-segment timing")
+{
+}
+
+void
+PointToPointTsoTest::SendOnePacket(Ptr<PointToPointNetDevice> device, uint32_t size, bool tso)
+{
+    Ptr<Packet> p = Create<Packet>(size);
+    if (tso)
+    {
+        // 40 bytes of headers and 4 segments of 1000 bytes
+        p->AddPacketTag(SegmentationOffloadTag(1000, 40, 4));
+    }
+    device->Send(p, device->GetBroadcast(), 0x800);
+}
+
+bool
+PointToPointTsoTest::RxPacket(Ptr<NetDevice> dev,
+                              Ptr<const Packet> pkt,
+                              uint16_t mode,
+                              const Address& sender)
+{
+    m_rxSizes.push_back(pkt->GetSize());
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointTsoTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+
+    DataRate dataRate("8Mbps");
+    devA->SetDataRate(dataRate);
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointTsoTest::RxPacket, this));
+
+    uint32_t size = 40 + 4 * 1000;
+    Simulator::Schedule(Seconds(1.0), &PointToPointTsoTest::SendOnePacket, this, devA, size, false);
+    Simulator::Schedule(Seconds(2.0), &PointToPointTsoTest::SendOnePacket, this, devA, size, true);
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes.size(), 2, "Both packets should have been received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0], size, "The plain packet should be received whole");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], size, "The super-segment should be received whole");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0],
+                          Seconds(1.0) + dataRate.CalculateBytesTxTime(size + 2),
+                          "The plain packet is sent as a single frame");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1],
+                          Seconds(2.0) + dataRate.CalculateBytesTxTime(size + 2 + 3 * (40 + 2)),
+                          "The super-segment takes the time of its 4 wire packets");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \brief Test the state of a PointToPoint link restored from a checkpoint
+ *
+ * The data rate, the delay and the queue size changed before the checkpoint
+ * must be restored, and used by the packets sent after the restore.
+ */
+class PointToPointCheckpointTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointCheckpointTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Build the nodes and the link
+     */
+    void Build();
+    /**
+     * \brief Change the attributes of the link
+     */
+    void Change();
+    /**
+     * \brief Callback function which records the reception time
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    Ptr<PointToPointNetDevice> m_devA;  //!< sending device
+    Ptr<PointToPointNetDevice> m_devB;  //!< receiving device
+    Ptr<PointToPointChannel> m_channel; //!< channel
+    std::vector<Time> m_rxTimes;        //!< reception times of the received packets
+};
+
+PointToPointCheckpointTest::PointToPointCheckpointTest()
+    : TestCase("PointToPoint link restored from a checkpoint")
+{
+}
+
+void
+PointToPointCheckpointTest::Build()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    m_devA = CreateObject<PointToPointNetDevice>();
+    m_devB = CreateObject<PointToPointNetDevice>();
+    m_channel = CreateObject<PointToPointChannel>();
+
+    m_devA->Attach(m_channel);
+    m_devA->SetAddress(Mac48Address::Allocate());
+    m_devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    m_devB->Attach(m_channel);
+    m_devB->SetAddress(Mac48Address::Allocate());
+    m_devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(m_devA);
+    b->AddDevice(m_devB);
+
+    m_devB->SetReceiveCallback(MakeCallback(&PointToPointCheckpointTest::RxPacket, this));
+}
+
+void
+PointToPointCheckpointTest::Change()
+{
+    m_devA->SetAttribute("DataRate", DataRateValue(DataRate("8Mbps")));
+    m_devA->GetQueue()->SetAttribute("MaxSize", QueueSizeValue(QueueSize("10p")));
+    m_channel->SetAttribute("Delay", TimeValue(MilliSeconds(5)));
+}
+
+bool
+PointToPointCheckpointTest::RxPacket(Ptr<NetDevice> dev,
+                                     Ptr<const Packet> pkt,
+                                     uint16_t mode,
+                                     const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointCheckpointTest::DoRun()
+{
+    std::string filename = CreateTempDirFilename("point-to-point.ckpt");
+
+    Build();
+    Simulator::Schedule(Seconds(1.0), &PointToPointCheckpointTest::Change, this);
+    Simulator::Schedule(Seconds(5.0), &Checkpoint::Save, filename);
+    Simulator::Stop(Seconds(5.0));
+    Simulator::Run();
+    Address addressA = m_devA->GetAddress();
+    Simulator::Destroy();
+
+    Build();
+    Checkpoint::Restore(filename);
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(5.0), "Wrong time restored");
+    NS_TEST_EXPECT_MSG_EQ(m_devA->GetAddress(), addressA, "Address not restored");
+    NS_TEST_EXPECT_MSG_EQ(m_devA->GetQueue()->GetMaxSize(),
+                          QueueSize("10p"),
+                          "Queue size not restored");
+
+    uint32_t size = 1000;
+    m_devA->Send(Create<Packet>(size), m_devA->GetBroadcast(), 0x800);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "The packet should have been received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0],
+                          Seconds(5.0) + DataRate("8Mbps").CalculateBytesTxTime(size + 2) +
+                              MilliSeconds(5),
+                          "The packet should use the data rate and delay restored");
+
+    Simulator::Destroy();
+    remove(filename.c_str());
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -155,6 +400,8 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::QUICK);
+    AddTestCase(new PointToPointTsoTest, TestCase::QUICK);
+    AddTestCase(new PointToPointCheckpointTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -255,6 +255,95 @@ FqCoDelQueueDiscIPFlowsSeparationAndPacketLimit::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup system-tests-tc
+ *
+ * This class tests that, when the packet limit is exceeded, packets are dropped
+ * from the fat flow created first if several flows have the same backlog, even
+ * if such flow was reactivated after the others.
+ */
+class FqCoDelQueueDiscFatFlowDrop : public TestCase
+{
+  public:
+    FqCoDelQueueDiscFatFlowDrop();
+    ~FqCoDelQueueDiscFatFlowDrop() override;
+
+  private:
+    void DoRun() override;
+    /**
+     * Enqueue a packet.
+     * \param queue The queue disc.
+     * \param hash The hash of the flow of the packet.
+     */
+    void AddPacket(Ptr<FqCoDelQueueDisc> queue, int32_t hash);
+};
+
+FqCoDelQueueDiscFatFlowDrop::FqCoDelQueueDiscFatFlowDrop()
+    : TestCase("Test the selection of the fat flow")
+{
+}
+
+FqCoDelQueueDiscFatFlowDrop::~FqCoDelQueueDiscFatFlowDrop()
+{
+}
+
+void
+FqCoDelQueueDiscFatFlowDrop::AddPacket(Ptr<FqCoDelQueueDisc> queue, int32_t hash)
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    Address dest;
+    Ipv4Header hdr;
+    hdr.SetPayloadSize(100);
+    Ptr<Ipv4QueueDiscItem> item = Create<Ipv4QueueDiscItem>(p, dest, 0, hdr);
+    g_hash = hash;
+    queue->Enqueue(item);
+}
+
+void
+FqCoDelQueueDiscFatFlowDrop::DoRun()
+{
+    Ptr<FqCoDelQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCoDelQueueDisc>("MaxSize", StringValue("4p"));
+    queueDisc->AddPacketFilter(CreateObject<Ipv4TestPacketFilter>());
+    queueDisc->SetQuantum(1500);
+    queueDisc->Initialize();
+
+    // create the flow queues 0 and 1, then make them inactive
+    AddPacket(queueDisc, 0);
+    AddPacket(queueDisc, 1);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          2,
+                          "unexpected number of flow queues");
+    queueDisc->Dequeue();
+    queueDisc->Dequeue();
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->Dequeue(), nullptr, "the queue disc should be empty");
+    NS_TEST_ASSERT_MSG_EQ(
+        StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(0))->GetStatus(),
+        FqCoDelFlow::INACTIVE,
+        "the first flow queue should be inactive");
+
+    // reactivate the flow queue 1 before the flow queue 0, with the same backlog
+    AddPacket(queueDisc, 1);
+    AddPacket(queueDisc, 1);
+    AddPacket(queueDisc, 0);
+    AddPacket(queueDisc, 0);
+
+    // exceed the packet limit, which causes one packet to be dropped from the
+    // flow queue 0 (max backlog = 240, threshold = 120)
+    AddPacket(queueDisc, 2);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->QueueDisc::GetNPackets(),
+                          4,
+                          "unexpected number of packets in the queue disc");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the flow queue");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+                          2,
+                          "unexpected number of packets in the flow queue");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup system-tests-tc
  *
@@ -1772,6 +1861,7 @@ FqCoDelQueueDiscTestSuite::FqCoDelQueueDiscTestSuite()
 {
     AddTestCase(new FqCoDelQueueDiscNoSuitableFilter, TestCase::QUICK);
     AddTestCase(new FqCoDelQueueDiscIPFlowsSeparationAndPacketLimit, TestCase::QUICK);
+    AddTestCase(new FqCoDelQueueDiscFatFlowDrop, TestCase::QUICK);
     AddTestCase(new FqCoDelQueueDiscDeficit, TestCase::QUICK);
     AddTestCase(new FqCoDelQueueDiscTCPFlowsSeparation, TestCase::QUICK);
     AddTestCase(new FqCoDelQueueDiscUDPFlowsSeparation, TestCase::QUICK);
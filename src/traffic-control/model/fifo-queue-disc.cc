@@ -96,6 +96,20 @@ FifoQueueDisc::DoDequeue()
     return item;
 }
 
+void
+FifoQueueDisc::DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << budget);
+
+    Ptr<InternalQueue> queue = GetInternalQueue(0);
+    Ptr<QueueDiscItem> item;
+    while (budget > 0 && (item = queue->Dequeue()))
+    {
+        items.push_back(item);
+        budget -= std::min(budget, item->GetSize());
+    }
+}
+
 Ptr<const QueueDiscItem>
 FifoQueueDisc::DoPeek()
 {
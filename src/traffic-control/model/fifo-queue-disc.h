@@ -55,6 +55,7 @@ class FifoQueueDisc : public QueueDisc
   private:
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
+    void DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items) override;
     Ptr<const QueueDiscItem> DoPeek() override;
     bool CheckConfig() override;
     void InitializeParams() override;
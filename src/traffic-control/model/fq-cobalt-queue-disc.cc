@@ -236,11 +236,10 @@ FqCobaltQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCobaltFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
+        if (index == FqFlowList::NONE || m_tags[i] == flowHash ||
+            StaticCast<FqCobaltFlow>(GetQueueDiscClass(index))->GetStatus() ==
                 FqCobaltFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
@@ -293,7 +292,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCobaltFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == FqFlowList::NONE)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCobaltFlow>();
@@ -313,6 +312,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         AddQueueDiscClass(flow);
 
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_backlogs.push_back(0);
     }
     else
     {
@@ -323,10 +323,11 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     {
         flow->SetStatus(FqCobaltFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(m_flowsIndices[h]);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
+    m_backlogs[m_flowsIndices[h]] = flow->GetQueueDisc()->GetNBytes();
 
     NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
 
@@ -344,6 +345,7 @@ FqCobaltQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
+    uint32_t index = 0;
     Ptr<FqCobaltFlow> flow;
     Ptr<QueueDiscItem> item;
 
@@ -351,17 +353,17 @@ FqCobaltQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            index = m_newFlows.GetFront();
+            flow = StaticCast<FqCobaltFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -370,16 +372,16 @@ FqCobaltQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            index = m_oldFlows.GetFront();
+            flow = StaticCast<FqCobaltFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_oldFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -395,20 +397,20 @@ FqCobaltQueueDisc::DoDequeue()
         }
 
         item = flow->GetQueueDisc()->Dequeue();
+        m_backlogs[index] = flow->GetQueueDisc()->GetNBytes();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqCobaltFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -484,6 +486,12 @@ FqCobaltQueueDisc::InitializeParams()
 
     m_flowFactory.SetTypeId("ns3::FqCobaltFlow");
 
+    m_flowsIndices.assign(m_flows, FqFlowList::NONE);
+    if (m_enableSetAssociativeHash)
+    {
+        m_tags.assign(m_flows, 0);
+    }
+
     m_queueDiscFactory.SetTypeId("ns3::CobaltQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("Interval", StringValue(m_interval));
@@ -503,13 +511,11 @@ FqCobaltQueueDisc::FqCobaltDrop()
     Ptr<QueueDisc> qd;
 
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    for (uint32_t i = 0; i < m_backlogs.size(); i++)
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
+        if (m_backlogs[i] > maxBacklog)
         {
-            maxBacklog = bytes;
+            maxBacklog = m_backlogs[i];
             index = i;
         }
     }
@@ -529,6 +535,7 @@ FqCobaltQueueDisc::FqCobaltDrop()
         DropAfterDequeue(item, OVERLIMIT_DROP);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
+    m_backlogs[index] = qd->GetNBytes();
 
     return index;
 }
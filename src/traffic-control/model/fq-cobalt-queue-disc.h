@@ -27,11 +27,12 @@
 #ifndef FQ_COBALT_QUEUE_DISC
 #define FQ_COBALT_QUEUE_DISC
 
+#include "fq-flow-list.h"
+
 #include "ns3/object-factory.h"
 #include "ns3/queue-disc.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -189,11 +190,12 @@ class FqCobaltQueueDisc : public QueueDisc
     double m_Pdrop;       //!< Drop Probability
     Time m_blueThreshold; //!< Threshold to enable blue enhancement
 
-    std::list<Ptr<FqCobaltFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCobaltFlow>> m_oldFlows; //!< The list of old flows
+    FqFlowList m_newFlows; //!< The list of new flows
+    FqFlowList m_oldFlows; //!< The list of old flows
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<uint32_t> m_flowsIndices; //!< Index of the class of each flow (NONE if not created)
+    std::vector<uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<uint32_t> m_backlogs;     //!< Backlog in bytes of each flow, by class index
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
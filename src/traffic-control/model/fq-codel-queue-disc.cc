@@ -210,12 +210,10 @@ FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
+        if (index == FqFlowList::NONE || m_tags[i] == flowHash ||
+            StaticCast<FqCoDelFlow>(GetQueueDiscClass(index))->GetStatus() == FqCoDelFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -267,7 +265,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == FqFlowList::NONE)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCoDelFlow>();
@@ -286,6 +284,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         AddQueueDiscClass(flow);
 
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_backlogs.push_back(0);
     }
     else
     {
@@ -296,10 +295,11 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     {
         flow->SetStatus(FqCoDelFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(m_flowsIndices[h]);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
+    m_backlogs[m_flowsIndices[h]] = flow->GetQueueDisc()->GetNBytes();
 
     NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
 
@@ -317,6 +317,7 @@ FqCoDelQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
+    uint32_t index = 0;
     Ptr<FqCoDelFlow> flow;
     Ptr<QueueDiscItem> item;
 
@@ -324,16 +325,17 @@ FqCoDelQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            index = m_newFlows.GetFront();
+            flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -342,15 +344,16 @@ FqCoDelQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            index = m_oldFlows.GetFront();
+            flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                m_oldFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -366,20 +369,20 @@ FqCoDelQueueDisc::DoDequeue()
         }
 
         item = flow->GetQueueDisc()->Dequeue();
+        m_backlogs[index] = flow->GetQueueDisc()->GetNBytes();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqCoDelFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -455,6 +458,12 @@ FqCoDelQueueDisc::InitializeParams()
 
     m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
 
+    m_flowsIndices.assign(m_flows, FqFlowList::NONE);
+    if (m_enableSetAssociativeHash)
+    {
+        m_tags.assign(m_flows, 0);
+    }
+
     m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("Interval", StringValue(m_interval));
@@ -471,13 +480,11 @@ FqCoDelQueueDisc::FqCoDelDrop()
     Ptr<QueueDisc> qd;
 
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    for (uint32_t i = 0; i < m_backlogs.size(); i++)
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
+        if (m_backlogs[i] > maxBacklog)
         {
-            maxBacklog = bytes;
+            maxBacklog = m_backlogs[i];
             index = i;
         }
     }
@@ -497,6 +504,7 @@ FqCoDelQueueDisc::FqCoDelDrop()
         DropAfterDequeue(item, OVERLIMIT_DROP);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
+    m_backlogs[index] = qd->GetNBytes();
 
     return index;
 }
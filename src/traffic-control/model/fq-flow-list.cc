@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Pasquale Imputato <p.imputato@gmail.com>
+ *          Stefano Avallone <stefano.avallone@unina.it>
+ */
+
+#include "fq-flow-list.h"
+
+#include "ns3/assert.h"
+
+namespace ns3
+{
+
+FqFlowList::FqFlowList()
+    : m_head(NONE),
+      m_tail(NONE)
+{
+}
+
+bool
+FqFlowList::IsEmpty() const
+{
+    return m_head == NONE;
+}
+
+uint32_t
+FqFlowList::GetFront() const
+{
+    return m_head;
+}
+
+uint32_t
+FqFlowList::GetNext(uint32_t index) const
+{
+    NS_ASSERT(index < m_next.size());
+    return m_next[index];
+}
+
+void
+FqFlowList::PushBack(uint32_t index)
+{
+    NS_ASSERT(index != NONE);
+    if (index >= m_next.size())
+    {
+        m_next.resize(index + 1, NONE);
+    }
+    m_next[index] = NONE;
+    if (m_head == NONE)
+    {
+        m_head = index;
+    }
+    else
+    {
+        m_next[m_tail] = index;
+    }
+    m_tail = index;
+}
+
+void
+FqFlowList::PopFront()
+{
+    NS_ASSERT_MSG(m_head != NONE, "The list of flows is empty");
+    uint32_t next = m_next[m_head];
+    m_next[m_head] = NONE;
+    m_head = next;
+    if (m_head == NONE)
+    {
+        m_tail = NONE;
+    }
+}
+
+void
+FqFlowList::MoveFront(FqFlowList& list)
+{
+    uint32_t index = m_head;
+    PopFront();
+    list.PushBack(index);
+}
+
+void
+FqFlowList::Clear()
+{
+    m_head = NONE;
+    m_tail = NONE;
+    m_next.clear();
+}
+
+} // namespace ns3
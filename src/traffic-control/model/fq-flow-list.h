@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Pasquale Imputato <p.imputato@gmail.com>
+ *          Stefano Avallone <stefano.avallone@unina.it>
+ */
+
+#ifndef FQ_FLOW_LIST_H
+#define FQ_FLOW_LIST_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A FIFO list of the flow queues of a flow queueing queue disc
+ *
+ * FqCoDelQueueDisc, FqPieQueueDisc and FqCobaltQueueDisc keep their active
+ * flows in a list of new flows and in a list of old flows. Flows are identified
+ * by the index of their queue disc class and the links between them are stored
+ * in a flat array indexed by such index, so that adding, removing and moving
+ * flows does not allocate memory once a flow has been in the list.
+ *
+ * A flow can be in a list at most once.
+ */
+class FqFlowList
+{
+  public:
+    /// Value returned when there is no (more) flow in the list
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    FqFlowList();
+
+    /**
+     * \return true if the list is empty
+     */
+    bool IsEmpty() const;
+    /**
+     * \return the index of the flow at the head of the list, or NONE if the list is empty
+     */
+    uint32_t GetFront() const;
+    /**
+     * \param index the index of a flow in the list
+     * \return the index of the flow following the given one, or NONE if it is the last
+     */
+    uint32_t GetNext(uint32_t index) const;
+    /**
+     * \brief Append a flow to the list
+     * \param index the index of the flow
+     */
+    void PushBack(uint32_t index);
+    /**
+     * \brief Remove the flow at the head of the list, which must not be empty
+     */
+    void PopFront();
+    /**
+     * \brief Move the flow at the head of this list to the tail of the given list
+     *
+     * The given list may be this list, in which case the head flow is moved to its tail.
+     *
+     * \param list the list the head flow is appended to
+     */
+    void MoveFront(FqFlowList& list);
+    /**
+     * \brief Remove all the flows
+     */
+    void Clear();
+
+  private:
+    uint32_t m_head;              //!< the index of the first flow
+    uint32_t m_tail;              //!< the index of the last flow
+    std::vector<uint32_t> m_next; //!< the index of the flow following each flow
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_LIST_H */
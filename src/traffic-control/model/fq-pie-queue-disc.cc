@@ -265,12 +265,10 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        if (index == FqFlowList::NONE || m_tags[i] == flowHash ||
+            StaticCast<FqPieFlow>(GetQueueDiscClass(index))->GetStatus() == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -322,7 +320,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == FqFlowList::NONE)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -341,6 +339,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         AddQueueDiscClass(flow);
 
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_backlogs.push_back(0);
     }
     else
     {
@@ -351,10 +350,11 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     {
         flow->SetStatus(FqPieFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(m_flowsIndices[h]);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
+    m_backlogs[m_flowsIndices[h]] = flow->GetQueueDisc()->GetNBytes();
 
     NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
 
@@ -372,6 +372,7 @@ FqPieQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
+    uint32_t index = 0;
     Ptr<FqPieFlow> flow;
     Ptr<QueueDiscItem> item;
 
@@ -379,17 +380,17 @@ FqPieQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            index = m_newFlows.GetFront();
+            flow = StaticCast<FqPieFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -398,16 +399,16 @@ FqPieQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            index = m_oldFlows.GetFront();
+            flow = StaticCast<FqPieFlow>(GetQueueDiscClass(index));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_oldFlows.MoveFront(m_oldFlows);
             }
             else
             {
@@ -423,20 +424,20 @@ FqPieQueueDisc::DoDequeue()
         }
 
         item = flow->GetQueueDisc()->Dequeue();
+        m_backlogs[index] = flow->GetQueueDisc()->GetNBytes();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFront(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -512,6 +513,12 @@ FqPieQueueDisc::InitializeParams()
 
     m_flowFactory.SetTypeId("ns3::FqPieFlow");
 
+    m_flowsIndices.assign(m_flows, FqFlowList::NONE);
+    if (m_enableSetAssociativeHash)
+    {
+        m_tags.assign(m_flows, 0);
+    }
+
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("MeanPktSize", UintegerValue(m_meanPktSize));
@@ -537,13 +544,11 @@ FqPieQueueDisc::FqPieDrop()
     Ptr<QueueDisc> qd;
 
     /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    for (uint32_t i = 0; i < m_backlogs.size(); i++)
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
+        if (m_backlogs[i] > maxBacklog)
         {
-            maxBacklog = bytes;
+            maxBacklog = m_backlogs[i];
             index = i;
         }
     }
@@ -563,6 +568,7 @@ FqPieQueueDisc::FqPieDrop()
         DropAfterDequeue(item, OVERLIMIT_DROP);
         len += item->GetSize();
     } while (++count < m_dropBatchSize && len < threshold);
+    m_backlogs[index] = qd->GetNBytes();
 
     return index;
 }
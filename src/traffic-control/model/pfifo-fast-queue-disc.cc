@@ -119,6 +119,24 @@ PfifoFastQueueDisc::DoDequeue()
     return item;
 }
 
+void
+PfifoFastQueueDisc::DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << budget);
+
+    // nothing is enqueued meanwhile, hence the bands can be drained in order
+    Ptr<QueueDiscItem> item;
+    for (uint32_t i = 0; i < GetNInternalQueues() && budget > 0; i++)
+    {
+        Ptr<InternalQueue> band = GetInternalQueue(i);
+        while (budget > 0 && (item = band->Dequeue()))
+        {
+            items.push_back(item);
+            budget -= std::min(budget, item->GetSize());
+        }
+    }
+}
+
 Ptr<const QueueDiscItem>
 PfifoFastQueueDisc::DoPeek()
 {
@@ -76,6 +76,7 @@ class PfifoFastQueueDisc : public QueueDisc
 
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
+    void DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items) override;
     Ptr<const QueueDiscItem> DoPeek() override;
     bool CheckConfig() override;
     void InitializeParams() override;
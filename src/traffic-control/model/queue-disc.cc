@@ -24,6 +24,7 @@
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
@@ -260,6 +261,12 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("BatchBytes",
+                          "The byte budget of the bulk dequeues performed in a qdisc run "
+                          "(0 disables them)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&QueueDisc::m_batchBytes),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -322,6 +329,7 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     : m_nPackets(0),
       m_nBytes(0),
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
+      m_batchBytes(0),
       m_running(false),
       m_peeked(false),
       m_sizePolicy(policy),
@@ -384,7 +392,9 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
+    m_sendBatch = nullptr;
     m_requeued = nullptr;
+    m_requeuedBatch.clear();
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
     m_childQueueDiscDbeFunctor = nullptr;
@@ -423,11 +433,17 @@ QueueDisc::GetStats()
     // the total number of sent packets is only updated here to avoid to increase it
     // after a dequeue and then having to decrease it if the packet is dropped after
     // dequeue or requeued
-    m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - (m_requeued ? 1 : 0) -
+    uint32_t nRequeuedPackets = (m_requeued ? GetNQueuedPackets(PeekPointer(m_requeued)) : 0);
+    uint32_t nRequeuedBytes = (m_requeued ? m_requeued->GetSize() : 0);
+    for (const auto& item : m_requeuedBatch)
+    {
+        nRequeuedPackets += GetNQueuedPackets(PeekPointer(item));
+        nRequeuedBytes += item->GetSize();
+    }
+    m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - nRequeuedPackets -
                                 m_stats.nTotalDroppedPacketsAfterDequeue;
-    m_stats.nTotalSentBytes = m_stats.nTotalDequeuedBytes -
-                              (m_requeued ? m_requeued->GetSize() : 0) -
-                              m_stats.nTotalDroppedBytesAfterDequeue;
+    m_stats.nTotalSentBytes =
+        m_stats.nTotalDequeuedBytes - nRequeuedBytes - m_stats.nTotalDroppedBytesAfterDequeue;
 
     return m_stats;
 }
@@ -559,6 +575,13 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::SetSendBatchCallback(SendBatchCallback func)
+{
+    NS_LOG_FUNCTION(this);
+    m_sendBatch = func;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -691,9 +714,10 @@ QueueDisc::GetWakeMode() const
 void
 QueueDisc::PacketEnqueued(Ptr<const QueueDiscItem> item)
 {
-    m_nPackets++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_nPackets += nPackets;
     m_nBytes += item->GetSize();
-    m_stats.nTotalEnqueuedPackets++;
+    m_stats.nTotalEnqueuedPackets += nPackets;
     m_stats.nTotalEnqueuedBytes += item->GetSize();
 
     NS_LOG_LOGIC("m_traceEnqueue (p)");
@@ -710,9 +734,10 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
     // the packet will be actually dequeued.
     if (!m_peeked)
     {
-        m_nPackets--;
+        uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+        m_nPackets -= nPackets;
         m_nBytes -= item->GetSize();
-        m_stats.nTotalDequeuedPackets++;
+        m_stats.nTotalDequeuedPackets += nPackets;
         m_stats.nTotalDequeuedBytes += item->GetSize();
 
         m_sojourn(Simulator::Now() - item->GetTimeStamp());
@@ -727,9 +752,10 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
 {
     NS_LOG_FUNCTION(this << item << reason);
 
-    m_stats.nTotalDroppedPackets++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_stats.nTotalDroppedPackets += nPackets;
     m_stats.nTotalDroppedBytes += item->GetSize();
-    m_stats.nTotalDroppedPacketsBeforeEnqueue++;
+    m_stats.nTotalDroppedPacketsBeforeEnqueue += nPackets;
     m_stats.nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
     // update the number of packets dropped for the given reason
@@ -737,11 +763,11 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
         m_stats.nDroppedPacketsBeforeEnqueue.find(reason);
     if (itp != m_stats.nDroppedPacketsBeforeEnqueue.end())
     {
-        itp->second++;
+        itp->second += nPackets;
     }
     else
     {
-        m_stats.nDroppedPacketsBeforeEnqueue[reason] = 1;
+        m_stats.nDroppedPacketsBeforeEnqueue[reason] = nPackets;
     }
     // update the amount of bytes dropped for the given reason
     std::map<std::string, uint64_t>::iterator itb = m_stats.nDroppedBytesBeforeEnqueue.find(reason);
@@ -767,9 +793,10 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
 {
     NS_LOG_FUNCTION(this << item << reason);
 
-    m_stats.nTotalDroppedPackets++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_stats.nTotalDroppedPackets += nPackets;
     m_stats.nTotalDroppedBytes += item->GetSize();
-    m_stats.nTotalDroppedPacketsAfterDequeue++;
+    m_stats.nTotalDroppedPacketsAfterDequeue += nPackets;
     m_stats.nTotalDroppedBytesAfterDequeue += item->GetSize();
 
     // update the number of packets dropped for the given reason
@@ -777,11 +804,11 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
         m_stats.nDroppedPacketsAfterDequeue.find(reason);
     if (itp != m_stats.nDroppedPacketsAfterDequeue.end())
     {
-        itp->second++;
+        itp->second += nPackets;
     }
     else
     {
-        m_stats.nDroppedPacketsAfterDequeue[reason] = 1;
+        m_stats.nDroppedPacketsAfterDequeue[reason] = nPackets;
     }
     // update the amount of bytes dropped for the given reason
     std::map<std::string, uint64_t>::iterator itb = m_stats.nDroppedBytesAfterDequeue.find(reason);
@@ -825,18 +852,19 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
         return false;
     }
 
-    m_stats.nTotalMarkedPackets++;
+    uint32_t nPackets = GetNQueuedPackets(PeekPointer(item));
+    m_stats.nTotalMarkedPackets += nPackets;
     m_stats.nTotalMarkedBytes += item->GetSize();
 
     // update the number of packets marked for the given reason
     std::map<std::string, uint32_t>::iterator itp = m_stats.nMarkedPackets.find(reason);
     if (itp != m_stats.nMarkedPackets.end())
     {
-        itp->second++;
+        itp->second += nPackets;
     }
     else
     {
-        m_stats.nMarkedPackets[reason] = 1;
+        m_stats.nMarkedPackets[reason] = nPackets;
     }
     // update the amount of bytes marked for the given reason
     std::map<std::string, uint64_t>::iterator itb = m_stats.nMarkedBytes.find(reason);
@@ -860,7 +888,7 @@ QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
 {
     NS_LOG_FUNCTION(this << item);
 
-    m_stats.nTotalReceivedPackets++;
+    m_stats.nTotalReceivedPackets += GetNQueuedPackets(PeekPointer(item));
     m_stats.nTotalReceivedBytes += item->GetSize();
 
     bool retval = DoEnqueue(item);
@@ -903,6 +931,11 @@ QueueDisc::Dequeue()
     if (item)
     {
         m_requeued = nullptr;
+        if (!m_requeuedBatch.empty())
+        {
+            m_requeued = m_requeuedBatch.front();
+            m_requeuedBatch.pop_front();
+        }
         if (m_peeked)
         {
             // If the packet was requeued because a peek operation was requested
@@ -924,6 +957,41 @@ QueueDisc::Dequeue()
     return item;
 }
 
+void
+QueueDisc::DequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << budget);
+
+    // first extract the packets dequeued by Peek or requeued, if any
+    while (m_requeued && budget > 0)
+    {
+        Ptr<QueueDiscItem> item = Dequeue();
+        items.push_back(item);
+        budget -= std::min(budget, item->GetSize());
+    }
+
+    if (budget > 0)
+    {
+        DoDequeueBatch(budget, items);
+    }
+
+    NS_ASSERT(m_nPackets == m_stats.nTotalEnqueuedPackets - m_stats.nTotalDequeuedPackets);
+    NS_ASSERT(m_nBytes == m_stats.nTotalEnqueuedBytes - m_stats.nTotalDequeuedBytes);
+}
+
+void
+QueueDisc::DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << budget);
+
+    Ptr<QueueDiscItem> item;
+    while (budget > 0 && (item = DoDequeue()))
+    {
+        items.push_back(item);
+        budget -= std::min(budget, item->GetSize());
+    }
+}
+
 Ptr<const QueueDiscItem>
 QueueDisc::Peek()
 {
@@ -957,9 +1025,15 @@ QueueDisc::Run()
     if (RunBegin())
     {
         uint32_t quota = m_quota;
-        while (Restart())
+        uint32_t nPackets = 0;
+        while (Restart(nPackets))
         {
-            quota -= 1;
+            if (nPackets > 1 && nPackets >= quota)
+            {
+                // a bulk dequeue may exceed the quota
+                break;
+            }
+            quota -= nPackets;
             if (quota <= 0)
             {
                 /// \todo netif_schedule (q);
@@ -991,9 +1065,11 @@ QueueDisc::RunEnd()
 }
 
 bool
-QueueDisc::Restart()
+QueueDisc::Restart(uint32_t& nPackets)
 {
     NS_LOG_FUNCTION(this);
+    // requeued packets are sent one at a time
+    bool requeued = (m_requeued != nullptr);
     Ptr<QueueDiscItem> item = DequeuePacket();
     if (!item)
     {
@@ -1001,9 +1077,55 @@ QueueDisc::Restart()
         return false;
     }
 
+    uint32_t budget = (requeued ? 0 : GetBatchBudget(item));
+    if (budget > 0)
+    {
+        std::vector<Ptr<QueueDiscItem>> items{item};
+        DequeueBatch(budget, items);
+        nPackets = items.size();
+        if (nPackets > 1)
+        {
+            NS_LOG_LOGIC("Bulk dequeue of " << nPackets << " packets");
+            for (auto it = std::next(items.begin()); it != items.end(); it++)
+            {
+                (*it)->AddHeader();
+            }
+            return TransmitBatch(items);
+        }
+    }
+
+    nPackets = 1;
     return Transmit(item);
 }
 
+uint32_t
+QueueDisc::GetBatchBudget(Ptr<const QueueDiscItem> item) const
+{
+    NS_LOG_FUNCTION(this << item);
+
+    if (m_batchBytes == 0 || !m_sendBatch)
+    {
+        return 0;
+    }
+
+    uint32_t budget = m_batchBytes;
+    if (m_devQueueIface)
+    {
+        // multi-queue aware queue discs pick the packets to dequeue based on
+        // the state of the device queues, hence only single queue devices
+        if (m_devQueueIface->GetNTxQueues() > 1)
+        {
+            return 0;
+        }
+        Ptr<QueueLimits> queueLimits = m_devQueueIface->GetTxQueue(0)->GetQueueLimits();
+        if (queueLimits)
+        {
+            budget = std::min<int64_t>(budget, std::max(queueLimits->Available(), 0));
+        }
+    }
+    return budget - std::min(budget, item->GetSize());
+}
+
 Ptr<QueueDiscItem>
 QueueDisc::DequeuePacket()
 {
@@ -1022,6 +1144,11 @@ QueueDisc::DequeuePacket()
         {
             item = m_requeued;
             m_requeued = nullptr;
+            if (!m_requeuedBatch.empty())
+            {
+                m_requeued = m_requeuedBatch.front();
+                m_requeuedBatch.pop_front();
+            }
             if (m_peeked)
             {
                 // If the packet was requeued because a peek operation was requested
@@ -1058,10 +1185,18 @@ void
 QueueDisc::Requeue(Ptr<QueueDiscItem> item)
 {
     NS_LOG_FUNCTION(this << item);
-    m_requeued = item;
+    if (m_requeued)
+    {
+        // the packets of a batch that were not sent are requeued in order
+        m_requeuedBatch.push_back(item);
+    }
+    else
+    {
+        m_requeued = item;
+    }
     /// \todo netif_schedule (q);
 
-    m_stats.nTotalRequeuedPackets++;
+    m_stats.nTotalRequeuedPackets += GetNQueuedPackets(PeekPointer(item));
     m_stats.nTotalRequeuedBytes += item->GetSize();
 
     NS_LOG_LOGIC("m_traceRequeue (p)");
@@ -1117,4 +1252,43 @@ QueueDisc::Transmit(Ptr<QueueDiscItem> item)
     return true;
 }
 
+bool
+QueueDisc::TransmitBatch(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    // batches are only dequeued for single queue devices (see GetBatchBudget),
+    // which make no use of the priority tag
+    if (m_devQueueIface && m_devQueueIface->GetTxQueue(0)->IsStopped())
+    {
+        for (const auto& item : items)
+        {
+            Requeue(item);
+        }
+        return false;
+    }
+
+    for (const auto& item : items)
+    {
+        SocketPriorityTag priorityTag;
+        item->GetPacket()->RemovePacketTag(priorityTag);
+    }
+    NS_ASSERT_MSG(m_sendBatch, "Send batch callback not set");
+    uint32_t nSent = m_sendBatch(items);
+
+    // as in Transmit, the packets taken by the device are considered consumed
+    for (std::size_t i = nSent; i < items.size(); i++)
+    {
+        Requeue(items[i]);
+    }
+
+    if (nSent < items.size() || GetNPackets() == 0 ||
+        (m_devQueueIface && m_devQueueIface->GetTxQueue(0)->IsStopped()))
+    {
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace ns3
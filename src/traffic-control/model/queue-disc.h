@@ -28,6 +28,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <string>
@@ -151,6 +152,14 @@ enum QueueDiscSizePolicy
  * is room for another packet in its transmission queue, but the transmission queue
  * is stopped. Waking a queue disc is equivalent to make it run.
  *
+ * If the "BatchBytes" attribute is not null and the device has a single
+ * transmission queue, each dequeue of a run is followed, as in Linux, by a bulk
+ * dequeue of the packets that fit in that byte budget, further bounded by the
+ * bytes allowed by the dynamic queue limits (BQL) of the device, if any. The
+ * packets are then handed to the device at once (see NetDevice::SendBatch).
+ * If the device queue gets stopped in the middle of a batch, the remaining
+ * packets are requeued, which is why bulk dequeues are disabled by default.
+ *
  * Every queue disc collects statistics about the total number of packets/bytes
  * received from the upper layers (in case of root queue disc) or from the parent
  * queue disc (in case of child queue disc), enqueued, dequeued, requeued, dropped,
@@ -162,7 +171,7 @@ enum QueueDiscSizePolicy
  * - dropped = dropped before enqueue + dropped after dequeue
  * - received = dropped before enqueue + enqueued
  * - queued = enqueued - dequeued
- * - sent = dequeued - dropped after dequeue (- 1 if there is a requeued packet)
+ * - sent = dequeued - dropped after dequeue (- the number of requeued packets)
  *
  * Separate counters are also kept for each possible reason to drop a packet.
  * When a packet is dropped by an internal queue, e.g., because the queue is full,
@@ -177,6 +186,11 @@ enum QueueDiscSizePolicy
  * the additional time the packet is retained within the traffic control
  * infrastructure in case it is requeued.
  *
+ * The number of packets in the queue disc and the statistics about packets
+ * count a TSO super-segment as the segments it stands for (see
+ * GetNQueuedPackets), so that queue discs whose size is measured in packets
+ * hold as much data whether or not segmentation offload is emulated.
+ *
  * The design and implementation of this class is heavily inspired by Linux.
  * For more details, see the traffic-control model page.
  */
@@ -378,6 +392,22 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /**
+     * Callback invoked to send several packets to the receiving object when Run
+     * is called. It returns the number of packets taken by the receiving object,
+     * which stops taking them when its transmission queue is stopped.
+     */
+    typedef std::function<uint32_t(const std::vector<Ptr<QueueDiscItem>>&)> SendBatchCallback;
+
+    /**
+     * \param func the callback to send several packets to the receiving object.
+     *
+     * Set the callback used by the TransmitBatch method (called eventually by
+     * the Run method) to send the packets of a bulk dequeue to the receiving
+     * object. Bulk dequeues are only performed if this callback is set.
+     */
+    void SetSendBatchCallback(SendBatchCallback func);
+
     /**
      * \brief Set the maximum number of dequeue operations following a packet enqueue
      * \param quota the maximum number of dequeue operations following a packet enqueue.
@@ -408,6 +438,19 @@ class QueueDisc : public Object
      */
     Ptr<QueueDiscItem> Dequeue();
 
+    /**
+     * Extract packets from the queue disc until their total size reaches the
+     * given budget (the last packet may exceed it) or the queue disc is empty,
+     * starting with the packet that has been dequeued by calling Peek, if any.
+     * This function calls the private DoDequeueBatch method, which subclasses
+     * may override to extract the packets more efficiently than with repeated
+     * calls to DoDequeue.
+     *
+     * \param budget the number of bytes to extract
+     * \param items the vector the extracted items are appended to
+     */
+    void DequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * Get a copy of the next packet the queue discipline will extract. This
      * function only calls the (private) DoPeek function. This base class provides
@@ -586,6 +629,15 @@ class QueueDisc : public Object
      */
     virtual Ptr<QueueDiscItem> DoDequeue() = 0;
 
+    /**
+     * This function actually extracts packets from the queue disc, until their
+     * total size reaches the given budget or the queue disc is empty. The
+     * default implementation calls DoDequeue repeatedly.
+     * \param budget the number of bytes to extract
+     * \param items the vector the extracted items are appended to
+     */
+    virtual void DoDequeueBatch(uint32_t budget, std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * \brief Return a copy of the next packet the queue disc will extract.
      *
@@ -644,9 +696,19 @@ class QueueDisc : public Object
     /**
      * Modelled after the Linux function qdisc_restart (net/sched/sch_generic.c)
      * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling Transmit).
-     * \return true if a packet is successfully sent to the device.
+     * If bulk dequeues are enabled, further packets are dequeued within the byte
+     * budget (see GetBatchBudget) and all of them are sent by calling TransmitBatch.
+     * \param nPackets the number of packets dequeued
+     * \return true if the packets are successfully sent to the device.
      */
-    bool Restart();
+    bool Restart(uint32_t& nPackets);
+
+    /**
+     * Modelled after the Linux function qdisc_avail_bulklimit (include/net/sch_generic.h)
+     * \param item the first packet of the batch
+     * \return the number of bytes that can be dequeued after the given packet
+     */
+    uint32_t GetBatchBudget(Ptr<const QueueDiscItem> item) const;
 
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
@@ -670,6 +732,16 @@ class QueueDisc : public Object
      */
     bool Transmit(Ptr<QueueDiscItem> item);
 
+    /**
+     * Sends the packets of a bulk dequeue to the device if the device queue is
+     * not stopped, and requeues the packets the device did not take because
+     * its queue got stopped.
+     * \param items the packets to transmit
+     * \return true if all the packets were sent, the device queue is not
+     *         stopped and the queue disc is not empty
+     */
+    bool TransmitBatch(const std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * \brief Perform the actions required when the queue disc is notified of
      *        a packet enqueue
@@ -700,8 +772,11 @@ class QueueDisc : public Object
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
+    SendBatchCallback m_sendBatch; //!< Callback used to send packets to the receiving object
+    uint32_t m_batchBytes;         //!< Byte budget of bulk dequeues (0 to disable them)
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
+    std::deque<Ptr<QueueDiscItem>> m_requeuedBatch; //!< Requeued packets following m_requeued
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
     std::string m_childQueueDiscDropMsg; //!< Reason why a packet was dropped by a child queue disc
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
@@ -211,6 +211,16 @@ TrafficControlLayer::ScanDevices()
                 q->SetSendCallback([dev](Ptr<QueueDiscItem> item) {
                     dev->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
                 });
+                q->SetSendBatchCallback([dev](const std::vector<Ptr<QueueDiscItem>>& items) {
+                    std::vector<NetDevice::BatchItem> batch;
+                    batch.reserve(items.size());
+                    for (const auto& item : items)
+                    {
+                        batch.push_back(
+                            {item->GetPacket(), item->GetAddress(), item->GetProtocol()});
+                    }
+                    return dev->SendBatch(batch);
+                });
             }
         }
     }
@@ -275,6 +285,7 @@ TrafficControlLayer::DeleteRootQueueDiscOnDevice(Ptr<NetDevice> device)
     {
         q->SetNetDeviceQueueInterface(nullptr);
         q->SetSendCallback(nullptr);
+        q->SetSendBatchCallback(nullptr);
     }
     ndi->second.m_queueDiscsToWake.clear();
 
@@ -267,6 +267,96 @@ FifoQueueDiscTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fifo Queue Disc Bulk Dequeue Test Case
+ *
+ * Check that the packets are dequeued in bulk within the byte budget, that the
+ * packets of a batch not taken by the device are requeued and sent first,
+ * in order, and that the statistics account for them.
+ */
+class FifoQueueDiscBatchTestCase : public TestCase
+{
+  public:
+    FifoQueueDiscBatchTestCase();
+    void DoRun() override;
+};
+
+FifoQueueDiscBatchTestCase::FifoQueueDiscBatchTestCase()
+    : TestCase("Check the bulk dequeues of the fifo queue disc")
+{
+}
+
+void
+FifoQueueDiscBatchTestCase::DoRun()
+{
+    Ptr<FifoQueueDisc> q = CreateObject<FifoQueueDisc>();
+    q->SetAttribute("BatchBytes", UintegerValue(3500));
+    q->Initialize();
+
+    Address dest;
+    std::vector<uint64_t> uids;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        uids.push_back(p->GetUid());
+        q->Enqueue(Create<FifoQueueDiscTestItem>(p, dest));
+    }
+
+    // DequeueBatch starts with the packet retained by Peek
+    q->Peek();
+    std::vector<Ptr<QueueDiscItem>> items;
+    q->DequeueBatch(1500, items);
+    NS_TEST_ASSERT_MSG_EQ(items.size(), 2, "The last packet may exceed the budget");
+    NS_TEST_EXPECT_MSG_EQ(items[0]->GetPacket()->GetUid(), uids[0], "Wrong packet order");
+    NS_TEST_EXPECT_MSG_EQ(items[1]->GetPacket()->GetUid(), uids[1], "Wrong packet order");
+    NS_TEST_EXPECT_MSG_EQ(q->GetNPackets(), 8, "There should be 8 packets in the queue disc");
+    uids.erase(uids.begin(), uids.begin() + 2);
+
+    // the device takes 2 packets of the first batch, then all of them
+    std::vector<uint64_t> sentUids;
+    std::vector<std::size_t> batchSizes;
+    uint32_t nSingle = 0;
+    uint32_t accept = 2;
+    q->SetSendCallback([&](Ptr<QueueDiscItem> item) {
+        sentUids.push_back(item->GetPacket()->GetUid());
+        nSingle++;
+    });
+    q->SetSendBatchCallback([&](const std::vector<Ptr<QueueDiscItem>>& batch) {
+        batchSizes.push_back(batch.size());
+        uint32_t nSent = std::min<uint32_t>(batch.size(), accept);
+        for (uint32_t i = 0; i < nSent; i++)
+        {
+            sentUids.push_back(batch[i]->GetPacket()->GetUid());
+        }
+        return nSent;
+    });
+
+    q->Run();
+    NS_TEST_ASSERT_MSG_EQ(batchSizes.size(), 1, "A single batch should have been sent");
+    NS_TEST_EXPECT_MSG_EQ(batchSizes[0], 4, "The batch should contain 3500B worth of packets");
+    NS_TEST_EXPECT_MSG_EQ(q->GetNPackets(), 4, "There should be 4 packets in the queue disc");
+    NS_TEST_EXPECT_MSG_EQ(q->GetStats().nTotalRequeuedPackets, 2, "2 packets should be requeued");
+    NS_TEST_EXPECT_MSG_EQ(q->GetStats().nTotalSentPackets, 4, "4 packets should be sent");
+
+    accept = 10;
+    q->Run();
+    NS_TEST_EXPECT_MSG_EQ(nSingle, 2, "The requeued packets should be sent one at a time");
+    NS_TEST_ASSERT_MSG_EQ(batchSizes.size(), 2, "A second batch should have been sent");
+    NS_TEST_EXPECT_MSG_EQ(batchSizes[1], 4, "The second batch should contain 4 packets");
+    NS_TEST_EXPECT_MSG_EQ(q->GetNPackets(), 0, "The queue disc should be empty");
+    NS_TEST_EXPECT_MSG_EQ(q->GetStats().nTotalSentPackets, 10, "10 packets should be sent");
+    NS_TEST_ASSERT_MSG_EQ(sentUids.size(), uids.size(), "All the packets should be sent");
+    for (std::size_t i = 0; i < uids.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sentUids[i], uids[i], "Wrong packet order");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup traffic-control-test
  * \ingroup tests
@@ -280,5 +370,6 @@ static class FifoQueueDiscTestSuite : public TestSuite
         : TestSuite("fifo-queue-disc", UNIT)
     {
         AddTestCase(new FifoQueueDiscTestCase(), TestCase::QUICK);
+        AddTestCase(new FifoQueueDiscBatchTestCase(), TestCase::QUICK);
     }
 } g_fifoQueueTestSuite; ///< the test suite
@@ -20,6 +20,7 @@
 #include "wave-mac-helper.h"
 
 #include "ns3/abort.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/minstrel-wifi-manager.h"
@@ -53,6 +54,11 @@ AsciiPhyTransmitSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                 uint8_t txLevel [[maybe_unused]])
 {
     NS_LOG_FUNCTION(stream << context << p << mode << preamble << txLevel);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -73,6 +79,11 @@ AsciiPhyTransmitSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
                                    uint8_t txLevel)
 {
     NS_LOG_FUNCTION(stream << p << mode << preamble << txLevel);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -94,6 +105,11 @@ AsciiPhyReceiveSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                enum WifiPreamble preamble)
 {
     NS_LOG_FUNCTION(stream << context << p << snr << mode << preamble);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -114,6 +130,11 @@ AsciiPhyReceiveSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
                                   enum WifiPreamble preamble)
 {
     NS_LOG_FUNCTION(stream << p << snr << mode << preamble);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), Simulator::GetContext(), BinaryTraceWriter::NO_ID, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -23,6 +23,7 @@
 
 #include "ns3/ampdu-subframe-header.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/config.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/he-configuration.h"
@@ -68,6 +69,11 @@ AsciiPhyTransmitSinkWithContext(Ptr<OutputStreamWrapper> stream,
     auto pCopy = p->Copy();
     WifiMacTrailer fcs;
     pCopy->RemoveTrailer(fcs);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), context, pCopy);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << context << " " << mode
                          << " " << *pCopy << " " << fcs << std::endl;
 }
@@ -91,6 +97,15 @@ AsciiPhyTransmitSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
     auto pCopy = p->Copy();
     WifiMacTrailer fcs;
     pCopy->RemoveTrailer(fcs);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t',
+                      Simulator::Now(),
+                      Simulator::GetContext(),
+                      BinaryTraceWriter::NO_ID,
+                      pCopy);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " " << mode << " " << *pCopy
                          << " " << fcs << std::endl;
 }
@@ -116,6 +131,11 @@ AsciiPhyReceiveSinkWithContext(Ptr<OutputStreamWrapper> stream,
     auto pCopy = p->Copy();
     WifiMacTrailer fcs;
     pCopy->RemoveTrailer(fcs);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), context, pCopy);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << mode << " " << context
                          << " " << *pCopy << " " << fcs << std::endl;
 }
@@ -139,6 +159,15 @@ AsciiPhyReceiveSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
     auto pCopy = p->Copy();
     WifiMacTrailer fcs;
     pCopy->RemoveTrailer(fcs);
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r',
+                      Simulator::Now(),
+                      Simulator::GetContext(),
+                      BinaryTraceWriter::NO_ID,
+                      pCopy);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << mode << " " << *pCopy
                          << " " << fcs << std::endl;
 }
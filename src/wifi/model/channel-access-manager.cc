@@ -28,7 +28,7 @@
 #include "ns3/simulator.h"
 
 #undef NS_LOG_APPEND_CONTEXT
-#define NS_LOG_APPEND_CONTEXT std::clog << "[link=" << +m_linkId << "] "
+#define NS_LOG_APPEND_CONTEXT LogGetContextStream() << "[link=" << +m_linkId << "] "
 
 namespace ns3
 {
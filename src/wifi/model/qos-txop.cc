@@ -45,7 +45,7 @@
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     if (m_mac)                                                                                     \
     {                                                                                              \
-        std::clog << "[mac=" << m_mac->GetAddress() << "] ";                                       \
+        LogGetContextStream() << "[mac=" << m_mac->GetAddress() << "] ";                           \
     }
 
 namespace ns3
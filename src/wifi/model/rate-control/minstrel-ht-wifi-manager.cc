@@ -642,6 +642,7 @@ MinstrelHtWifiManager::DoReportDataFailed(WifiRemoteStation* st)
         station->m_groupsTable[groupId]
             .m_ratesTable[rateId]
             .numRateAttempt++; // Increment the attempts counter for the rate used.
+        station->m_groupsTable[groupId].m_attempted = true;
         UpdateRate(station);
     }
 }
@@ -696,6 +697,7 @@ MinstrelHtWifiManager::DoReportDataOk(WifiRemoteStation* st,
         uint8_t groupId = GetGroupId(station->m_txrate);
         station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
         station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+        station->m_groupsTable[groupId].m_attempted = true;
 
         UpdatePacketCounters(station, 1, 0);
 
@@ -805,6 +807,7 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus(WifiRemoteStation* st,
     station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
     station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt +=
         nSuccessfulMpdus + nFailedMpdus;
+    station->m_groupsTable[groupId].m_attempted = true;
 
     if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries(station))
     {
@@ -1423,8 +1426,6 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_numSamplesSlow = 0;
     station->m_sampleCount = 0;
 
-    double tempProb;
-
     if (station->m_ampduPacketCount > 0)
     {
         uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1443,89 +1444,30 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     for (uint8_t j = 0; j < m_numGroups; j++)
     {
         if (station->m_groupsTable[j].m_supported)
+        {
+            UpdateGroupStats(station, j);
+        }
+    }
+
+    /// Select the best rates, now that the statistics of all the groups are up to date.
+    for (uint8_t j = 0; j < m_numGroups; j++)
+    {
+        GroupInfo& group = station->m_groupsTable[j];
+        if (group.m_supported)
         {
             station->m_sampleCount++;
 
             /* (re)Initialize group rate indexes */
-            station->m_groupsTable[j].m_maxTpRate = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxProbRate = GetLowestIndex(station, j);
+            group.m_maxTpRate = GetLowestIndex(station, j);
+            group.m_maxTpRate2 = GetLowestIndex(station, j);
+            group.m_maxProbRate = GetLowestIndex(station, j);
 
             for (uint8_t i = 0; i < m_numRates; i++)
             {
-                if (station->m_groupsTable[j].m_ratesTable[i].supported)
+                if (group.m_ratesTable[i].supported && group.m_ratesTable[i].throughput != 0)
                 {
-                    station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
-
-                    NS_LOG_DEBUG(
-                        +i << " "
-                           << GetMcsSupported(station,
-                                              station->m_groupsTable[j].m_ratesTable[i].mcsIndex)
-                           << "\t attempt="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt
-                           << "\t success="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                    /// If we've attempted something.
-                    if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                        /**
-                         * Calculate the probability of success.
-                         * Assume probability scales from 0 to 100.
-                         */
-                        tempProb =
-                            (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) /
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                        /// Bookkeeping.
-                        station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                        if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                        else
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmsdProb =
-                                CalculateEwmsd(station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                               tempProb,
-                                               station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                               m_ewmaLevel);
-                            /// EWMA probability
-                            tempProb =
-                                (tempProb * (100 - m_ewmaLevel) +
-                                 station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel) /
-                                100;
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-
-                        station->m_groupsTable[j].m_ratesTable[i].throughput =
-                            CalculateThroughput(station, j, i, tempProb);
-
-                        station->m_groupsTable[j].m_ratesTable[i].successHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                        station->m_groupsTable[j].m_ratesTable[i].attemptHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                    else
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
-
-                    /// Bookkeeping.
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
-
-                    if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                        SetBestStationThRates(station, GetIndex(j, i));
-                        SetBestProbabilityRate(station, GetIndex(j, i));
-                    }
+                    SetBestStationThRates(station, GetIndex(j, i));
+                    SetBestProbabilityRate(station, GetIndex(j, i));
                 }
             }
         }
@@ -1547,6 +1489,91 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     }
 }
 
+void
+MinstrelHtWifiManager::UpdateGroupStats(MinstrelHtWifiRemoteStation* station, uint8_t groupId)
+{
+    NS_LOG_FUNCTION(this << station << +groupId);
+
+    GroupInfo& group = station->m_groupsTable[groupId];
+    MinstrelHtRate& rates = group.m_ratesTable;
+
+    if (!group.m_attempted)
+    {
+        /// Nothing was transmitted with the rates of this group since the last update:
+        /// only the bookkeeping needs to be done, EWMA and throughput are unchanged.
+        for (uint8_t i = 0; i < m_numRates; i++)
+        {
+            MinstrelHtRateInfo& rate = rates[i];
+            if (rate.supported)
+            {
+                rate.retryUpdated = false;
+                rate.numSamplesSkipped++;
+                rate.prevNumRateSuccess = 0;
+                rate.prevNumRateAttempt = 0;
+            }
+        }
+        return;
+    }
+    group.m_attempted = false;
+
+    const double ewmaLevel = m_ewmaLevel;
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        MinstrelHtRateInfo& rate = rates[i];
+        if (!rate.supported)
+        {
+            continue;
+        }
+        rate.retryUpdated = false;
+
+        NS_LOG_DEBUG(+i << " " << GetMcsSupported(station, rate.mcsIndex)
+                        << "\t attempt=" << rate.numRateAttempt
+                        << "\t success=" << rate.numRateSuccess);
+
+        /// If we've attempted something.
+        if (rate.numRateAttempt > 0)
+        {
+            rate.numSamplesSkipped = 0;
+            /**
+             * Calculate the probability of success.
+             * Assume probability scales from 0 to 100.
+             */
+            double tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
+
+            /// Bookkeeping.
+            rate.prob = tempProb;
+
+            if (rate.successHist == 0)
+            {
+                rate.ewmaProb = tempProb;
+            }
+            else
+            {
+                rate.ewmsdProb =
+                    CalculateEwmsd(rate.ewmsdProb, tempProb, rate.ewmaProb, m_ewmaLevel);
+                /// EWMA probability
+                tempProb = (tempProb * (100 - ewmaLevel) + rate.ewmaProb * ewmaLevel) / 100;
+                rate.ewmaProb = tempProb;
+            }
+
+            rate.throughput = CalculateThroughput(station, groupId, i, tempProb);
+
+            rate.successHist += rate.numRateSuccess;
+            rate.attemptHist += rate.numRateAttempt;
+        }
+        else
+        {
+            rate.numSamplesSkipped++;
+        }
+
+        /// Bookkeeping.
+        rate.prevNumRateSuccess = rate.numRateSuccess;
+        rate.prevNumRateAttempt = rate.numRateAttempt;
+        rate.numRateSuccess = 0;
+        rate.numRateAttempt = 0;
+    }
+}
+
 double
 MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
                                            uint8_t groupId,
@@ -1568,14 +1595,14 @@ MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
          * For the throughput calculation, limit the probability value to 90% to
          * account for collision related packet error rate fluctuation.
          */
-        Time txTime = station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime;
+        double txTime = station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTimeSeconds;
         if (ewmaProb > 90)
         {
-            return 90 / txTime.GetSeconds();
+            return 90 / txTime;
         }
         else
         {
-            return ewmaProb / txTime.GetSeconds();
+            return ewmaProb / txTime;
         }
     }
 }
@@ -1788,6 +1815,7 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
             station->m_groupsTable[groupId].m_supported = true;
             station->m_groupsTable[groupId].m_col = 0;
             station->m_groupsTable[groupId].m_index = 0;
+            station->m_groupsTable[groupId].m_attempted = false;
 
             station->m_groupsTable[groupId].m_ratesTable =
                 MinstrelHtRate(m_numRates); /// Create the rate list for the group.
@@ -1849,6 +1877,10 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                     station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime =
                         GetFirstMpduTxTime(groupId, GetMcsSupported(station, i));
+                    station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTimeSeconds =
+                        station->m_groupsTable[groupId]
+                            .m_ratesTable[rateId]
+                            .perfectTxTime.GetSeconds();
                     station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
                     CalculateRetransmits(station, groupId, rateId);
@@ -109,6 +109,7 @@ struct MinstrelHtRateInfo
      * Given a bit rate and a packet length n bytes.
      */
     Time perfectTxTime;
+    double perfectTxTimeSeconds; //!< perfectTxTime in seconds, cached for throughput updates.
     bool supported;      //!< If the rate is supported.
     uint8_t mcsIndex;    //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
     uint32_t retryCount; //!< Retry limit.
@@ -154,6 +155,7 @@ struct GroupInfo
     uint16_t m_maxTpRate;        //!< The max throughput rate of this group in bps.
     uint16_t m_maxTpRate2;       //!< The second max throughput rate of this group in bps.
     uint16_t m_maxProbRate;      //!< The highest success probability rate of this group in bps.
+    bool m_attempted;            //!< If any rate of this group was attempted since last update.
     MinstrelHtRate m_ratesTable; //!< Information about rates of this group.
 };
 
@@ -400,6 +402,17 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
      */
     void UpdateStats(MinstrelHtWifiRemoteStation* station);
 
+    /**
+     * Update the EWMA, EWMSD and throughput of all the supported rates of a group.
+     *
+     * This only touches the rate table of the given group; the selection of the
+     * best rates is done afterwards by UpdateStats, once all groups are updated.
+     *
+     * \param station the Minstrel-HT wifi remote station
+     * \param groupId the group ID
+     */
+    void UpdateGroupStats(MinstrelHtWifiRemoteStation* station, uint8_t groupId);
+
     /**
      * Initialize Minstrel Table.
      *
@@ -23,7 +23,8 @@
 #include "ns3/log.h"
 
 #undef NS_LOG_APPEND_CONTEXT
-#define NS_LOG_APPEND_CONTEXT std::clog << "[link=" << +m_linkId << "][mac=" << m_self << "] "
+#define NS_LOG_APPEND_CONTEXT                                                                      \
+    LogGetContextStream() << "[link=" << +m_linkId << "][mac=" << m_self << "] "
 
 namespace ns3
 {
@@ -20,6 +20,7 @@
 
 #include "wimax-helper.h"
 
+#include "ns3/binary-trace-file.h"
 #include "ns3/bs-net-device.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
@@ -426,6 +427,11 @@ WimaxHelper::AsciiRxEvent(Ptr<OutputStreamWrapper> stream,
                           Ptr<const Packet> packet,
                           const Mac48Address& source)
 {
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('r', Simulator::Now(), path, packet);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " from: " << source << " ";
     *stream->GetStream() << path << std::endl;
 }
@@ -436,6 +442,11 @@ WimaxHelper::AsciiTxEvent(Ptr<OutputStreamWrapper> stream,
                           Ptr<const Packet> packet,
                           const Mac48Address& dest)
 {
+    if (Ptr<BinaryTraceWriter> writer = stream->GetBinaryWriter())
+    {
+        writer->Write('t', Simulator::Now(), path, packet);
+        return;
+    }
     *stream->GetStream() << "t " << Simulator::Now().GetSeconds() << " to: " << dest << " ";
     *stream->GetStream() << path << std::endl;
 }
@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the flow classification and the
+// scheduling of FqCoDelQueueDisc with a large number of flows: 'n' packets
+// of 'flows' flows (in a round robin) are enqueued, one packet is dequeued
+// every two packets enqueued, so that the packet limit is eventually
+// exceeded, and the queue disc is finally drained. The checksum of the
+// flows of the dequeued packets can be used to check that the dequeue order
+// is unchanged.
+// Sample usage:  ./ns3 run 'bench-fq-codel --flows=100000 --n=2000000'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/queue-item.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * A queue disc item whose hash is the identifier of its flow.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * \param p the packet
+     * \param flow the identifier of the flow of the packet
+     */
+    BenchQueueDiscItem(Ptr<Packet> p, uint32_t flow)
+        : QueueDiscItem(p, Address(), 0),
+          m_flow(flow)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    uint32_t Hash(uint32_t perturbation) const override
+    {
+        return m_flow;
+    }
+
+  private:
+    uint32_t m_flow; //!< the identifier of the flow
+};
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t flows = 100000;
+    uint32_t queues = 100000;
+    uint32_t n = 2000000;
+    uint32_t packetSize = 1000;
+    std::string limit = "10240p";
+    bool setAssociativeHash = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark FqCoDelQueueDisc with a large number of flows");
+    cmd.AddValue("flows", "number of flows", flows);
+    cmd.AddValue("queues", "number of flow queues", queues);
+    cmd.AddValue("n", "number of packets to enqueue", n);
+    cmd.AddValue("packetSize", "packet size", packetSize);
+    cmd.AddValue("limit", "packet limit of the queue disc", limit);
+    cmd.AddValue("setAssociativeHash", "use the set associative hash", setAssociativeHash);
+    cmd.Parse(argc, argv);
+
+    Ptr<FqCoDelQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCoDelQueueDisc>("Flows",
+                                                     UintegerValue(queues),
+                                                     "MaxSize",
+                                                     StringValue(limit),
+                                                     "EnableSetAssociativeHash",
+                                                     BooleanValue(setAssociativeHash));
+    queueDisc->SetQuantum(1500);
+    queueDisc->Initialize();
+    Ptr<Packet> p = Create<Packet>(packetSize);
+
+    std::cout << "Running bench-fq-codel with " << n << " packets of " << flows << " flows into "
+              << queues << " flow queues" << std::endl;
+
+    SystemWallClockMs time;
+    uint64_t checksum = 0;
+    Ptr<QueueDiscItem> item;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queueDisc->Enqueue(Create<BenchQueueDiscItem>(p->Copy(), i % flows));
+        if (i % 2 == 1 && (item = queueDisc->Dequeue()))
+        {
+            checksum = checksum * 31 + item->Hash();
+        }
+    }
+    uint64_t enqueueMs = time.End();
+
+    time.Start();
+    while ((item = queueDisc->Dequeue()))
+    {
+        checksum = checksum * 31 + item->Hash();
+    }
+    uint64_t drainMs = time.End();
+
+    const QueueDisc::Stats& stats = queueDisc->GetStats();
+    std::cout << "Enqueue/dequeue: " << enqueueMs << " ms" << std::endl;
+    std::cout << "Drain:           " << drainMs << " ms" << std::endl;
+    std::cout << "Flow queues:     " << queueDisc->GetNQueueDiscClasses() << std::endl;
+    std::cout << "Sent packets:    " << stats.nTotalSentPackets << std::endl;
+    std::cout << "Dropped packets: " << stats.nTotalDroppedPackets << std::endl;
+    std::cout << "Checksum:        " << checksum << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the forwarding table lookups of
+// Ipv4StaticRouting and Ipv4GlobalRouting, for a routing table with
+// 'hosts' host routes and 'networks' /24 network routes.
+// Sample usage:  ./ns3 run 'bench-ipv4-routing --hosts=20000 --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Look up the route to a set of destinations.
+ *
+ * \param routing the routing protocol
+ * \param dests the destinations, used in a round robin
+ * \param n the number of lookups
+ * \return the number of lookups which found a route
+ */
+static uint32_t
+RunLookups(Ptr<Ipv4RoutingProtocol> routing, const std::vector<Ipv4Address>& dests, uint32_t n)
+{
+    Ptr<Packet> p = Create<Packet>();
+    Ipv4Header header;
+    Socket::SocketErrno sockerr;
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        header.SetDestination(dests[i % dests.size()]);
+        if (routing->RouteOutput(p, header, nullptr, sockerr))
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+/**
+ * Run and time the lookups.
+ *
+ * \param routing the routing protocol
+ * \param dests the destinations, used in a round robin
+ * \param n the number of lookups
+ * \param name the name of the routing protocol
+ */
+static void
+RunBench(Ptr<Ipv4RoutingProtocol> routing,
+         const std::vector<Ipv4Address>& dests,
+         uint32_t n,
+         const char* name)
+{
+    // the first lookup after the routes were added builds the lookup index
+    SystemWallClockMs time;
+    time.Start();
+    RunLookups(routing, dests, 1);
+    uint64_t firstMs = time.End();
+
+    time.Start();
+    uint32_t found = RunLookups(routing, dests, n);
+    uint64_t deltaMs = time.End();
+    double lps = n;
+    lps *= 1000;
+    lps /= std::max<uint64_t>(deltaMs, 1);
+    std::cout << lps << " lookups/s"
+              << " (" << deltaMs << " ms elapsed, " << found << " routes found, first lookup "
+              << firstMs << " ms)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t hosts = 20000;
+    uint32_t networks = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark IPv4 forwarding table lookups");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("hosts", "number of host routes", hosts);
+    cmd.AddValue("networks", "number of network routes", networks);
+    cmd.Parse(argc, argv);
+
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(device);
+    uint32_t ifIndex = ipv4->AddInterface(device);
+    ipv4->AddAddress(ifIndex, Ipv4InterfaceAddress(Ipv4Address("192.168.0.1"), Ipv4Mask("/16")));
+    ipv4->SetUp(ifIndex);
+    Ipv4Address gateway("192.168.0.2");
+
+    Ptr<Ipv4StaticRouting> staticRouting = CreateObject<Ipv4StaticRouting>();
+    staticRouting->SetIpv4(ipv4);
+    Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting>();
+    globalRouting->SetIpv4(ipv4);
+
+    std::vector<Ipv4Address> dests;
+    for (uint32_t i = 0; i < hosts; i++)
+    {
+        Ipv4Address dest(Ipv4Address("10.0.0.1").Get() + i);
+        staticRouting->AddHostRouteTo(dest, gateway, ifIndex);
+        globalRouting->AddHostRouteTo(dest, gateway, ifIndex);
+        dests.push_back(dest);
+    }
+    for (uint32_t i = 0; i < networks; i++)
+    {
+        Ipv4Address network(Ipv4Address("20.0.0.0").Get() + (i << 8));
+        staticRouting->AddNetworkRouteTo(network, Ipv4Mask("/24"), gateway, ifIndex);
+        globalRouting->AddNetworkRouteTo(network, Ipv4Mask("/24"), gateway, ifIndex);
+        dests.emplace_back(network.Get() + 1);
+    }
+
+    std::cout << "Running bench-ipv4-routing with n=" << n << ", " << hosts << " host routes and "
+              << networks << " network routes" << std::endl;
+    RunBench(staticRouting, dests, n, "Ipv4StaticRouting");
+    RunBench(globalRouting, dests, n, "Ipv4GlobalRouting");
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the downlink allocation of the FF MAC
+// schedulers of the LTE module with a large number of UEs: a 'scheduler' is
+// driven directly through its SAPs, without PHY, for 'ttis' TTIs of a cell
+// of 'bandwidth' RBs serving 'ues' UEs with saturated buffers.  Every
+// 'cqiPeriod' TTIs, new random wideband and subband CQIs are reported and
+// the buffers are refilled.  Half the UEs have a GBR bearer.  All the
+// transport blocks are acknowledged.  The checksum of the allocations can be
+// used to check that they are unchanged.
+// Sample usage:  ./ns3 run 'bench-lte-scheduler --scheduler=ns3::PfFfMacScheduler --ues=200'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/lte-fr-no-op-algorithm.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * The MAC side of the SAPs of the scheduler, which keeps the DL allocations.
+ */
+class BenchSchedulerUser : public FfMacCschedSapUser, public FfMacSchedSapUser
+{
+  public:
+    void CschedCellConfigCnf(const struct CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(const struct CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(const struct CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(const struct CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(const struct CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(const struct CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(
+        const struct CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void SchedDlConfigInd(const struct SchedDlConfigIndParameters& params) override
+    {
+        m_dlConfig = params;
+    }
+
+    void SchedUlConfigInd(const struct SchedUlConfigIndParameters& params) override
+    {
+    }
+
+    SchedDlConfigIndParameters m_dlConfig; //!< the last DL allocations
+};
+
+int
+main(int argc, char* argv[])
+{
+    std::string scheduler = "ns3::PfFfMacScheduler";
+    uint16_t ues = 200;
+    uint16_t bandwidth = 100;
+    uint32_t ttis = 10000;
+    uint32_t cqiPeriod = 10;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the downlink allocation of the LTE FF MAC schedulers");
+    cmd.AddValue("scheduler", "type of the FF MAC scheduler", scheduler);
+    cmd.AddValue("ues", "number of UEs", ues);
+    cmd.AddValue("bandwidth", "bandwidth of the cell in RBs", bandwidth);
+    cmd.AddValue("ttis", "number of TTIs", ttis);
+    cmd.AddValue("cqiPeriod", "number of TTIs between two CQI reports", cqiPeriod);
+    cmd.Parse(argc, argv);
+
+    ObjectFactory factory(scheduler);
+    Ptr<FfMacScheduler> sched = factory.Create<FfMacScheduler>();
+    Ptr<LteFfrAlgorithm> ffr = CreateObject<LteFrNoOpAlgorithm>();
+    ffr->SetDlBandwidth(bandwidth);
+    ffr->SetUlBandwidth(bandwidth);
+    ffr->SetLteFfrSapUser(sched->GetLteFfrSapUser());
+    sched->SetLteFfrSapProvider(ffr->GetLteFfrSapProvider());
+    BenchSchedulerUser user;
+    sched->SetFfMacCschedSapUser(&user);
+    sched->SetFfMacSchedSapUser(&user);
+    FfMacCschedSapProvider* csched = sched->GetFfMacCschedSapProvider();
+    FfMacSchedSapProvider* schedSap = sched->GetFfMacSchedSapProvider();
+
+    FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+    cellConfig.m_dlBandwidth = bandwidth;
+    cellConfig.m_ulBandwidth = bandwidth;
+    csched->CschedCellConfigReq(cellConfig);
+    for (uint16_t rnti = 1; rnti <= ues; rnti++)
+    {
+        FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+        ueConfig.m_rnti = rnti;
+        ueConfig.m_transmissionMode = 0;
+        ueConfig.m_reconfigureFlag = false;
+        csched->CschedUeConfigReq(ueConfig);
+
+        LogicalChannelConfigListElement_s lc;
+        lc.m_logicalChannelIdentity = 3;
+        lc.m_logicalChannelGroup = 1;
+        lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+        bool gbr = rnti % 2 == 0;
+        lc.m_qosBearerType = gbr ? LogicalChannelConfigListElement_s::QBT_GBR
+                                 : LogicalChannelConfigListElement_s::QBT_NON_GBR;
+        lc.m_qci = gbr ? 1 : 9;
+        lc.m_eRabMaximulBitrateUl = gbr ? 1000000 : 0;
+        lc.m_eRabMaximulBitrateDl = gbr ? 1000000 : 0;
+        lc.m_eRabGuaranteedBitrateUl = gbr ? 1000000 : 0;
+        lc.m_eRabGuaranteedBitrateDl = gbr ? 1000000 : 0;
+        FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+        lcConfig.m_rnti = rnti;
+        lcConfig.m_reconfigureFlag = false;
+        lcConfig.m_logicalChannelConfigList.push_back(lc);
+        csched->CschedLcConfigReq(lcConfig);
+    }
+
+    std::cout << "Running bench-lte-scheduler with " << scheduler << ", " << ues << " UEs, "
+              << bandwidth << " RBs, " << ttis << " TTIs" << std::endl;
+
+    Ptr<UniformRandomVariable> cqi = CreateObject<UniformRandomVariable>();
+    uint16_t rbgs = ffr->GetLteFfrSapProvider()->GetAvailableDlRbg().size();
+    uint64_t checksum = 0;
+    uint64_t allocations = 0;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t tti = 0; tti < ttis; tti++)
+    {
+        if (tti % cqiPeriod == 0)
+        {
+            FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiInfo;
+            for (uint16_t rnti = 1; rnti <= ues; rnti++)
+            {
+                CqiListElement_s wb;
+                wb.m_rnti = rnti;
+                wb.m_cqiType = CqiListElement_s::P10;
+                wb.m_wbCqi.push_back(cqi->GetInteger(1, 15));
+                cqiInfo.m_cqiList.push_back(wb);
+
+                CqiListElement_s sb;
+                sb.m_rnti = rnti;
+                sb.m_cqiType = CqiListElement_s::A30;
+                sb.m_wbCqi = wb.m_wbCqi;
+                sb.m_sbMeasResult.m_higherLayerSelected.resize(rbgs);
+                for (auto& higherLayerSelected : sb.m_sbMeasResult.m_higherLayerSelected)
+                {
+                    higherLayerSelected.m_sbCqi.push_back(cqi->GetInteger(1, 15));
+                }
+                cqiInfo.m_cqiList.push_back(sb);
+
+                FfMacSchedSapProvider::SchedDlRlcBufferReqParameters buffer;
+                buffer.m_rnti = rnti;
+                buffer.m_logicalChannelIdentity = 3;
+                buffer.m_rlcTransmissionQueueSize = 1000000;
+                buffer.m_rlcTransmissionQueueHolDelay = rnti % 50;
+                buffer.m_rlcRetransmissionQueueSize = 0;
+                buffer.m_rlcRetransmissionHolDelay = 0;
+                buffer.m_rlcStatusPduSize = 0;
+                schedSap->SchedDlRlcBufferReq(buffer);
+            }
+            schedSap->SchedDlCqiInfoReq(cqiInfo);
+        }
+
+        FfMacSchedSapProvider::SchedDlTriggerReqParameters trigger;
+        trigger.m_sfnSf = (((tti / 10 + 1) & 0x3FF) << 4) | (tti % 10 + 1);
+        for (const auto& data : user.m_dlConfig.m_buildDataList)
+        {
+            DlInfoListElement_s ack;
+            ack.m_rnti = data.m_rnti;
+            ack.m_harqProcessId = data.m_dci.m_harqProcess;
+            ack.m_harqStatus.resize(data.m_dci.m_tbsSize.size(), DlInfoListElement_s::ACK);
+            trigger.m_dlInfoList.push_back(ack);
+            checksum = checksum * 31 + (data.m_rnti ^ data.m_dci.m_rbBitmap);
+            allocations++;
+        }
+        user.m_dlConfig = FfMacSchedSapUser::SchedDlConfigIndParameters();
+        schedSap->SchedDlTriggerReq(trigger);
+    }
+    uint64_t runMs = time.End();
+
+    std::cout << "Run:         " << runMs << " ms (" << runMs * 1000.0 / ttis << " us per TTI)"
+              << std::endl;
+    std::cout << "Allocations: " << allocations << std::endl;
+    std::cout << "Checksum:    " << checksum << std::endl;
+
+    sched->Dispose();
+    ffr->Dispose();
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the statistics update of
+// MinstrelHtWifiManager with a large number of stations: the remote station
+// manager of an 802.11ac AP is fed, every 'interval', with the status of an
+// A-MPDU sent to each of the 'active' first stations out of 'stas', for
+// 'duration' of simulated time.  The MPDUs sent at a MCS above a limit
+// drawn for each station fail, so that the stations settle on distinct
+// rates.  The checksum of the MCSs selected can be used to check that the
+// rate selection is unchanged.
+// Sample usage:  ./ns3 run 'bench-minstrel-ht --stas=1000 --duration=20'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/node.h"
+#include "ns3/ssid.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Send an A-MPDU to each active station and report its status.
+ *
+ * \param manager the remote station manager of the AP
+ * \param stations the addresses of the stations
+ * \param maxMcs the highest MCS that each station receives
+ * \param active the number of active stations
+ * \param interval the interval between two A-MPDUs to a station
+ * \param checksum the checksum of the MCSs selected
+ */
+static void
+SendAmpdus(Ptr<WifiRemoteStationManager> manager,
+           const std::vector<Mac48Address>* stations,
+           const std::vector<uint8_t>* maxMcs,
+           uint32_t active,
+           Time interval,
+           uint64_t* checksum)
+{
+    WifiMacHeader header;
+    header.SetType(WIFI_MAC_QOSDATA);
+    for (uint32_t i = 0; i < active; i++)
+    {
+        header.SetAddr1((*stations)[i]);
+        WifiTxVector txVector = manager->GetDataTxVector(header, 80);
+        uint8_t mcs = txVector.GetMode().GetMcsValue();
+        *checksum = *checksum * 31 + mcs;
+        bool ok = mcs <= (*maxMcs)[i];
+        manager->ReportAmpduTxStatus((*stations)[i], ok ? 16 : 0, ok ? 0 : 16, 30, 30, txVector);
+    }
+    Simulator::Schedule(interval,
+                        &SendAmpdus,
+                        manager,
+                        stations,
+                        maxMcs,
+                        active,
+                        interval,
+                        checksum);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stas = 1000;
+    uint32_t active = 1000;
+    double duration = 20;
+    Time interval = MilliSeconds(10);
+    std::string manager = "ns3::MinstrelHtWifiManager";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the statistics update of MinstrelHtWifiManager");
+    cmd.AddValue("stas", "number of stations", stas);
+    cmd.AddValue("active", "number of stations receiving A-MPDUs", active);
+    cmd.AddValue("duration", "simulated time (s)", duration);
+    cmd.AddValue("interval", "interval between two A-MPDUs to a station", interval);
+    cmd.AddValue("manager", "remote station manager of the AP", manager);
+    cmd.Parse(argc, argv);
+    active = std::min(active, stas);
+
+    Ptr<Node> node = CreateObject<Node>();
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac",
+                "Ssid",
+                SsidValue(Ssid("bench")),
+                "BeaconGeneration",
+                BooleanValue(false));
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ac);
+    wifi.SetRemoteStationManager(manager);
+    Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(wifi.Install(phy, mac, node).Get(0));
+    Ptr<WifiRemoteStationManager> stationManager = device->GetRemoteStationManager();
+    Ptr<WifiMac> apMac = device->GetMac();
+
+    std::vector<Mac48Address> stations;
+    std::vector<uint8_t> maxMcs;
+    Ptr<UniformRandomVariable> mcsLimit = CreateObject<UniformRandomVariable>();
+    for (uint32_t i = 0; i < stas; i++)
+    {
+        Mac48Address address = Mac48Address::Allocate();
+        stationManager->AddAllSupportedModes(address);
+        stationManager->AddStationHtCapabilities(address, apMac->GetHtCapabilities(0));
+        stationManager->AddStationVhtCapabilities(address, apMac->GetVhtCapabilities(0));
+        stationManager->AddAllSupportedMcs(address);
+        stationManager->RecordGotAssocTxOk(address);
+        stations.push_back(address);
+        maxMcs.push_back(mcsLimit->GetInteger(0, 9));
+    }
+
+    std::cout << "Running bench-minstrel-ht with " << manager << ", " << active
+              << " active stations out of " << stas << " for " << duration << " s" << std::endl;
+
+    uint64_t checksum = 0;
+    Simulator::Schedule(interval,
+                        &SendAmpdus,
+                        stationManager,
+                        &stations,
+                        &maxMcs,
+                        active,
+                        interval,
+                        &checksum);
+    Simulator::Stop(Seconds(duration));
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    uint64_t runMs = time.End();
+
+    std::cout << "Run:      " << runMs << " ms" << std::endl;
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
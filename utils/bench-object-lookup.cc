@@ -0,0 +1,99 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the lookups of the object model
+// done by the setup of a scenario and by the models: the lookup of TypeIds,
+// Attributes and TraceSources by name, the creation of objects with an
+// ObjectFactory, and GetObject() on aggregated objects.
+// Sample usage:  ./ns3 run 'bench-object-lookup --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the lookups of TypeIds, Attributes, TraceSources and aggregates");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-object-lookup with " << n << " lookups" << std::endl;
+
+    uint64_t found = 0;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        TypeId tid;
+        found += TypeId::LookupByNameFailSafe("ns3::UniformRandomVariable", &tid);
+    }
+    std::cout << "TypeId by name:      " << time.End() << " ms" << std::endl;
+
+    // "Stream" is declared by the parent of UniformRandomVariable
+    TypeId tid = UniformRandomVariable::GetTypeId();
+    struct TypeId::AttributeInformation info;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        found += tid.LookupAttributeByName("Max", &info);
+        found += tid.LookupAttributeByName("Stream", &info);
+    }
+    std::cout << "Attribute by name:   " << time.End() << " ms" << std::endl;
+
+    // A missing TraceSource is searched in the whole inheritance tree
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        found += (tid.LookupTraceSourceByName("Value") == nullptr);
+    }
+    std::cout << "TraceSource by name: " << time.End() << " ms" << std::endl;
+
+    ObjectFactory factory("ns3::UniformRandomVariable");
+    time.Start();
+    for (uint32_t i = 0; i < n / 10; i++)
+    {
+        factory.Set("Min", DoubleValue(1));
+        factory.Set("Max", DoubleValue(2));
+        found += (factory.Create<UniformRandomVariable>() != nullptr);
+    }
+    std::cout << "ObjectFactory:       " << time.End() << " ms" << std::endl;
+
+    Ptr<Object> aggregate = CreateObject<UniformRandomVariable>();
+    aggregate->AggregateObject(CreateObject<ConstantRandomVariable>());
+    aggregate->AggregateObject(CreateObject<SequentialRandomVariable>());
+    aggregate->AggregateObject(CreateObject<ExponentialRandomVariable>());
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // Alternate between the aggregates, so that the first one is
+        // rarely the one looked up.
+        found += (aggregate->GetObject<ExponentialRandomVariable>() != nullptr);
+        found += (aggregate->GetObject<ConstantRandomVariable>() != nullptr);
+    }
+    std::cout << "GetObject:           " << time.End() << " ms" << std::endl;
+
+    std::cout << "Found:               " << found << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup time of large topologies:
+// it times the creation of the nodes, the installation of the devices and of
+// the internet stack, and the assignment of the addresses, for a chain of
+// point-to-point links, for CSMA LANs and for Wi-Fi ad hoc networks.  The
+// device attributes are set with strings, as in most scenarios.
+// Sample usage:  ./ns3 run 'bench-setup --nodes=100000 --topology=p2p'
+
+#include "ns3/channel-list.h"
+#include "ns3/command-line.h"
+#include "ns3/csma-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Print the time of a phase of the setup, and restart the clock
+ * \param phase the phase
+ * \param time the clock
+ */
+static void
+Report(const std::string& phase, SystemWallClockMs& time)
+{
+    std::cout << "  " << std::left << std::setw(10) << phase << time.End() << " ms" << std::endl;
+    time.Start();
+}
+
+/**
+ * \brief Install the internet stack and the addresses of a topology
+ * \param nodes the nodes
+ * \param lans the devices of each subnet
+ * \param mask the mask of the subnets
+ * \param time the clock
+ */
+static void
+InstallInternet(NodeContainer& nodes,
+                const std::vector<NetDeviceContainer>& lans,
+                const char* mask,
+                SystemWallClockMs& time)
+{
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Report("stack:", time);
+
+    Ipv4AddressHelper address("10.0.0.0", mask);
+    for (const auto& devices : lans)
+    {
+        address.Assign(devices);
+        address.NewNetwork();
+    }
+    Report("address:", time);
+}
+
+/**
+ * \brief Build a chain of point-to-point links
+ * \param n the number of nodes
+ */
+static void
+BuildPointToPoint(uint32_t n)
+{
+    std::cout << "Point-to-point chain" << std::endl;
+    SystemWallClockMs time;
+    time.Start();
+    NodeContainer nodes;
+    nodes.Create(n);
+    Report("nodes:", time);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("2ms"));
+    std::vector<NetDeviceContainer> links;
+    links.reserve(n);
+    ChannelList::Reserve(n - 1);
+    for (uint32_t i = 1; i < n; i++)
+    {
+        links.push_back(p2p.Install(nodes.Get(i - 1), nodes.Get(i)));
+    }
+    Report("devices:", time);
+
+    InstallInternet(nodes, links, "255.255.255.252", time);
+    Simulator::Destroy();
+    Report("destroy:", time);
+}
+
+/**
+ * \brief Build CSMA LANs
+ * \param n the number of nodes
+ * \param size the number of nodes of each LAN
+ */
+static void
+BuildCsma(uint32_t n, uint32_t size)
+{
+    std::cout << "CSMA LANs of " << size << " nodes" << std::endl;
+    SystemWallClockMs time;
+    time.Start();
+    NodeContainer nodes;
+    nodes.Create(n);
+    Report("nodes:", time);
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("100Mbps"));
+    csma.SetChannelAttribute("Delay", StringValue("6560ns"));
+    std::vector<NetDeviceContainer> lans;
+    ChannelList::Reserve((n + size - 1) / size);
+    for (uint32_t first = 0; first < n; first += size)
+    {
+        NodeContainer lan;
+        for (uint32_t i = first; i < std::min(n, first + size); i++)
+        {
+            lan.Add(nodes.Get(i));
+        }
+        lans.push_back(csma.Install(lan));
+    }
+    Report("devices:", time);
+
+    InstallInternet(nodes, lans, "255.255.255.0", time);
+    Simulator::Destroy();
+    Report("destroy:", time);
+}
+
+/**
+ * \brief Build Wi-Fi ad hoc networks
+ * \param n the number of nodes
+ * \param size the number of nodes of each network
+ */
+static void
+BuildWifi(uint32_t n, uint32_t size)
+{
+    std::cout << "Wi-Fi ad hoc networks of " << size << " nodes" << std::endl;
+    SystemWallClockMs time;
+    time.Start();
+    NodeContainer nodes;
+    nodes.Create(n);
+    Report("nodes:", time);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  StringValue("10.0"),
+                                  "DeltaY",
+                                  StringValue("10.0"),
+                                  "GridWidth",
+                                  StringValue("100"));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+    Report("mobility:", time);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.Set("TxPowerStart", StringValue("16.0"));
+    phy.Set("TxPowerEnd", StringValue("16.0"));
+    std::vector<NetDeviceContainer> networks;
+    for (uint32_t first = 0; first < n; first += size)
+    {
+        NodeContainer network;
+        for (uint32_t i = first; i < std::min(n, first + size); i++)
+        {
+            network.Add(nodes.Get(i));
+        }
+        phy.SetChannel(channel.Create());
+        networks.push_back(wifi.Install(phy, mac, network));
+    }
+    Report("devices:", time);
+
+    InstallInternet(nodes, networks, "255.255.255.0", time);
+    Simulator::Destroy();
+    Report("destroy:", time);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nNodes = 10000;
+    uint32_t size = 50;
+    std::string topology = "all";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the setup time of large topologies");
+    cmd.AddValue("nodes", "number of nodes", nNodes);
+    cmd.AddValue("size", "number of nodes of each CSMA or Wi-Fi network", size);
+    cmd.AddValue("topology", "p2p, csma, wifi or all", topology);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-setup with " << nNodes << " nodes" << std::endl;
+
+    if (topology == "p2p" || topology == "all")
+    {
+        BuildPointToPoint(nNodes);
+    }
+    if (topology == "csma" || topology == "all")
+    {
+        BuildCsma(nNodes, size);
+    }
+    if (topology == "wifi" || topology == "all")
+    {
+        BuildWifi(nNodes, size);
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the overhead of the trace sources on
+// a TCP bulk transfer between two nodes connected by a point-to-point link.
+// With 'traces', sinks are connected to the Tx and Rx trace sources of the
+// sockets and of the devices; without it, the time left to the trace sources
+// is the one of the checks of NS_TRACE (none when configured with
+// --disable-trace-sources) and of the TracedCallbacks still invoked directly.
+// Sample usage:  ./ns3 run 'bench-tcp-bulk-send --bytes=100000000 --traces=1'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-socket-factory.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace ns3;
+
+static uint64_t g_bytesToSend; //!< bytes left to send
+static uint64_t g_bytesRecv;   //!< bytes received
+static uint64_t g_traced;      //!< packets seen by the trace sinks
+
+/**
+ * \brief Fill the transmission buffer of the sender
+ * \param socket the sender socket
+ * \param available the free space of the buffer
+ */
+static void
+Send(Ptr<Socket> socket, uint32_t available)
+{
+    while (g_bytesToSend > 0 && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint64_t>({g_bytesToSend, socket->GetTxAvailable(), 65536});
+        int sent = socket->Send(Create<Packet>(size));
+        if (sent <= 0)
+        {
+            return;
+        }
+        g_bytesToSend -= sent;
+    }
+    if (g_bytesToSend == 0)
+    {
+        socket->Close();
+    }
+}
+
+/**
+ * \brief Drain the reception buffer of the receiver
+ * \param socket the receiver socket
+ */
+static void
+Receive(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        g_bytesRecv += packet->GetSize();
+    }
+}
+
+/**
+ * \brief Accept a connection on the receiver
+ * \param socket the accepted socket
+ * \param from the address of the sender
+ */
+static void
+Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&Receive));
+}
+
+/**
+ * \brief Connect the sender, once the nodes are initialized
+ * \param socket the sender socket
+ * \param to the address of the receiver
+ */
+static void
+Connect(Ptr<Socket> socket, const Address& to)
+{
+    socket->Connect(to);
+}
+
+/**
+ * \brief Trace sink of the sockets
+ * \param packet the packet
+ * \param header the TCP header
+ * \param socket the socket
+ */
+static void
+SocketSink(Ptr<const Packet> packet, const TcpHeader& header, Ptr<const TcpSocketBase> socket)
+{
+    g_traced++;
+}
+
+/**
+ * \brief Trace sink of the devices
+ * \param packet the packet
+ */
+static void
+DeviceSink(Ptr<const Packet> packet)
+{
+    g_traced++;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t bytes = 100000000;
+    bool traces = false;
+    std::string dataRate = "10Gbps";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the trace sources on a TCP bulk transfer");
+    cmd.AddValue("bytes", "number of bytes to send", bytes);
+    cmd.AddValue("traces", "connect sinks to the Tx and Rx trace sources", traces);
+    cmd.AddValue("dataRate", "data rate of the link", dataRate);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 22));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 22));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue(dataRate));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Ipv4AddressHelper address("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    uint16_t port = 50000;
+    Ptr<Socket> receiver = Socket::CreateSocket(nodes.Get(1), TcpSocketFactory::GetTypeId());
+    receiver->Bind(InetSocketAddress(Ipv4Address::GetAny(), port));
+    receiver->Listen();
+    receiver->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                MakeCallback(&Accept));
+
+    Ptr<Socket> sender = Socket::CreateSocket(nodes.Get(0), TcpSocketFactory::GetTypeId());
+    sender->Bind();
+    sender->SetSendCallback(MakeCallback(&Send));
+    Simulator::Schedule(Seconds(0),
+                        &Connect,
+                        sender,
+                        InetSocketAddress(interfaces.GetAddress(1), port));
+
+    if (traces)
+    {
+        sender->TraceConnectWithoutContext("Tx", MakeCallback(&SocketSink));
+        sender->TraceConnectWithoutContext("Rx", MakeCallback(&SocketSink));
+        for (uint32_t i = 0; i < devices.GetN(); i++)
+        {
+            devices.Get(i)->TraceConnectWithoutContext("MacTx", MakeCallback(&DeviceSink));
+            devices.Get(i)->TraceConnectWithoutContext("MacRx", MakeCallback(&DeviceSink));
+        }
+    }
+
+    g_bytesToSend = bytes;
+    g_bytesRecv = 0;
+    g_traced = 0;
+
+    std::cout << "Running bench-tcp-bulk-send with " << bytes << " bytes at " << dataRate
+              << (traces ? ", with" : ", without") << " trace sinks" << std::endl;
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+
+    std::cout << "Received:   " << g_bytesRecv << " bytes in " << Simulator::Now().GetSeconds()
+              << " s" << std::endl;
+    std::cout << "Events:     " << Simulator::GetEventCount() << std::endl;
+    std::cout << "Traced:     " << g_traced << " packets" << std::endl;
+    std::cout << "Run:        " << elapsed << " ms" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the reassembly of TcpRxBuffer with
+// heavy reordering: a window of 'segments' segments is received with the
+// first segment of each group of 'reorder' segments arriving last, and the
+// application reads the data only when the whole window has arrived.
+// Sample usage:  ./ns3 run 'bench-tcp-rx-buffer --segments=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-rx-buffer.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t segments = 100000;
+    uint32_t segmentSize = 1448;
+    uint32_t reorder = 10;
+    uint32_t windows = 5;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the reassembly of TcpRxBuffer with heavy reordering");
+    cmd.AddValue("segments", "number of segments per window", segments);
+    cmd.AddValue("segmentSize", "segment size", segmentSize);
+    cmd.AddValue("reorder", "the first segment of each group of reorder segments is late", reorder);
+    cmd.AddValue("windows", "number of windows", windows);
+    cmd.Parse(argc, argv);
+
+    TcpRxBuffer rxBuf;
+    rxBuf.SetMaxBufferSize(segments * segmentSize);
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+    TcpHeader header;
+    Ptr<Packet> segment = Create<Packet>(segmentSize);
+
+    std::cout << "Running bench-tcp-rx-buffer with " << windows << " windows of " << segments
+              << " segments of " << segmentSize << " bytes, reordering " << reorder << std::endl;
+
+    SystemWallClockMs time;
+    uint64_t addMs = 0;
+    uint64_t extractMs = 0;
+    uint64_t extracted = 0;
+    SequenceNumber32 windowStart(1);
+    for (uint32_t w = 0; w < windows; w++)
+    {
+        time.Start();
+        for (uint32_t i = 0; i < segments; i++)
+        {
+            if (i % reorder != 0)
+            {
+                header.SetSequenceNumber(windowStart + i * segmentSize);
+                rxBuf.Add(segment, header);
+            }
+        }
+        for (uint32_t i = 0; i < segments; i += reorder)
+        {
+            header.SetSequenceNumber(windowStart + i * segmentSize);
+            rxBuf.Add(segment, header);
+        }
+        addMs += time.End();
+
+        time.Start();
+        while (rxBuf.Available() > 0)
+        {
+            extracted += rxBuf.Extract(segmentSize)->GetSize();
+        }
+        extractMs += time.End();
+        windowStart = rxBuf.NextRxSequence();
+    }
+
+    std::cout << "Add:     " << addMs << " ms" << std::endl;
+    std::cout << "Extract: " << extractMs << " ms (" << extracted << " bytes)" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the SACK scoreboard of TcpTxBuffer
+// for a long fat pipe: 'segments' segments are in flight, one every 'gap'
+// segments is lost, and the receiver reports the others in SACK blocks
+// (three per ACK), while the sender retransmits the lost segments.
+// Sample usage:  ./ns3 run 'bench-tcp-tx-buffer --segments=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/core-module.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-option-sack.h"
+#include "ns3/tcp-tx-buffer.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * \return an unlimited receiver window
+ */
+static uint32_t
+GetRWnd()
+{
+    return std::numeric_limits<uint32_t>::max();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t segments = 100000;
+    uint32_t segmentSize = 1448;
+    uint32_t gap = 100;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the SACK scoreboard of TcpTxBuffer");
+    cmd.AddValue("segments", "number of segments in flight", segments);
+    cmd.AddValue("segmentSize", "segment size", segmentSize);
+    cmd.AddValue("gap", "one segment every gap segments is lost", gap);
+    cmd.Parse(argc, argv);
+
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&GetRWnd));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetMaxBufferSize(segments * segmentSize);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(segments * segmentSize));
+
+    std::cout << "Running bench-tcp-tx-buffer with " << segments << " segments of "
+              << segmentSize << " bytes, one every " << gap << " lost" << std::endl;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < segments; i++)
+    {
+        txBuf->CopyFromSequence(segmentSize, SequenceNumber32(1 + i * segmentSize));
+    }
+    std::cout << "Send:       " << time.End() << " ms" << std::endl;
+
+    time.Start();
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    SequenceNumber32 blockStart(1 + segmentSize);
+    uint32_t nAcks = 0;
+    for (uint32_t i = 1; i < segments; i++)
+    {
+        SequenceNumber32 segmentStart(1 + i * segmentSize);
+        if (i % gap == 0)
+        {
+            if (segmentStart > blockStart)
+            {
+                sack->AddSackBlock(TcpOptionSack::SackBlock(blockStart, segmentStart));
+            }
+            blockStart = segmentStart + segmentSize;
+        }
+        else if (i == segments - 1)
+        {
+            sack->AddSackBlock(TcpOptionSack::SackBlock(blockStart, segmentStart + segmentSize));
+        }
+        if (sack->GetNumSackBlocks() == 3 || (i == segments - 1 && sack->GetNumSackBlocks() > 0))
+        {
+            txBuf->Update(sack->GetSackList());
+            sack->ClearSackList();
+            nAcks++;
+        }
+    }
+    std::cout << "SACK:       " << time.End() << " ms (" << nAcks << " ACKs, "
+              << txBuf->GetSacked() << " bytes sacked, " << txBuf->GetLost() << " bytes lost)"
+              << std::endl;
+
+    time.Start();
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    uint32_t nRetransmissions = 0;
+    while (txBuf->NextSeg(&seq, &seqHigh, false) && txBuf->IsLost(seq))
+    {
+        txBuf->CopyFromSequence(segmentSize, seq);
+        txBuf->BytesInFlight();
+        nRetransmissions++;
+    }
+    std::cout << "Retransmit: " << time.End() << " ms (" << nRetransmissions
+              << " segments retransmitted)" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program renders a binary log written with the 'binary' token of
+// NS_LOG, or with LogSetBinaryFile, in the text format of the NS_LOG macros.
+// The messages of each thread are in order; the messages of different
+// threads are in the order in which their buffers were flushed.
+// Sample usage:  ./ns3 run 'read-binary-log --file=ns3-log.bin'
+
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string file = "ns3-log.bin";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Render a binary log as text");
+    cmd.AddValue("file", "the binary log", file);
+    cmd.Parse(argc, argv);
+
+    BinaryLogReader reader;
+    if (!reader.Open(file))
+    {
+        std::cerr << "Unable to open binary log " << file << std::endl;
+        return 1;
+    }
+    std::string line;
+    while (reader.Read(line))
+    {
+        std::cout << line << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a binary trace written with
+// AsciiTraceHelper::CreateBinaryFileStream to text or CSV, optionally keeping
+// only the events of a node or of a time range.  The blocks of the trace which
+// cannot contain such events are skipped without being decoded.
+// Sample usage:  ./ns3 run 'read-binary-trace --file=trace.btr --node=1 --start=2s'
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * \param id a node or device id
+ * \return the id, or -1 if unknown
+ */
+static int64_t
+FormatId(uint32_t id)
+{
+    return id == BinaryTraceWriter::NO_ID ? -1 : static_cast<int64_t>(id);
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string file;
+    bool csv = false;
+    int64_t node = -1;
+    Time start = Time::Min();
+    Time stop = Time::Max();
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace to text or CSV");
+    cmd.AddValue("file", "the binary trace", file);
+    cmd.AddValue("csv", "write CSV instead of text", csv);
+    cmd.AddValue("node", "only write the events of this node (-1 for all)", node);
+    cmd.AddValue("start", "only write the events from this time", start);
+    cmd.AddValue("stop", "only write the events until this time", stop);
+    cmd.Parse(argc, argv);
+
+    BinaryTraceReader reader;
+    if (!reader.Open(file))
+    {
+        std::cerr << "Unable to open binary trace " << file << std::endl;
+        return 1;
+    }
+    if (node >= 0)
+    {
+        reader.SetNode(node);
+    }
+    reader.SetTimeRange(start.GetNanoSeconds(), stop.GetNanoSeconds());
+
+    if (csv)
+    {
+        std::cout << "type,time,node,device,uid,size,headers" << std::endl;
+    }
+    BinaryTraceReader::Event event;
+    while (reader.Read(event))
+    {
+        double seconds = NanoSeconds(event.time).GetSeconds();
+        if (csv)
+        {
+            std::cout << event.type << "," << seconds << "," << FormatId(event.node) << ","
+                      << FormatId(event.device) << "," << event.uid << "," << event.size << ",\""
+                      << event.summary << "\"\n";
+        }
+        else
+        {
+            std::cout << event.type << " " << seconds << " " << FormatId(event.node) << " "
+                      << FormatId(event.device) << " " << event.uid << " " << event.size;
+            if (!event.summary.empty())
+            {
+                std::cout << " " << event.summary;
+            }
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}